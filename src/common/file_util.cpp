@@ -43,7 +43,9 @@
 #include <cstdlib>
 #include <cstring>
 #include <dirent.h>
+#include <fcntl.h>
 #include <pwd.h>
+#include <sys/mman.h>
 #include <unistd.h>
 #endif
 
@@ -1025,4 +1027,52 @@ bool IOFile::Resize(u64 size) {
         ;
 }
 
+MappedFile::MappedFile(const std::string& filename) {
+#ifdef _WIN32
+    const HANDLE file =
+        CreateFileW(Common::UTF8ToUTF16W(filename).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    LARGE_INTEGER file_size;
+    if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0) {
+        // The view keeps the mapping alive, neither handle is needed after this
+        const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping != nullptr) {
+            m_data = static_cast<const u8*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            m_size = m_data != nullptr ? static_cast<std::size_t>(file_size.QuadPart) : 0;
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+#else
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return;
+    }
+    struct stat file_info;
+    if (fstat(fd, &file_info) == 0 && file_info.st_size > 0) {
+        const auto size = static_cast<std::size_t>(file_info.st_size);
+        void* const pointer = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (pointer != MAP_FAILED) {
+            m_data = static_cast<const u8*>(pointer);
+            m_size = size;
+        }
+    }
+    close(fd);
+#endif
+}
+
+MappedFile::~MappedFile() {
+    if (m_data == nullptr) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+#else
+    munmap(const_cast<u8*>(m_data), m_size);
+#endif
+}
+
 } // namespace Common::FS
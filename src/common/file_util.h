@@ -10,6 +10,7 @@
 #include <functional>
 #include <limits>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -296,4 +297,24 @@ private:
     std::FILE* m_file = nullptr;
 };
 
+// Read-only view of a whole file mapped into memory, for large files that are only parsed once
+class MappedFile : public NonCopyable {
+public:
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+
+    // Empty files are never mapped
+    [[nodiscard]] bool IsOpen() const {
+        return m_data != nullptr;
+    }
+
+    [[nodiscard]] std::span<const u8> Data() const {
+        return {m_data, m_size};
+    }
+
+private:
+    const u8* m_data = nullptr;
+    std::size_t m_size = 0;
+};
+
 } // namespace Common::FS
@@ -0,0 +1,242 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+
+#include "common/bit_util.h"
+#include "common/common_types.h"
+
+namespace Common {
+
+/// Links of an element in an IntrusiveMultiLevelQueue.
+template <typename T>
+struct IntrusiveMultiLevelQueueNode {
+    T* prev = nullptr;
+    T* next = nullptr;
+    /// Queue the element is in, nullptr when it is in none
+    const void* owner = nullptr;
+    u32 priority = 0;
+};
+
+/**
+ * A MultiLevelQueue whose links live in the elements themselves, so that adding and removing an
+ * element never allocates nor searches its level. The highest priority level in use is found with
+ * a single bit scan of the level bitmap.
+ *
+ * Elements are pointers to T. Nodes is a pointer to a member of T holding an array of
+ * IntrusiveMultiLevelQueueNode<T>, and each queue uses the node at its own node index. An element
+ * can be in any number of queues at once as long as they use different nodes.
+ */
+template <typename T, std::size_t Depth, auto Nodes>
+class IntrusiveMultiLevelQueue {
+    static_assert(Depth <= 64, "Priorities must fit in the level bitmap");
+
+public:
+    using Node = IntrusiveMultiLevelQueueNode<T>;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T*;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T* const*;
+        using reference = T* const&;
+
+        const_iterator() = default;
+
+        friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) {
+            return lhs.element == rhs.element;
+        }
+
+        friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs) {
+            return !operator==(lhs, rhs);
+        }
+
+        reference operator*() const {
+            return element;
+        }
+
+        const_iterator& operator++() {
+            if (element == nullptr) {
+                return *this;
+            }
+            const Node& node = queue->GetNode(element);
+            element = node.next;
+            if (element == nullptr) {
+                const u32 priority = queue->highest_priority_set(node.priority + 1);
+                element = priority == Depth ? nullptr : queue->heads[priority];
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const const_iterator v{*this};
+            ++(*this);
+            return v;
+        }
+
+    private:
+        friend class IntrusiveMultiLevelQueue;
+
+        explicit const_iterator(const IntrusiveMultiLevelQueue* queue_, T* element_)
+            : queue{queue_}, element{element_} {}
+
+        const IntrusiveMultiLevelQueue* queue = nullptr;
+        T* element = nullptr;
+    };
+    using iterator = const_iterator;
+
+    /// Sets which of the nodes of the elements this queue links through. Must be called while the
+    /// queue is empty.
+    void set_node_index(std::size_t index) {
+        node_index = index;
+    }
+
+    void add(T* element, u32 priority, bool send_back = true) {
+        Node& node = GetNode(element);
+        if (node.owner != nullptr) {
+            // The node is taken by this or another queue, linking it again would corrupt both
+            return;
+        }
+        node.owner = this;
+        node.priority = priority;
+        if (send_back) {
+            node.prev = tails[priority];
+            node.next = nullptr;
+            if (node.prev != nullptr) {
+                GetNode(node.prev).next = element;
+            } else {
+                heads[priority] = element;
+            }
+            tails[priority] = element;
+        } else {
+            node.prev = nullptr;
+            node.next = heads[priority];
+            if (node.next != nullptr) {
+                GetNode(node.next).prev = element;
+            } else {
+                tails[priority] = element;
+            }
+            heads[priority] = element;
+        }
+        ++sizes[priority];
+        used_priorities |= 1ULL << priority;
+    }
+
+    void remove(T* element, u32 priority) {
+        Node& node = GetNode(element);
+        if (node.owner != this || node.priority != priority) {
+            return;
+        }
+        Unlink(element, node);
+    }
+
+    /// Moves the first n elements of a level to its back.
+    void yield(u32 priority, std::size_t n = 1) {
+        if (n >= sizes[priority]) {
+            return;
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            T* const element = heads[priority];
+            Node& node = GetNode(element);
+            Unlink(element, node);
+            add(element, priority);
+        }
+    }
+
+    [[nodiscard]] std::size_t depth() const {
+        return Depth;
+    }
+
+    [[nodiscard]] std::size_t size(u32 priority) const {
+        return sizes[priority];
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        std::size_t size = 0;
+        for (const u32 level_size : sizes) {
+            size += level_size;
+        }
+        return size;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return used_priorities == 0;
+    }
+
+    [[nodiscard]] bool empty(u32 priority) const {
+        return (used_priorities & (1ULL << priority)) == 0;
+    }
+
+    [[nodiscard]] u32 highest_priority_set(u32 max_priority = 0) const {
+        if (max_priority >= Depth) {
+            return Depth;
+        }
+        const u64 priorities = used_priorities & ~((1ULL << max_priority) - 1);
+        return priorities == 0 ? Depth : static_cast<u32>(CountTrailingZeroes64(priorities));
+    }
+
+    [[nodiscard]] const_iterator begin(u32 max_priority = 0) const {
+        const u32 priority = highest_priority_set(max_priority);
+        return const_iterator{this, priority == Depth ? nullptr : heads[priority]};
+    }
+
+    [[nodiscard]] const_iterator end() const {
+        return const_iterator{this, nullptr};
+    }
+
+    /// Returns the first element of the highest priority level at or below max_priority, or
+    /// nullptr if there is none.
+    [[nodiscard]] T* front(u32 max_priority = 0) const {
+        const u32 priority = highest_priority_set(max_priority);
+        return priority == Depth ? nullptr : heads[priority];
+    }
+
+    void clear() {
+        while (used_priorities != 0) {
+            const u32 priority = static_cast<u32>(CountTrailingZeroes64(used_priorities));
+            while (heads[priority] != nullptr) {
+                T* const element = heads[priority];
+                Unlink(element, GetNode(element));
+            }
+        }
+    }
+
+private:
+    Node& GetNode(T* element) const {
+        return (element->*Nodes)[node_index];
+    }
+
+    void Unlink(T* element, Node& node) {
+        const u32 priority = node.priority;
+        if (node.prev != nullptr) {
+            GetNode(node.prev).next = node.next;
+        } else {
+            heads[priority] = node.next;
+        }
+        if (node.next != nullptr) {
+            GetNode(node.next).prev = node.prev;
+        } else {
+            tails[priority] = node.prev;
+        }
+        node.prev = nullptr;
+        node.next = nullptr;
+        node.owner = nullptr;
+        if (--sizes[priority] == 0) {
+            used_priorities &= ~(1ULL << priority);
+        }
+    }
+
+    std::array<T*, Depth> heads{};
+    std::array<T*, Depth> tails{};
+    std::array<u32, Depth> sizes{};
+    u64 used_priorities = 0;
+    std::size_t node_index = 0;
+};
+
+} // namespace Common
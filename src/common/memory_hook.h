@@ -41,6 +41,10 @@ public:
     virtual bool Write64(VAddr addr, u64 data) = 0;
 
     virtual bool WriteBlock(VAddr dest_addr, const void* src_buffer, std::size_t size) = 0;
+
+    /// Called once [base, base + size) has been remapped. Hooks on those pages belonged to the old
+    /// mapping and have been removed.
+    virtual void OnRemap(VAddr base, u64 size) {}
 };
 
 using MemoryHookPointer = std::shared_ptr<MemoryHook>;
@@ -2,6 +2,9 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <mutex>
+
 #include "common/page_table.h"
 
 namespace Common {
@@ -22,4 +25,28 @@ void PageTable::Resize(std::size_t address_space_width_in_bits, std::size_t page
     }
 }
 
+void PageTable::AddMemoryRun(VAddr base, u64 size, u8* pointer) {
+    using Interval = decltype(memory_runs)::interval_type;
+    std::unique_lock lock{memory_runs_mutex};
+    memory_runs.set(
+        {Interval::right_open(base, base + size), reinterpret_cast<uintptr_t>(pointer)});
+}
+
+void PageTable::RemoveMemoryRun(VAddr base, u64 size) {
+    using Interval = decltype(memory_runs)::interval_type;
+    std::unique_lock lock{memory_runs_mutex};
+    memory_runs.erase(Interval::right_open(base, base + size));
+}
+
+std::pair<u8*, std::size_t> PageTable::FindMemoryRun(VAddr vaddr, std::size_t size) const {
+    std::shared_lock lock{memory_runs_mutex};
+    const auto it = memory_runs.find(vaddr);
+    if (it == memory_runs.end()) {
+        return {nullptr, 0};
+    }
+    const u64 run_size = boost::icl::last(it->first) + 1 - vaddr;
+    return {reinterpret_cast<u8*>(it->second) + vaddr,
+            static_cast<std::size_t>(std::min<u64>(run_size, size))};
+}
+
 } // namespace Common
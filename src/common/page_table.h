@@ -4,6 +4,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <set>
+#include <shared_mutex>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include <boost/icl/interval_map.hpp>
@@ -62,6 +67,27 @@ struct PageTable {
     void Resize(std::size_t address_space_width_in_bits, std::size_t page_size_in_bits,
                 bool has_attribute);
 
+    /**
+     * Records a range of pages of type `Memory` that is contiguous in host memory.
+     *
+     * @param base    The address of the first page of the range.
+     * @param size    The size of the range in bytes.
+     * @param pointer The entry the pages of the range share in `pointers`.
+     */
+    void AddMemoryRun(VAddr base, u64 size, u8* pointer);
+
+    /// Forgets a range of pages that is no longer of type `Memory`.
+    void RemoveMemoryRun(VAddr base, u64 size);
+
+    /**
+     * Finds the run of contiguous plain memory holding an address.
+     *
+     * @returns A host pointer to the address and the number of bytes from it, up to size, that can
+     *          be accessed through it. nullptr and zero if the page of the address is not of type
+     *          `Memory`.
+     */
+    [[nodiscard]] std::pair<u8*, std::size_t> FindMemoryRun(VAddr vaddr, std::size_t size) const;
+
     /**
      * Vector of memory pointers backing each page. An entry can only be non-null if the
      * corresponding entry in the `attributes` vector is of type `Memory`.
@@ -71,6 +97,26 @@ struct PageTable {
     VirtualBuffer<u64> backing_addr;
 
     VirtualBuffer<PageType> attributes;
+
+    /**
+     * Hooks attached to ranges of virtual addresses. Pages covered by a debug hook are of type
+     * `Special`, they keep their `backing_addr` so accesses not handled by a hook still reach
+     * memory.
+     */
+    boost::icl::interval_map<VAddr, std::set<SpecialRegion>> special_regions;
+
+    /// Number of intervals in `special_regions`, read without a lock so that accesses to pages
+    /// that can't have hooks skip looking them up while none are attached.
+    std::atomic<std::size_t> num_special_regions{0};
+
+    /**
+     * Runs of pages of type `Memory` that are contiguous in host memory, mapped to the entry they
+     * share in `pointers`. Adjacent runs with the same entry are joined, so whether a whole range
+     * can be accessed with a single host pointer takes a single lookup. Whoever changes the
+     * pointer of a page keeps it up to date.
+     */
+    boost::icl::interval_map<VAddr, uintptr_t> memory_runs;
+    mutable std::shared_mutex memory_runs_mutex;
 };
 
 } // namespace Common
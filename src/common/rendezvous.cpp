@@ -0,0 +1,67 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <thread>
+#include "common/rendezvous.h"
+
+#if _MSC_VER
+#include <intrin.h>
+#if _M_AMD64
+#define __x86_64__ 1
+#endif
+#if _M_ARM64
+#define __aarch64__ 1
+#endif
+#else
+#if __x86_64__
+#include <xmmintrin.h>
+#endif
+#endif
+
+namespace {
+
+// Number of polls before falling back to a kernel wait. Most frame steps hand the baton back
+// within a few microseconds, so this avoids the futex syscall on the common path. Spinning on a
+// single core host only delays the other side, so it is skipped there.
+u32 GetSpinCount() {
+    static const u32 spin_count = std::thread::hardware_concurrency() > 1 ? 512 : 0;
+    return spin_count;
+}
+
+void ThreadPause() {
+#if __x86_64__
+    _mm_pause();
+#elif __aarch64__ && _MSC_VER
+    __yield();
+#elif __aarch64__
+    asm("yield");
+#endif
+}
+
+} // Anonymous namespace
+
+namespace Common {
+
+void Rendezvous::HandTo(Side side) {
+    owner.store(side, std::memory_order_release);
+    owner.notify_one();
+}
+
+void Rendezvous::WaitFor(Side side) const {
+    const u32 spin_count = GetSpinCount();
+    for (u32 spin = 0; spin < spin_count; ++spin) {
+        if (owner.load(std::memory_order_acquire) == side) {
+            return;
+        }
+        ThreadPause();
+    }
+
+    Side current = owner.load(std::memory_order_acquire);
+    while (current != side) {
+        owner.wait(current, std::memory_order_acquire);
+        current = owner.load(std::memory_order_acquire);
+    }
+}
+
+} // namespace Common
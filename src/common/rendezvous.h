@@ -0,0 +1,47 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include "common/common_types.h"
+
+namespace Common {
+
+/**
+ * Rendezvous class
+ * a two party baton where exactly one side runs at any time. Ownership is handed over with a
+ * single atomic store and waited on with a short spin followed by an atomic wait (a futex on
+ * Linux), so a round trip costs neither a mutex nor a condition variable.
+ */
+class Rendezvous {
+public:
+    enum class Side : u32 {
+        Host,
+        Worker,
+    };
+
+    explicit Rendezvous(Side initial = Side::Host) : owner{initial} {}
+
+    /// Gives ownership to the specified side and wakes it up if it is sleeping.
+    void HandTo(Side side);
+
+    /// Blocks the calling thread until the specified side owns the rendezvous.
+    void WaitFor(Side side) const;
+
+    /// Hands ownership to `to` and then blocks until it is handed back to `from`.
+    void HandToAndWait(Side to, Side from) {
+        HandTo(to);
+        WaitFor(from);
+    }
+
+    [[nodiscard]] Side Owner() const {
+        return owner.load(std::memory_order_acquire);
+    }
+
+private:
+    std::atomic<Side> owner;
+};
+
+} // namespace Common
@@ -155,44 +155,9 @@ std::vector<ARM_Interface::BacktraceEntry> ARM_Interface::GetBacktraceFromContex
         fp = memory.Read64(fp);
     }
 
-    std::map<VAddr, std::string> modules;
-    auto& loader{system.GetAppLoader()};
-    if (loader.ReadNSOModules(modules) != Loader::ResultStatus::Success) {
+    if (!SymbolizeBacktrace(system, out)) {
         return {};
     }
-
-    std::map<std::string, Symbols> symbols;
-    for (const auto& module : modules) {
-        symbols.insert_or_assign(module.second, GetSymbols(module.first, memory));
-    }
-
-    for (auto& entry : out) {
-        VAddr base = 0;
-        for (auto iter = modules.rbegin(); iter != modules.rend(); ++iter) {
-            const auto& module{*iter};
-            if (entry.original_address >= module.first) {
-                entry.module = module.second;
-                base = module.first;
-                break;
-            }
-        }
-
-        entry.offset = entry.original_address - base;
-        entry.address = SEGMENT_BASE + entry.offset;
-
-        if (entry.module.empty())
-            entry.module = "unknown";
-
-        const auto symbol_set = symbols.find(entry.module);
-        if (symbol_set != symbols.end()) {
-            const auto symbol = GetSymbolName(symbol_set->second, entry.offset);
-            if (symbol.has_value()) {
-                // TODO(DarkLordZach): Add demangling of symbol names.
-                entry.name = *symbol;
-            }
-        }
-    }
-
     return out;
 }
 
@@ -211,10 +176,19 @@ std::vector<ARM_Interface::BacktraceEntry> ARM_Interface::GetBacktrace() const {
         fp = memory.Read64(fp);
     }
 
+    if (!SymbolizeBacktrace(system, out)) {
+        return {};
+    }
+    return out;
+}
+
+bool ARM_Interface::SymbolizeBacktrace(System& system, std::vector<BacktraceEntry>& backtrace) {
+    auto& memory = system.Memory();
+
     std::map<VAddr, std::string> modules;
     auto& loader{system.GetAppLoader()};
     if (loader.ReadNSOModules(modules) != Loader::ResultStatus::Success) {
-        return {};
+        return false;
     }
 
     std::map<std::string, Symbols> symbols;
@@ -222,7 +196,7 @@ std::vector<ARM_Interface::BacktraceEntry> ARM_Interface::GetBacktrace() const {
         symbols.insert_or_assign(module.second, GetSymbols(module.first, memory));
     }
 
-    for (auto& entry : out) {
+    for (auto& entry : backtrace) {
         VAddr base = 0;
         for (auto iter = modules.rbegin(); iter != modules.rend(); ++iter) {
             const auto& module{*iter};
@@ -249,7 +223,7 @@ std::vector<ARM_Interface::BacktraceEntry> ARM_Interface::GetBacktrace() const {
         }
     }
 
-    return out;
+    return true;
 }
 
 void ARM_Interface::LogBacktrace() const {
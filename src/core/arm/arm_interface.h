@@ -67,6 +67,9 @@ public:
     /// Clear all instruction cache
     virtual void ClearInstructionCache() = 0;
 
+    /// Clear the instruction cache for the given range of guest code, keeping the rest
+    virtual void InvalidateCacheRange(VAddr addr, std::size_t size) = 0;
+
     /// Notifies CPU emulation that the current page table has changed.
     ///
     /// @param new_page_table                 The new page table.
@@ -174,6 +177,10 @@ public:
 
     std::vector<BacktraceEntry> GetBacktrace() const;
 
+    /// Fills in the module, offset and symbol name of each entry from its original address.
+    /// Returns false if the loaded modules cannot be listed.
+    static bool SymbolizeBacktrace(System& system, std::vector<BacktraceEntry>& backtrace);
+
     /// fp (= r29) points to the last frame record.
     /// Note that this is the frame record for the *previous* frame, not the current one.
     /// Note we need to subtract 4 from our last read to get the proper address
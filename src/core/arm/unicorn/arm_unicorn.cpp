@@ -271,6 +271,8 @@ void ARM_Unicorn::ClearExclusiveState() {}
 
 void ARM_Unicorn::ClearInstructionCache() {}
 
+void ARM_Unicorn::InvalidateCacheRange(VAddr addr, std::size_t size) {}
+
 void ARM_Unicorn::RecordBreak(GDBStub::BreakpointAddress bkpt) {
     last_bkpt = bkpt;
     last_bkpt_hit = true;
@@ -49,6 +49,10 @@
 #include "core/settings.h"
 #include "core/telemetry_session.h"
 #include "core/tools/freezer.h"
+#include "core/tools/guest_profiler.h"
+#include "core/tools/input_movie.h"
+#include "core/tools/memory_watcher.h"
+#include "core/tools/rewind_buffer.h"
 #include "core/tools/plugin_manager.h"
 #include "video_core/renderer_base.h"
 #include "video_core/video_core.h"
@@ -121,7 +125,9 @@ FileSys::VirtualFile GetGameFileFromPath(const FileSys::VirtualFilesystem& vfs,
 }
 struct System::Impl {
     explicit Impl(System& system)
-        : kernel{system}, fs_controller{system}, memory{system},
+        : kernel{system}, fs_controller{system},
+          device_memory{std::make_unique<Core::DeviceMemory>()}, memory{system},
+          memory_watcher{system}, guest_profiler{system}, rewind_buffer{system},
           cpu_manager{system}, reporter{system}, plugin_manager{system}, applet_manager{system} {}
 
     ResultStatus Run() {
@@ -147,8 +153,6 @@ struct System::Impl {
     ResultStatus Init(System& system, Frontend::EmuWindow& emu_window) {
         LOG_DEBUG(HW_Memory, "initialized OK");
 
-        device_memory = std::make_unique<Core::DeviceMemory>();
-
         is_multicore = Settings::values.use_multi_core.GetValue();
         is_async_gpu = is_multicore || Settings::values.use_asynchronous_gpu_emulation.GetValue();
 
@@ -242,6 +246,17 @@ struct System::Impl {
         main_process->Run(load_parameters->main_thread_priority,
                           load_parameters->main_thread_stack_size);
 
+        // The frames are captured while the presenting thread is in a call, any other core would
+        // keep running guest code
+        if (Settings::values.rewind_frames != 0) {
+            if (is_multicore) {
+                LOG_WARNING(Core, "Rewinding is only supported in single core mode");
+            } else {
+                constexpr std::size_t max_rewind_bytes = 512ULL * 1024 * 1024;
+                rewind_buffer.Start(Settings::values.rewind_frames, max_rewind_bytes);
+            }
+        }
+
         if (Settings::values.gamecard_inserted) {
             if (Settings::values.gamecard_current_game) {
                 fs_controller.SetGameCard(GetGameFileFromPath(virtual_filesystem, filepath));
@@ -294,8 +309,13 @@ struct System::Impl {
         Service::Shutdown();
         service_manager.reset();
         cheat_engine.reset();
+        memory_watcher.Clear();
+        input_movie.Stop();
+        guest_profiler.Stop();
+        rewind_buffer.Stop();
         telemetry_session.reset();
-        device_memory.reset();
+        // The next session starts from untouched memory, which holds on to nothing until then
+        device_memory = std::make_unique<Core::DeviceMemory>();
 
         // Close all CPU/threading state
         cpu_manager.Shutdown();
@@ -370,6 +390,10 @@ struct System::Impl {
     std::unique_ptr<Hardware::InterruptManager> interrupt_manager;
     std::unique_ptr<Core::DeviceMemory> device_memory;
     Core::Memory::Memory memory;
+    Tools::MemoryWatcher memory_watcher;
+    Tools::InputMovie input_movie;
+    Tools::GuestProfiler guest_profiler;
+    Tools::RewindBuffer rewind_buffer;
     CpuManager cpu_manager;
     bool is_powered_on = false;
     bool exit_lock = false;
@@ -439,6 +463,10 @@ void System::InvalidateCpuInstructionCaches() {
     impl->kernel.InvalidateAllInstructionCaches();
 }
 
+void System::InvalidateCpuInstructionCacheRange(VAddr addr, std::size_t size) {
+    impl->kernel.InvalidateCpuInstructionCacheRange(addr, size);
+}
+
 System::ResultStatus System::Load(Frontend::EmuWindow& emu_window, const std::string& filepath) {
     return impl->Load(*this, emu_window, filepath);
 }
@@ -615,6 +643,38 @@ const Core::FrameLimiter& System::FrameLimiter() const {
     return impl->frame_limiter;
 }
 
+Tools::GuestProfiler& System::GuestProfiler() {
+    return impl->guest_profiler;
+}
+
+const Tools::GuestProfiler& System::GuestProfiler() const {
+    return impl->guest_profiler;
+}
+
+Tools::InputMovie& System::InputMovie() {
+    return impl->input_movie;
+}
+
+const Tools::InputMovie& System::InputMovie() const {
+    return impl->input_movie;
+}
+
+Tools::MemoryWatcher& System::MemoryWatcher() {
+    return impl->memory_watcher;
+}
+
+const Tools::MemoryWatcher& System::MemoryWatcher() const {
+    return impl->memory_watcher;
+}
+
+Tools::RewindBuffer& System::RewindBuffer() {
+    return impl->rewind_buffer;
+}
+
+const Tools::RewindBuffer& System::RewindBuffer() const {
+    return impl->rewind_buffer;
+}
+
 Tools::PluginManager& System::PluginManager() {
     return impl->plugin_manager;
 }
@@ -43,7 +43,11 @@ class Memory;
 } // namespace Core::Memory
 
 namespace Tools {
+class GuestProfiler;
+class InputMovie;
+class MemoryWatcher;
 class PluginManager;
+class RewindBuffer;
 } // namespace Tools
 
 namespace Service {
@@ -108,6 +112,12 @@ struct PerfStatsResults;
 FileSys::VirtualFile GetGameFileFromPath(const FileSys::VirtualFilesystem& vfs,
                                          const std::string& path);
 
+/**
+ * The emulated console. There is exactly one per host process: Settings::values, the input
+ * factories, logging, MicroProfile and the host thread registration in the kernel are process
+ * wide, and the file system, gdbstub and settings code still reach this class through
+ * GetInstance(). Code on the IPC and presentation paths gets its System passed in instead.
+ */
 class System {
 public:
     using CurrentBuildProcessID = std::array<u8, 0x20>;
@@ -165,6 +175,12 @@ public:
      */
     void InvalidateCpuInstructionCaches();
 
+    /**
+     * Invalidate the CPU instruction caches for the given range of guest code only, so that code
+     * translated elsewhere does not have to be translated again.
+     */
+    void InvalidateCpuInstructionCacheRange(VAddr addr, std::size_t size);
+
     /// Shutdown the emulated system.
     void Shutdown();
 
@@ -308,6 +324,30 @@ public:
     /// Provides a constant referent to the frame limiter
     const Core::FrameLimiter& FrameLimiter() const;
 
+    /// Provides a reference to the guest sampling profiler.
+    Tools::GuestProfiler& GuestProfiler();
+
+    /// Provides a constant reference to the guest sampling profiler.
+    const Tools::GuestProfiler& GuestProfiler() const;
+
+    /// Provides a reference to the input movie recorder and player.
+    Tools::InputMovie& InputMovie();
+
+    /// Provides a constant reference to the input movie recorder and player.
+    const Tools::InputMovie& InputMovie() const;
+
+    /// Provides a reference to the memory watcher.
+    Tools::MemoryWatcher& MemoryWatcher();
+
+    /// Provides a constant reference to the memory watcher.
+    const Tools::MemoryWatcher& MemoryWatcher() const;
+
+    /// Provides a reference to the buffer of recent frames to rewind to.
+    Tools::RewindBuffer& RewindBuffer();
+
+    /// Provides a constant reference to the buffer of recent frames to rewind to.
+    const Tools::RewindBuffer& RewindBuffer() const;
+
     /// Provides a reference to the plugin manager.
     Tools::PluginManager& PluginManager();
 
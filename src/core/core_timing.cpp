@@ -3,8 +3,11 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <map>
 #include <mutex>
+#include <set>
 #include <string>
+#include <string_view>
 #include <tuple>
 
 #include "common/microprofile.h"
@@ -25,22 +28,83 @@ struct CoreTiming::Event {
     u64 fifo_order;
     std::uintptr_t user_data;
     std::weak_ptr<EventType> type;
+    /// Key of the list in scheduled_events the event belongs to
+    EventKey key;
+
+    /// Pairing heap links, prev is the parent of a first child and the left sibling otherwise
+    Event* child{};
+    Event* sibling{};
+    Event* prev{};
+
+    /// Links of the list of scheduled events with the same key
+    Event* key_prev{};
+    Event* key_next{};
+
+    /// Next event in pending_events
+    Event* next_pending{};
 
     // Sort by time, unless the times are the same, in which case sort by
     // the order added to the queue
-    friend bool operator>(const Event& left, const Event& right) {
-        return std::tie(left.time, left.fifo_order) > std::tie(right.time, right.fifo_order);
-    }
-
     friend bool operator<(const Event& left, const Event& right) {
         return std::tie(left.time, left.fifo_order) < std::tie(right.time, right.fifo_order);
     }
+
+    /// Melds two heaps, returning the root of the result.
+    static Event* Meld(Event* a, Event* b) {
+        if (a == nullptr) {
+            return b;
+        }
+        if (b == nullptr) {
+            return a;
+        }
+        if (*b < *a) {
+            std::swap(a, b);
+        }
+        b->prev = a;
+        b->sibling = a->child;
+        if (a->child != nullptr) {
+            a->child->prev = b;
+        }
+        a->child = b;
+        return a;
+    }
+
+    /// Melds a list of siblings into a single heap, in two passes to keep the heap shallow.
+    static Event* MergePairs(Event* first) {
+        // Meld pairs from left to right, chaining the results in reverse order
+        Event* merged = nullptr;
+        while (first != nullptr) {
+            Event* const a = first;
+            Event* const b = a->sibling;
+            first = b != nullptr ? b->sibling : nullptr;
+
+            a->sibling = a->prev = nullptr;
+            if (b != nullptr) {
+                b->sibling = b->prev = nullptr;
+            }
+            Event* const pair = Meld(a, b);
+            pair->sibling = merged;
+            merged = pair;
+        }
+
+        // Meld the results from right to left
+        Event* root = nullptr;
+        while (merged != nullptr) {
+            Event* const next = merged->sibling;
+            merged->sibling = nullptr;
+            root = Meld(root, merged);
+            merged = next;
+        }
+        return root;
+    }
 };
 
 CoreTiming::CoreTiming()
     : clock{Common::CreateBestMatchingClock(Hardware::BASE_CLOCK_RATE, Hardware::CNTFREQ)} {}
 
-CoreTiming::~CoreTiming() = default;
+CoreTiming::~CoreTiming() {
+    ClearPendingEvents();
+}
 
 void CoreTiming::ThreadEntry(CoreTiming& instance) {
     constexpr char name[] = "yuzu:HostTiming";
@@ -101,34 +165,34 @@ bool CoreTiming::IsRunning() const {
 }
 
 bool CoreTiming::HasPendingEvents() const {
-    return !(wait_set && event_queue.empty());
+    return !(wait_set && event_heap == nullptr && pending_events.load() == nullptr);
 }
 
 void CoreTiming::ScheduleEvent(std::chrono::nanoseconds ns_into_future,
                                const std::shared_ptr<EventType>& event_type,
                                std::uintptr_t user_data) {
-    {
-        std::scoped_lock scope{basic_lock};
-        const u64 timeout = static_cast<u64>((GetGlobalTimeNs() + ns_into_future).count());
-
-        event_queue.emplace_back(Event{timeout, event_fifo_id++, user_data, event_type});
-
-        std::push_heap(event_queue.begin(), event_queue.end(), std::greater<>());
-    }
+    const u64 timeout = static_cast<u64>((GetGlobalTimeNs() + ns_into_future).count());
+    auto* const evt =
+        new Event{timeout, event_fifo_id++, user_data, event_type, {event_type.get(), user_data}};
+
+    Event* head = pending_events.load(std::memory_order_relaxed);
+    do {
+        evt->next_pending = head;
+    } while (!pending_events.compare_exchange_weak(head, evt, std::memory_order_release,
+                                                   std::memory_order_relaxed));
     event.Set();
 }
 
 void CoreTiming::UnscheduleEvent(const std::shared_ptr<EventType>& event_type,
                                  std::uintptr_t user_data) {
     std::scoped_lock scope{basic_lock};
-    const auto itr = std::remove_if(event_queue.begin(), event_queue.end(), [&](const Event& e) {
-        return e.type.lock().get() == event_type.get() && e.user_data == user_data;
-    });
+    MergePendingEvents();
 
-    // Removing random items breaks the invariant so we have to re-establish it.
-    if (itr != event_queue.end()) {
-        event_queue.erase(itr, event_queue.end());
-        std::make_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+    const auto it = scheduled_events.find({event_type.get(), user_data});
+    if (it != scheduled_events.end()) {
+        Event* const head = it->second;
+        scheduled_events.erase(it);
+        EraseEvents(head);
     }
 }
 
@@ -138,8 +202,11 @@ void CoreTiming::AddTicks(u64 ticks) {
 }
 
 void CoreTiming::Idle() {
-    if (!event_queue.empty()) {
-        const u64 next_event_time = event_queue.front().time;
+    std::scoped_lock lock{basic_lock};
+    MergePendingEvents();
+
+    if (event_heap != nullptr) {
+        const u64 next_event_time = event_heap->time;
         const u64 next_ticks = nsToCycles(std::chrono::nanoseconds(next_event_time)) + 10U;
         if (next_ticks > ticks) {
             ticks = next_ticks;
@@ -168,50 +235,197 @@ u64 CoreTiming::GetClockTicks() const {
 }
 
 void CoreTiming::ClearPendingEvents() {
-    event_queue.clear();
+    std::scoped_lock lock{basic_lock};
+    MergePendingEvents();
+
+    // Every scheduled event is in exactly one list
+    for (auto& [key, head] : scheduled_events) {
+        while (head != nullptr) {
+            Event* const next = head->key_next;
+            delete head;
+            head = next;
+        }
+    }
+    scheduled_events.clear();
+    event_heap = nullptr;
+}
+
+void CoreTiming::MergePendingEvents() {
+    Event* evt = pending_events.exchange(nullptr, std::memory_order_acquire);
+    while (evt != nullptr) {
+        Event* const next = evt->next_pending;
+        evt->next_pending = nullptr;
+
+        Event*& head = scheduled_events[evt->key];
+        evt->key_next = head;
+        if (head != nullptr) {
+            head->key_prev = evt;
+        }
+        head = evt;
+
+        event_heap = Event::Meld(event_heap, evt);
+        evt = next;
+    }
+}
+
+void CoreTiming::EraseFromHeap(Event* evt) {
+    if (evt == event_heap) {
+        event_heap = Event::MergePairs(evt->child);
+        return;
+    }
+
+    // Cut the subtree of the event out and meld its children back into the heap
+    if (evt->prev->child == evt) {
+        evt->prev->child = evt->sibling;
+    } else {
+        evt->prev->sibling = evt->sibling;
+    }
+    if (evt->sibling != nullptr) {
+        evt->sibling->prev = evt->prev;
+    }
+    event_heap = Event::Meld(event_heap, Event::MergePairs(evt->child));
+}
+
+void CoreTiming::EraseEvents(Event* head) {
+    while (head != nullptr) {
+        Event* const next = head->key_next;
+        EraseFromHeap(head);
+        delete head;
+        head = next;
+    }
 }
 
 void CoreTiming::RemoveEvent(const std::shared_ptr<EventType>& event_type) {
     std::scoped_lock lock{basic_lock};
+    MergePendingEvents();
 
-    const auto itr = std::remove_if(event_queue.begin(), event_queue.end(), [&](const Event& e) {
-        return e.type.lock().get() == event_type.get();
-    });
-
-    // Removing random items breaks the invariant so we have to re-establish it.
-    if (itr != event_queue.end()) {
-        event_queue.erase(itr, event_queue.end());
-        std::make_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+    for (auto it = scheduled_events.begin(); it != scheduled_events.end();) {
+        if (it->first.type != event_type.get()) {
+            ++it;
+            continue;
+        }
+        Event* const head = it->second;
+        it = scheduled_events.erase(it);
+        EraseEvents(head);
     }
 }
 
 std::optional<s64> CoreTiming::Advance() {
     std::scoped_lock lock{advance_lock, basic_lock};
+    MergePendingEvents();
     global_timer = GetGlobalTimeNs().count();
 
-    while (!event_queue.empty() && event_queue.front().time <= global_timer) {
-        Event evt = std::move(event_queue.front());
-        std::pop_heap(event_queue.begin(), event_queue.end(), std::greater<>());
-        event_queue.pop_back();
+    while (event_heap != nullptr && event_heap->time <= global_timer) {
+        const std::unique_ptr<Event> evt{event_heap};
+        EraseFromHeap(evt.get());
+        if (evt->key_prev != nullptr) {
+            evt->key_prev->key_next = evt->key_next;
+        } else if (evt->key_next != nullptr) {
+            scheduled_events[evt->key] = evt->key_next;
+        } else {
+            scheduled_events.erase(evt->key);
+        }
+        if (evt->key_next != nullptr) {
+            evt->key_next->key_prev = evt->key_prev;
+        }
         basic_lock.unlock();
 
-        if (const auto event_type{evt.type.lock()}) {
-            event_type->callback(
-                evt.user_data, std::chrono::nanoseconds{static_cast<s64>(global_timer - evt.time)});
+        if (const auto event_type{evt->type.lock()}) {
+            event_type->callback(evt->user_data, std::chrono::nanoseconds{static_cast<s64>(
+                                                     global_timer - evt->time)});
         }
 
         basic_lock.lock();
+        MergePendingEvents();
         global_timer = GetGlobalTimeNs().count();
     }
 
-    if (!event_queue.empty()) {
-        const s64 next_time = event_queue.front().time - global_timer;
+    if (event_heap != nullptr) {
+        const s64 next_time = event_heap->time - global_timer;
         return next_time;
     } else {
         return std::nullopt;
     }
 }
 
+std::vector<CoreTiming::PendingEvent> CoreTiming::GetPendingEvents() {
+    std::scoped_lock lock{basic_lock};
+    MergePendingEvents();
+
+    std::vector<Event*> scheduled;
+    for (const auto& [key, head] : scheduled_events) {
+        for (Event* evt = head; evt != nullptr; evt = evt->key_next) {
+            scheduled.push_back(evt);
+        }
+    }
+    std::sort(scheduled.begin(), scheduled.end(),
+              [](const Event* a, const Event* b) { return *a < *b; });
+
+    const s64 now = GetGlobalTimeNs().count();
+    std::vector<PendingEvent> events;
+    events.reserve(scheduled.size());
+    for (const Event* evt : scheduled) {
+        if (const auto event_type{evt->type.lock()}) {
+            events.push_back({event_type->name, evt->user_data,
+                              std::chrono::nanoseconds{static_cast<s64>(evt->time) - now}});
+        }
+    }
+    return events;
+}
+
+std::size_t CoreTiming::RestorePendingEvents(const std::vector<PendingEvent>& events) {
+    std::map<std::pair<std::string_view, std::uintptr_t>, std::vector<const PendingEvent*>> listed;
+    std::set<std::string_view> listed_types;
+    for (const PendingEvent& pending : events) {
+        listed[{pending.name, pending.user_data}].push_back(&pending);
+        listed_types.insert(pending.name);
+    }
+
+    std::scoped_lock lock{basic_lock};
+    MergePendingEvents();
+
+    const s64 now = GetGlobalTimeNs().count();
+    std::size_t restored = 0;
+    for (auto& [key, head] : scheduled_events) {
+        const auto event_type{head->type.lock()};
+        if (!event_type || !listed_types.contains(event_type->name)) {
+            continue;
+        }
+        const auto it = listed.find({event_type->name, key.user_data});
+        const std::size_t num_listed = it != listed.end() ? it->second.size() : 0;
+
+        // Move as many of the scheduled events as there are listed, unschedule the others
+        std::size_t index = 0;
+        for (Event* evt = head; evt != nullptr;) {
+            Event* const next = evt->key_next;
+            EraseFromHeap(evt);
+            if (index < num_listed) {
+                const PendingEvent& pending = *it->second[index];
+                evt->time = static_cast<u64>(now + pending.time_left.count());
+                evt->fifo_order = event_fifo_id++;
+                evt->child = evt->sibling = evt->prev = nullptr;
+                event_heap = Event::Meld(event_heap, evt);
+                ++restored;
+            } else {
+                if (evt->key_prev != nullptr) {
+                    evt->key_prev->key_next = next;
+                } else {
+                    head = next;
+                }
+                if (next != nullptr) {
+                    next->key_prev = evt->key_prev;
+                }
+                delete evt;
+            }
+            ++index;
+            evt = next;
+        }
+    }
+    std::erase_if(scheduled_events, [](const auto& entry) { return entry.second == nullptr; });
+
+    return events.size() - restored;
+}
+
 void CoreTiming::ThreadLoop() {
     has_started = true;
     while (!shutting_down) {
@@ -12,6 +12,7 @@
 #include <optional>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "common/common_types.h"
@@ -50,6 +51,14 @@ struct EventType {
  */
 class CoreTiming {
 public:
+    /// An event that has not fired yet, as stored in savestates.
+    struct PendingEvent {
+        std::string name;
+        std::uintptr_t user_data;
+        /// Time until the event fires, negative if it is already late
+        std::chrono::nanoseconds time_left;
+    };
+
     CoreTiming();
     ~CoreTiming();
 
@@ -127,12 +136,45 @@ public:
     /// Checks for events manually and returns time in nanoseconds for next event, threadsafe.
     std::optional<s64> Advance();
 
+    /// Returns the events that have not fired yet, in the order they will fire.
+    std::vector<PendingEvent> GetPendingEvents();
+
+    /// Moves the scheduled events to the times in a list returned by GetPendingEvents. Events of a
+    /// type in the list that are not in it are unscheduled, events of other types are left alone.
+    /// Events can only be moved, so listed events that are not scheduled are skipped and their
+    /// count is returned.
+    std::size_t RestorePendingEvents(const std::vector<PendingEvent>& events);
+
 private:
     struct Event;
 
+    /// Identifies the events UnscheduleEvent removes
+    struct EventKey {
+        const EventType* type;
+        std::uintptr_t user_data;
+
+        bool operator==(const EventKey&) const = default;
+    };
+
+    struct EventKeyHash {
+        std::size_t operator()(const EventKey& key) const noexcept {
+            return std::hash<const EventType*>{}(key.type) ^
+                   (std::hash<std::uintptr_t>{}(key.user_data) * 0x9E3779B97F4A7C15ULL);
+        }
+    };
+
     /// Clear all pending events. This should ONLY be done on exit.
     void ClearPendingEvents();
 
+    /// Moves the events scheduled since the last call into the heap. Requires basic_lock.
+    void MergePendingEvents();
+
+    /// Removes an event from the heap. Requires basic_lock.
+    void EraseFromHeap(Event* evt);
+
+    /// Removes the events of a key from the heap and frees them. Requires basic_lock.
+    void EraseEvents(Event* head);
+
     static void ThreadEntry(CoreTiming& instance);
     void ThreadLoop();
 
@@ -140,12 +182,15 @@ private:
 
     u64 global_timer = 0;
 
-    // The queue is a min-heap using std::make_heap/push_heap/pop_heap.
-    // We don't use std::priority_queue because we need to be able to serialize, unserialize and
-    // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't
-    // accomodated by the standard adaptor class.
-    std::vector<Event> event_queue;
-    u64 event_fifo_id = 0;
+    // Scheduled events are kept in a pairing heap ordered by time, which allows inserting and
+    // erasing arbitrary events without rebuilding it. Each event is also linked into the list of
+    // scheduled events with the same type and user data, so unscheduling doesn't search the heap.
+    // ScheduleEvent only pushes the event onto pending_events, which doesn't need any lock and is
+    // merged into the heap the next time the heap is looked at.
+    Event* event_heap{};
+    std::atomic<Event*> pending_events{};
+    std::unordered_map<EventKey, Event*, EventKeyHash> scheduled_events;
+    std::atomic<u64> event_fifo_id{};
 
     std::shared_ptr<EventType> ev_lost;
     Common::Event event{};
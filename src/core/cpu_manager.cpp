@@ -14,6 +14,7 @@
 #include "core/hle/kernel/physical_core.h"
 #include "core/hle/kernel/scheduler.h"
 #include "core/hle/kernel/thread.h"
+#include "core/tools/guest_profiler.h"
 #include "video_core/gpu.h"
 
 namespace Core {
@@ -126,6 +127,7 @@ void CpuManager::MultiCoreRunGuestLoop() {
         while (!physical_core->IsInterrupted()) {
             arm_interface.Run();
             physical_core = &kernel.CurrentPhysicalCore();
+            system.GuestProfiler().OnCoreReturn(physical_core->CoreIndex(), arm_interface);
         }
         system.ExitDynarmicProfile();
         arm_interface.ClearExclusiveState();
@@ -222,6 +224,7 @@ void CpuManager::SingleCoreRunGuestLoop() {
         if (!physical_core->IsInterrupted()) {
             arm_interface.Run();
             physical_core = &kernel.CurrentPhysicalCore();
+            system.GuestProfiler().OnCoreReturn(current_core, arm_interface);
         }
         system.ExitDynarmicProfile();
         thread->SetPhantomMode(true);
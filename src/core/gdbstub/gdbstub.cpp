@@ -510,7 +510,7 @@ static void RemoveBreakpoint(BreakpointType type, VAddr addr) {
     if (type == BreakpointType::Execute) {
         auto& system = Core::System::GetInstance();
         system.Memory().WriteBlock(bp->second.addr, bp->second.inst.data(), bp->second.inst.size());
-        system.InvalidateCpuInstructionCaches();
+        system.InvalidateCpuInstructionCacheRange(bp->second.addr, bp->second.inst.size());
     }
     p.erase(addr);
 }
@@ -1002,7 +1002,7 @@ static void WriteMemory() {
     std::vector<u8> data(len);
     GdbHexToMem(data.data(), len_pos + 1, len);
     memory.WriteBlock(addr, data.data(), len);
-    system.InvalidateCpuInstructionCaches();
+    system.InvalidateCpuInstructionCacheRange(addr, len);
     SendReply("OK");
 }
 
@@ -1066,7 +1066,7 @@ static bool CommitBreakpoint(BreakpointType type, VAddr addr, u64 len) {
     static constexpr std::array<u8, 4> btrap{0x00, 0x7d, 0x20, 0xd4};
     if (type == BreakpointType::Execute) {
         memory.WriteBlock(addr, btrap.data(), btrap.size());
-        system.InvalidateCpuInstructionCaches();
+        system.InvalidateCpuInstructionCacheRange(addr, btrap.size());
     }
     p.insert({addr, breakpoint});
 
@@ -0,0 +1,338 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "common/bit_field.h"
+#include "common/cityhash.h"
+#include "common/common_funcs.h"
+#include "common/hex_util.h"
+#include "common/logging/log.h"
+#include "common/page_table.h"
+#include "core/arm/arm_interface.h"
+#include "core/core.h"
+#include "core/hle/guest_functions.h"
+#include "core/hle/kernel/memory/page_table.h"
+#include "core/hle/kernel/process.h"
+#include "core/memory.h"
+
+namespace HLE::GuestFunctions {
+namespace {
+
+using Core::Memory::PAGE_BITS;
+using Core::Memory::PAGE_MASK;
+using Core::Memory::PAGE_SIZE;
+
+constexpr u64 ELF_DYNAMIC_TAG_NULL = 0;
+constexpr u64 ELF_DYNAMIC_TAG_STRTAB = 5;
+constexpr u64 ELF_DYNAMIC_TAG_SYMTAB = 6;
+constexpr u64 ELF_DYNAMIC_TAG_STRSZ = 10;
+constexpr u64 ELF_DYNAMIC_TAG_SYMENT = 11;
+
+constexpr u8 ELF_SYMBOL_TYPE_FUNCTION = 2;
+
+struct ELFSymbol {
+    u32 name_index;
+    union {
+        u8 info;
+
+        BitField<0, 4, u8> type;
+        BitField<4, 4, u8> binding;
+    };
+    u8 visibility;
+    u16 sh_index;
+    u64 value;
+    u64 size;
+};
+static_assert(sizeof(ELFSymbol) == 0x18, "ELFSymbol has incorrect size.");
+
+constexpr u32 ARM64_RET = 0xD65F03C0;
+
+constexpr u32 EncodeSvc(u32 immediate) {
+    return 0xD4000001 | (immediate << 5);
+}
+
+template <typename T>
+std::optional<T> ReadObject(std::span<const u8> image, u64 offset) {
+    if (offset > image.size() || image.size() - offset < sizeof(T)) {
+        return std::nullopt;
+    }
+    T object;
+    std::memcpy(&object, image.data() + offset, sizeof(T));
+    return object;
+}
+
+const Common::PageTable& CurrentPageTable(Core::System& system) {
+    return system.CurrentProcess()->PageTable().PageTableImpl();
+}
+
+// HLE'd functions
+using HostRoutine = u64 (*)(Core::Memory::Memory& memory, const Common::PageTable& page_table,
+                            const std::array<u64, 3>& args);
+
+u64 HLE_MoveBlock(Core::Memory::Memory& memory, const Common::PageTable& page_table,
+                  const std::array<u64, 3>& args) {
+    MoveBlock(memory, page_table, args[0], args[1], args[2]);
+    return args[0];
+}
+
+u64 HLE_FillBlock(Core::Memory::Memory& memory, const Common::PageTable& page_table,
+                  const std::array<u64, 3>& args) {
+    FillBlock(memory, page_table, args[0], static_cast<u8>(args[1]), args[2]);
+    return args[0];
+}
+
+u64 HLE_StringLength(Core::Memory::Memory& memory, const Common::PageTable& page_table,
+                     const std::array<u64, 3>& args) {
+    return StringLength(memory, page_table, args[0]);
+}
+
+// Indexed by Routine
+constexpr std::array<HostRoutine, 3> host_routines{
+    &HLE_MoveBlock,
+    &HLE_FillBlock,
+    &HLE_StringLength,
+};
+
+// Guest functions are only added once their code has been checked to do what the routine does.
+// Functions named like one of the routines are logged with their hash when a module is loaded.
+constexpr std::array<KnownFunction, 0> known_functions{};
+
+constexpr std::array<std::string_view, 4> routine_names{"memcpy", "memmove", "memset", "strlen"};
+
+/// Host pointer to a page of guest memory, nullptr if it has to go through Memory
+u8* GetPagePointer(const Common::PageTable& page_table, VAddr addr) {
+    if ((addr >> PAGE_BITS) >= page_table.pointers.size()) {
+        return nullptr;
+    }
+    u8* const page_pointer = page_table.pointers[addr >> PAGE_BITS];
+    return page_pointer == nullptr ? nullptr : page_pointer + addr;
+}
+
+/// Host pointer to a range of guest memory, nullptr if it is not contiguous plain memory
+u8* GetRangePointer(const Common::PageTable& page_table, VAddr addr, std::size_t size) {
+    const std::size_t first_page = addr >> PAGE_BITS;
+    const std::size_t last_page = (addr + std::max<std::size_t>(size, 1) - 1) >> PAGE_BITS;
+    if (last_page >= page_table.pointers.size() || last_page < first_page) {
+        return nullptr;
+    }
+    // Page pointers have their virtual address subtracted, so contiguous pages share a pointer
+    u8* const page_pointer = page_table.pointers[first_page];
+    if (page_pointer == nullptr) {
+        return nullptr;
+    }
+    for (std::size_t page = first_page + 1; page <= last_page; ++page) {
+        if (page_table.pointers[page] != page_pointer) {
+            return nullptr;
+        }
+    }
+    return page_pointer + addr;
+}
+
+} // Anonymous namespace
+
+std::size_t PatchModule(std::span<u8> image, std::size_t text_size,
+                        const std::array<u8, 0x20>& build_id,
+                        std::span<const KnownFunction> functions) {
+    const std::span<const u8> view{image};
+    const auto mod_offset = ReadObject<u32>(view, 4);
+    if (!mod_offset || *mod_offset >= text_size ||
+        ReadObject<u32>(view, *mod_offset) != Common::MakeMagic('M', 'O', 'D', '0')) {
+        return 0;
+    }
+    const auto dynamic_offset = ReadObject<u32>(view, *mod_offset + 4);
+    if (!dynamic_offset) {
+        return 0;
+    }
+
+    u64 string_table_offset{};
+    u64 string_table_size{};
+    u64 symbol_table_offset{};
+    u64 symbol_entry_size{};
+    for (u64 entry = *mod_offset + *dynamic_offset;; entry += 0x10) {
+        const auto tag = ReadObject<u64>(view, entry);
+        const auto value = ReadObject<u64>(view, entry + 8);
+        if (!tag || !value || *tag == ELF_DYNAMIC_TAG_NULL) {
+            break;
+        }
+        switch (*tag) {
+        case ELF_DYNAMIC_TAG_STRTAB:
+            string_table_offset = *value;
+            break;
+        case ELF_DYNAMIC_TAG_STRSZ:
+            string_table_size = *value;
+            break;
+        case ELF_DYNAMIC_TAG_SYMTAB:
+            symbol_table_offset = *value;
+            break;
+        case ELF_DYNAMIC_TAG_SYMENT:
+            symbol_entry_size = *value;
+            break;
+        }
+    }
+    if (symbol_table_offset == 0 || symbol_entry_size < sizeof(ELFSymbol)) {
+        return 0;
+    }
+    // Names are only used for logging
+    std::string_view strings;
+    if (string_table_offset != 0 && string_table_offset < image.size()) {
+        const u64 max_string_table_size = image.size() - string_table_offset;
+        if (string_table_size == 0 || string_table_size > max_string_table_size) {
+            string_table_size = max_string_table_size;
+        }
+        strings = {reinterpret_cast<const char*>(image.data()) + string_table_offset,
+                   string_table_size};
+    }
+    const u64 symbol_table_end =
+        string_table_offset > symbol_table_offset ? string_table_offset : image.size();
+
+    // Every function is hashed before anything is patched, symbols can share their code
+    std::vector<std::pair<u64, Routine>> patches;
+    for (u64 entry = symbol_table_offset; entry < symbol_table_end; entry += symbol_entry_size) {
+        const auto symbol = ReadObject<ELFSymbol>(view, entry);
+        if (!symbol) {
+            break;
+        }
+        // Only functions defined in this module that can fit the patch
+        if (symbol->type != ELF_SYMBOL_TYPE_FUNCTION || symbol->sh_index == 0 ||
+            symbol->size < 8 || (symbol->value & 3) != 0 || symbol->value >= text_size ||
+            text_size - symbol->value < symbol->size) {
+            continue;
+        }
+        const u64 code_hash = ComputeCodeHash(view.subspan(symbol->value, symbol->size));
+        const auto it = std::find_if(functions.begin(), functions.end(),
+                                     [code_hash](const KnownFunction& function) {
+                                         return function.code_hash == code_hash;
+                                     });
+        if (it != functions.end()) {
+            patches.emplace_back(symbol->value, it->routine);
+            continue;
+        }
+
+        if (symbol->name_index < strings.size()) {
+            std::string_view name = strings.substr(symbol->name_index);
+            name = name.substr(0, name.find('\0'));
+            if (std::find(routine_names.begin(), routine_names.end(), name) !=
+                routine_names.end()) {
+                LOG_DEBUG(Loader, "{} of module {} has the unknown code hash {:016X}", name,
+                          Common::HexToString(build_id), code_hash);
+            }
+        }
+    }
+
+    std::sort(patches.begin(), patches.end());
+    patches.erase(std::unique(patches.begin(), patches.end()), patches.end());
+    for (const auto& [offset, routine] : patches) {
+        const u32 immediate = SVC_BASE + static_cast<u32>(routine);
+        const std::array<u32, 2> patch{EncodeSvc(immediate), ARM64_RET};
+        std::memcpy(image.data() + offset, patch.data(), sizeof(patch));
+    }
+
+    if (!patches.empty()) {
+        LOG_INFO(Loader, "Replaced {} functions of module {} with host implementations",
+                 patches.size(), Common::HexToString(build_id));
+    }
+    return patches.size();
+}
+
+void Call(Core::System& system, u32 immediate) {
+    Core::ARM_Interface& arm_interface = system.CurrentArmInterface();
+    const std::array<u64, 3> args{arm_interface.GetReg(0), arm_interface.GetReg(1),
+                                  arm_interface.GetReg(2)};
+    arm_interface.SetReg(0, Invoke(system.Memory(), CurrentPageTable(system), immediate, args));
+}
+
+u64 Invoke(Core::Memory::Memory& memory, const Common::PageTable& page_table, u32 immediate,
+           const std::array<u64, 3>& args) {
+    const std::size_t index = immediate - SVC_BASE;
+    if (index >= host_routines.size()) {
+        LOG_CRITICAL(Kernel_SVC, "Unknown guest function 0x{:X}", immediate);
+        return args[0];
+    }
+    return host_routines[index](memory, page_table, args);
+}
+
+u64 ComputeCodeHash(std::span<const u8> code) {
+    return Common::CityHash64(reinterpret_cast<const char*>(code.data()), code.size());
+}
+
+std::span<const KnownFunction> GetKnownFunctions() {
+    return known_functions;
+}
+
+void MoveBlock(Core::Memory::Memory& memory, const Common::PageTable& page_table, VAddr dest_addr,
+               VAddr src_addr, std::size_t size) {
+    if (dest_addr < src_addr + size && src_addr < dest_addr + size) {
+        // Overlapping ranges are practically always in the same buffer
+        u8* const dest = GetRangePointer(page_table, dest_addr, size);
+        const u8* const src = GetRangePointer(page_table, src_addr, size);
+        if (dest != nullptr && src != nullptr) {
+            std::memmove(dest, src, size);
+        } else {
+            std::vector<u8> buffer(size);
+            memory.ReadBlock(src_addr, buffer.data(), size);
+            memory.WriteBlock(dest_addr, buffer.data(), size);
+        }
+        return;
+    }
+
+    while (size > 0) {
+        const std::size_t copy_amount = std::min(
+            {PAGE_SIZE - (dest_addr & PAGE_MASK), PAGE_SIZE - (src_addr & PAGE_MASK), size});
+        u8* const dest = GetPagePointer(page_table, dest_addr);
+        const u8* const src = GetPagePointer(page_table, src_addr);
+        if (dest != nullptr && src != nullptr) {
+            std::memcpy(dest, src, copy_amount);
+        } else {
+            memory.CopyBlock(dest_addr, src_addr, copy_amount);
+        }
+        dest_addr += copy_amount;
+        src_addr += copy_amount;
+        size -= copy_amount;
+    }
+}
+
+void FillBlock(Core::Memory::Memory& memory, const Common::PageTable& page_table, VAddr dest_addr,
+               u8 value, std::size_t size) {
+    while (size > 0) {
+        const std::size_t fill_amount = std::min(PAGE_SIZE - (dest_addr & PAGE_MASK), size);
+        if (u8* const dest = GetPagePointer(page_table, dest_addr)) {
+            std::memset(dest, value, fill_amount);
+        } else if (value == 0) {
+            memory.ZeroBlock(dest_addr, fill_amount);
+        } else {
+            std::array<u8, PAGE_SIZE> buffer;
+            buffer.fill(value);
+            memory.WriteBlock(dest_addr, buffer.data(), fill_amount);
+        }
+        dest_addr += fill_amount;
+        size -= fill_amount;
+    }
+}
+
+std::size_t StringLength(Core::Memory::Memory& memory, const Common::PageTable& page_table,
+                         VAddr addr) {
+    std::size_t length = 0;
+    std::array<u8, PAGE_SIZE> buffer;
+    while (true) {
+        const std::size_t page_amount = PAGE_SIZE - (addr & PAGE_MASK);
+        const u8* page = GetPagePointer(page_table, addr);
+        if (page == nullptr) {
+            memory.ReadBlock(addr, buffer.data(), page_amount);
+            page = buffer.data();
+        }
+        if (const void* const end = std::memchr(page, 0, page_amount)) {
+            return length + static_cast<std::size_t>(static_cast<const u8*>(end) - page);
+        }
+        addr += page_amount;
+        length += page_amount;
+    }
+}
+
+} // namespace HLE::GuestFunctions
@@ -0,0 +1,107 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include "common/common_types.h"
+
+namespace Common {
+struct PageTable;
+}
+
+namespace Core {
+class System;
+}
+
+namespace Core::Memory {
+class Memory;
+}
+
+namespace HLE {
+
+/**
+ * Replacement of well known guest functions with host implementations.
+ *
+ * When a module is loaded, the functions it defines are identified by the hash of their code, as
+ * given by the size of their symbol, like the macro HLE identifies macros. Known ones get their
+ * first two instructions patched to "svc #imm; ret". The SVC immediate is far above the ones used
+ * by the kernel and picks the host routine, which reads its arguments from the guest registers and
+ * writes its return value back to x0 before the ret returns to the caller.
+ *
+ * The replacement is off unless Settings::values.enable_hle_functions is set. Only 64-bit modules
+ * are patched.
+ */
+namespace GuestFunctions {
+
+/// SVC immediate of the first host routine
+constexpr u32 SVC_BASE = 0x8000;
+
+/// Host routines guest functions are replaced with, in the order of their SVC immediates
+enum class Routine : u32 {
+    /// memcpy and memmove, overlapping ranges are handled
+    MoveBlock,
+    /// memset
+    FillBlock,
+    /// strlen
+    StringLength,
+};
+
+/// A guest function that behaves like a host routine
+struct KnownFunction {
+    /// Hash of the code of the function, see ComputeCodeHash
+    u64 code_hash;
+    Routine routine;
+};
+
+/// Whether an SVC immediate calls a host routine rather than the kernel
+[[nodiscard]] constexpr bool IsGuestFunctionCall(u32 immediate) {
+    return immediate >= SVC_BASE;
+}
+
+/// Hash identifying the code of a guest function.
+[[nodiscard]] u64 ComputeCodeHash(std::span<const u8> code);
+
+/// Guest functions replaced when loading a module.
+[[nodiscard]] std::span<const KnownFunction> GetKnownFunctions();
+
+/**
+ * Patches the known functions of a module before it is mapped.
+ * @param image Program image of the module, symbol values are offsets into it
+ * @param text_size Size of the .text segment, which starts the image
+ * @param build_id Build ID of the module, only used for logging
+ * @param functions Functions to look for
+ * @returns the number of patched functions
+ */
+std::size_t PatchModule(std::span<u8> image, std::size_t text_size,
+                        const std::array<u8, 0x20>& build_id,
+                        std::span<const KnownFunction> functions = GetKnownFunctions());
+
+/// Runs the host routine for an SVC immediate on the current guest thread.
+void Call(Core::System& system, u32 immediate);
+
+/**
+ * Runs the host routine for an SVC immediate.
+ * @param args Arguments of the call, x0 to x2
+ * @returns the value for x0
+ */
+u64 Invoke(Core::Memory::Memory& memory, const Common::PageTable& page_table, u32 immediate,
+           const std::array<u64, 3>& args);
+
+/**
+ * Guest memory helpers of the host functions. Pages with a host pointer in the page table are
+ * accessed directly, the rest go through Memory so the GPU caches and debug hooks see them.
+ */
+void MoveBlock(Core::Memory::Memory& memory, const Common::PageTable& page_table, VAddr dest_addr,
+               VAddr src_addr, std::size_t size);
+void FillBlock(Core::Memory::Memory& memory, const Common::PageTable& page_table, VAddr dest_addr,
+               u8 value, std::size_t size);
+std::size_t StringLength(Core::Memory::Memory& memory, const Common::PageTable& page_table,
+                         VAddr addr);
+
+} // namespace GuestFunctions
+
+} // namespace HLE
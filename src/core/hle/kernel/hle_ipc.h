@@ -286,6 +286,10 @@ public:
         return is_thread_waiting;
     }
 
+    KernelCore& GetKernel() const {
+        return kernel;
+    }
+
 private:
     void ParseCommandBuffer(const HandleTable& handle_table, u32_le* src_cmdbuf, bool incoming);
 
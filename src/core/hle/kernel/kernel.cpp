@@ -367,6 +367,14 @@ void KernelCore::Shutdown() {
     impl->Shutdown();
 }
 
+Core::System& KernelCore::System() {
+    return impl->system;
+}
+
+const Core::System& KernelCore::System() const {
+    return impl->system;
+}
+
 std::shared_ptr<ResourceLimit> KernelCore::GetSystemResourceLimit() const {
     return impl->system_resource_limit;
 }
@@ -486,6 +494,16 @@ void KernelCore::InvalidateAllInstructionCaches() {
     }
 }
 
+void KernelCore::InvalidateCpuInstructionCacheRange(VAddr addr, std::size_t size) {
+    auto& threads = GlobalScheduler().GetThreadList();
+    for (auto& thread : threads) {
+        if (!thread->IsHLEThread()) {
+            auto& arm_interface = thread->ArmInterface();
+            arm_interface.InvalidateCacheRange(addr, size);
+        }
+    }
+}
+
 void KernelCore::PrepareReschedule(std::size_t id) {
     // TODO: Reimplement, this
 }
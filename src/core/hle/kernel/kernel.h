@@ -77,6 +77,12 @@ public:
     /// Clears all resources in use by the kernel instance.
     void Shutdown();
 
+    /// Retrieves the system instance that owns this kernel.
+    Core::System& System();
+
+    /// Retrieves the system instance that owns this kernel.
+    const Core::System& System() const;
+
     /// Retrieves a shared pointer to the system resource limit instance.
     std::shared_ptr<ResourceLimit> GetSystemResourceLimit() const;
 
@@ -153,6 +159,8 @@ public:
 
     void InvalidateAllInstructionCaches();
 
+    void InvalidateCpuInstructionCacheRange(VAddr addr, std::size_t size);
+
     /// Adds a port to the named port table
     void AddNamedPort(std::string name, std::shared_ptr<ClientPort> port);
 
@@ -27,7 +27,12 @@
 
 namespace Kernel {
 
-GlobalScheduler::GlobalScheduler(KernelCore& kernel) : kernel{kernel} {}
+GlobalScheduler::GlobalScheduler(KernelCore& kernel) : kernel{kernel} {
+    for (std::size_t core = 0; core < Core::Hardware::NUM_CPU_CORES; core++) {
+        scheduled_queue[core].set_node_index(core);
+        suggested_queue[core].set_node_index(core);
+    }
+}
 
 GlobalScheduler::~GlobalScheduler() = default;
 
@@ -67,8 +72,7 @@ u32 GlobalScheduler::SelectThreads() {
 
     // Step 1: Get top thread in schedule queue.
     for (u32 core = 0; core < Core::Hardware::NUM_CPU_CORES; core++) {
-        Thread* top_thread =
-            scheduled_queue[core].empty() ? nullptr : scheduled_queue[core].front();
+        Thread* top_thread = scheduled_queue[core].front();
         if (top_thread != nullptr) {
             // TODO(Blinkhawk): Implement Thread Pinning
         } else {
@@ -178,7 +182,7 @@ bool GlobalScheduler::YieldThreadAndBalanceLoad(Thread* yielding_thread) {
 
     std::array<Thread*, Core::Hardware::NUM_CPU_CORES> current_threads;
     for (std::size_t i = 0; i < current_threads.size(); i++) {
-        current_threads[i] = scheduled_queue[i].empty() ? nullptr : scheduled_queue[i].front();
+        current_threads[i] = scheduled_queue[i].front();
     }
 
     Thread* next_thread = scheduled_queue[core_id].front(priority);
@@ -238,7 +242,7 @@ bool GlobalScheduler::YieldThreadAndWaitForLoadBalancing(Thread* yielding_thread
         // Here, "current_threads" is calculated after the ""yield"", unlike yield -1
         std::array<Thread*, Core::Hardware::NUM_CPU_CORES> current_threads;
         for (std::size_t i = 0; i < current_threads.size(); i++) {
-            current_threads[i] = scheduled_queue[i].empty() ? nullptr : scheduled_queue[i].front();
+            current_threads[i] = scheduled_queue[i].front();
         }
         for (auto& thread : suggested_queue[core_id]) {
             const s32 source_core = thread->GetProcessorID();
@@ -284,8 +288,7 @@ void GlobalScheduler::PreemptThreads() {
             }
         }
 
-        Thread* current_thread =
-            scheduled_queue[core_id].empty() ? nullptr : scheduled_queue[core_id].front();
+        Thread* current_thread = scheduled_queue[core_id].front();
         Thread* winner = nullptr;
         for (auto& thread : suggested_queue[core_id]) {
             const s32 source_core = thread->GetProcessorID();
@@ -293,9 +296,7 @@ void GlobalScheduler::PreemptThreads() {
                 continue;
             }
             if (source_core >= 0) {
-                Thread* next_thread = scheduled_queue[source_core].empty()
-                                          ? nullptr
-                                          : scheduled_queue[source_core].front();
+                Thread* next_thread = scheduled_queue[source_core].front();
                 if (next_thread != nullptr && next_thread->GetPriority() < 2) {
                     break;
                 }
@@ -323,9 +324,7 @@ void GlobalScheduler::PreemptThreads() {
                     continue;
                 }
                 if (source_core >= 0) {
-                    Thread* next_thread = scheduled_queue[source_core].empty()
-                                              ? nullptr
-                                              : scheduled_queue[source_core].front();
+                    Thread* next_thread = scheduled_queue[source_core].front();
                     if (next_thread != nullptr && next_thread->GetPriority() < 2) {
                         break;
                     }
@@ -10,7 +10,7 @@
 #include <vector>
 
 #include "common/common_types.h"
-#include "common/multi_level_queue.h"
+#include "common/intrusive_multi_level_queue.h"
 #include "common/spin_lock.h"
 #include "core/hardware_properties.h"
 #include "core/hle/kernel/thread.h"
@@ -176,10 +176,12 @@ private:
     bool AskForReselectionOrMarkRedundant(Thread* current_thread, const Thread* winner);
 
     static constexpr u32 min_regular_priority = 2;
-    std::array<Common::MultiLevelQueue<Thread*, THREADPRIO_COUNT>, Core::Hardware::NUM_CPU_CORES>
-        scheduled_queue;
-    std::array<Common::MultiLevelQueue<Thread*, THREADPRIO_COUNT>, Core::Hardware::NUM_CPU_CORES>
-        suggested_queue;
+
+    /// Scheduled and suggested threads of a core share the node of that core in the thread
+    using ThreadQueue =
+        Common::IntrusiveMultiLevelQueue<Thread, THREADPRIO_COUNT, &Thread::scheduling_nodes>;
+    std::array<ThreadQueue, Core::Hardware::NUM_CPU_CORES> scheduled_queue;
+    std::array<ThreadQueue, Core::Hardware::NUM_CPU_CORES> suggested_queue;
     std::atomic<bool> is_reselection_pending{false};
 
     // The priority levels at which the global scheduler preempts threads every 10 ms. They are
@@ -19,6 +19,7 @@
 #include "core/core_timing.h"
 #include "core/core_timing_util.h"
 #include "core/cpu_manager.h"
+#include "core/hle/guest_functions.h"
 #include "core/hle/kernel/address_arbiter.h"
 #include "core/hle/kernel/client_port.h"
 #include "core/hle/kernel/client_session.h"
@@ -2639,6 +2640,13 @@ void Call(Core::System& system, u32 immediate) {
     auto& kernel = system.Kernel();
     kernel.EnterSVCProfile();
 
+    if (HLE::GuestFunctions::IsGuestFunctionCall(immediate)) {
+        HLE::GuestFunctions::Call(system, immediate);
+        kernel.ExitSVCProfile();
+        system.EnterDynarmicProfile();
+        return;
+    }
+
     const FunctionDef* info = system.CurrentProcess()->Is64BitProcess() ? GetSVCInfo64(immediate)
                                                                         : GetSVCInfo32(immediate);
     if (info) {
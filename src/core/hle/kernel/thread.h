@@ -4,14 +4,17 @@
 
 #pragma once
 
+#include <array>
 #include <functional>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "common/common_types.h"
+#include "common/intrusive_multi_level_queue.h"
 #include "common/spin_lock.h"
 #include "core/arm/arm_interface.h"
+#include "core/hardware_properties.h"
 #include "core/hle/kernel/object.h"
 #include "core/hle/kernel/synchronization_object.h"
 #include "core/hle/result.h"
@@ -614,6 +617,11 @@ private:
 
     s32 processor_id = 0;
 
+    /// Links in the scheduling queues, one per core. On each core the thread is either scheduled
+    /// or suggested, never both.
+    std::array<Common::IntrusiveMultiLevelQueueNode<Thread>, Core::Hardware::NUM_CPU_CORES>
+        scheduling_nodes{};
+
     VAddr tls_address = 0; ///< Virtual address of the Thread Local Storage of the thread
     u64 tpidr_el0 = 0;     ///< TPIDR_EL0 read/write system register.
 
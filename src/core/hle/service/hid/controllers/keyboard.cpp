@@ -4,9 +4,11 @@
 
 #include <cstring>
 #include "common/common_types.h"
+#include "core/core.h"
 #include "core/core_timing.h"
 #include "core/hle/service/hid/controllers/keyboard.h"
 #include "core/settings.h"
+#include "core/tools/input_movie.h"
 
 namespace Service::HID {
 constexpr std::size_t SHARED_MEMORY_OFFSET = 0x3800;
@@ -42,6 +44,19 @@ void Controller_Keyboard::OnUpdate(const Core::Timing::CoreTiming& core_timing,
         RequestKeyboardStateUpdate();
     }
 
+    auto& input_movie = system.InputMovie();
+    auto& keyboard_entry = shared_memory.pad_states[shared_memory.header.last_entry_index];
+    Tools::InputMovie::KeyboardState movie_keyboard{
+        .modifier = keyboard_entry.modifier,
+        .keys = keyboard_entry.key,
+    };
+    if (input_movie.PlaybackKeyboard(movie_keyboard)) {
+        keyboard_entry.modifier = movie_keyboard.modifier;
+        keyboard_entry.key = movie_keyboard.keys;
+    } else {
+        input_movie.RecordKeyboard(movie_keyboard);
+    }
+
     std::memcpy(data + SHARED_MEMORY_OFFSET, &shared_memory, sizeof(SharedMemory));
 }
 
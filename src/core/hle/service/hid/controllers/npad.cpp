@@ -17,6 +17,7 @@
 #include "core/hle/kernel/writable_event.h"
 #include "core/hle/service/hid/controllers/npad.h"
 #include "core/settings.h"
+#include "core/tools/input_movie.h"
 
 namespace Service::HID {
 constexpr s32 HID_JOYSTICK_MAX = 0x7fff;
@@ -396,6 +397,22 @@ void Controller_NPad::OnUpdate(const Core::Timing::CoreTiming& core_timing, u8*
         }
         auto& pad_state = npad_pad_states[npad_index];
 
+        auto& input_movie = system.InputMovie();
+        Tools::InputMovie::PadState movie_pad{
+            .buttons = pad_state.pad_states.raw,
+            .l_stick_x = pad_state.l_stick.x,
+            .l_stick_y = pad_state.l_stick.y,
+            .r_stick_x = pad_state.r_stick.x,
+            .r_stick_y = pad_state.r_stick.y,
+        };
+        if (input_movie.PlaybackPad(i, movie_pad)) {
+            pad_state.pad_states.raw = movie_pad.buttons;
+            pad_state.l_stick = {movie_pad.l_stick_x, movie_pad.l_stick_y};
+            pad_state.r_stick = {movie_pad.r_stick_x, movie_pad.r_stick_y};
+        } else {
+            input_movie.RecordPad(i, movie_pad);
+        }
+
         auto& main_controller =
             npad.main_controller_states.npad[npad.main_controller_states.common.last_entry_index];
         auto& handheld_entry =
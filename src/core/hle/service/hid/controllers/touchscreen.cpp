@@ -2,13 +2,16 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cstring>
 #include "common/common_types.h"
+#include "core/core.h"
 #include "core/core_timing.h"
 #include "core/frontend/emu_window.h"
 #include "core/frontend/input.h"
 #include "core/hle/service/hid/controllers/touchscreen.h"
 #include "core/settings.h"
+#include "core/tools/input_movie.h"
 
 namespace Service::HID {
 constexpr std::size_t SHARED_MEMORY_OFFSET = 0x400;
@@ -54,6 +57,25 @@ void Controller_Touchscreen::OnUpdate(const Core::Timing::CoreTiming& core_timin
         RequestTouchscreenStateUpdate(core_timing);
     }
 
+    auto& input_movie = system.InputMovie();
+    auto& touch_screen_entry =
+        shared_memory.shared_memory_entries[shared_memory.header.last_entry_index];
+    Tools::InputMovie::TouchState movie_touch{};
+    movie_touch.count = std::min<u32>(touch_screen_entry.entry_count,
+                                      static_cast<u32>(touch_screen_entry.states.size()));
+    for (u32 i = 0; i < movie_touch.count; ++i) {
+        movie_touch.points[i] = {touch_screen_entry.states[i].x, touch_screen_entry.states[i].y};
+    }
+    if (input_movie.PlaybackTouch(movie_touch)) {
+        touch_screen_entry.entry_count = static_cast<s32>(movie_touch.count);
+        for (u32 i = 0; i < movie_touch.count; ++i) {
+            touch_screen_entry.states[i].x = movie_touch.points[i].x;
+            touch_screen_entry.states[i].y = movie_touch.points[i].y;
+        }
+    } else {
+        input_movie.RecordTouch(movie_touch);
+    }
+
     std::memcpy(data + SHARED_MEMORY_OFFSET, &shared_memory, sizeof(TouchScreenSharedMemory));
 }
 
@@ -513,7 +513,7 @@ public:
                                      header.segment_headers[DATA_INDEX].memory_size, nro_address});
 
         // Invalidate JIT caches for the newly mapped process code
-        system.InvalidateCpuInstructionCaches();
+        system.InvalidateCpuInstructionCacheRange(*map_result, nro_size);
 
         IPC::ResponseBuilder rb{ctx, 4};
         rb.Push(RESULT_SUCCESS);
@@ -575,7 +575,7 @@ public:
 
         const auto result{UnmapNro(iter->second)};
 
-        system.InvalidateCpuInstructionCaches();
+        system.InvalidateCpuInstructionCacheRange(iter->second.nro_address, iter->second.nro_size);
 
         nro.erase(iter);
 
@@ -16,6 +16,7 @@
 #include "common/logging/log.h"
 #include "common/math_util.h"
 #include "common/swap.h"
+#include "core/core.h"
 #include "core/core_timing.h"
 #include "core/hle/ipc_helpers.h"
 #include "core/hle/kernel/readable_event.h"
@@ -31,7 +32,9 @@
 #include "core/hle/service/vi/vi_s.h"
 #include "core/hle/service/vi/vi_u.h"
 #include "core/settings.h"
+#include "core/tools/input_movie.h"
 #include "core/tools/plugin_manager.h"
+#include "core/tools/rewind_buffer.h"
 
 namespace Service::VI {
 
@@ -474,8 +477,10 @@ private:
 
 class IHOSBinderDriver final : public ServiceFramework<IHOSBinderDriver> {
 public:
-    explicit IHOSBinderDriver(std::shared_ptr<NVFlinger::NVFlinger> nv_flinger)
-        : ServiceFramework("IHOSBinderDriver"), nv_flinger(std::move(nv_flinger)) {
+    explicit IHOSBinderDriver(Core::System& system_,
+                              std::shared_ptr<NVFlinger::NVFlinger> nv_flinger)
+        : ServiceFramework("IHOSBinderDriver"), system(system_),
+          nv_flinger(std::move(nv_flinger)) {
         static const FunctionInfo functions[] = {
             {0, &IHOSBinderDriver::TransactParcel, "TransactParcel"},
             {1, &IHOSBinderDriver::AdjustRefcount, "AdjustRefcount"},
@@ -583,7 +588,9 @@ private:
                                      request.data.multi_fence);
 
             // The plugin manager counts vsync as when the game pushes a buffer onto the queue
-            Core::System::GetInstance().PluginManager().ProcessScriptFromVsync();
+            system.PluginManager().ProcessScriptFromVsync();
+            system.InputMovie().AdvanceFrame();
+            system.RewindBuffer().AdvanceFrame();
 
             IGBPQueueBufferResponseParcel response{1280, 720};
             ctx.WriteBuffer(response.Serialize());
@@ -664,6 +671,7 @@ private:
         rb.PushCopyObjects(buffer_queue.GetBufferWaitEvent());
     }
 
+    Core::System& system;
     std::shared_ptr<NVFlinger::NVFlinger> nv_flinger;
 }; // namespace VI
 
@@ -915,7 +923,8 @@ private:
 
 class IApplicationDisplayService final : public ServiceFramework<IApplicationDisplayService> {
 public:
-    explicit IApplicationDisplayService(std::shared_ptr<NVFlinger::NVFlinger> nv_flinger);
+    explicit IApplicationDisplayService(Core::System& system_,
+                                        std::shared_ptr<NVFlinger::NVFlinger> nv_flinger);
 
 private:
     enum class ConvertedScaleMode : u64 {
@@ -939,7 +948,7 @@ private:
 
         IPC::ResponseBuilder rb{ctx, 2, 0, 1};
         rb.Push(RESULT_SUCCESS);
-        rb.PushIpcInterface<IHOSBinderDriver>(nv_flinger);
+        rb.PushIpcInterface<IHOSBinderDriver>(system, nv_flinger);
     }
 
     void GetSystemDisplayService(Kernel::HLERequestContext& ctx) {
@@ -963,7 +972,7 @@ private:
 
         IPC::ResponseBuilder rb{ctx, 2, 0, 1};
         rb.Push(RESULT_SUCCESS);
-        rb.PushIpcInterface<IHOSBinderDriver>(nv_flinger);
+        rb.PushIpcInterface<IHOSBinderDriver>(system, nv_flinger);
     }
 
     void OpenDisplay(Kernel::HLERequestContext& ctx) {
@@ -1238,12 +1247,14 @@ private:
         }
     }
 
+    Core::System& system;
     std::shared_ptr<NVFlinger::NVFlinger> nv_flinger;
 };
 
 IApplicationDisplayService::IApplicationDisplayService(
-    std::shared_ptr<NVFlinger::NVFlinger> nv_flinger)
-    : ServiceFramework("IApplicationDisplayService"), nv_flinger(std::move(nv_flinger)) {
+    Core::System& system_, std::shared_ptr<NVFlinger::NVFlinger> nv_flinger)
+    : ServiceFramework("IApplicationDisplayService"), system(system_),
+      nv_flinger(std::move(nv_flinger)) {
     static const FunctionInfo functions[] = {
         {100, &IApplicationDisplayService::GetRelayService, "GetRelayService"},
         {101, &IApplicationDisplayService::GetSystemDisplayService, "GetSystemDisplayService"},
@@ -1284,7 +1295,7 @@ static bool IsValidServiceAccess(Permission permission, Policy policy) {
     return false;
 }
 
-void detail::GetDisplayServiceImpl(Kernel::HLERequestContext& ctx,
+void detail::GetDisplayServiceImpl(Kernel::HLERequestContext& ctx, Core::System& system,
                                    std::shared_ptr<NVFlinger::NVFlinger> nv_flinger,
                                    Permission permission) {
     IPC::RequestParser rp{ctx};
@@ -1299,14 +1310,14 @@ void detail::GetDisplayServiceImpl(Kernel::HLERequestContext& ctx,
 
     IPC::ResponseBuilder rb{ctx, 2, 0, 1};
     rb.Push(RESULT_SUCCESS);
-    rb.PushIpcInterface<IApplicationDisplayService>(std::move(nv_flinger));
+    rb.PushIpcInterface<IApplicationDisplayService>(system, std::move(nv_flinger));
 }
 
-void InstallInterfaces(SM::ServiceManager& service_manager,
+void InstallInterfaces(SM::ServiceManager& service_manager, Core::System& system,
                        std::shared_ptr<NVFlinger::NVFlinger> nv_flinger) {
-    std::make_shared<VI_M>(nv_flinger)->InstallAsService(service_manager);
-    std::make_shared<VI_S>(nv_flinger)->InstallAsService(service_manager);
-    std::make_shared<VI_U>(nv_flinger)->InstallAsService(service_manager);
+    std::make_shared<VI_M>(system, nv_flinger)->InstallAsService(service_manager);
+    std::make_shared<VI_S>(system, nv_flinger)->InstallAsService(service_manager);
+    std::make_shared<VI_U>(system, nv_flinger)->InstallAsService(service_manager);
 }
 
 } // namespace Service::VI
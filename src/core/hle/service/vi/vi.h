@@ -7,6 +7,10 @@
 #include <memory>
 #include "common/common_types.h"
 
+namespace Core {
+class System;
+}
+
 namespace Kernel {
 class HLERequestContext;
 }
@@ -43,12 +47,12 @@ enum class Policy {
 };
 
 namespace detail {
-void GetDisplayServiceImpl(Kernel::HLERequestContext& ctx,
+void GetDisplayServiceImpl(Kernel::HLERequestContext& ctx, Core::System& system,
                            std::shared_ptr<NVFlinger::NVFlinger> nv_flinger, Permission permission);
 } // namespace detail
 
 /// Registers all VI services with the specified service manager.
-void InstallInterfaces(SM::ServiceManager& service_manager,
+void InstallInterfaces(SM::ServiceManager& service_manager, Core::System& system,
                        std::shared_ptr<NVFlinger::NVFlinger> nv_flinger);
 
 } // namespace Service::VI
@@ -2,8 +2,10 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <array>
 #include <cinttypes>
 #include <cstring>
+#include <thread>
 #include <vector>
 
 #include "common/common_funcs.h"
@@ -15,6 +17,7 @@
 #include "core/core.h"
 #include "core/file_sys/patch_manager.h"
 #include "core/gdbstub/gdbstub.h"
+#include "core/hle/guest_functions.h"
 #include "core/hle/kernel/code_set.h"
 #include "core/hle/kernel/memory/page_table.h"
 #include "core/hle/kernel/process.h"
@@ -88,15 +91,27 @@ std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::Process& process, Core::S
         return std::nullopt;
     }
 
-    // Build program image
-    Kernel::CodeSet codeset;
-    Kernel::PhysicalMemory program_image;
+    // Segments are decompressed in parallel, .text is usually by far the largest
+    std::array<std::vector<u8>, 3> segments;
+    std::vector<std::thread> workers;
     for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
-        std::vector<u8> data =
+        segments[i] =
             file.ReadBytes(nso_header.segments_compressed_size[i], nso_header.segments[i].offset);
         if (nso_header.IsSegmentCompressed(i)) {
-            data = DecompressSegment(data, nso_header.segments[i]);
+            workers.emplace_back([&segments, &nso_header, i] {
+                segments[i] = DecompressSegment(segments[i], nso_header.segments[i]);
+            });
         }
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    // Build program image
+    Kernel::CodeSet codeset;
+    Kernel::PhysicalMemory program_image;
+    for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
+        const std::vector<u8>& data = segments[i];
         program_image.resize(nso_header.segments[i].location + static_cast<u32>(data.size()));
         std::memcpy(program_image.data() + nso_header.segments[i].location, data.data(),
                     data.size());
@@ -146,6 +161,12 @@ std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::Process& process, Core::S
         return load_base + image_size;
     }
 
+    // Replace the guest functions of the module with known code
+    if (process.Is64BitProcess() && Settings::values.enable_hle_functions) {
+        HLE::GuestFunctions::PatchModule(program_image, codeset.CodeSegment().size,
+                                         nso_header.build_id);
+    }
+
     // Apply cheats if they exist and the program has a valid title ID
     if (pm) {
         system.SetCurrentProcessBuildID(nso_header.build_id);
@@ -3,10 +3,15 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
 #include <cstring>
+#include <mutex>
 #include <optional>
+#include <set>
 #include <utility>
 
+#include <boost/container/small_vector.hpp>
+
 #include "common/assert.h"
 #include "common/atomic_ops.h"
 #include "common/common_types.h"
@@ -33,6 +38,11 @@ struct Memory::Impl {
     void SetCurrentPageTable(Kernel::Process& process, u32 core_id) {
         current_page_table = &process.PageTable().PageTableImpl();
 
+        // The cores only run guest code while powered on, until then only HLE accesses memory
+        if (!system.IsPoweredOn()) {
+            return;
+        }
+
         const std::size_t address_space_width = process.PageTable().GetAddressSpaceWidth();
 
         system.ArmInterface(core_id).PageTableChanged(*current_page_table, address_space_width);
@@ -57,12 +67,51 @@ struct Memory::Impl {
 
     void AddDebugHook(Common::PageTable& page_table, VAddr base, u64 size,
                       Common::MemoryHookPointer hook) {
-        UNIMPLEMENTED();
+        ASSERT_MSG((size & PAGE_MASK) == 0, "non-page aligned size: {:016X}", size);
+        ASSERT_MSG((base & PAGE_MASK) == 0, "non-page aligned base: {:016X}", base);
+
+        std::lock_guard lock{special_regions_mutex};
+
+        const Common::SpecialRegion region{Common::SpecialRegion::Type::DebugHook, std::move(hook)};
+        page_table.special_regions.add(
+            {SpecialRegionMap::interval_type::right_open(base, base + size), std::set{region}});
+        UpdateSpecialRegionCount(page_table);
+
+        for (u64 page = base >> PAGE_BITS; page < (base + size) >> PAGE_BITS; ++page) {
+            // Pages cached by the rasterizer already leave the fast path, their writes check for
+            // hooks and they become special once they are uncached
+            if (page_table.attributes[page] == Common::PageType::Memory) {
+                // Without a pointer every access to the page leaves the fast path
+                page_table.attributes[page] = Common::PageType::Special;
+                page_table.pointers[page] = nullptr;
+            }
+        }
+        page_table.RemoveMemoryRun(base, size);
     }
 
     void RemoveDebugHook(Common::PageTable& page_table, VAddr base, u64 size,
                          Common::MemoryHookPointer hook) {
-        UNIMPLEMENTED();
+        ASSERT_MSG((size & PAGE_MASK) == 0, "non-page aligned size: {:016X}", size);
+        ASSERT_MSG((base & PAGE_MASK) == 0, "non-page aligned base: {:016X}", base);
+
+        std::lock_guard lock{special_regions_mutex};
+
+        const Common::SpecialRegion region{Common::SpecialRegion::Type::DebugHook, std::move(hook)};
+        page_table.special_regions.subtract(
+            {SpecialRegionMap::interval_type::right_open(base, base + size), std::set{region}});
+        UpdateSpecialRegionCount(page_table);
+
+        for (u64 page = base >> PAGE_BITS; page < (base + size) >> PAGE_BITS; ++page) {
+            if (page_table.attributes[page] != Common::PageType::Special ||
+                page_table.special_regions.find(page << PAGE_BITS) !=
+                    page_table.special_regions.end()) {
+                continue;
+            }
+            page_table.attributes[page] = Common::PageType::Memory;
+            page_table.pointers[page] =
+                system.DeviceMemory().GetPointer(page_table.backing_addr[page]);
+            page_table.AddMemoryRun(page << PAGE_BITS, PAGE_SIZE, page_table.pointers[page]);
+        }
     }
 
     bool IsValidVirtualAddress(const Kernel::Process& process, const VAddr vaddr) const {
@@ -81,7 +130,14 @@ struct Memory::Impl {
             return false;
         }
 
-        return false;
+        for (const auto& hook : GetDebugHooks(page_table, vaddr, 1)) {
+            if (const auto result = hook->IsValidAddress(vaddr)) {
+                return *result;
+            }
+        }
+
+        // Debug hooked pages are still backed by memory
+        return true;
     }
 
     bool IsValidVirtualAddress(VAddr vaddr) const {
@@ -98,18 +154,34 @@ struct Memory::Impl {
         return system.DeviceMemory().GetPointer(paddr) + vaddr;
     }
 
+    u8* GetPointerFromSpecialMemory(const Common::PageTable& page_table, VAddr vaddr) const {
+        return system.DeviceMemory().GetPointer(page_table.backing_addr[vaddr >> PAGE_BITS]) +
+               vaddr;
+    }
+
     u8* GetPointer(const VAddr vaddr) const {
         u8* const page_pointer{current_page_table->pointers[vaddr >> PAGE_BITS]};
         if (page_pointer) {
             return page_pointer + vaddr;
         }
 
-        if (current_page_table->attributes[vaddr >> PAGE_BITS] ==
-            Common::PageType::RasterizerCachedMemory) {
+        switch (current_page_table->attributes[vaddr >> PAGE_BITS]) {
+        case Common::PageType::RasterizerCachedMemory:
             return GetPointerFromRasterizerCachedMemory(vaddr);
+        case Common::PageType::Special:
+            // Accesses through the returned pointer are not seen by debug hooks
+            return GetPointerFromSpecialMemory(*current_page_table, vaddr);
+        default:
+            return {};
         }
+    }
 
-        return {};
+    u8* GetContiguousPointer(const Kernel::Process& process, const VAddr vaddr,
+                             const std::size_t size) const {
+        const std::size_t min_size = std::max<std::size_t>(size, 1);
+        const auto [pointer, run_size] =
+            process.PageTable().PageTableImpl().FindMemoryRun(vaddr, min_size);
+        return run_size == min_size ? pointer : nullptr;
     }
 
     u8 Read8(const VAddr addr) {
@@ -208,18 +280,41 @@ struct Memory::Impl {
         return string;
     }
 
-    void ReadBlock(const Kernel::Process& process, const VAddr src_addr, void* dest_buffer,
-                   const std::size_t size) {
+    /**
+     * Run of plain memory that a block access can copy at once. Accesses within a single page
+     * don't look for one, the page pointer is enough and the lookup takes a lock.
+     */
+    static std::pair<u8*, std::size_t> FindBlockRun(const Common::PageTable& page_table,
+                                                    VAddr vaddr, std::size_t size) {
+        if ((vaddr & PAGE_MASK) + size <= PAGE_SIZE) {
+            return {};
+        }
+        return page_table.FindMemoryRun(vaddr, size);
+    }
+
+    template <bool UNSAFE>
+    void ReadBlockImpl(const Kernel::Process& process, const VAddr src_addr, void* dest_buffer,
+                       const std::size_t size) {
         const auto& page_table = process.PageTable().PageTableImpl();
 
         std::size_t remaining_size = size;
-        std::size_t page_index = src_addr >> PAGE_BITS;
-        std::size_t page_offset = src_addr & PAGE_MASK;
+        VAddr current_vaddr = src_addr;
 
         while (remaining_size > 0) {
-            const std::size_t copy_amount =
-                std::min(static_cast<std::size_t>(PAGE_SIZE) - page_offset, remaining_size);
-            const auto current_vaddr = static_cast<VAddr>((page_index << PAGE_BITS) + page_offset);
+            // Runs of plain memory are copied at once, however many pages they span
+            if (const auto [src_ptr, run_size] =
+                    FindBlockRun(page_table, current_vaddr, remaining_size);
+                src_ptr != nullptr) {
+                std::memcpy(dest_buffer, src_ptr, run_size);
+                current_vaddr += run_size;
+                dest_buffer = static_cast<u8*>(dest_buffer) + run_size;
+                remaining_size -= run_size;
+                continue;
+            }
+
+            const std::size_t page_index = current_vaddr >> PAGE_BITS;
+            const std::size_t copy_amount = std::min(
+                static_cast<std::size_t>(PAGE_SIZE - (current_vaddr & PAGE_MASK)), remaining_size);
 
             switch (page_table.attributes[page_index]) {
             case Common::PageType::Unmapped: {
@@ -232,71 +327,40 @@ struct Memory::Impl {
             case Common::PageType::Memory: {
                 DEBUG_ASSERT(page_table.pointers[page_index]);
 
-                const u8* const src_ptr =
-                    page_table.pointers[page_index] + page_offset + (page_index << PAGE_BITS);
+                const u8* const src_ptr = page_table.pointers[page_index] + current_vaddr;
                 std::memcpy(dest_buffer, src_ptr, copy_amount);
                 break;
             }
             case Common::PageType::RasterizerCachedMemory: {
                 const u8* const host_ptr{GetPointerFromRasterizerCachedMemory(current_vaddr)};
-                system.GPU().FlushRegion(current_vaddr, copy_amount);
+                if constexpr (!UNSAFE) {
+                    system.GPU().FlushRegion(current_vaddr, copy_amount);
+                }
                 std::memcpy(dest_buffer, host_ptr, copy_amount);
                 break;
             }
+            case Common::PageType::Special: {
+                ReadSpecialBlock(page_table, current_vaddr, dest_buffer, copy_amount);
+                break;
+            }
             default:
                 UNREACHABLE();
             }
 
-            page_index++;
-            page_offset = 0;
+            current_vaddr += copy_amount;
             dest_buffer = static_cast<u8*>(dest_buffer) + copy_amount;
             remaining_size -= copy_amount;
         }
     }
 
+    void ReadBlock(const Kernel::Process& process, const VAddr src_addr, void* dest_buffer,
+                   const std::size_t size) {
+        ReadBlockImpl<false>(process, src_addr, dest_buffer, size);
+    }
+
     void ReadBlockUnsafe(const Kernel::Process& process, const VAddr src_addr, void* dest_buffer,
                          const std::size_t size) {
-        const auto& page_table = process.PageTable().PageTableImpl();
-
-        std::size_t remaining_size = size;
-        std::size_t page_index = src_addr >> PAGE_BITS;
-        std::size_t page_offset = src_addr & PAGE_MASK;
-
-        while (remaining_size > 0) {
-            const std::size_t copy_amount =
-                std::min(static_cast<std::size_t>(PAGE_SIZE) - page_offset, remaining_size);
-            const auto current_vaddr = static_cast<VAddr>((page_index << PAGE_BITS) + page_offset);
-
-            switch (page_table.attributes[page_index]) {
-            case Common::PageType::Unmapped: {
-                LOG_ERROR(HW_Memory,
-                          "Unmapped ReadBlock @ 0x{:016X} (start address = 0x{:016X}, size = {})",
-                          current_vaddr, src_addr, size);
-                std::memset(dest_buffer, 0, copy_amount);
-                break;
-            }
-            case Common::PageType::Memory: {
-                DEBUG_ASSERT(page_table.pointers[page_index]);
-
-                const u8* const src_ptr =
-                    page_table.pointers[page_index] + page_offset + (page_index << PAGE_BITS);
-                std::memcpy(dest_buffer, src_ptr, copy_amount);
-                break;
-            }
-            case Common::PageType::RasterizerCachedMemory: {
-                const u8* const host_ptr{GetPointerFromRasterizerCachedMemory(current_vaddr)};
-                std::memcpy(dest_buffer, host_ptr, copy_amount);
-                break;
-            }
-            default:
-                UNREACHABLE();
-            }
-
-            page_index++;
-            page_offset = 0;
-            dest_buffer = static_cast<u8*>(dest_buffer) + copy_amount;
-            remaining_size -= copy_amount;
-        }
+        ReadBlockImpl<true>(process, src_addr, dest_buffer, size);
     }
 
     void ReadBlock(const VAddr src_addr, void* dest_buffer, const std::size_t size) {
@@ -307,17 +371,28 @@ struct Memory::Impl {
         ReadBlockUnsafe(*system.CurrentProcess(), src_addr, dest_buffer, size);
     }
 
-    void WriteBlock(const Kernel::Process& process, const VAddr dest_addr, const void* src_buffer,
-                    const std::size_t size) {
+    template <bool UNSAFE>
+    void WriteBlockImpl(const Kernel::Process& process, const VAddr dest_addr,
+                        const void* src_buffer, const std::size_t size) {
         const auto& page_table = process.PageTable().PageTableImpl();
+
         std::size_t remaining_size = size;
-        std::size_t page_index = dest_addr >> PAGE_BITS;
-        std::size_t page_offset = dest_addr & PAGE_MASK;
+        VAddr current_vaddr = dest_addr;
 
         while (remaining_size > 0) {
-            const std::size_t copy_amount =
-                std::min(static_cast<std::size_t>(PAGE_SIZE) - page_offset, remaining_size);
-            const auto current_vaddr = static_cast<VAddr>((page_index << PAGE_BITS) + page_offset);
+            if (const auto [dest_ptr, run_size] =
+                    FindBlockRun(page_table, current_vaddr, remaining_size);
+                dest_ptr != nullptr) {
+                std::memcpy(dest_ptr, src_buffer, run_size);
+                current_vaddr += run_size;
+                src_buffer = static_cast<const u8*>(src_buffer) + run_size;
+                remaining_size -= run_size;
+                continue;
+            }
+
+            const std::size_t page_index = current_vaddr >> PAGE_BITS;
+            const std::size_t copy_amount = std::min(
+                static_cast<std::size_t>(PAGE_SIZE - (current_vaddr & PAGE_MASK)), remaining_size);
 
             switch (page_table.attributes[page_index]) {
             case Common::PageType::Unmapped: {
@@ -329,69 +404,40 @@ struct Memory::Impl {
             case Common::PageType::Memory: {
                 DEBUG_ASSERT(page_table.pointers[page_index]);
 
-                u8* const dest_ptr =
-                    page_table.pointers[page_index] + page_offset + (page_index << PAGE_BITS);
+                u8* const dest_ptr = page_table.pointers[page_index] + current_vaddr;
                 std::memcpy(dest_ptr, src_buffer, copy_amount);
                 break;
             }
             case Common::PageType::RasterizerCachedMemory: {
-                u8* const host_ptr{GetPointerFromRasterizerCachedMemory(current_vaddr)};
-                system.GPU().InvalidateRegion(current_vaddr, copy_amount);
-                std::memcpy(host_ptr, src_buffer, copy_amount);
+                if constexpr (!UNSAFE) {
+                    system.GPU().InvalidateRegion(current_vaddr, copy_amount);
+                }
+                // Cached pages may still have debug hooks
+                WriteSpecialBlock(page_table, current_vaddr, src_buffer, copy_amount);
+                break;
+            }
+            case Common::PageType::Special: {
+                WriteSpecialBlock(page_table, current_vaddr, src_buffer, copy_amount);
                 break;
             }
             default:
                 UNREACHABLE();
             }
 
-            page_index++;
-            page_offset = 0;
+            current_vaddr += copy_amount;
             src_buffer = static_cast<const u8*>(src_buffer) + copy_amount;
             remaining_size -= copy_amount;
         }
     }
 
+    void WriteBlock(const Kernel::Process& process, const VAddr dest_addr, const void* src_buffer,
+                    const std::size_t size) {
+        WriteBlockImpl<false>(process, dest_addr, src_buffer, size);
+    }
+
     void WriteBlockUnsafe(const Kernel::Process& process, const VAddr dest_addr,
                           const void* src_buffer, const std::size_t size) {
-        const auto& page_table = process.PageTable().PageTableImpl();
-        std::size_t remaining_size = size;
-        std::size_t page_index = dest_addr >> PAGE_BITS;
-        std::size_t page_offset = dest_addr & PAGE_MASK;
-
-        while (remaining_size > 0) {
-            const std::size_t copy_amount =
-                std::min(static_cast<std::size_t>(PAGE_SIZE) - page_offset, remaining_size);
-            const auto current_vaddr = static_cast<VAddr>((page_index << PAGE_BITS) + page_offset);
-
-            switch (page_table.attributes[page_index]) {
-            case Common::PageType::Unmapped: {
-                LOG_ERROR(HW_Memory,
-                          "Unmapped WriteBlock @ 0x{:016X} (start address = 0x{:016X}, size = {})",
-                          current_vaddr, dest_addr, size);
-                break;
-            }
-            case Common::PageType::Memory: {
-                DEBUG_ASSERT(page_table.pointers[page_index]);
-
-                u8* const dest_ptr =
-                    page_table.pointers[page_index] + page_offset + (page_index << PAGE_BITS);
-                std::memcpy(dest_ptr, src_buffer, copy_amount);
-                break;
-            }
-            case Common::PageType::RasterizerCachedMemory: {
-                u8* const host_ptr{GetPointerFromRasterizerCachedMemory(current_vaddr)};
-                std::memcpy(host_ptr, src_buffer, copy_amount);
-                break;
-            }
-            default:
-                UNREACHABLE();
-            }
-
-            page_index++;
-            page_offset = 0;
-            src_buffer = static_cast<const u8*>(src_buffer) + copy_amount;
-            remaining_size -= copy_amount;
-        }
+        WriteBlockImpl<true>(process, dest_addr, src_buffer, size);
     }
 
     void WriteBlock(const VAddr dest_addr, const void* src_buffer, const std::size_t size) {
@@ -404,14 +450,23 @@ struct Memory::Impl {
 
     void ZeroBlock(const Kernel::Process& process, const VAddr dest_addr, const std::size_t size) {
         const auto& page_table = process.PageTable().PageTableImpl();
+
         std::size_t remaining_size = size;
-        std::size_t page_index = dest_addr >> PAGE_BITS;
-        std::size_t page_offset = dest_addr & PAGE_MASK;
+        VAddr current_vaddr = dest_addr;
 
         while (remaining_size > 0) {
-            const std::size_t copy_amount =
-                std::min(static_cast<std::size_t>(PAGE_SIZE) - page_offset, remaining_size);
-            const auto current_vaddr = static_cast<VAddr>((page_index << PAGE_BITS) + page_offset);
+            if (const auto [dest_ptr, run_size] =
+                    FindBlockRun(page_table, current_vaddr, remaining_size);
+                dest_ptr != nullptr) {
+                std::memset(dest_ptr, 0, run_size);
+                current_vaddr += run_size;
+                remaining_size -= run_size;
+                continue;
+            }
+
+            const std::size_t page_index = current_vaddr >> PAGE_BITS;
+            const std::size_t copy_amount = std::min(
+                static_cast<std::size_t>(PAGE_SIZE - (current_vaddr & PAGE_MASK)), remaining_size);
 
             switch (page_table.attributes[page_index]) {
             case Common::PageType::Unmapped: {
@@ -423,23 +478,25 @@ struct Memory::Impl {
             case Common::PageType::Memory: {
                 DEBUG_ASSERT(page_table.pointers[page_index]);
 
-                u8* dest_ptr =
-                    page_table.pointers[page_index] + page_offset + (page_index << PAGE_BITS);
+                u8* const dest_ptr = page_table.pointers[page_index] + current_vaddr;
                 std::memset(dest_ptr, 0, copy_amount);
                 break;
             }
-            case Common::PageType::RasterizerCachedMemory: {
-                u8* const host_ptr{GetPointerFromRasterizerCachedMemory(current_vaddr)};
-                system.GPU().InvalidateRegion(current_vaddr, copy_amount);
-                std::memset(host_ptr, 0, copy_amount);
+            case Common::PageType::RasterizerCachedMemory:
+            case Common::PageType::Special: {
+                if (page_table.attributes[page_index] ==
+                    Common::PageType::RasterizerCachedMemory) {
+                    system.GPU().InvalidateRegion(current_vaddr, copy_amount);
+                }
+                static constexpr std::array<u8, PAGE_SIZE> zeros{};
+                WriteSpecialBlock(page_table, current_vaddr, zeros.data(), copy_amount);
                 break;
             }
             default:
                 UNREACHABLE();
             }
 
-            page_index++;
-            page_offset = 0;
+            current_vaddr += copy_amount;
             remaining_size -= copy_amount;
         }
     }
@@ -451,42 +508,55 @@ struct Memory::Impl {
     void CopyBlock(const Kernel::Process& process, VAddr dest_addr, VAddr src_addr,
                    const std::size_t size) {
         const auto& page_table = process.PageTable().PageTableImpl();
+
+        const VAddr start_src_addr = src_addr;
         std::size_t remaining_size = size;
-        std::size_t page_index = src_addr >> PAGE_BITS;
-        std::size_t page_offset = src_addr & PAGE_MASK;
 
         while (remaining_size > 0) {
-            const std::size_t copy_amount =
-                std::min(static_cast<std::size_t>(PAGE_SIZE) - page_offset, remaining_size);
-            const auto current_vaddr = static_cast<VAddr>((page_index << PAGE_BITS) + page_offset);
+            // WriteBlock merges the destination into runs of its own
+            if (const auto [src_ptr, run_size] = FindBlockRun(page_table, src_addr, remaining_size);
+                src_ptr != nullptr) {
+                WriteBlock(process, dest_addr, src_ptr, run_size);
+                dest_addr += run_size;
+                src_addr += run_size;
+                remaining_size -= run_size;
+                continue;
+            }
+
+            const std::size_t page_index = src_addr >> PAGE_BITS;
+            const std::size_t copy_amount = std::min(
+                static_cast<std::size_t>(PAGE_SIZE - (src_addr & PAGE_MASK)), remaining_size);
 
             switch (page_table.attributes[page_index]) {
             case Common::PageType::Unmapped: {
                 LOG_ERROR(HW_Memory,
                           "Unmapped CopyBlock @ 0x{:016X} (start address = 0x{:016X}, size = {})",
-                          current_vaddr, src_addr, size);
+                          src_addr, start_src_addr, size);
                 ZeroBlock(process, dest_addr, copy_amount);
                 break;
             }
             case Common::PageType::Memory: {
                 DEBUG_ASSERT(page_table.pointers[page_index]);
-                const u8* src_ptr =
-                    page_table.pointers[page_index] + page_offset + (page_index << PAGE_BITS);
+                const u8* const src_ptr = page_table.pointers[page_index] + src_addr;
                 WriteBlock(process, dest_addr, src_ptr, copy_amount);
                 break;
             }
             case Common::PageType::RasterizerCachedMemory: {
-                const u8* const host_ptr{GetPointerFromRasterizerCachedMemory(current_vaddr)};
-                system.GPU().FlushRegion(current_vaddr, copy_amount);
+                const u8* const host_ptr{GetPointerFromRasterizerCachedMemory(src_addr)};
+                system.GPU().FlushRegion(src_addr, copy_amount);
                 WriteBlock(process, dest_addr, host_ptr, copy_amount);
                 break;
             }
+            case Common::PageType::Special: {
+                std::array<u8, PAGE_SIZE> buffer;
+                ReadSpecialBlock(page_table, src_addr, buffer.data(), copy_amount);
+                WriteBlock(process, dest_addr, buffer.data(), copy_amount);
+                break;
+            }
             default:
                 UNREACHABLE();
             }
 
-            page_index++;
-            page_offset = 0;
             dest_addr += static_cast<VAddr>(copy_amount);
             src_addr += static_cast<VAddr>(copy_amount);
             remaining_size -= copy_amount;
@@ -521,11 +591,17 @@ struct Memory::Impl {
                 case Common::PageType::Memory:
                     page_type = Common::PageType::RasterizerCachedMemory;
                     current_page_table->pointers[vaddr >> PAGE_BITS] = nullptr;
+                    current_page_table->RemoveMemoryRun(vaddr & ~PAGE_MASK, PAGE_SIZE);
                     break;
                 case Common::PageType::RasterizerCachedMemory:
                     // There can be more than one GPU region mapped per CPU region, so it's common
                     // that this area is already marked as cached.
                     break;
+                case Common::PageType::Special:
+                    // Writes to cached pages still go through the debug hooks, the page becomes
+                    // special again when it is uncached
+                    page_type = Common::PageType::RasterizerCachedMemory;
+                    break;
                 default:
                     UNREACHABLE();
                 }
@@ -537,6 +613,7 @@ struct Memory::Impl {
                     // space, for example, a system module need not have a VRAM mapping.
                     break;
                 case Common::PageType::Memory:
+                case Common::PageType::Special:
                     // There can be more than one GPU region mapped per CPU region, so it's common
                     // that this area is already unmarked as cached.
                     break;
@@ -547,9 +624,14 @@ struct Memory::Impl {
                         // pagetable after unmapping a VMA. In that case the underlying VMA will no
                         // longer exist, and we should just leave the pagetable entry blank.
                         page_type = Common::PageType::Unmapped;
+                    } else if (HasDebugHook(*current_page_table, vaddr)) {
+                        page_type = Common::PageType::Special;
                     } else {
                         current_page_table->pointers[vaddr >> PAGE_BITS] =
                             pointer - (vaddr & ~PAGE_MASK);
+                        current_page_table->AddMemoryRun(
+                            vaddr & ~PAGE_MASK, PAGE_SIZE,
+                            current_page_table->pointers[vaddr >> PAGE_BITS]);
                         page_type = Common::PageType::Memory;
                     }
                     break;
@@ -590,6 +672,23 @@ struct Memory::Impl {
         ASSERT_MSG(end <= page_table.pointers.size(), "out of range mapping at {:016X}",
                    base + page_table.pointers.size());
 
+        // Hooks belong to the old mapping, their owners are told once the new one is in place
+        const VAddr first_vaddr = base << PAGE_BITS;
+        const DebugHookList dropped_hooks =
+            GetDebugHooks(page_table, first_vaddr, size << PAGE_BITS);
+        if (HasSpecialRegions(page_table)) {
+            std::lock_guard lock{special_regions_mutex};
+            page_table.special_regions.erase(
+                SpecialRegionMap::interval_type::right_open(first_vaddr, end << PAGE_BITS));
+            UpdateSpecialRegionCount(page_table);
+        }
+
+        page_table.RemoveMemoryRun(base << PAGE_BITS, size << PAGE_BITS);
+        if (target && type == Common::PageType::Memory) {
+            page_table.AddMemoryRun(base << PAGE_BITS, size << PAGE_BITS,
+                                    system.DeviceMemory().GetPointer(target) - (base << PAGE_BITS));
+        }
+
         if (!target) {
             ASSERT_MSG(type != Common::PageType::Memory,
                        "Mapping memory page without a pointer @ {:016x}", base * PAGE_SIZE);
@@ -615,6 +714,10 @@ struct Memory::Impl {
                 target += PAGE_SIZE;
             }
         }
+
+        for (const auto& hook : dropped_hooks) {
+            hook->OnRemap(first_vaddr, size << PAGE_BITS);
+        }
     }
 
     /**
@@ -653,6 +756,17 @@ struct Memory::Impl {
             std::memcpy(&value, host_ptr, sizeof(T));
             return value;
         }
+        case Common::PageType::Special: {
+            for (const auto& hook : GetDebugHooks(*current_page_table, vaddr, sizeof(T))) {
+                if (const auto value = ReadFromHook<T>(*hook, vaddr)) {
+                    return *value;
+                }
+            }
+            T value;
+            std::memcpy(&value, GetPointerFromSpecialMemory(*current_page_table, vaddr),
+                        sizeof(T));
+            return value;
+        }
         default:
             UNREACHABLE();
         }
@@ -688,10 +802,19 @@ struct Memory::Impl {
         case Common::PageType::Memory:
             ASSERT_MSG(false, "Mapped memory page without a pointer @ {:016X}", vaddr);
             break;
-        case Common::PageType::RasterizerCachedMemory: {
-            u8* const host_ptr{GetPointerFromRasterizerCachedMemory(vaddr)};
-            system.GPU().InvalidateRegion(vaddr, sizeof(T));
-            std::memcpy(host_ptr, &data, sizeof(T));
+        case Common::PageType::RasterizerCachedMemory:
+        case Common::PageType::Special: {
+            if (type == Common::PageType::RasterizerCachedMemory) {
+                // Cached pages may still have debug hooks
+                system.GPU().InvalidateRegion(vaddr, sizeof(T));
+            }
+            for (const auto& hook : GetDebugHooks(*current_page_table, vaddr, sizeof(T))) {
+                if (WriteToHook(*hook, vaddr, data)) {
+                    return;
+                }
+            }
+            std::memcpy(GetPointerFromSpecialMemory(*current_page_table, vaddr), &data,
+                        sizeof(T));
             break;
         }
         default:
@@ -723,6 +846,20 @@ struct Memory::Impl {
             auto* pointer = reinterpret_cast<volatile T*>(&host_ptr);
             return Common::AtomicCompareAndSwap(pointer, data, expected);
         }
+        case Common::PageType::Special: {
+            u8* const host_ptr{GetPointerFromSpecialMemory(*current_page_table, vaddr)};
+            auto* pointer = reinterpret_cast<volatile T*>(host_ptr);
+            if (!Common::AtomicCompareAndSwap(pointer, data, expected)) {
+                return false;
+            }
+            // Hooks can't take part in the exchange, they see it as a regular write afterwards
+            for (const auto& hook : GetDebugHooks(*current_page_table, vaddr, sizeof(T))) {
+                if (WriteToHook(*hook, vaddr, data)) {
+                    break;
+                }
+            }
+            return true;
+        }
         default:
             UNREACHABLE();
         }
@@ -752,13 +889,125 @@ struct Memory::Impl {
             auto* pointer = reinterpret_cast<volatile u64*>(&host_ptr);
             return Common::AtomicCompareAndSwap(pointer, data, expected);
         }
+        case Common::PageType::Special: {
+            u8* const host_ptr{GetPointerFromSpecialMemory(*current_page_table, vaddr)};
+            auto* pointer = reinterpret_cast<volatile u64*>(host_ptr);
+            if (!Common::AtomicCompareAndSwap(pointer, data, expected)) {
+                return false;
+            }
+            for (const auto& hook : GetDebugHooks(*current_page_table, vaddr, sizeof(u128))) {
+                if (hook->WriteBlock(vaddr, &data, sizeof(u128))) {
+                    break;
+                }
+            }
+            return true;
+        }
         default:
             UNREACHABLE();
         }
         return true;
     }
 
+    using SpecialRegionMap = decltype(Common::PageTable::special_regions);
+    using DebugHookList = boost::container::small_vector<Common::MemoryHookPointer, 4>;
+
+    /// Whether any page of the page table may have a hook. A single load, so that pages which only
+    /// leave the fast path for the rasterizer don't pay for the lookup while no hook exists.
+    static bool HasSpecialRegions(const Common::PageTable& page_table) {
+        return page_table.num_special_regions.load(std::memory_order_acquire) != 0;
+    }
+
+    /// Publishes the size of the special regions, special_regions_mutex must be held.
+    static void UpdateSpecialRegionCount(Common::PageTable& page_table) {
+        page_table.num_special_regions.store(page_table.special_regions.iterative_size(),
+                                             std::memory_order_release);
+    }
+
+    /// Returns the debug hooks attached to any byte of [vaddr, vaddr + size).
+    DebugHookList GetDebugHooks(const Common::PageTable& page_table, VAddr vaddr,
+                                std::size_t size) const {
+        if (!HasSpecialRegions(page_table)) {
+            return {};
+        }
+
+        DebugHookList hooks;
+
+        // Hooks are copied out so they can run without the lock held, they may access memory
+        std::lock_guard lock{special_regions_mutex};
+        const auto [begin, end] = page_table.special_regions.equal_range(
+            SpecialRegionMap::interval_type::right_open(vaddr, vaddr + size));
+        for (auto it = begin; it != end; ++it) {
+            for (const Common::SpecialRegion& region : it->second) {
+                if (region.type == Common::SpecialRegion::Type::DebugHook &&
+                    std::find(hooks.begin(), hooks.end(), region.handler) == hooks.end()) {
+                    hooks.push_back(region.handler);
+                }
+            }
+        }
+        return hooks;
+    }
+
+    bool HasDebugHook(const Common::PageTable& page_table, VAddr vaddr) const {
+        if (!HasSpecialRegions(page_table)) {
+            return false;
+        }
+        std::lock_guard lock{special_regions_mutex};
+        return page_table.special_regions.find(vaddr) != page_table.special_regions.end();
+    }
+
+    template <typename T>
+    static std::optional<T> ReadFromHook(Common::MemoryHook& hook, VAddr vaddr) {
+        if constexpr (sizeof(T) == sizeof(u8)) {
+            return hook.Read8(vaddr);
+        } else if constexpr (sizeof(T) == sizeof(u16)) {
+            return hook.Read16(vaddr);
+        } else if constexpr (sizeof(T) == sizeof(u32)) {
+            return hook.Read32(vaddr);
+        } else {
+            static_assert(sizeof(T) == sizeof(u64));
+            return hook.Read64(vaddr);
+        }
+    }
+
+    template <typename T>
+    static bool WriteToHook(Common::MemoryHook& hook, VAddr vaddr, T data) {
+        if constexpr (sizeof(T) == sizeof(u8)) {
+            return hook.Write8(vaddr, data);
+        } else if constexpr (sizeof(T) == sizeof(u16)) {
+            return hook.Write16(vaddr, data);
+        } else if constexpr (sizeof(T) == sizeof(u32)) {
+            return hook.Write32(vaddr, data);
+        } else {
+            static_assert(sizeof(T) == sizeof(u64));
+            return hook.Write64(vaddr, data);
+        }
+    }
+
+    /// Reads from a debug hooked page, size must not cross the end of the page.
+    void ReadSpecialBlock(const Common::PageTable& page_table, VAddr vaddr, void* dest_buffer,
+                          std::size_t size) {
+        for (const auto& hook : GetDebugHooks(page_table, vaddr, size)) {
+            if (hook->ReadBlock(vaddr, dest_buffer, size)) {
+                return;
+            }
+        }
+        std::memcpy(dest_buffer, GetPointerFromSpecialMemory(page_table, vaddr), size);
+    }
+
+    /// Writes to a debug hooked page, size must not cross the end of the page.
+    void WriteSpecialBlock(const Common::PageTable& page_table, VAddr vaddr,
+                           const void* src_buffer, std::size_t size) {
+        for (const auto& hook : GetDebugHooks(page_table, vaddr, size)) {
+            if (hook->WriteBlock(vaddr, src_buffer, size)) {
+                return;
+            }
+        }
+        std::memcpy(GetPointerFromSpecialMemory(page_table, vaddr), src_buffer, size);
+    }
+
     Common::PageTable* current_page_table = nullptr;
+    /// Guards the special regions of every page table, which hooks can be added to at any time
+    mutable std::mutex special_regions_mutex;
     Core::System& system;
 };
 
@@ -808,6 +1057,10 @@ const u8* Memory::GetPointer(VAddr vaddr) const {
     return impl->GetPointer(vaddr);
 }
 
+u8* Memory::GetContiguousPointer(const Kernel::Process& process, VAddr vaddr, std::size_t size) {
+    return impl->GetContiguousPointer(process, vaddr, size);
+}
+
 u8 Memory::Read8(const VAddr addr) {
     return impl->Read8(addr);
 }
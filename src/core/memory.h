@@ -160,6 +160,20 @@ public:
      */
     const u8* GetPointer(VAddr vaddr) const;
 
+    /**
+     * Gets a pointer to a range of a process' address space, provided the whole range is regular
+     * memory backed by contiguous host memory.
+     *
+     * @param process The process to look the range up in.
+     * @param vaddr   Virtual address of the start of the range.
+     * @param size    Size of the range in bytes.
+     *
+     * @returns A pointer to the start of the range, which stays valid until the range is remapped.
+     *          If any page of the range is unmapped, rasterizer cached or not contiguous with the
+     *          previous one, nullptr will be returned.
+     */
+    u8* GetContiguousPointer(const Kernel::Process& process, VAddr vaddr, std::size_t size);
+
     /**
      * Reads an 8-bit unsigned value from the current process' address space
      * at the given virtual address.
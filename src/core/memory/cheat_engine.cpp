@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <cstring>
 #include <locale>
 #include "common/hex_util.h"
 #include "common/microprofile.h"
@@ -43,11 +44,25 @@ StandardVmCallbacks::StandardVmCallbacks(Core::System& system, const CheatProces
 StandardVmCallbacks::~StandardVmCallbacks() = default;
 
 void StandardVmCallbacks::MemoryRead(VAddr address, void* data, u64 size) {
-    system.Memory().ReadBlock(SanitizeAddress(address), data, size);
+    const VAddr sanitized = SanitizeAddress(address);
+    // Plain memory is accessed through the page table directly, cached and hooked pages have no
+    // pointer there and go through the slow path.
+    if (const u8* const pointer =
+            system.Memory().GetContiguousPointer(*system.CurrentProcess(), sanitized, size)) {
+        std::memcpy(data, pointer, size);
+        return;
+    }
+    system.Memory().ReadBlock(sanitized, data, size);
 }
 
 void StandardVmCallbacks::MemoryWrite(VAddr address, const void* data, u64 size) {
-    system.Memory().WriteBlock(SanitizeAddress(address), data, size);
+    const VAddr sanitized = SanitizeAddress(address);
+    if (u8* const pointer =
+            system.Memory().GetContiguousPointer(*system.CurrentProcess(), sanitized, size)) {
+        std::memcpy(pointer, data, size);
+        return;
+    }
+    system.Memory().WriteBlock(sanitized, data, size);
 }
 
 u64 StandardVmCallbacks::HidKeysDown() {
@@ -641,8 +641,57 @@ bool DmntCheatVm::DecodeNextOpcode(CheatVmOpcode& out) {
     return valid;
 }
 
+bool DmntCheatVm::FetchNextOpcode(const CheatVmOpcode*& out) {
+    if (!use_predecoded_program) {
+        if (!DecodeNextOpcode(scratch_opcode)) {
+            return false;
+        }
+        out = &scratch_opcode;
+        return true;
+    }
+
+    if (instruction_ptr >= decoded_program.size()) {
+        return false;
+    }
+    out = &decoded_program[instruction_ptr++].opcode;
+    return true;
+}
+
+void DmntCheatVm::PredecodeProgram() {
+    decoded_program.clear();
+    instruction_ptr = 0;
+    decode_success = true;
+
+    // Decoding stops at the first invalid instruction, which is also where the interpreter would
+    // stop, whether it reaches it by executing or by skipping a conditional block.
+    std::vector<std::size_t> open_blocks;
+    CheatVmOpcode opcode{};
+    while (DecodeNextOpcode(opcode)) {
+        const std::size_t index = decoded_program.size();
+        if (opcode.begin_conditional_block) {
+            open_blocks.push_back(index);
+        } else if (std::holds_alternative<EndConditionalOpcode>(opcode.opcode) &&
+                   !open_blocks.empty()) {
+            decoded_program[open_blocks.back()].skip_target = index + 1;
+            open_blocks.pop_back();
+        }
+        decoded_program.push_back({opcode, 0});
+    }
+
+    // Blocks that are never closed are skipped until the end of the program.
+    for (const std::size_t index : open_blocks) {
+        decoded_program[index].skip_target = decoded_program.size();
+    }
+
+    instruction_ptr = 0;
+}
+
 void DmntCheatVm::SkipConditionalBlock() {
-    if (condition_depth > 0) {
+    if (use_predecoded_program && condition_depth > 0) {
+        // The conditional instruction was the last one fetched.
+        instruction_ptr = decoded_program[instruction_ptr - 1].skip_target;
+        condition_depth--;
+    } else if (condition_depth > 0) {
         // We want to continue until we're out of the current block.
         const std::size_t desired_depth = condition_depth - 1;
 
@@ -717,6 +766,7 @@ bool DmntCheatVm::LoadProgram(const std::vector<CheatEntry>& entries) {
             // Bounds check.
             if (entries[i].definition.num_opcodes + num_opcodes > MaximumProgramOpcodeCount) {
                 num_opcodes = 0;
+                decoded_program.clear();
                 return false;
             }
 
@@ -726,11 +776,12 @@ bool DmntCheatVm::LoadProgram(const std::vector<CheatEntry>& entries) {
         }
     }
 
+    PredecodeProgram();
     return true;
 }
 
 void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
-    CheatVmOpcode cur_opcode{};
+    const CheatVmOpcode* cur_opcode = nullptr;
 
     // Get Keys down.
     u64 kDown = callbacks->HidKeysDown();
@@ -744,7 +795,10 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
     ResetState();
 
     // Loop until program finishes.
-    while (DecodeNextOpcode(cur_opcode)) {
+    while (FetchNextOpcode(cur_opcode)) {
+#ifdef _DEBUG
+        // Formatting the whole VM state for every instruction costs far more than executing it,
+        // so like trace logging it is only done in debug builds.
         callbacks->CommandLog(
             fmt::format("Instruction Ptr: {:04X}", static_cast<u32>(instruction_ptr)));
 
@@ -755,14 +809,15 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
         for (std::size_t i = 0; i < NumRegisters; i++) {
             callbacks->CommandLog(fmt::format("SavedRegs[{:02X}]: {:016X}", i, saved_values[i]));
         }
-        LogOpcode(cur_opcode);
+        LogOpcode(*cur_opcode);
+#endif
 
         // Increment conditional depth, if relevant.
-        if (cur_opcode.begin_conditional_block) {
+        if (cur_opcode->begin_conditional_block) {
             condition_depth++;
         }
 
-        if (auto store_static = std::get_if<StoreStaticOpcode>(&cur_opcode.opcode)) {
+        if (auto store_static = std::get_if<StoreStaticOpcode>(&cur_opcode->opcode)) {
             // Calculate address, write value to memory.
             u64 dst_address = GetCheatProcessAddress(metadata, store_static->mem_type,
                                                      store_static->rel_address +
@@ -776,12 +831,12 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
                 callbacks->MemoryWrite(dst_address, &dst_value, store_static->bit_width);
                 break;
             }
-        } else if (auto begin_cond = std::get_if<BeginConditionalOpcode>(&cur_opcode.opcode)) {
+        } else if (auto begin_cond = std::get_if<BeginConditionalOpcode>(&cur_opcode->opcode)) {
             // Read value from memory.
             u64 src_address =
                 GetCheatProcessAddress(metadata, begin_cond->mem_type, begin_cond->rel_address);
             u64 src_value = 0;
-            switch (store_static->bit_width) {
+            switch (begin_cond->bit_width) {
             case 1:
             case 2:
             case 4:
@@ -816,13 +871,13 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
             if (!cond_met) {
                 SkipConditionalBlock();
             }
-        } else if (std::holds_alternative<EndConditionalOpcode>(cur_opcode.opcode)) {
+        } else if (std::holds_alternative<EndConditionalOpcode>(cur_opcode->opcode)) {
             // Decrement the condition depth.
             // We will assume, graciously, that mismatched conditional block ends are a nop.
             if (condition_depth > 0) {
                 condition_depth--;
             }
-        } else if (auto ctrl_loop = std::get_if<ControlLoopOpcode>(&cur_opcode.opcode)) {
+        } else if (auto ctrl_loop = std::get_if<ControlLoopOpcode>(&cur_opcode->opcode)) {
             if (ctrl_loop->start_loop) {
                 // Start a loop.
                 registers[ctrl_loop->reg_index] = ctrl_loop->num_iters;
@@ -834,10 +889,10 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
                     instruction_ptr = loop_tops[ctrl_loop->reg_index];
                 }
             }
-        } else if (auto ldr_static = std::get_if<LoadRegisterStaticOpcode>(&cur_opcode.opcode)) {
+        } else if (auto ldr_static = std::get_if<LoadRegisterStaticOpcode>(&cur_opcode->opcode)) {
             // Set a register to a static value.
             registers[ldr_static->reg_index] = ldr_static->value;
-        } else if (auto ldr_memory = std::get_if<LoadRegisterMemoryOpcode>(&cur_opcode.opcode)) {
+        } else if (auto ldr_memory = std::get_if<LoadRegisterMemoryOpcode>(&cur_opcode->opcode)) {
             // Choose source address.
             u64 src_address;
             if (ldr_memory->load_from_reg) {
@@ -856,7 +911,7 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
                                       ldr_memory->bit_width);
                 break;
             }
-        } else if (auto str_static = std::get_if<StoreStaticToAddressOpcode>(&cur_opcode.opcode)) {
+        } else if (auto str_static = std::get_if<StoreStaticToAddressOpcode>(&cur_opcode->opcode)) {
             // Calculate address.
             u64 dst_address = registers[str_static->reg_index];
             u64 dst_value = str_static->value;
@@ -877,7 +932,7 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
                 registers[str_static->reg_index] += str_static->bit_width;
             }
         } else if (auto perform_math_static =
-                       std::get_if<PerformArithmeticStaticOpcode>(&cur_opcode.opcode)) {
+                       std::get_if<PerformArithmeticStaticOpcode>(&cur_opcode->opcode)) {
             // Do requested math.
             switch (perform_math_static->math_type) {
             case RegisterArithmeticType::Addition:
@@ -924,14 +979,14 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
                 break;
             }
         } else if (auto begin_keypress_cond =
-                       std::get_if<BeginKeypressConditionalOpcode>(&cur_opcode.opcode)) {
+                       std::get_if<BeginKeypressConditionalOpcode>(&cur_opcode->opcode)) {
             // Check for keypress.
             if ((begin_keypress_cond->key_mask & kDown) != begin_keypress_cond->key_mask) {
                 // Keys not pressed. Skip conditional block.
                 SkipConditionalBlock();
             }
         } else if (auto perform_math_reg =
-                       std::get_if<PerformArithmeticRegisterOpcode>(&cur_opcode.opcode)) {
+                       std::get_if<PerformArithmeticRegisterOpcode>(&cur_opcode->opcode)) {
             const u64 operand_1_value = registers[perform_math_reg->src_reg_1_index];
             const u64 operand_2_value =
                 perform_math_reg->has_immediate
@@ -992,7 +1047,7 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
             // Save to register.
             registers[perform_math_reg->dst_reg_index] = res_val;
         } else if (auto str_register =
-                       std::get_if<StoreRegisterToAddressOpcode>(&cur_opcode.opcode)) {
+                       std::get_if<StoreRegisterToAddressOpcode>(&cur_opcode->opcode)) {
             // Calculate address.
             u64 dst_value = registers[str_register->str_reg_index];
             u64 dst_address = registers[str_register->addr_reg_index];
@@ -1036,7 +1091,7 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
                 registers[str_register->addr_reg_index] += str_register->bit_width;
             }
         } else if (auto begin_reg_cond =
-                       std::get_if<BeginRegisterConditionalOpcode>(&cur_opcode.opcode)) {
+                       std::get_if<BeginRegisterConditionalOpcode>(&cur_opcode->opcode)) {
             // Get value from register.
             u64 src_value = 0;
             switch (begin_reg_cond->bit_width) {
@@ -1139,7 +1194,7 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
                 SkipConditionalBlock();
             }
         } else if (auto save_restore_reg =
-                       std::get_if<SaveRestoreRegisterOpcode>(&cur_opcode.opcode)) {
+                       std::get_if<SaveRestoreRegisterOpcode>(&cur_opcode->opcode)) {
             // Save or restore a register.
             switch (save_restore_reg->op_type) {
             case SaveRestoreRegisterOpType::ClearRegs:
@@ -1157,7 +1212,7 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
                 break;
             }
         } else if (auto save_restore_regmask =
-                       std::get_if<SaveRestoreRegisterMaskOpcode>(&cur_opcode.opcode)) {
+                       std::get_if<SaveRestoreRegisterMaskOpcode>(&cur_opcode->opcode)) {
             // Save or restore register mask.
             u64* src;
             u64* dst;
@@ -1190,7 +1245,7 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
                 }
             }
         } else if (auto rw_static_reg =
-                       std::get_if<ReadWriteStaticRegisterOpcode>(&cur_opcode.opcode)) {
+                       std::get_if<ReadWriteStaticRegisterOpcode>(&cur_opcode->opcode)) {
             if (rw_static_reg->static_idx < NumReadableStaticRegisters) {
                 // Load a register with a static register.
                 registers[rw_static_reg->idx] = static_registers[rw_static_reg->static_idx];
@@ -1198,7 +1253,7 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
                 // Store a register to a static register.
                 static_registers[rw_static_reg->static_idx] = registers[rw_static_reg->idx];
             }
-        } else if (auto debug_log = std::get_if<DebugLogOpcode>(&cur_opcode.opcode)) {
+        } else if (auto debug_log = std::get_if<DebugLogOpcode>(&cur_opcode->opcode)) {
             // Read value from memory.
             u64 log_value = 0;
             if (debug_log->val_type == DebugLogValueType::RegisterValue) {
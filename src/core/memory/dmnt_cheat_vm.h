@@ -303,7 +303,19 @@ public:
     bool LoadProgram(const std::vector<CheatEntry>& cheats);
     void Execute(const CheatProcessMetadata& metadata);
 
+    /// Selects whether Execute runs the program decoded by LoadProgram or decodes every
+    /// instruction as it goes. Both behave the same, the latter is kept for comparison.
+    void SetUsePredecodedProgram(bool enabled) {
+        use_predecoded_program = enabled;
+    }
+
 private:
+    struct DecodedInstruction {
+        CheatVmOpcode opcode;
+        /// For conditional blocks, the index following the matching EndConditional
+        std::size_t skip_target;
+    };
+
     std::unique_ptr<Callbacks> callbacks;
 
     std::size_t num_opcodes = 0;
@@ -316,7 +328,15 @@ private:
     std::array<u64, NumStaticRegisters> static_registers{};
     std::array<std::size_t, NumRegisters> loop_tops{};
 
+    /// Every instruction of the program up to the first one that fails to decode. When it is
+    /// used, instruction_ptr and loop_tops hold indices into it instead of dword offsets.
+    std::vector<DecodedInstruction> decoded_program;
+    bool use_predecoded_program = true;
+    CheatVmOpcode scratch_opcode{};
+
     bool DecodeNextOpcode(CheatVmOpcode& out);
+    bool FetchNextOpcode(const CheatVmOpcode*& out);
+    void PredecodeProgram();
     void SkipConditionalBlock();
     void ResetState();
 
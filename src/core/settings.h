@@ -19,6 +19,7 @@ namespace Settings {
 enum class RendererBackend {
     OpenGL = 0,
     Vulkan = 1,
+    Null = 2,
 };
 
 enum class GPUAccuracy : u32 {
@@ -180,6 +181,8 @@ struct Values {
     bool reporting_services;
     bool quest_flag;
     bool disable_macro_jit;
+    bool enable_hle_functions = false;
+    u32 rewind_frames;
 
     // Misceallaneous
     std::string log_filter;
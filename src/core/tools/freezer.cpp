@@ -4,18 +4,13 @@
 
 #include "common/assert.h"
 #include "common/logging/log.h"
-#include "core/core.h"
-#include "core/core_timing.h"
-#include "core/core_timing_util.h"
-#include "core/hardware_properties.h"
 #include "core/memory.h"
 #include "core/tools/freezer.h"
+#include "core/tools/memory_watcher.h"
 
 namespace Tools {
 namespace {
 
-constexpr auto memory_freezer_ns = std::chrono::nanoseconds{1000000000 / 60};
-
 u64 MemoryReadWidth(Core::Memory::Memory& memory, u32 width, VAddr addr) {
     switch (width) {
     case 1:
@@ -53,24 +48,18 @@ void MemoryWriteWidth(Core::Memory::Memory& memory, u32 width, VAddr addr, u64 v
 
 } // Anonymous namespace
 
-Freezer::Freezer(Core::Timing::CoreTiming& core_timing_, Core::Memory::Memory& memory_)
-    : core_timing{core_timing_}, memory{memory_} {
-    event = Core::Timing::CreateEvent(
-        "MemoryFreezer::FrameCallback",
-        [this](std::uintptr_t user_data, std::chrono::nanoseconds ns_late) {
-            FrameCallback(user_data, ns_late);
-        });
-    core_timing.ScheduleEvent(memory_freezer_ns, event);
-}
+Freezer::Freezer(Core::Memory::Memory& memory_, MemoryWatcher& watcher_)
+    : memory{memory_}, watcher{watcher_} {}
 
 Freezer::~Freezer() {
-    core_timing.UnscheduleEvent(event, 0);
+    RemoveWatches();
+    // Callbacks that are already running still refer to this freezer
+    watcher.WaitForCallbacks();
 }
 
 void Freezer::SetActive(bool active) {
     if (!this->active.exchange(active)) {
         FillEntryReads();
-        core_timing.ScheduleEvent(memory_freezer_ns, event);
         LOG_DEBUG(Common_Memory, "Memory freezer activated!");
     } else {
         LOG_DEBUG(Common_Memory, "Memory freezer deactivated!");
@@ -82,18 +71,24 @@ bool Freezer::IsActive() const {
 }
 
 void Freezer::Clear() {
-    std::lock_guard lock{entries_mutex};
-
     LOG_DEBUG(Common_Memory, "Clearing all frozen memory values.");
 
-    entries.clear();
+    RemoveWatches();
 }
 
 u64 Freezer::Freeze(VAddr address, u32 width) {
     std::lock_guard lock{entries_mutex};
 
     const auto current_value = MemoryReadWidth(memory, width, address);
-    entries.push_back({address, width, current_value});
+    const auto iter = entries.find(address);
+    if (iter != entries.end()) {
+        watcher.RemoveWatch(iter->second.watch);
+        entries.erase(iter);
+    }
+
+    const u64 watch = watcher.AddWatch(
+        address, width, [this](VAddr watch_address, u64) { return OnWrite(watch_address); });
+    entries.emplace(address, FrozenEntry{{address, width, current_value}, watch});
 
     LOG_DEBUG(Common_Memory,
               "Freezing memory for address={:016X}, width={:02X}, current_value={:016X}", address,
@@ -107,76 +102,87 @@ void Freezer::Unfreeze(VAddr address) {
 
     LOG_DEBUG(Common_Memory, "Unfreezing memory for address={:016X}", address);
 
-    std::erase_if(entries, [address](const Entry& entry) { return entry.address == address; });
+    const auto iter = entries.find(address);
+    if (iter != entries.end()) {
+        watcher.RemoveWatch(iter->second.watch);
+        entries.erase(iter);
+    }
 }
 
 bool Freezer::IsFrozen(VAddr address) const {
     std::lock_guard lock{entries_mutex};
 
-    return FindEntry(address) != entries.cend();
+    return entries.contains(address);
 }
 
 void Freezer::SetFrozenValue(VAddr address, u64 value) {
-    std::lock_guard lock{entries_mutex};
+    u32 width;
+    {
+        std::lock_guard lock{entries_mutex};
 
-    const auto iter = FindEntry(address);
+        const auto iter = entries.find(address);
 
-    if (iter == entries.cend()) {
-        LOG_ERROR(Common_Memory,
-                  "Tried to set freeze value for address={:016X} that is not frozen!", address);
-        return;
+        if (iter == entries.cend()) {
+            LOG_ERROR(Common_Memory,
+                      "Tried to set freeze value for address={:016X} that is not frozen!",
+                      address);
+            return;
+        }
+
+        Entry& entry = iter->second.entry;
+        LOG_DEBUG(Common_Memory,
+                  "Manually overridden freeze value for address={:016X}, width={:02X} to "
+                  "value={:016X}",
+                  entry.address, entry.width, value);
+        entry.value = value;
+        width = entry.width;
     }
 
-    LOG_DEBUG(Common_Memory,
-              "Manually overridden freeze value for address={:016X}, width={:02X} to value={:016X}",
-              iter->address, iter->width, value);
-    iter->value = value;
+    // Nothing else writes the new value, and the write has to happen without the lock held since
+    // it runs the watch callback
+    if (IsActive()) {
+        MemoryWriteWidth(memory, width, address, value);
+    }
 }
 
 std::optional<Freezer::Entry> Freezer::GetEntry(VAddr address) const {
     std::lock_guard lock{entries_mutex};
 
-    const auto iter = FindEntry(address);
+    const auto iter = entries.find(address);
 
     if (iter == entries.cend()) {
         return std::nullopt;
     }
 
-    return *iter;
+    return iter->second.entry;
 }
 
 std::vector<Freezer::Entry> Freezer::GetEntries() const {
     std::lock_guard lock{entries_mutex};
 
-    return entries;
-}
-
-Freezer::Entries::iterator Freezer::FindEntry(VAddr address) {
-    return std::find_if(entries.begin(), entries.end(),
-                        [address](const Entry& entry) { return entry.address == address; });
-}
-
-Freezer::Entries::const_iterator Freezer::FindEntry(VAddr address) const {
-    return std::find_if(entries.begin(), entries.end(),
-                        [address](const Entry& entry) { return entry.address == address; });
+    std::vector<Entry> out;
+    out.reserve(entries.size());
+    for (const auto& [address, frozen] : entries) {
+        out.push_back(frozen.entry);
+    }
+    return out;
 }
 
-void Freezer::FrameCallback(std::uintptr_t, std::chrono::nanoseconds ns_late) {
+std::optional<u64> Freezer::OnWrite(VAddr address) {
     if (!IsActive()) {
-        LOG_DEBUG(Common_Memory, "Memory freezer has been deactivated, ending callback events.");
-        return;
+        return std::nullopt;
     }
 
     std::lock_guard lock{entries_mutex};
 
-    for (const auto& entry : entries) {
-        LOG_DEBUG(Common_Memory,
-                  "Enforcing memory freeze at address={:016X}, value={:016X}, width={:02X}",
-                  entry.address, entry.value, entry.width);
-        MemoryWriteWidth(memory, entry.width, entry.address, entry.value);
+    const auto iter = entries.find(address);
+    if (iter == entries.cend()) {
+        return std::nullopt;
     }
 
-    core_timing.ScheduleEvent(memory_freezer_ns - ns_late, event);
+    LOG_TRACE(Common_Memory, "Enforcing memory freeze at address={:016X}, value={:016X}",
+              address, iter->second.entry.value);
+    return iter->second.entry.value;
 }
 
 void Freezer::FillEntryReads() {
@@ -184,9 +190,18 @@ void Freezer::FillEntryReads() {
 
     LOG_DEBUG(Common_Memory, "Updating memory freeze entries to current values.");
 
-    for (auto& entry : entries) {
-        entry.value = MemoryReadWidth(memory, entry.width, entry.address);
+    for (auto& [address, frozen] : entries) {
+        frozen.entry.value = MemoryReadWidth(memory, frozen.entry.width, address);
     }
 }
 
+void Freezer::RemoveWatches() {
+    std::lock_guard lock{entries_mutex};
+
+    for (const auto& [address, frozen] : entries) {
+        watcher.RemoveWatch(frozen.watch);
+    }
+    entries.clear();
+}
+
 } // namespace Tools
@@ -5,24 +5,20 @@
 #pragma once
 
 #include <atomic>
-#include <chrono>
-#include <memory>
+#include <map>
 #include <mutex>
 #include <optional>
 #include <vector>
 #include "common/common_types.h"
 
-namespace Core::Timing {
-class CoreTiming;
-struct EventType;
-} // namespace Core::Timing
-
 namespace Core::Memory {
 class Memory;
 }
 
 namespace Tools {
 
+class MemoryWatcher;
+
 /**
  * This class allows the user to prevent an application from writing new values to certain memory
  * locations. This has a variety of uses when attempting to reverse a game.
@@ -30,6 +26,8 @@ namespace Tools {
  * One example could be a cheat to prevent Mario from taking damage in SMO. One could freeze the
  * memory address that the game uses to store Mario's health so when he takes damage (and the game
  * tries to write the new health value to memory), the value won't change.
+ *
+ * Every frozen address is watched, so a write is undone as soon as it happens.
  */
 class Freezer {
 public:
@@ -39,7 +37,7 @@ public:
         u64 value;
     };
 
-    explicit Freezer(Core::Timing::CoreTiming& core_timing_, Core::Memory::Memory& memory_);
+    explicit Freezer(Core::Memory::Memory& memory_, MemoryWatcher& watcher_);
     ~Freezer();
 
     // Enables or disables the entire memory freezer.
@@ -73,22 +71,25 @@ public:
     std::vector<Entry> GetEntries() const;
 
 private:
-    using Entries = std::vector<Entry>;
+    struct FrozenEntry {
+        Entry entry;
+        u64 watch;
+    };
 
-    Entries::iterator FindEntry(VAddr address);
-    Entries::const_iterator FindEntry(VAddr address) const;
+    using Entries = std::map<VAddr, FrozenEntry>;
 
-    void FrameCallback(std::uintptr_t user_data, std::chrono::nanoseconds ns_late);
+    /// Returns the value a write to a frozen address is replaced with.
+    std::optional<u64> OnWrite(VAddr address);
     void FillEntryReads();
+    void RemoveWatches();
 
     std::atomic_bool active{false};
 
     mutable std::mutex entries_mutex;
     Entries entries;
 
-    std::shared_ptr<Core::Timing::EventType> event;
-    Core::Timing::CoreTiming& core_timing;
     Core::Memory::Memory& memory;
+    MemoryWatcher& watcher;
 };
 
 } // namespace Tools
@@ -0,0 +1,381 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+
+#include <fmt/format.h>
+
+#include "common/file_util.h"
+#include "common/logging/log.h"
+#include "core/arm/arm_interface.h"
+#include "core/core.h"
+#include "core/core_timing.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/memory/page_table.h"
+#include "core/hle/kernel/physical_core.h"
+#include "core/hle/kernel/process.h"
+#include "core/memory.h"
+#include "core/tools/guest_profiler.h"
+
+namespace Tools {
+namespace {
+
+using BacktraceEntry = Core::ARM_Interface::BacktraceEntry;
+
+/// Reads an aligned word of the process' memory. Unlike Memory::Read64 this doesn't log on unmapped
+/// addresses, flush rasterizer caches or trigger debug hooks and watchers.
+std::optional<u64> Peek64(const Core::Memory::Memory& memory, const Kernel::Process& process,
+                          VAddr vaddr) {
+    // Aligned words never cross a page
+    const auto& page_table = process.PageTable().PageTableImpl();
+    if ((vaddr & 7) != 0 || (vaddr >> Core::Memory::PAGE_BITS) >= page_table.pointers.size()) {
+        return std::nullopt;
+    }
+    const u8* const pointer = memory.GetPointer(vaddr);
+    if (pointer == nullptr) {
+        return std::nullopt;
+    }
+    u64 value;
+    std::memcpy(&value, pointer, sizeof(value));
+    return value;
+}
+
+/// Every sampled address resolved to its module and symbol
+struct Symbolized {
+    std::vector<BacktraceEntry> entries;
+    std::unordered_map<VAddr, std::size_t> index;
+
+    const BacktraceEntry& Get(VAddr address) const {
+        return entries[index.at(address)];
+    }
+};
+
+Symbolized Symbolize(const GuestProfiler::Samples& samples,
+                     const GuestProfiler::Symbolizer& symbolizer) {
+    Symbolized result;
+    for (const auto& [stack, count] : samples) {
+        for (const VAddr address : stack) {
+            if (result.index.try_emplace(address, result.entries.size()).second) {
+                result.entries.push_back({"", 0, address, 0, ""});
+            }
+        }
+    }
+    if (!symbolizer(result.entries)) {
+        for (BacktraceEntry& entry : result.entries) {
+            entry.module = "unknown";
+            entry.offset = entry.original_address;
+        }
+    }
+    return result;
+}
+
+std::string FunctionName(const BacktraceEntry& entry) {
+    if (entry.name.empty()) {
+        return fmt::format("{}+0x{:x}", entry.module, entry.offset);
+    }
+    return fmt::format("{}!{}", entry.module, entry.name);
+}
+
+/// Just enough of the protobuf wire format to write a pprof profile
+class ProtoWriter {
+public:
+    void Varint(u32 field, u64 value) {
+        Key(field, 0);
+        Raw(value);
+    }
+
+    void Bytes(u32 field, std::string_view bytes) {
+        Key(field, 2);
+        Raw(bytes.size());
+        data.append(bytes);
+    }
+
+    void Message(u32 field, const ProtoWriter& message) {
+        Bytes(field, message.data);
+    }
+
+    void PackedVarints(u32 field, const std::vector<u64>& values) {
+        ProtoWriter packed;
+        for (const u64 value : values) {
+            packed.Raw(value);
+        }
+        Bytes(field, packed.data);
+    }
+
+    const std::string& Data() const {
+        return data;
+    }
+
+private:
+    void Key(u32 field, u32 wire_type) {
+        Raw((u64{field} << 3) | wire_type);
+    }
+
+    void Raw(u64 value) {
+        while (value >= 0x80) {
+            data.push_back(static_cast<char>(value | 0x80));
+            value >>= 7;
+        }
+        data.push_back(static_cast<char>(value));
+    }
+
+    std::string data;
+};
+
+} // Anonymous namespace
+
+GuestProfiler::GuestProfiler(Core::System& system_) : system{system_} {
+    sample_event = Core::Timing::CreateEvent(
+        "GuestProfilerSample",
+        [this](std::uintptr_t, std::chrono::nanoseconds ns_late) { RequestSamples(ns_late); });
+}
+
+GuestProfiler::~GuestProfiler() = default;
+
+void GuestProfiler::Start(std::chrono::microseconds interval_) {
+    Stop();
+    {
+        std::scoped_lock lock{samples_mutex};
+        samples.clear();
+        sample_count = 0;
+    }
+    interval = interval_;
+    is_active.store(true, std::memory_order_release);
+    system.CoreTiming().ScheduleEvent(interval, sample_event);
+}
+
+void GuestProfiler::Stop() {
+    if (!is_active.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    system.CoreTiming().UnscheduleEvent(sample_event, 0);
+    for (auto& requested : sample_requested) {
+        requested.store(false, std::memory_order_release);
+    }
+}
+
+u64 GuestProfiler::GetSampleCount() const {
+    std::scoped_lock lock{samples_mutex};
+    return sample_count;
+}
+
+void GuestProfiler::RequestSamples(std::chrono::nanoseconds ns_late) {
+    if (!IsActive()) {
+        return;
+    }
+    auto& kernel = system.Kernel();
+    for (std::size_t core = 0; core < sample_requested.size(); ++core) {
+        sample_requested[core].store(true, std::memory_order_release);
+        // Single core mode returns from the JIT at every timing event on its own. An idle core
+        // wakes up, finds nothing to switch to and goes back to sleep.
+        if (kernel.IsMulticore()) {
+            kernel.PhysicalCore(core).Interrupt();
+        }
+    }
+    system.CoreTiming().ScheduleEvent(std::max(interval - ns_late, std::chrono::nanoseconds{0}),
+                                      sample_event);
+}
+
+void GuestProfiler::Sample(Core::ARM_Interface& arm_interface) {
+    const Kernel::Process* const process = system.CurrentProcess();
+    if (process == nullptr) {
+        return;
+    }
+
+    Stack stack;
+    stack.push_back(arm_interface.GetPC());
+    if (process->Is64BitProcess()) {
+        // Frame records are {previous fp, lr}, the call is the instruction before lr
+        const auto& memory = system.Memory();
+        VAddr fp = arm_interface.GetReg(29);
+        while (stack.size() < MAX_DEPTH && fp != 0) {
+            const std::optional<u64> lr = Peek64(memory, *process, fp + 8);
+            if (!lr || *lr == 0) {
+                break;
+            }
+            stack.push_back(*lr - 4);
+            const std::optional<u64> previous_fp = Peek64(memory, *process, fp);
+            if (!previous_fp || *previous_fp <= fp) {
+                break;
+            }
+            fp = *previous_fp;
+        }
+    }
+
+    std::scoped_lock lock{samples_mutex};
+    ++samples[std::move(stack)];
+    ++sample_count;
+}
+
+bool GuestProfiler::WriteCollapsedStacks(const std::string& path) const {
+    std::string out;
+    u64 count;
+    {
+        std::scoped_lock lock{samples_mutex};
+        out = CollapseStacks(samples, [this](std::vector<BacktraceEntry>& entries) {
+            return Core::ARM_Interface::SymbolizeBacktrace(system, entries);
+        });
+        count = sample_count;
+    }
+
+    Common::FS::IOFile file(path, "w");
+    if (!file.IsOpen() || file.WriteString(out) != out.size()) {
+        LOG_ERROR(Core, "Could not write profile {}", path);
+        return false;
+    }
+    LOG_INFO(Core, "Wrote {} samples to {}", count, path);
+    return true;
+}
+
+bool GuestProfiler::WritePprof(const std::string& path) const {
+    std::string data;
+    u64 count;
+    {
+        std::scoped_lock lock{samples_mutex};
+        data = EncodePprof(samples, interval, [this](std::vector<BacktraceEntry>& entries) {
+            return Core::ARM_Interface::SymbolizeBacktrace(system, entries);
+        });
+        count = sample_count;
+    }
+
+    Common::FS::IOFile file(path, "wb");
+    if (!file.IsOpen() || file.WriteBytes(data.data(), data.size()) != data.size()) {
+        LOG_ERROR(Core, "Could not write profile {}", path);
+        return false;
+    }
+    LOG_INFO(Core, "Wrote {} samples to {}", count, path);
+    return true;
+}
+
+std::string GuestProfiler::CollapseStacks(const Samples& samples, const Symbolizer& symbolizer) {
+    const Symbolized symbolized = Symbolize(samples, symbolizer);
+
+    // Different addresses of the same function make the same line
+    std::map<std::string, u64> lines;
+    for (const auto& [stack, count] : samples) {
+        std::string line;
+        for (auto it = stack.rbegin(); it != stack.rend(); ++it) {
+            if (!line.empty()) {
+                line += ';';
+            }
+            line += FunctionName(symbolized.Get(*it));
+        }
+        lines[std::move(line)] += count;
+    }
+
+    std::string out;
+    for (const auto& [line, count] : lines) {
+        out += fmt::format("{} {}\n", line, count);
+    }
+    return out;
+}
+
+std::string GuestProfiler::EncodePprof(const Samples& samples, std::chrono::nanoseconds interval,
+                                       const Symbolizer& symbolizer) {
+    const Symbolized symbolized = Symbolize(samples, symbolizer);
+
+    std::vector<std::string> strings{""};
+    std::unordered_map<std::string, u64> string_index{{"", 0}};
+    const auto intern = [&](const std::string& string) {
+        const auto [it, inserted] = string_index.try_emplace(string, strings.size());
+        if (inserted) {
+            strings.push_back(string);
+        }
+        return it->second;
+    };
+
+    ProtoWriter profile;
+    const auto value_type = [&](std::string_view type, std::string_view unit) {
+        ProtoWriter message;
+        message.Varint(1, intern(std::string(type)));
+        message.Varint(2, intern(std::string(unit)));
+        return message;
+    };
+    profile.Message(1, value_type("samples", "count"));
+    profile.Message(1, value_type("cpu", "nanoseconds"));
+
+    // Ids are one based, location ids follow the order of the symbolized entries
+    const u64 period = static_cast<u64>(interval.count());
+    u64 total_count = 0;
+    for (const auto& [stack, count] : samples) {
+        total_count += count;
+        std::vector<u64> locations;
+        for (const VAddr address : stack) {
+            locations.push_back(symbolized.index.at(address) + 1);
+        }
+        ProtoWriter sample;
+        sample.PackedVarints(1, locations);
+        sample.PackedVarints(2, {count, count * period});
+        profile.Message(2, sample);
+    }
+
+    // One mapping per module, spanning the addresses sampled in it
+    struct Mapping {
+        u64 id;
+        VAddr start;
+        VAddr limit;
+    };
+    std::map<std::string, Mapping> mappings;
+    for (const BacktraceEntry& entry : symbolized.entries) {
+        const VAddr base = entry.original_address - entry.offset;
+        const auto [it, inserted] = mappings.try_emplace(
+            entry.module, Mapping{mappings.size() + 1, base, entry.original_address + 4});
+        it->second.limit = std::max(it->second.limit, entry.original_address + 4);
+    }
+    for (const auto& [module, mapping] : mappings) {
+        ProtoWriter message;
+        message.Varint(1, mapping.id);
+        message.Varint(2, mapping.start);
+        message.Varint(3, mapping.limit);
+        message.Varint(5, intern(module));
+        // Symbols are already resolved, there is no binary for pprof to look at
+        message.Varint(7, 1);
+        profile.Message(3, message);
+    }
+
+    std::unordered_map<std::string, u64> function_ids;
+    std::vector<std::pair<u64, const BacktraceEntry*>> functions;
+    for (std::size_t i = 0; i < symbolized.entries.size(); ++i) {
+        const BacktraceEntry& entry = symbolized.entries[i];
+        const auto [it, inserted] =
+            function_ids.try_emplace(FunctionName(entry), function_ids.size() + 1);
+        if (inserted) {
+            functions.emplace_back(it->second, &entry);
+        }
+
+        ProtoWriter line;
+        line.Varint(1, it->second);
+        ProtoWriter location;
+        location.Varint(1, i + 1);
+        location.Varint(2, mappings.at(entry.module).id);
+        location.Varint(3, entry.original_address);
+        location.Message(4, line);
+        profile.Message(4, location);
+    }
+    for (const auto& [id, entry] : functions) {
+        const u64 name = intern(entry->name.empty() ? FunctionName(*entry) : entry->name);
+        ProtoWriter function;
+        function.Varint(1, id);
+        function.Varint(2, name);
+        function.Varint(3, name);
+        function.Varint(4, intern(entry->module));
+        profile.Message(5, function);
+    }
+
+    profile.Varint(10, total_count * period);
+    profile.Message(11, value_type("cpu", "nanoseconds"));
+    profile.Varint(12, period);
+    // The string table goes last, every string has been interned by now
+    for (const std::string& string : strings) {
+        profile.Bytes(6, string);
+    }
+
+    return profile.Data();
+}
+
+} // namespace Tools
@@ -0,0 +1,111 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "common/common_types.h"
+#include "core/arm/arm_interface.h"
+#include "core/hardware_properties.h"
+
+namespace Core {
+class System;
+}
+
+namespace Core::Timing {
+struct EventType;
+}
+
+namespace Tools {
+
+/**
+ * Samples where guest code spends its time. Every emulated core records the PC and the frame
+ * pointer chain of the guest thread it runs at a fixed interval of emulated time. Samples are kept
+ * as raw addresses and are only resolved to modules and symbols when written out, either as
+ * collapsed stacks for flamegraph tools or as a pprof profile.
+ *
+ * A timing event requests a sample from every core and interrupts them, so the JIT returns
+ * wherever the guest happens to be instead of only at supervisor calls. The sample itself is taken
+ * by the CPU thread when the JIT has returned, so the registers are exact and no guest thread can
+ * exit while it is being sampled. Frame records are peeked at without going through the memory
+ * accessors. Functions that do not set up a frame record do not show their caller.
+ */
+class GuestProfiler {
+public:
+    /// Stacks are stored leaf first
+    using Stack = std::vector<VAddr>;
+    /// Number of samples taken of each stack
+    using Samples = std::map<Stack, u64>;
+    /// Fills in the module, offset and name of entries from their original address. Returns false
+    /// if they cannot be resolved.
+    using Symbolizer = std::function<bool(std::vector<Core::ARM_Interface::BacktraceEntry>&)>;
+
+    explicit GuestProfiler(Core::System& system_);
+    ~GuestProfiler();
+
+    /// Starts sampling, dropping the samples of the previous run.
+    void Start(std::chrono::microseconds interval_);
+
+    /// Stops sampling, the samples are kept until the next start.
+    void Stop();
+
+    [[nodiscard]] bool IsActive() const {
+        return is_active.load(std::memory_order_acquire);
+    }
+
+    /// Called by the CPU loop of a core every time the JIT returns to it.
+    void OnCoreReturn(std::size_t core, Core::ARM_Interface& arm_interface) {
+        if (IsActive() && sample_requested[core].exchange(false, std::memory_order_acq_rel)) {
+            Sample(arm_interface);
+        }
+    }
+
+    [[nodiscard]] u64 GetSampleCount() const;
+
+    /// Writes one line per distinct stack, root first and frames separated by semicolons,
+    /// followed by its number of samples.
+    bool WriteCollapsedStacks(const std::string& path) const;
+
+    /// Writes an uncompressed pprof profile.
+    bool WritePprof(const std::string& path) const;
+
+    /// The collapsed stacks written by WriteCollapsedStacks
+    [[nodiscard]] static std::string CollapseStacks(const Samples& samples,
+                                                    const Symbolizer& symbolizer);
+
+    /// The pprof profile written by WritePprof, each sample stands for an interval of CPU time
+    [[nodiscard]] static std::string EncodePprof(const Samples& samples,
+                                                 std::chrono::nanoseconds interval,
+                                                 const Symbolizer& symbolizer);
+
+private:
+    static constexpr std::size_t MAX_DEPTH = 64;
+
+    /// Asks every core for a sample and schedules the next request.
+    void RequestSamples(std::chrono::nanoseconds ns_late);
+
+    void Sample(Core::ARM_Interface& arm_interface);
+
+    Core::System& system;
+    std::shared_ptr<Core::Timing::EventType> sample_event;
+
+    std::atomic<bool> is_active{};
+    std::chrono::nanoseconds interval{};
+    std::array<std::atomic<bool>, Core::Hardware::NUM_CPU_CORES> sample_requested{};
+
+    mutable std::mutex samples_mutex;
+    Samples samples;
+    u64 sample_count = 0;
+};
+
+} // namespace Tools
@@ -0,0 +1,462 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/common_funcs.h"
+#include "common/file_util.h"
+#include "common/logging/log.h"
+#include "core/tools/input_movie.h"
+
+namespace Tools {
+namespace {
+
+constexpr u32 MOVIE_MAGIC = Common::MakeMagic('Y', 'Z', 'M', 'V');
+constexpr u32 MOVIE_VERSION = 1;
+
+constexpr u32 KEYBOARD_CHANGED = 1U << InputMovie::NUM_PADS;
+constexpr u32 TOUCH_CHANGED = 1U << (InputMovie::NUM_PADS + 1);
+
+void WriteVarint(std::vector<u8>& out, u64 value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<u8>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<u8>(value));
+}
+
+bool ReadVarint(const std::vector<u8>& data, std::size_t& offset, u64& value) {
+    value = 0;
+    for (u32 shift = 0; shift < 64; shift += 7) {
+        if (offset >= data.size()) {
+            return false;
+        }
+        const u8 byte = data[offset++];
+        value |= static_cast<u64>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Stick positions move by small amounts between frames, in either direction
+void WriteDelta(std::vector<u8>& out, s32 value, s32 previous) {
+    const s64 delta = static_cast<s64>(value) - previous;
+    WriteVarint(out, static_cast<u64>((delta << 1) ^ (delta >> 63)));
+}
+
+bool ReadDelta(const std::vector<u8>& data, std::size_t& offset, s32& value) {
+    u64 zigzag;
+    if (!ReadVarint(data, offset, zigzag)) {
+        return false;
+    }
+    const s64 delta = static_cast<s64>(zigzag >> 1) ^ -static_cast<s64>(zigzag & 1);
+    value = static_cast<s32>(value + delta);
+    return true;
+}
+
+} // Anonymous namespace
+
+InputMovie::InputMovie() = default;
+
+InputMovie::~InputMovie() {
+    Stop();
+}
+
+bool InputMovie::StartRecording(const std::string& path) {
+    std::lock_guard lock{mutex};
+    if (state != State::Idle) {
+        LOG_ERROR(Core, "Cannot record an input movie while another is in use");
+        return false;
+    }
+
+    movie_path = path;
+    movie_data.clear();
+    keyframe_offsets.clear();
+    current = {};
+    previous = {};
+    frame_number = 0;
+    state = State::Recording;
+
+    LOG_INFO(Core, "Recording input movie to {}", path);
+    return true;
+}
+
+bool InputMovie::StartPlayback(const std::string& path) {
+    std::lock_guard lock{mutex};
+    if (state != State::Idle) {
+        LOG_ERROR(Core, "Cannot play an input movie while another is in use");
+        return false;
+    }
+
+    Common::FS::IOFile file(path, "rb");
+    if (!file.IsOpen()) {
+        LOG_ERROR(Core, "Could not open input movie {}", path);
+        return false;
+    }
+    movie_data.resize(file.GetSize());
+    if (file.ReadBytes(movie_data.data(), movie_data.size()) != movie_data.size() ||
+        !LoadIndex() || frame_count == 0) {
+        LOG_ERROR(Core, "Input movie {} is invalid", path);
+        movie_data.clear();
+        return false;
+    }
+
+    movie_path = path;
+    read_offset = keyframe_offsets[0];
+    frame_number = 0;
+    current = {};
+    if (!DecodeFrame(movie_data, read_offset, current)) {
+        LOG_ERROR(Core, "Input movie {} is invalid", path);
+        movie_data.clear();
+        return false;
+    }
+    state = State::Playing;
+
+    LOG_INFO(Core, "Playing input movie {} with {} frames", path, frame_count);
+    return true;
+}
+
+bool InputMovie::Stop() {
+    std::lock_guard lock{mutex};
+    const State old_state = state;
+    state = State::Idle;
+
+    if (old_state != State::Recording) {
+        movie_data.clear();
+        keyframe_offsets.clear();
+        return true;
+    }
+
+    const Header header{
+        .magic = MOVIE_MAGIC,
+        .version = MOVIE_VERSION,
+        .frame_count = frame_number,
+        .keyframe_interval = KEYFRAME_INTERVAL,
+        .index_offset = sizeof(Header) + movie_data.size(),
+    };
+
+    Common::FS::IOFile file(movie_path, "wb");
+    bool success = file.IsOpen();
+    success = success && file.WriteObject(header) == 1;
+    success = success && file.WriteBytes(movie_data.data(), movie_data.size()) == movie_data.size();
+    for (const u64 offset : keyframe_offsets) {
+        const u64 file_offset = sizeof(Header) + offset;
+        success = success && file.WriteObject(file_offset) == 1;
+    }
+
+    if (success) {
+        LOG_INFO(Core, "Wrote input movie {} with {} frames", movie_path, frame_number);
+    } else {
+        LOG_ERROR(Core, "Could not write input movie {}", movie_path);
+    }
+
+    movie_data.clear();
+    keyframe_offsets.clear();
+    return success;
+}
+
+bool InputMovie::Seek(u64 frame) {
+    std::lock_guard lock{mutex};
+    if (state != State::Playing || frame >= frame_count) {
+        return false;
+    }
+
+    const u64 keyframe = frame / KEYFRAME_INTERVAL;
+    std::size_t offset = keyframe_offsets[keyframe];
+    Frame decoded{};
+    for (u64 i = keyframe * KEYFRAME_INTERVAL; i <= frame; ++i) {
+        if (!DecodeFrame(movie_data, offset, decoded)) {
+            return false;
+        }
+    }
+
+    current = decoded;
+    read_offset = offset;
+    frame_number = frame;
+    return true;
+}
+
+InputMovie::State InputMovie::GetState() const {
+    std::lock_guard lock{mutex};
+    return state;
+}
+
+u64 InputMovie::GetCurrentFrame() const {
+    std::lock_guard lock{mutex};
+    return frame_number;
+}
+
+u64 InputMovie::GetFrameCount() const {
+    std::lock_guard lock{mutex};
+    return state == State::Playing ? frame_count : frame_number;
+}
+
+void InputMovie::AdvanceFrame() {
+    std::lock_guard lock{mutex};
+    switch (state) {
+    case State::Idle:
+        break;
+    case State::Recording:
+        AppendFrame();
+        break;
+    case State::Playing:
+        if (!DecodeNextFrame()) {
+            LOG_INFO(Core, "Input movie {} finished after {} frames", movie_path, frame_count);
+            state = State::Idle;
+            movie_data.clear();
+            keyframe_offsets.clear();
+        }
+        break;
+    }
+}
+
+bool InputMovie::PlaybackPad(std::size_t index, PadState& pad) const {
+    std::lock_guard lock{mutex};
+    if (state != State::Playing || index >= NUM_PADS) {
+        return false;
+    }
+    pad = current.pads[index];
+    return true;
+}
+
+bool InputMovie::PlaybackKeyboard(KeyboardState& keyboard) const {
+    std::lock_guard lock{mutex};
+    if (state != State::Playing) {
+        return false;
+    }
+    keyboard = current.keyboard;
+    return true;
+}
+
+bool InputMovie::PlaybackTouch(TouchState& touch) const {
+    std::lock_guard lock{mutex};
+    if (state != State::Playing) {
+        return false;
+    }
+    touch = current.touch;
+    return true;
+}
+
+void InputMovie::RecordPad(std::size_t index, const PadState& pad) {
+    std::lock_guard lock{mutex};
+    if (state == State::Recording && index < NUM_PADS) {
+        current.pads[index] = pad;
+    }
+}
+
+void InputMovie::RecordKeyboard(const KeyboardState& keyboard) {
+    std::lock_guard lock{mutex};
+    if (state == State::Recording) {
+        current.keyboard = keyboard;
+    }
+}
+
+void InputMovie::RecordTouch(const TouchState& touch) {
+    std::lock_guard lock{mutex};
+    if (state == State::Recording) {
+        current.touch = touch;
+    }
+}
+
+std::vector<u8> InputMovie::Encode(const std::vector<Frame>& frames) {
+    std::vector<u8> body;
+    std::vector<u64> offsets;
+    Frame last{};
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+        if (i % KEYFRAME_INTERVAL == 0) {
+            offsets.push_back(sizeof(Header) + body.size());
+            last = {};
+        }
+        EncodeFrame(body, frames[i], last);
+        last = frames[i];
+    }
+
+    const Header header{
+        .magic = MOVIE_MAGIC,
+        .version = MOVIE_VERSION,
+        .frame_count = frames.size(),
+        .keyframe_interval = KEYFRAME_INTERVAL,
+        .index_offset = sizeof(Header) + body.size(),
+    };
+
+    std::vector<u8> out(sizeof(Header));
+    std::memcpy(out.data(), &header, sizeof(Header));
+    out.insert(out.end(), body.begin(), body.end());
+    const std::size_t index_start = out.size();
+    out.resize(index_start + offsets.size() * sizeof(u64));
+    std::memcpy(out.data() + index_start, offsets.data(), offsets.size() * sizeof(u64));
+    return out;
+}
+
+bool InputMovie::Decode(const std::vector<u8>& data, std::vector<Frame>& frames) {
+    InputMovie movie;
+    movie.movie_data = data;
+    if (!movie.LoadIndex()) {
+        return false;
+    }
+
+    frames.clear();
+    std::size_t offset = sizeof(Header);
+    Frame frame{};
+    for (u64 i = 0; i < movie.frame_count; ++i) {
+        if (i % KEYFRAME_INTERVAL == 0) {
+            frame = {};
+        }
+        if (!DecodeFrame(data, offset, frame)) {
+            return false;
+        }
+        frames.push_back(frame);
+    }
+    return true;
+}
+
+void InputMovie::EncodeFrame(std::vector<u8>& out, const Frame& frame, const Frame& last) {
+    u32 changed = 0;
+    for (std::size_t i = 0; i < NUM_PADS; ++i) {
+        if (frame.pads[i] != last.pads[i]) {
+            changed |= 1U << i;
+        }
+    }
+    if (frame.keyboard != last.keyboard) {
+        changed |= KEYBOARD_CHANGED;
+    }
+    if (frame.touch != last.touch) {
+        changed |= TOUCH_CHANGED;
+    }
+
+    WriteVarint(out, changed);
+
+    for (std::size_t i = 0; i < NUM_PADS; ++i) {
+        if ((changed & (1U << i)) == 0) {
+            continue;
+        }
+        const PadState& pad = frame.pads[i];
+        const PadState& last_pad = last.pads[i];
+        WriteVarint(out, pad.buttons);
+        WriteDelta(out, pad.l_stick_x, last_pad.l_stick_x);
+        WriteDelta(out, pad.l_stick_y, last_pad.l_stick_y);
+        WriteDelta(out, pad.r_stick_x, last_pad.r_stick_x);
+        WriteDelta(out, pad.r_stick_y, last_pad.r_stick_y);
+    }
+
+    if ((changed & KEYBOARD_CHANGED) != 0) {
+        WriteVarint(out, static_cast<u32>(frame.keyboard.modifier));
+        out.insert(out.end(), frame.keyboard.keys.begin(), frame.keyboard.keys.end());
+    }
+
+    if ((changed & TOUCH_CHANGED) != 0) {
+        const u32 count = std::min<u32>(frame.touch.count, MAX_TOUCHES);
+        WriteVarint(out, count);
+        for (u32 i = 0; i < count; ++i) {
+            WriteVarint(out, frame.touch.points[i].x);
+            WriteVarint(out, frame.touch.points[i].y);
+        }
+    }
+}
+
+bool InputMovie::DecodeFrame(const std::vector<u8>& data, std::size_t& offset, Frame& frame) {
+    u64 changed;
+    if (!ReadVarint(data, offset, changed)) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < NUM_PADS; ++i) {
+        if ((changed & (1U << i)) == 0) {
+            continue;
+        }
+        PadState& pad = frame.pads[i];
+        if (!ReadVarint(data, offset, pad.buttons) || !ReadDelta(data, offset, pad.l_stick_x) ||
+            !ReadDelta(data, offset, pad.l_stick_y) || !ReadDelta(data, offset, pad.r_stick_x) ||
+            !ReadDelta(data, offset, pad.r_stick_y)) {
+            return false;
+        }
+    }
+
+    if ((changed & KEYBOARD_CHANGED) != 0) {
+        u64 modifier;
+        auto& keys = frame.keyboard.keys;
+        if (!ReadVarint(data, offset, modifier) || data.size() - offset < keys.size()) {
+            return false;
+        }
+        frame.keyboard.modifier = static_cast<s32>(modifier);
+        std::memcpy(keys.data(), data.data() + offset, keys.size());
+        offset += keys.size();
+    }
+
+    if ((changed & TOUCH_CHANGED) != 0) {
+        u64 count;
+        if (!ReadVarint(data, offset, count) || count > MAX_TOUCHES) {
+            return false;
+        }
+        frame.touch = {};
+        frame.touch.count = static_cast<u32>(count);
+        for (u64 i = 0; i < count; ++i) {
+            u64 x;
+            u64 y;
+            if (!ReadVarint(data, offset, x) || !ReadVarint(data, offset, y)) {
+                return false;
+            }
+            frame.touch.points[i] = {static_cast<u32>(x), static_cast<u32>(y)};
+        }
+    }
+
+    return true;
+}
+
+bool InputMovie::LoadIndex() {
+    Header header;
+    if (movie_data.size() < sizeof(Header)) {
+        return false;
+    }
+    std::memcpy(&header, movie_data.data(), sizeof(Header));
+
+    if (header.magic != MOVIE_MAGIC || header.version != MOVIE_VERSION ||
+        header.keyframe_interval != KEYFRAME_INTERVAL || header.index_offset < sizeof(Header) ||
+        header.index_offset > movie_data.size()) {
+        return false;
+    }
+
+    const u64 num_keyframes = (header.frame_count + KEYFRAME_INTERVAL - 1) / KEYFRAME_INTERVAL;
+    if ((movie_data.size() - header.index_offset) / sizeof(u64) != num_keyframes) {
+        return false;
+    }
+
+    keyframe_offsets.resize(num_keyframes);
+    std::memcpy(keyframe_offsets.data(), movie_data.data() + header.index_offset,
+                num_keyframes * sizeof(u64));
+    for (const u64 offset : keyframe_offsets) {
+        if (offset < sizeof(Header) || offset >= header.index_offset) {
+            return false;
+        }
+    }
+
+    frame_count = header.frame_count;
+    return true;
+}
+
+bool InputMovie::DecodeNextFrame() {
+    if (frame_number + 1 >= frame_count) {
+        return false;
+    }
+    ++frame_number;
+    if (frame_number % KEYFRAME_INTERVAL == 0) {
+        current = {};
+    }
+    return DecodeFrame(movie_data, read_offset, current);
+}
+
+void InputMovie::AppendFrame() {
+    if (frame_number % KEYFRAME_INTERVAL == 0) {
+        keyframe_offsets.push_back(movie_data.size());
+        previous = {};
+    }
+    EncodeFrame(movie_data, current, previous);
+    previous = current;
+    ++frame_number;
+}
+
+} // namespace Tools
@@ -0,0 +1,162 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "common/common_types.h"
+
+namespace Tools {
+
+/**
+ * Records the input the HID controllers hand to the game on every frame and plays it back
+ * without any frontend or plugin involvement. A frame lasts from one presented buffer to the next.
+ *
+ * While playing, the npad, keyboard and touchscreen controllers take their state from the movie
+ * in place of the input devices when they update shared memory. While recording, they report the
+ * state they wrote and the last state of each frame is stored.
+ *
+ * Movies are stored as the changes from the previous frame, so a frame without any new input
+ * takes a single byte. A full frame is stored at a fixed interval and indexed at the end of the
+ * file, which lets playback seek to any frame.
+ */
+class InputMovie {
+public:
+    static constexpr std::size_t NUM_PADS = 10;
+    static constexpr std::size_t MAX_TOUCHES = 16;
+    /// Frames between two full frames in the file
+    static constexpr u64 KEYFRAME_INTERVAL = 600;
+
+    enum class State : u8 {
+        Idle,
+        Recording,
+        Playing,
+    };
+
+    struct PadState {
+        u64 buttons{};
+        s32 l_stick_x{};
+        s32 l_stick_y{};
+        s32 r_stick_x{};
+        s32 r_stick_y{};
+
+        bool operator==(const PadState&) const = default;
+    };
+
+    struct KeyboardState {
+        s32 modifier{};
+        std::array<u8, 32> keys{};
+
+        bool operator==(const KeyboardState&) const = default;
+    };
+
+    struct TouchPoint {
+        u32 x{};
+        u32 y{};
+
+        bool operator==(const TouchPoint&) const = default;
+    };
+
+    struct TouchState {
+        u32 count{};
+        std::array<TouchPoint, MAX_TOUCHES> points{};
+
+        bool operator==(const TouchState&) const = default;
+    };
+
+    struct Frame {
+        std::array<PadState, NUM_PADS> pads{};
+        KeyboardState keyboard{};
+        TouchState touch{};
+
+        bool operator==(const Frame&) const = default;
+    };
+
+    InputMovie();
+    ~InputMovie();
+
+    /// Starts recording, the movie is written to path when recording stops.
+    bool StartRecording(const std::string& path);
+
+    /// Loads the movie at path and starts playing it from the first frame.
+    bool StartPlayback(const std::string& path);
+
+    /// Stops recording or playback, writing the movie if it was being recorded.
+    bool Stop();
+
+    /// Moves playback to the given frame. Only valid while playing.
+    bool Seek(u64 frame);
+
+    [[nodiscard]] State GetState() const;
+
+    /// Returns the frame being recorded or played.
+    [[nodiscard]] u64 GetCurrentFrame() const;
+
+    /// Returns the number of frames recorded so far or in the movie being played.
+    [[nodiscard]] u64 GetFrameCount() const;
+
+    /// Called whenever the game presents a frame. Stores the state of the frame that ended while
+    /// recording and moves to the next frame while playing.
+    void AdvanceFrame();
+
+    /// Called by the HID controllers, replace the given state while playing and return whether
+    /// they did.
+    bool PlaybackPad(std::size_t index, PadState& state) const;
+    bool PlaybackKeyboard(KeyboardState& state) const;
+    bool PlaybackTouch(TouchState& state) const;
+
+    /// Called by the HID controllers with the state they passed to the game.
+    void RecordPad(std::size_t index, const PadState& state);
+    void RecordKeyboard(const KeyboardState& state);
+    void RecordTouch(const TouchState& state);
+
+    /// Encodes frames into the movie format, exposed for testing.
+    static std::vector<u8> Encode(const std::vector<Frame>& frames);
+
+    /// Decodes every frame of a movie, exposed for testing. Returns false if it is malformed.
+    static bool Decode(const std::vector<u8>& data, std::vector<Frame>& frames);
+
+private:
+    struct Header {
+        u32 magic;
+        u32 version;
+        u64 frame_count;
+        u64 keyframe_interval;
+        u64 index_offset;
+    };
+    static_assert(sizeof(Header) == 0x20, "Header is an invalid size");
+
+    static void EncodeFrame(std::vector<u8>& out, const Frame& frame, const Frame& previous);
+    static bool DecodeFrame(const std::vector<u8>& data, std::size_t& offset, Frame& frame);
+
+    /// Parses the header and index of movie_data, returns false if they are malformed.
+    bool LoadIndex();
+
+    /// Decodes the next frame of movie_data into current, returns false at the end.
+    bool DecodeNextFrame();
+
+    void AppendFrame();
+
+    mutable std::mutex mutex;
+    State state{State::Idle};
+    std::string movie_path;
+
+    /// Frame being recorded or played
+    Frame current{};
+    u64 frame_number{};
+
+    /// Frames encoded so far while recording, or the whole file while playing
+    std::vector<u8> movie_data;
+    /// Offset of every keyframe in movie_data
+    std::vector<u64> keyframe_offsets;
+    Frame previous{};
+    std::size_t read_offset{};
+    u64 frame_count{};
+};
+
+} // namespace Tools
@@ -0,0 +1,337 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+
+#ifdef __linux__
+#include <csignal>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "common/assert.h"
+#include "common/cityhash.h"
+#include "common/logging/log.h"
+#include "core/tools/memory_journal.h"
+
+namespace Tools {
+
+#ifdef __linux__
+namespace {
+
+std::atomic<MemoryJournal*> current_journal{};
+struct sigaction previous_action {};
+
+void HandleSignal(int sig, siginfo_t* info, void* raw_context) {
+    MemoryJournal* const journal = current_journal.load(std::memory_order_acquire);
+    if (journal != nullptr && journal->HandleWriteFault(info->si_addr)) {
+        return;
+    }
+
+    // Not ours, hand the fault to whoever handled it before
+    if ((previous_action.sa_flags & SA_SIGINFO) != 0) {
+        previous_action.sa_sigaction(sig, info, raw_context);
+    } else if (previous_action.sa_handler == SIG_DFL || previous_action.sa_handler == SIG_IGN) {
+        // The faulting instruction runs again and gets the default action
+        signal(sig, SIG_DFL);
+    } else {
+        previous_action.sa_handler(sig);
+    }
+}
+
+void InstallHandler() {
+    // Something else may have replaced the handler since the last journal ran
+    struct sigaction current {};
+    sigaction(SIGSEGV, nullptr, &current);
+    if ((current.sa_flags & SA_SIGINFO) != 0 && current.sa_sigaction == HandleSignal) {
+        return;
+    }
+
+    struct sigaction action {};
+    action.sa_sigaction = HandleSignal;
+    action.sa_flags = SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGSEGV, &action, &previous_action);
+}
+
+} // Anonymous namespace
+#endif
+
+MemoryJournal::MemoryJournal(u8* base_, std::size_t size_, std::size_t max_written_pages_)
+    : base{base_}, size{size_}, num_pages{size_ / PAGE_SIZE},
+      max_written_pages{max_written_pages_} {}
+
+MemoryJournal::~MemoryJournal() {
+    Stop();
+}
+
+bool MemoryJournal::Start() {
+#ifdef __linux__
+    if (is_active || sysconf(_SC_PAGESIZE) != static_cast<long>(PAGE_SIZE)) {
+        return false;
+    }
+    MemoryJournal* expected = nullptr;
+    if (!current_journal.compare_exchange_strong(expected, this)) {
+        LOG_ERROR(Core, "Another memory journal is active");
+        return false;
+    }
+    InstallHandler();
+
+    writable.assign((num_pages + 63) / 64, 0);
+    for (Journal& journal : journals) {
+        if (journal.pages.size() != num_pages) {
+            journal.pages.resize(num_pages);
+            journal.data.resize(max_written_pages * PAGE_SIZE);
+        }
+        journal.count = 0;
+    }
+    active_journal = &journals[0];
+    snapshots.assign(1, {});
+    oldest_snapshot = 0;
+    last_written_pages = 0;
+    journaled_pages = 0;
+
+    // Writes fault from here on
+    is_active = true;
+    ASSERT(mprotect(base, size, PROT_READ) == 0);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void MemoryJournal::Stop() {
+#ifdef __linux__
+    if (!is_active) {
+        return;
+    }
+    {
+        std::scoped_lock lock{journal_lock};
+        ASSERT(mprotect(base, size, PROT_READ | PROT_WRITE) == 0);
+        is_active = false;
+    }
+    current_journal.store(nullptr, std::memory_order_release);
+
+    snapshots.clear();
+    store.clear();
+    writable.clear();
+    writable.shrink_to_fit();
+#endif
+}
+
+bool MemoryJournal::IsActive() const {
+    return is_active;
+}
+
+u64 MemoryJournal::TakeSnapshot() {
+    if (!is_active) {
+        return 0;
+    }
+
+    Journal* closed;
+    {
+        std::scoped_lock lock{journal_lock};
+        closed = active_journal;
+        active_journal = closed == &journals[0] ? &journals[1] : &journals[0];
+        ProtectPages(&closed->pages[0], closed->count);
+    }
+
+    // The copies are only stored once the written pages are protected again, writes made in the
+    // meantime go to the other journal
+    last_written_pages = closed->count;
+    if (closed->count > max_written_pages) {
+        LOG_WARNING(Core, "{} pages were written since the last snapshot, dropping all snapshots",
+                    closed->count);
+        const u64 newest = GetNewestSnapshot();
+        while (!snapshots.empty()) {
+            ReleaseSnapshot(snapshots.front());
+            snapshots.pop_front();
+        }
+        oldest_snapshot = newest + 1;
+    } else {
+        Snapshot& newest = snapshots.back();
+        newest.records.reserve(closed->count);
+        for (std::size_t i = 0; i < closed->count; ++i) {
+            newest.records.push_back({closed->pages[i], StorePage(&closed->data[i * PAGE_SIZE])});
+        }
+        journaled_pages += closed->count;
+    }
+    closed->count = 0;
+
+    snapshots.emplace_back();
+    return GetNewestSnapshot();
+}
+
+bool MemoryJournal::Restore(u64 snapshot) {
+    if (!is_active || snapshot < oldest_snapshot || snapshot > GetNewestSnapshot()) {
+        return false;
+    }
+    const std::size_t index = static_cast<std::size_t>(snapshot - oldest_snapshot);
+
+    {
+        std::scoped_lock lock{journal_lock};
+        Journal& journal = *active_journal;
+        if (journal.count > max_written_pages) {
+            LOG_ERROR(Core, "Too many pages were written since the last snapshot to restore");
+            return false;
+        }
+
+        std::vector<u32> unprotected;
+        const auto restore_page = [&](u32 page, const u8* data) {
+            if (!IsWritable(page)) {
+                SetWritable(page, true);
+                unprotected.push_back(page);
+            }
+            std::memcpy(base + page * PAGE_SIZE, data, PAGE_SIZE);
+        };
+
+        // Newest first, so the copy that ends up in each page is the one of the snapshot
+        for (std::size_t i = 0; i < journal.count; ++i) {
+            restore_page(journal.pages[i], &journal.data[i * PAGE_SIZE]);
+        }
+        for (std::size_t i = snapshots.size() - 1; i-- > index;) {
+            for (const Record& record : snapshots[i].records) {
+                restore_page(record.page, store.at(record.key).data->data());
+            }
+        }
+
+        unprotected.insert(unprotected.end(), &journal.pages[0], &journal.pages[0] + journal.count);
+        ProtectPages(unprotected.data(), unprotected.size());
+        journal.count = 0;
+    }
+
+    for (std::size_t i = index; i < snapshots.size(); ++i) {
+        ReleaseSnapshot(snapshots[i]);
+    }
+    snapshots.resize(index + 1);
+    return true;
+}
+
+void MemoryJournal::DropOldest() {
+    if (snapshots.size() <= 1) {
+        return;
+    }
+    ReleaseSnapshot(snapshots.front());
+    snapshots.pop_front();
+    ++oldest_snapshot;
+}
+
+u64 MemoryJournal::GetOldestSnapshot() const {
+    return oldest_snapshot;
+}
+
+u64 MemoryJournal::GetNewestSnapshot() const {
+    return oldest_snapshot + snapshots.size() - 1;
+}
+
+MemoryJournal::Stats MemoryJournal::GetStats() const {
+    return {
+        .num_snapshots = snapshots.size(),
+        .journaled_pages = journaled_pages,
+        .stored_pages = store.size(),
+        .last_written_pages = last_written_pages,
+    };
+}
+
+bool MemoryJournal::HandleWriteFault(const void* address) {
+    const auto* const byte = static_cast<const u8*>(address);
+    if (byte < base || byte >= base + size) {
+        return false;
+    }
+    const u32 page = static_cast<u32>((byte - base) / PAGE_SIZE);
+
+    std::scoped_lock lock{journal_lock};
+    if (!is_active) {
+        return false;
+    }
+    if (IsWritable(page)) {
+        // Another thread got to the page first
+        return true;
+    }
+    Journal& journal = *active_journal;
+    if (journal.count < max_written_pages) {
+        std::memcpy(&journal.data[journal.count * PAGE_SIZE], base + page * PAGE_SIZE, PAGE_SIZE);
+    }
+    journal.pages[journal.count++] = page;
+    SetWritable(page, true);
+    return true;
+}
+
+u64 MemoryJournal::StorePage(const u8* data) {
+    u64 key = Common::CityHash64(reinterpret_cast<const char*>(data), PAGE_SIZE);
+    while (true) {
+        const auto [it, inserted] = store.try_emplace(key);
+        StoredPage& stored = it->second;
+        if (inserted) {
+            stored.data = std::make_unique<std::array<u8, PAGE_SIZE>>();
+            std::memcpy(stored.data->data(), data, PAGE_SIZE);
+            stored.references = 1;
+            return key;
+        }
+        if (std::memcmp(stored.data->data(), data, PAGE_SIZE) == 0) {
+            ++stored.references;
+            return key;
+        }
+        // Another page has the same hash, try the next key
+        ++key;
+    }
+}
+
+void MemoryJournal::ReleasePage(u64 key) {
+    const auto it = store.find(key);
+    ASSERT(it != store.end());
+    if (--it->second.references == 0) {
+        store.erase(it);
+    }
+}
+
+void MemoryJournal::ReleaseSnapshot(Snapshot& snapshot) {
+    for (const Record& record : snapshot.records) {
+        ReleasePage(record.key);
+    }
+    journaled_pages -= snapshot.records.size();
+    snapshot.records.clear();
+    snapshot.records.shrink_to_fit();
+}
+
+void MemoryJournal::ProtectPages(const u32* pages, std::size_t count) {
+    // Written pages tend to be next to each other, protect them in runs
+    std::vector<u32> sorted(pages, pages + count);
+    std::sort(sorted.begin(), sorted.end());
+    for (std::size_t first = 0; first < sorted.size();) {
+        std::size_t last = first;
+        while (last + 1 < sorted.size() && sorted[last + 1] == sorted[last] + 1) {
+            ++last;
+        }
+#ifdef __linux__
+        ASSERT(mprotect(base + sorted[first] * PAGE_SIZE, (last - first + 1) * PAGE_SIZE,
+                        PROT_READ) == 0);
+#endif
+        for (std::size_t i = first; i <= last; ++i) {
+            writable[sorted[i] / 64] &= ~(u64{1} << (sorted[i] % 64));
+        }
+        first = last + 1;
+    }
+}
+
+bool MemoryJournal::IsWritable(u32 page) const {
+    return ((writable[page / 64] >> (page % 64)) & 1) != 0;
+}
+
+void MemoryJournal::SetWritable(u32 page, bool is_writable) {
+#ifdef __linux__
+    const int prot = is_writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    ASSERT(mprotect(base + page * PAGE_SIZE, PAGE_SIZE, prot) == 0);
+#endif
+    if (is_writable) {
+        writable[page / 64] |= u64{1} << (page % 64);
+    } else {
+        writable[page / 64] &= ~(u64{1} << (page % 64));
+    }
+}
+
+} // namespace Tools
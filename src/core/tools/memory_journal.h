@@ -0,0 +1,137 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "common/common_types.h"
+#include "common/spin_lock.h"
+#include "common/virtual_buffer.h"
+
+namespace Tools {
+
+/**
+ * Journals the writes to a range of host memory so that it can be brought back to any of a series
+ * of snapshots.
+ *
+ * The range is write protected. The first write to a page after a snapshot faults, and the fault
+ * handler copies the page as it was before the write and makes it writable again. Taking a
+ * snapshot moves those copies into a store deduplicated by content hash and protects the written
+ * pages again, so its cost follows the number of pages written since the previous snapshot rather
+ * than the size of the range. Restoring copies back every page written since the snapshot.
+ *
+ * Writes from any thread are journaled, but taking and restoring snapshots while other threads
+ * write to the range gives no consistent result. Only one journal can be active at a time. This
+ * relies on signal handlers and is only available on Linux, elsewhere Start fails.
+ */
+class MemoryJournal {
+public:
+    static constexpr std::size_t PAGE_SIZE = 0x1000;
+
+    struct Stats {
+        std::size_t num_snapshots;
+        /// Copies of pages kept for all snapshots
+        std::size_t journaled_pages;
+        /// Distinct page contents among those copies
+        std::size_t stored_pages;
+        /// Pages written between the last two snapshots
+        std::size_t last_written_pages;
+    };
+
+    /// Journals size bytes at base, which must be page aligned. Up to max_written_pages pages can
+    /// be written between two snapshots, snapshots taken before more are written are lost.
+    explicit MemoryJournal(u8* base_, std::size_t size_, std::size_t max_written_pages_);
+    ~MemoryJournal();
+
+    MemoryJournal(const MemoryJournal&) = delete;
+    MemoryJournal& operator=(const MemoryJournal&) = delete;
+
+    /// Protects the range and takes the first snapshot.
+    bool Start();
+
+    /// Makes the range writable again and drops every snapshot.
+    void Stop();
+
+    [[nodiscard]] bool IsActive() const;
+
+    /// Takes a snapshot of the range and returns its number. Numbers start at 0 in Start and
+    /// increase by one with every snapshot.
+    u64 TakeSnapshot();
+
+    /// Brings the range back to the given snapshot and drops the snapshots taken after it.
+    bool Restore(u64 snapshot);
+
+    /// Drops the oldest snapshot unless it is the only one.
+    void DropOldest();
+
+    [[nodiscard]] u64 GetOldestSnapshot() const;
+    [[nodiscard]] u64 GetNewestSnapshot() const;
+    [[nodiscard]] Stats GetStats() const;
+
+    /// Called by the fault handler, returns whether the fault was a journaled write.
+    bool HandleWriteFault(const void* address);
+
+private:
+    /// A page as it was before the first write after a snapshot
+    struct Record {
+        u32 page;
+        u64 key;
+    };
+
+    struct Snapshot {
+        /// Pages written between this snapshot and the next one
+        std::vector<Record> records;
+    };
+
+    /// Pages written since the newest snapshot, copied by the fault handler
+    struct Journal {
+        Common::VirtualBuffer<u32> pages;
+        Common::VirtualBuffer<u8> data;
+        /// Number of pages written, only the first max_written_pages are copied
+        std::size_t count = 0;
+    };
+
+    struct StoredPage {
+        std::unique_ptr<std::array<u8, PAGE_SIZE>> data;
+        u32 references;
+    };
+
+    u64 StorePage(const u8* data);
+    void ReleasePage(u64 key);
+    void ReleaseSnapshot(Snapshot& snapshot);
+
+    [[nodiscard]] bool IsWritable(u32 page) const;
+    void SetWritable(u32 page, bool is_writable);
+
+    /// Write protects the given pages again.
+    void ProtectPages(const u32* pages, std::size_t count);
+
+    u8* const base;
+    const std::size_t size;
+    const std::size_t num_pages;
+    const std::size_t max_written_pages;
+
+    bool is_active = false;
+
+    /// Taken by the fault handler, protects writable and the active journal
+    Common::SpinLock journal_lock;
+    std::vector<u64> writable;
+    std::array<Journal, 2> journals;
+    Journal* active_journal = &journals[0];
+
+    std::deque<Snapshot> snapshots;
+    u64 oldest_snapshot = 0;
+    std::size_t last_written_pages = 0;
+    std::size_t journaled_pages = 0;
+
+    /// Page contents by hash, shared between snapshots
+    std::unordered_map<u64, StoredPage> store;
+};
+
+} // namespace Tools
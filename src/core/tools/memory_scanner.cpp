@@ -0,0 +1,496 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "common/logging/log.h"
+#include "core/core.h"
+#include "core/hle/kernel/memory/memory_block.h"
+#include "core/hle/kernel/memory/page_table.h"
+#include "core/hle/kernel/process.h"
+#include "core/memory.h"
+#include "core/tools/memory_scanner.h"
+
+namespace Tools {
+namespace {
+
+using Core::Memory::PAGE_SIZE;
+using ValueType = MemoryScanner::ValueType;
+using Comparison = MemoryScanner::Comparison;
+
+/// Snapshot pages carry the start of the next page so every value can be read from one buffer
+constexpr std::size_t PAGE_PADDING = sizeof(u64);
+constexpr std::size_t PADDED_PAGE_SIZE = PAGE_SIZE + PAGE_PADDING;
+
+constexpr std::size_t MIN_PAGES_PER_THREAD = 64;
+constexpr std::size_t MIN_RESULTS_PER_THREAD = 0x4000;
+
+u32 GetWidth(ValueType type) {
+    switch (type) {
+    case ValueType::U8:
+        return 1;
+    case ValueType::U16:
+        return 2;
+    case ValueType::U32:
+    case ValueType::Float:
+        return 4;
+    case ValueType::U64:
+    case ValueType::Double:
+    default:
+        return 8;
+    }
+}
+
+template <typename T>
+T FromBits(u64 bits) {
+    T value;
+    std::memcpy(&value, &bits, sizeof(T));
+    return value;
+}
+
+template <typename T>
+u64 ToBits(T value) {
+    u64 bits = 0;
+    std::memcpy(&bits, &value, sizeof(T));
+    return bits;
+}
+
+std::size_t GetNumChunks(std::size_t count, std::size_t min_chunk_size) {
+    const std::size_t max_chunks = std::max(1U, std::thread::hardware_concurrency());
+    return std::clamp<std::size_t>(count / min_chunk_size, 1, max_chunks);
+}
+
+/// Calls func(chunk, begin, end) for num_chunks even slices of [0, count), each on its own thread.
+template <typename Func>
+void ParallelFor(std::size_t num_chunks, std::size_t count, Func&& func) {
+    std::vector<std::thread> threads;
+    threads.reserve(num_chunks - 1);
+    for (std::size_t chunk = 1; chunk < num_chunks; ++chunk) {
+        threads.emplace_back([&func, chunk, num_chunks, count] {
+            func(chunk, count * chunk / num_chunks, count * (chunk + 1) / num_chunks);
+        });
+    }
+    func(0, 0, count / num_chunks);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+template <typename Func>
+void WithType(ValueType type, Func&& func) {
+    switch (type) {
+    case ValueType::U8:
+        return func(u8{});
+    case ValueType::U16:
+        return func(u16{});
+    case ValueType::U32:
+        return func(u32{});
+    case ValueType::U64:
+        return func(u64{});
+    case ValueType::Float:
+        return func(float{});
+    case ValueType::Double:
+        return func(double{});
+    }
+}
+
+template <typename Func>
+void WithAlignment(u32 alignment, Func&& func) {
+    switch (alignment) {
+    case 1:
+        return func(std::integral_constant<u32, 1>{});
+    case 2:
+        return func(std::integral_constant<u32, 2>{});
+    case 4:
+        return func(std::integral_constant<u32, 4>{});
+    default:
+        return func(std::integral_constant<u32, 8>{});
+    }
+}
+
+/// Calls func with a predicate taking the current and the previous value. Every comparison is a
+/// separate type so the loops using it get specialized and vectorized.
+template <typename T, typename Func>
+void WithPredicate(const MemoryScanner::Query& query, Func&& func) {
+    const T value = FromBits<T>(query.value);
+    const T upper = FromBits<T>(query.upper);
+
+    switch (query.comparison) {
+    case Comparison::Any:
+        return func([](T, T) { return true; });
+    case Comparison::Exact:
+        return func([value](T current, T) { return current == value; });
+    case Comparison::Range:
+        return func(
+            [value, upper](T current, T) { return current >= value && current <= upper; });
+    case Comparison::Fuzzy:
+        if constexpr (std::is_floating_point_v<T>) {
+            const T tolerance = static_cast<T>(query.tolerance);
+            return func([value, tolerance](T current, T) {
+                return std::abs(current - value) <= tolerance;
+            });
+        } else {
+            return func([value](T current, T) { return current == value; });
+        }
+    case Comparison::Changed:
+        // Bitwise, so NaNs compare as unchanged
+        return func([](T current, T previous) { return ToBits(current) != ToBits(previous); });
+    case Comparison::Unchanged:
+        return func([](T current, T previous) { return ToBits(current) == ToBits(previous); });
+    case Comparison::Increased:
+        return func([](T current, T previous) { return current > previous; });
+    case Comparison::Decreased:
+        return func([](T current, T previous) { return current < previous; });
+    }
+}
+
+/// Clears the bits of slots that don't match, 64 slots at a time.
+template <typename T, u32 Alignment, typename Pred>
+void MatchPage(const u8* current, const u8* previous, u64* words, std::size_t num_words,
+               Pred pred) {
+    for (std::size_t word = 0; word < num_words; ++word) {
+        if (words[word] == 0) {
+            continue;
+        }
+        const u8* const current_block = current + word * 64 * Alignment;
+        const u8* const previous_block = previous + word * 64 * Alignment;
+        u64 mask = 0;
+        for (u32 slot = 0; slot < 64; ++slot) {
+            T current_value;
+            T previous_value;
+            std::memcpy(&current_value, current_block + slot * Alignment, sizeof(T));
+            std::memcpy(&previous_value, previous_block + slot * Alignment, sizeof(T));
+            mask |= static_cast<u64>(pred(current_value, previous_value)) << slot;
+        }
+        words[word] &= mask;
+    }
+}
+
+/// The heap and the data of the main module, everything a game keeps its state in
+class ProcessSource final : public MemoryScanner::Source {
+public:
+    explicit ProcessSource(Core::System& system_) : system{system_} {}
+
+    std::vector<Range> GetRanges() override {
+        std::vector<Range> ranges;
+        Kernel::Process* const process = system.CurrentProcess();
+        if (process == nullptr) {
+            return ranges;
+        }
+
+        auto& page_table = process->PageTable();
+        VAddr address = page_table.GetAddressSpaceStart();
+        while (address < page_table.GetAddressSpaceEnd()) {
+            const auto info = page_table.QueryInfo(address);
+            if (info.GetSize() == 0) {
+                break;
+            }
+            const VAddr end = info.GetAddress() + info.GetSize();
+            const bool is_data = info.state == Kernel::Memory::MemoryState::Normal ||
+                                 info.state == Kernel::Memory::MemoryState::CodeData ||
+                                 info.state == Kernel::Memory::MemoryState::AliasCodeData;
+            const bool is_writable =
+                (info.perm & Kernel::Memory::MemoryPermission::ReadAndWrite) ==
+                Kernel::Memory::MemoryPermission::ReadAndWrite;
+
+            if (is_data && is_writable) {
+                if (!ranges.empty() && ranges.back().base + ranges.back().size == address) {
+                    ranges.back().size += end - address;
+                } else {
+                    ranges.push_back({address, end - address});
+                }
+            }
+            address = end;
+        }
+        return ranges;
+    }
+
+    bool Read(VAddr vaddr, u8* dest, std::size_t size) override {
+        const Kernel::Process* const process = system.CurrentProcess();
+        if (process == nullptr) {
+            return false;
+        }
+        auto& memory = system.Memory();
+        if (const u8* const pointer = memory.GetContiguousPointer(*process, vaddr, size)) {
+            std::memcpy(dest, pointer, size);
+            return true;
+        }
+        if (!memory.IsValidVirtualAddress(*process, vaddr) ||
+            !memory.IsValidVirtualAddress(*process, vaddr + size - 1)) {
+            return false;
+        }
+        memory.ReadBlock(*process, vaddr, dest, size);
+        return true;
+    }
+
+private:
+    Core::System& system;
+};
+
+} // Anonymous namespace
+
+MemoryScanner::Source::~Source() = default;
+
+MemoryScanner::MemoryScanner(Core::System& system_)
+    : MemoryScanner(std::make_unique<ProcessSource>(system_)) {}
+
+MemoryScanner::MemoryScanner(std::unique_ptr<Source> source_) : source{std::move(source_)} {}
+
+MemoryScanner::~MemoryScanner() = default;
+
+std::size_t MemoryScanner::FirstScan(ValueType type, u32 alignment_, const Query& query) {
+    Reset();
+
+    if (alignment_ != 1 && alignment_ != 2 && alignment_ != 4 && alignment_ != 8) {
+        LOG_ERROR(Common_Memory, "Invalid memory scan alignment={}", alignment_);
+        return 0;
+    }
+    value_type = type;
+    alignment = alignment_;
+
+    Query first_query = query;
+    if (query.comparison >= Comparison::Changed) {
+        LOG_WARNING(Common_Memory, "First memory scan has no previous values, matching all");
+        first_query.comparison = Comparison::Any;
+    }
+
+    CollectRegions();
+    for (Region& region : regions) {
+        ScanDense(region, first_query, true);
+    }
+    has_scanned = true;
+    return GetResultCount();
+}
+
+std::size_t MemoryScanner::NextScan(const Query& query) {
+    if (!has_scanned) {
+        return 0;
+    }
+    if (query.comparison == Comparison::Any) {
+        // Only refreshes the values compared against by the next scan
+        LOG_DEBUG(Common_Memory, "Memory scan matching all previous results");
+    }
+
+    for (Region& region : regions) {
+        if (region.IsDense()) {
+            ScanDense(region, query, false);
+        } else {
+            ScanSparse(region, query);
+        }
+    }
+    return GetResultCount();
+}
+
+void MemoryScanner::Reset() {
+    regions.clear();
+    regions.shrink_to_fit();
+    has_scanned = false;
+}
+
+std::size_t MemoryScanner::GetResultCount() const {
+    std::size_t count = 0;
+    for (const Region& region : regions) {
+        count += region.count;
+    }
+    return count;
+}
+
+std::vector<MemoryScanner::Result> MemoryScanner::GetResults(std::size_t first,
+                                                            std::size_t max) const {
+    std::vector<Result> results;
+    const u32 width = GetWidth(value_type);
+    const std::size_t slots_per_page = PAGE_SIZE / alignment;
+
+    for (const Region& region : regions) {
+        if (results.size() >= max) {
+            break;
+        }
+        if (first >= region.count) {
+            first -= region.count;
+            continue;
+        }
+
+        if (!region.IsDense()) {
+            const std::size_t end = std::min(region.count, first + max - results.size());
+            for (std::size_t i = first; i < end; ++i) {
+                results.push_back({region.base + region.offsets[i] * alignment,
+                                   region.values[i]});
+            }
+            first = 0;
+            continue;
+        }
+
+        for (std::size_t word = 0; word < region.bits.size() && results.size() < max; ++word) {
+            u64 bits = region.bits[word];
+            const std::size_t popcount = static_cast<std::size_t>(std::popcount(bits));
+            if (first >= popcount) {
+                first -= popcount;
+                continue;
+            }
+            for (; bits != 0 && results.size() < max; bits &= bits - 1) {
+                if (first > 0) {
+                    --first;
+                    continue;
+                }
+                const std::size_t slot = word * 64 + std::countr_zero(bits);
+                const std::size_t page = slot / slots_per_page;
+                const std::size_t offset = (slot % slots_per_page) * alignment;
+                u64 value = 0;
+                std::memcpy(&value, region.snapshot.data() + page * PADDED_PAGE_SIZE + offset,
+                            width);
+                results.push_back({region.base + slot * alignment, value});
+            }
+        }
+    }
+    return results;
+}
+
+void MemoryScanner::CollectRegions() {
+    for (const Source::Range& range : source->GetRanges()) {
+        regions.push_back({.base = range.base, .size = range.size, .count = 0});
+    }
+}
+
+void MemoryScanner::ScanDense(Region& region, const Query& query, bool first) {
+    const u32 width = GetWidth(value_type);
+    const std::size_t num_pages = region.size / PAGE_SIZE;
+    const std::size_t words_per_page = PAGE_SIZE / alignment / 64;
+    // Slots past this one read into the padding, which is only valid if the next page is
+    const std::size_t last_full_slot = (PAGE_SIZE - width) / alignment;
+
+    if (first) {
+        region.bits.assign(num_pages * words_per_page, ~u64{0});
+        region.snapshot.assign(num_pages * PADDED_PAGE_SIZE, 0);
+    }
+
+    std::atomic<std::size_t> total{0};
+    WithType(value_type, [&](auto type_tag) {
+        using T = decltype(type_tag);
+        WithAlignment(alignment, [&](auto alignment_constant) {
+            constexpr u32 Alignment = decltype(alignment_constant)::value;
+            WithPredicate<T>(query, [&](auto pred) {
+                const std::size_t num_chunks = GetNumChunks(num_pages, MIN_PAGES_PER_THREAD);
+                ParallelFor(num_chunks, num_pages, [&](std::size_t, std::size_t begin,
+                                                       std::size_t end) {
+                    std::array<u8, PADDED_PAGE_SIZE> current;
+                    std::size_t count = 0;
+
+                    for (std::size_t page = begin; page < end; ++page) {
+                        u64* const words = region.bits.data() + page * words_per_page;
+                        if (std::all_of(words, words + words_per_page,
+                                        [](u64 word) { return word == 0; })) {
+                            continue;
+                        }
+
+                        const VAddr vaddr = region.base + page * PAGE_SIZE;
+                        if (!source->Read(vaddr, current.data(), PAGE_SIZE)) {
+                            std::fill(words, words + words_per_page, 0);
+                            continue;
+                        }
+                        const bool has_padding =
+                            page + 1 < num_pages &&
+                            source->Read(vaddr + PAGE_SIZE, current.data() + PAGE_SIZE,
+                                         PAGE_PADDING);
+
+                        u8* const previous = region.snapshot.data() + page * PADDED_PAGE_SIZE;
+                        MatchPage<T, Alignment>(current.data(), previous, words, words_per_page,
+                                                pred);
+                        if (!has_padding) {
+                            constexpr std::size_t slots_per_page = PAGE_SIZE / Alignment;
+                            for (std::size_t slot = last_full_slot + 1; slot < slots_per_page;
+                                 ++slot) {
+                                words[slot / 64] &= ~(u64{1} << (slot % 64));
+                            }
+                        }
+                        std::memcpy(previous, current.data(), PADDED_PAGE_SIZE);
+
+                        for (std::size_t word = 0; word < words_per_page; ++word) {
+                            count += static_cast<std::size_t>(std::popcount(words[word]));
+                        }
+                    }
+                    total.fetch_add(count, std::memory_order_relaxed);
+                });
+            });
+        });
+    });
+    region.count = total.load();
+
+    // Switch to a list once it is smaller than the bitset and snapshot
+    const std::size_t dense_size = region.bits.size() * sizeof(u64) + region.snapshot.size();
+    if (region.count * (sizeof(u64) + sizeof(u64)) < dense_size) {
+        MakeSparse(region, alignment, width);
+    }
+}
+
+void MemoryScanner::ScanSparse(Region& region, const Query& query) {
+    const std::size_t num_chunks = GetNumChunks(region.count, MIN_RESULTS_PER_THREAD);
+    std::vector<std::vector<u64>> chunk_offsets(num_chunks);
+    std::vector<std::vector<u64>> chunk_values(num_chunks);
+
+    WithType(value_type, [&](auto type_tag) {
+        using T = decltype(type_tag);
+        WithPredicate<T>(query, [&](auto pred) {
+            ParallelFor(num_chunks, region.count, [&](std::size_t chunk, std::size_t begin,
+                                                      std::size_t end) {
+                auto& offsets = chunk_offsets[chunk];
+                auto& values = chunk_values[chunk];
+                for (std::size_t i = begin; i < end; ++i) {
+                    const VAddr vaddr = region.base + region.offsets[i] * alignment;
+                    T current;
+                    if (!source->Read(vaddr, reinterpret_cast<u8*>(&current), sizeof(T))) {
+                        continue;
+                    }
+                    if (pred(current, FromBits<T>(region.values[i]))) {
+                        offsets.push_back(region.offsets[i]);
+                        values.push_back(ToBits(current));
+                    }
+                }
+            });
+        });
+    });
+
+    region.offsets.clear();
+    region.values.clear();
+    for (std::size_t chunk = 0; chunk < num_chunks; ++chunk) {
+        region.offsets.insert(region.offsets.end(), chunk_offsets[chunk].begin(),
+                              chunk_offsets[chunk].end());
+        region.values.insert(region.values.end(), chunk_values[chunk].begin(),
+                             chunk_values[chunk].end());
+    }
+    region.count = region.offsets.size();
+}
+
+void MemoryScanner::MakeSparse(Region& region, u32 alignment, u32 width) {
+    const std::size_t slots_per_page = PAGE_SIZE / alignment;
+
+    region.offsets.clear();
+    region.values.clear();
+    region.offsets.reserve(region.count);
+    region.values.reserve(region.count);
+
+    for (std::size_t word = 0; word < region.bits.size(); ++word) {
+        for (u64 bits = region.bits[word]; bits != 0; bits &= bits - 1) {
+            const std::size_t slot = word * 64 + std::countr_zero(bits);
+            const std::size_t page = slot / slots_per_page;
+            const std::size_t offset = (slot % slots_per_page) * alignment;
+            u64 value = 0;
+            std::memcpy(&value, region.snapshot.data() + page * PADDED_PAGE_SIZE + offset, width);
+            region.offsets.push_back(slot);
+            region.values.push_back(value);
+        }
+    }
+
+    region.bits = {};
+    region.snapshot = {};
+}
+
+} // namespace Tools
@@ -0,0 +1,136 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "common/common_types.h"
+
+namespace Core {
+class System;
+} // namespace Core
+
+namespace Tools {
+
+/**
+ * Searches the writable heap and main module memory of the current process for values, then
+ * narrows the results down over further scans. This is how the addresses handed to the Freezer are
+ * usually found.
+ *
+ * Results are kept as a bitset with a snapshot of each region while there are many of them, and as
+ * sorted offsets with their last value once that is smaller. Scans are split across threads.
+ */
+class MemoryScanner {
+public:
+    enum class ValueType : u8 {
+        U8,
+        U16,
+        U32,
+        U64,
+        Float,
+        Double,
+    };
+
+    enum class Comparison : u8 {
+        /// Matches everything, for searching a value that isn't known yet. First scan only.
+        Any,
+        /// Equal to value
+        Exact,
+        /// Between value and upper, inclusive
+        Range,
+        /// Within tolerance of value, floating point types only
+        Fuzzy,
+        /// Compared with the value at the previous scan
+        Changed,
+        Unchanged,
+        Increased,
+        Decreased,
+    };
+
+    struct Query {
+        Comparison comparison;
+        /// Bit pattern of a value of the scanned type
+        u64 value{};
+        u64 upper{};
+        double tolerance{};
+    };
+
+    struct Result {
+        VAddr address;
+        /// Bit pattern of the value at the last scan
+        u64 value;
+    };
+
+    /// Memory read by the scans, the data of the current process unless a test provides its own.
+    class Source {
+    public:
+        struct Range {
+            VAddr base;
+            std::size_t size;
+        };
+
+        virtual ~Source();
+
+        /// Page aligned ranges to search, in address order.
+        [[nodiscard]] virtual std::vector<Range> GetRanges() = 0;
+
+        /// Copies size bytes at vaddr, returns false if they aren't all mapped. Called from
+        /// several threads at once.
+        virtual bool Read(VAddr vaddr, u8* dest, std::size_t size) = 0;
+    };
+
+    explicit MemoryScanner(Core::System& system_);
+    explicit MemoryScanner(std::unique_ptr<Source> source_);
+    ~MemoryScanner();
+
+    /// Starts a new search, alignment may be 1, 2, 4 or 8. Returns the number of results.
+    std::size_t FirstScan(ValueType type, u32 alignment, const Query& query);
+
+    /// Keeps the results of the last scan that match. Returns the number of results.
+    std::size_t NextScan(const Query& query);
+
+    /// Drops all results and snapshots.
+    void Reset();
+
+    [[nodiscard]] std::size_t GetResultCount() const;
+
+    /// Returns up to max results, starting at the given index, in address order.
+    [[nodiscard]] std::vector<Result> GetResults(std::size_t first, std::size_t max) const;
+
+private:
+    struct Region {
+        VAddr base;
+        std::size_t size;
+        std::size_t count;
+
+        /// One bit per slot, each page starts with a new word
+        std::vector<u64> bits;
+        /// Every page as of the last scan, followed by the first bytes of the next page so
+        /// values crossing the page end can be read
+        std::vector<u8> snapshot;
+
+        /// Slot indices of the results and their values, used once bits is released
+        std::vector<u64> offsets;
+        std::vector<u64> values;
+
+        [[nodiscard]] bool IsDense() const {
+            return !bits.empty();
+        }
+    };
+
+    void CollectRegions();
+    void ScanDense(Region& region, const Query& query, bool first);
+    void ScanSparse(Region& region, const Query& query);
+    static void MakeSparse(Region& region, u32 alignment, u32 width);
+
+    std::unique_ptr<Source> source;
+    std::vector<Region> regions;
+    ValueType value_type{ValueType::U32};
+    u32 alignment{4};
+    bool has_scanned{false};
+};
+
+} // namespace Tools
@@ -0,0 +1,238 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <utility>
+
+#include <boost/container/small_vector.hpp>
+
+#include "common/logging/log.h"
+#include "common/memory_hook.h"
+#include "core/core.h"
+#include "core/hle/kernel/memory/page_table.h"
+#include "core/hle/kernel/process.h"
+#include "core/memory.h"
+#include "core/tools/memory_watcher.h"
+
+namespace Tools {
+namespace {
+
+constexpr u32 MAX_WIDTH = 8;
+
+// Byte by byte, since a watch may straddle two pages that aren't contiguous on the host
+u64 ReadValue(Core::Memory::Memory& memory, VAddr address, u32 width) {
+    u64 value = 0;
+    for (u32 i = 0; i < width; ++i) {
+        if (const u8* const byte = memory.GetPointer(address + i)) {
+            value |= u64{*byte} << (i * 8);
+        }
+    }
+    return value;
+}
+
+void WriteValue(Core::Memory::Memory& memory, VAddr address, u32 width, u64 value) {
+    for (u32 i = 0; i < width; ++i) {
+        if (u8* const byte = memory.GetPointer(address + i)) {
+            *byte = static_cast<u8>(value >> (i * 8));
+        }
+    }
+}
+
+} // Anonymous namespace
+
+class MemoryWatcher::Hook final : public Common::MemoryHook {
+public:
+    explicit Hook(MemoryWatcher& watcher_) : watcher{watcher_} {}
+
+    std::optional<bool> IsValidAddress(VAddr) override {
+        return std::nullopt;
+    }
+
+    std::optional<u8> Read8(VAddr) override {
+        return std::nullopt;
+    }
+    std::optional<u16> Read16(VAddr) override {
+        return std::nullopt;
+    }
+    std::optional<u32> Read32(VAddr) override {
+        return std::nullopt;
+    }
+    std::optional<u64> Read64(VAddr) override {
+        return std::nullopt;
+    }
+
+    bool ReadBlock(VAddr, void*, std::size_t) override {
+        return false;
+    }
+
+    bool Write8(VAddr addr, u8 data) override {
+        return WriteBlock(addr, &data, sizeof(data));
+    }
+    bool Write16(VAddr addr, u16 data) override {
+        return WriteBlock(addr, &data, sizeof(data));
+    }
+    bool Write32(VAddr addr, u32 data) override {
+        return WriteBlock(addr, &data, sizeof(data));
+    }
+    bool Write64(VAddr addr, u64 data) override {
+        return WriteBlock(addr, &data, sizeof(data));
+    }
+
+    bool WriteBlock(VAddr dest_addr, const void* src_buffer, std::size_t size) override {
+        watcher.HandleWrite(dest_addr, src_buffer, size);
+        return true;
+    }
+
+    void OnRemap(VAddr base, u64 size) override {
+        watcher.HandleRemap(base, size);
+    }
+
+private:
+    MemoryWatcher& watcher;
+};
+
+MemoryWatcher::MemoryWatcher(Core::System& system_)
+    : system{system_}, hook{std::make_shared<Hook>(*this)} {}
+
+MemoryWatcher::~MemoryWatcher() {
+    Clear();
+}
+
+u64 MemoryWatcher::AddWatch(VAddr address, u32 width, Callback callback) {
+    if (width != 1 && width != 2 && width != 4 && width != 8) {
+        LOG_ERROR(Common_Memory, "Invalid watch width={:02X} for address={:016X}", width, address);
+        return 0;
+    }
+    if (system.CurrentProcess() == nullptr) {
+        return 0;
+    }
+
+    std::lock_guard lock{mutex};
+
+    const u64 handle = next_handle++;
+    watches.emplace(address,
+                    Watch{handle, width, std::make_shared<Callback>(std::move(callback))});
+    RefPages(address, width);
+
+    LOG_DEBUG(Common_Memory, "Watching memory at address={:016X}, width={:02X}", address, width);
+
+    return handle;
+}
+
+void MemoryWatcher::RemoveWatch(u64 handle) {
+    std::lock_guard lock{mutex};
+
+    const auto iter = std::find_if(watches.begin(), watches.end(), [handle](const auto& pair) {
+        return pair.second.handle == handle;
+    });
+    if (iter == watches.end()) {
+        return;
+    }
+
+    LOG_DEBUG(Common_Memory, "Removing memory watch at address={:016X}", iter->first);
+
+    UnrefPages(iter->first, iter->second.width);
+    watches.erase(iter);
+}
+
+void MemoryWatcher::Clear() {
+    std::lock_guard lock{mutex};
+
+    if (Kernel::Process* const process = system.CurrentProcess()) {
+        auto& page_table = process->PageTable().PageTableImpl();
+        for (const auto& [page, refs] : page_refs) {
+            system.Memory().RemoveDebugHook(page_table, page, Core::Memory::PAGE_SIZE, hook);
+        }
+    }
+    page_refs.clear();
+    watches.clear();
+}
+
+void MemoryWatcher::WaitForCallbacks() const {
+    while (running_callbacks.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+}
+
+void MemoryWatcher::RefPages(VAddr address, u32 width) {
+    auto& page_table = system.CurrentProcess()->PageTable().PageTableImpl();
+    for (VAddr page = address & ~Core::Memory::PAGE_MASK; page < address + width;
+         page += Core::Memory::PAGE_SIZE) {
+        if (page_refs[page]++ == 0) {
+            system.Memory().AddDebugHook(page_table, page, Core::Memory::PAGE_SIZE, hook);
+        }
+    }
+}
+
+void MemoryWatcher::UnrefPages(VAddr address, u32 width) {
+    Kernel::Process* const process = system.CurrentProcess();
+    for (VAddr page = address & ~Core::Memory::PAGE_MASK; page < address + width;
+         page += Core::Memory::PAGE_SIZE) {
+        const auto iter = page_refs.find(page);
+        if (iter == page_refs.end() || --iter->second != 0) {
+            continue;
+        }
+        page_refs.erase(iter);
+        if (process != nullptr) {
+            system.Memory().RemoveDebugHook(process->PageTable().PageTableImpl(), page,
+                                            Core::Memory::PAGE_SIZE, hook);
+        }
+    }
+}
+
+void MemoryWatcher::HandleRemap(VAddr base, u64 size) {
+    std::lock_guard lock{mutex};
+
+    Kernel::Process* const process = system.CurrentProcess();
+    if (process == nullptr) {
+        return;
+    }
+
+    // Watches follow their addresses, hook whatever is mapped there now
+    auto& page_table = process->PageTable().PageTableImpl();
+    const auto last = page_refs.lower_bound(base + size);
+    for (auto iter = page_refs.lower_bound(base); iter != last; ++iter) {
+        system.Memory().AddDebugHook(page_table, iter->first, Core::Memory::PAGE_SIZE, hook);
+    }
+}
+
+void MemoryWatcher::HandleWrite(VAddr address, const void* data, std::size_t size) {
+    auto& memory = system.Memory();
+
+    // The hook performs the write itself so callbacks see the new value
+    if (u8* const host_ptr = memory.GetPointer(address)) {
+        std::memcpy(host_ptr, data, size);
+    }
+
+    boost::container::small_vector<std::pair<VAddr, Watch>, 4> triggered;
+    {
+        std::lock_guard lock{mutex};
+
+        // No watch starting more than MAX_WIDTH bytes earlier can overlap the write
+        const VAddr first = address >= MAX_WIDTH ? address - (MAX_WIDTH - 1) : 0;
+        for (auto iter = watches.lower_bound(first);
+             iter != watches.end() && iter->first < address + size; ++iter) {
+            if (iter->first + iter->second.width > address) {
+                triggered.push_back(*iter);
+            }
+        }
+        if (triggered.empty()) {
+            return;
+        }
+        running_callbacks.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    for (const auto& [watch_address, watch] : triggered) {
+        const u64 value = ReadValue(memory, watch_address, watch.width);
+        if (const auto replacement = (*watch.callback)(watch_address, value)) {
+            WriteValue(memory, watch_address, watch.width, *replacement);
+        }
+    }
+
+    running_callbacks.fetch_sub(1, std::memory_order_release);
+}
+
+} // namespace Tools
@@ -0,0 +1,81 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include "common/common_types.h"
+
+namespace Core {
+class System;
+} // namespace Core
+
+namespace Tools {
+
+/**
+ * Calls back whenever the emulated application writes to a watched range of memory. The pages
+ * holding a watch get a debug hook, so only accesses to those pages leave the fast path and nothing
+ * has to be polled.
+ *
+ * Callbacks run on the thread that did the write, usually a CPU core, right after the write.
+ * Watches stay on their addresses when the memory there is remapped.
+ */
+class MemoryWatcher {
+public:
+    /// Receives the address of the watch and the value it now holds. Returning a value stores it
+    /// in place of what was written, which is how the freezer keeps values from changing.
+    using Callback = std::function<std::optional<u64>(VAddr address, u64 value)>;
+
+    explicit MemoryWatcher(Core::System& system_);
+    ~MemoryWatcher();
+
+    /// Watches width bytes (1, 2, 4 or 8) at address in the current process. Returns a handle for
+    /// RemoveWatch, or zero if the watch couldn't be added.
+    u64 AddWatch(VAddr address, u32 width, Callback callback);
+
+    /// Stops a watch. A callback that was already started may still be running.
+    void RemoveWatch(u64 handle);
+
+    /// Removes every watch and the hooks they installed.
+    void Clear();
+
+    /// Waits until no callback is running, must not be called from a callback.
+    void WaitForCallbacks() const;
+
+private:
+    class Hook;
+
+    struct Watch {
+        u64 handle;
+        u32 width;
+        std::shared_ptr<Callback> callback;
+    };
+
+    void RefPages(VAddr address, u32 width);
+    void UnrefPages(VAddr address, u32 width);
+
+    /// Called by the hook when pages it was on have been remapped, which removed it from them.
+    void HandleRemap(VAddr base, u64 size);
+
+    /// Called by the hook, writes size bytes of data and runs the callbacks of overlapping watches.
+    void HandleWrite(VAddr address, const void* data, std::size_t size);
+
+    Core::System& system;
+    std::shared_ptr<Hook> hook;
+
+    mutable std::mutex mutex;
+    std::multimap<VAddr, Watch> watches;
+    /// Number of watches on each hooked page
+    std::map<VAddr, u32> page_refs;
+    u64 next_handle{1};
+
+    std::atomic<u32> running_callbacks{0};
+};
+
+} // namespace Tools
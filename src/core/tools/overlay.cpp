@@ -0,0 +1,235 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+
+#include <QColor>
+#include <QImage>
+#include <QPainter>
+#include <QPen>
+#include <QString>
+
+#include "common/assert.h"
+#include "core/tools/overlay.h"
+
+namespace Tools {
+
+namespace {
+
+constexpr std::size_t BYTES_PER_PIXEL = 4;
+
+QColor ToQColor(PluginDefinitions::GuiColor color) {
+    return QColor(color.red, color.green, color.blue, color.alpha);
+}
+
+bool operator!=(PluginDefinitions::GuiColor lhs, PluginDefinitions::GuiColor rhs) {
+    return lhs.red != rhs.red || lhs.green != rhs.green || lhs.blue != rhs.blue ||
+           lhs.alpha != rhs.alpha;
+}
+
+/// Source-over blend of a non premultiplied color onto a non premultiplied RGBA8 pixel
+void BlendPixel(u8* dest, PluginDefinitions::GuiColor color) {
+    if (color.alpha == 0xFF) {
+        dest[0] = color.red;
+        dest[1] = color.green;
+        dest[2] = color.blue;
+        dest[3] = 0xFF;
+        return;
+    }
+
+    const u32 src_alpha = color.alpha;
+    const u32 dest_alpha = dest[3] * (0xFF - src_alpha) / 0xFF;
+    const u32 out_alpha = src_alpha + dest_alpha;
+    if (out_alpha == 0) {
+        return;
+    }
+    const auto blend = [&](u8 src, u8 dst) {
+        return static_cast<u8>((src * src_alpha + dst * dest_alpha) / out_alpha);
+    };
+    dest[0] = blend(color.red, dest[0]);
+    dest[1] = blend(color.green, dest[1]);
+    dest[2] = blend(color.blue, dest[2]);
+    dest[3] = static_cast<u8>(out_alpha);
+}
+
+} // Anonymous namespace
+
+OverlayDisplayList::OverlayDisplayList() = default;
+
+OverlayDisplayList::~OverlayDisplayList() = default;
+
+void OverlayDisplayList::Reset() {
+    commands.clear();
+    pixels.clear();
+    blits.clear();
+    blit_data.clear();
+    lines.clear();
+    rects.clear();
+    texts.clear();
+}
+
+void OverlayDisplayList::AddClear() {
+    // Everything recorded before a clear would be erased anyway
+    Reset();
+    commands.push_back({CommandType::Clear, 0, 0});
+}
+
+void OverlayDisplayList::AddPixel(s32 x, s32 y, PluginDefinitions::GuiColor color) {
+    pixels.push_back({x, y, color});
+    PushCommand(CommandType::Pixels, pixels.size() - 1, 1);
+}
+
+void OverlayDisplayList::AddBlit(s32 x, s32 y, u32 width, u32 height, const u8* data, u32 stride) {
+    const std::size_t row_size = std::size_t{width} * BYTES_PER_PIXEL;
+    const std::size_t offset = blit_data.size();
+    blit_data.resize(offset + row_size * height);
+
+    u8* dest = blit_data.data() + offset;
+    if (stride == row_size) {
+        std::memcpy(dest, data, row_size * height);
+    } else {
+        for (u32 row = 0; row < height; ++row) {
+            std::memcpy(dest + row * row_size, data + std::size_t{row} * stride, row_size);
+        }
+    }
+
+    blits.push_back({x, y, width, height, offset});
+    PushCommand(CommandType::Blit, blits.size() - 1, 1);
+}
+
+void OverlayDisplayList::AddLines(const PluginDefinitions::GuiLine* new_lines, std::size_t count) {
+    const std::size_t first = lines.size();
+    lines.insert(lines.end(), new_lines, new_lines + count);
+    PushCommand(CommandType::Lines, first, count);
+}
+
+void OverlayDisplayList::AddRects(const PluginDefinitions::GuiRect* new_rects, std::size_t count) {
+    const std::size_t first = rects.size();
+    rects.insert(rects.end(), new_rects, new_rects + count);
+    PushCommand(CommandType::Rects, first, count);
+}
+
+void OverlayDisplayList::AddTexts(const PluginDefinitions::GuiText* new_texts, std::size_t count) {
+    const std::size_t first = texts.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& text = new_texts[i];
+        texts.push_back({text.x, text.y, text.color, text.text ? text.text : ""});
+    }
+    PushCommand(CommandType::Texts, first, count);
+}
+
+void OverlayDisplayList::PushCommand(CommandType type, std::size_t first, std::size_t count) {
+    if (count == 0) {
+        return;
+    }
+    if (!commands.empty() && commands.back().type == type &&
+        commands.back().first + commands.back().count == first) {
+        commands.back().count += count;
+        return;
+    }
+    commands.push_back({type, first, count});
+}
+
+void OverlayDisplayList::CompositePixels(QImage& target, const Command& command) const {
+    const s32 width = target.width();
+    const s32 height = target.height();
+    u8* const bits = target.bits();
+    const std::size_t stride = static_cast<std::size_t>(target.bytesPerLine());
+
+    for (std::size_t i = command.first; i < command.first + command.count; ++i) {
+        const Pixel& pixel = pixels[i];
+        if (pixel.x < 0 || pixel.y < 0 || pixel.x >= width || pixel.y >= height) {
+            continue;
+        }
+        BlendPixel(bits + pixel.y * stride + pixel.x * BYTES_PER_PIXEL, pixel.color);
+    }
+}
+
+void OverlayDisplayList::Composite(QImage& target) const {
+    ASSERT(target.format() == QImage::Format_RGBA8888);
+
+    // Pixels and clears write the image directly, so the painter is only opened for the batches
+    // that actually need it
+    std::optional<QPainter> painter;
+    const auto get_painter = [&]() -> QPainter& {
+        if (!painter) {
+            painter.emplace(&target);
+        }
+        return *painter;
+    };
+    const auto end_painter = [&] {
+        if (painter) {
+            painter->end();
+            painter.reset();
+        }
+    };
+
+    for (const Command& command : commands) {
+        switch (command.type) {
+        case CommandType::Clear:
+            end_painter();
+            target.fill(Qt::GlobalColor::transparent);
+            break;
+        case CommandType::Pixels:
+            end_painter();
+            CompositePixels(target, command);
+            break;
+        case CommandType::Blit: {
+            QPainter& p = get_painter();
+            for (std::size_t i = command.first; i < command.first + command.count; ++i) {
+                const Blit& blit = blits[i];
+                // Wraps the recorded pixels without copying them
+                const QImage image(blit_data.data() + blit.offset, static_cast<int>(blit.width),
+                                   static_cast<int>(blit.height),
+                                   static_cast<int>(blit.width * BYTES_PER_PIXEL),
+                                   QImage::Format_RGBA8888);
+                p.drawImage(blit.x, blit.y, image);
+            }
+            break;
+        }
+        case CommandType::Lines: {
+            QPainter& p = get_painter();
+            std::optional<PluginDefinitions::GuiColor> current_color;
+            for (std::size_t i = command.first; i < command.first + command.count; ++i) {
+                const auto& line = lines[i];
+                if (!current_color || *current_color != line.color) {
+                    current_color = line.color;
+                    p.setPen(ToQColor(line.color));
+                }
+                p.drawLine(line.x0, line.y0, line.x1, line.y1);
+            }
+            break;
+        }
+        case CommandType::Rects: {
+            QPainter& p = get_painter();
+            for (std::size_t i = command.first; i < command.first + command.count; ++i) {
+                const auto& rect = rects[i];
+                if (rect.filled) {
+                    p.fillRect(rect.x, rect.y, rect.width, rect.height, ToQColor(rect.color));
+                } else {
+                    p.setPen(ToQColor(rect.color));
+                    p.setBrush(Qt::NoBrush);
+                    p.drawRect(rect.x, rect.y, rect.width, rect.height);
+                }
+            }
+            break;
+        }
+        case CommandType::Texts: {
+            QPainter& p = get_painter();
+            for (std::size_t i = command.first; i < command.first + command.count; ++i) {
+                const Text& text = texts[i];
+                p.setPen(ToQColor(text.color));
+                p.drawText(text.x, text.y, QString::fromStdString(text.text));
+            }
+            break;
+        }
+        default:
+            UNREACHABLE();
+        }
+    }
+}
+
+} // namespace Tools
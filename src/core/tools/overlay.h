@@ -0,0 +1,102 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include "common/common_types.h"
+#include "core/tools/plugin_definitions.h"
+
+class QImage;
+
+namespace Tools {
+
+/**
+ * Records the drawing commands plugins issue during a frame so they can be composited onto the
+ * overlay image in one pass, instead of going through QPainter once per call. Consecutive commands
+ * of the same kind are merged into a single batch.
+ */
+class OverlayDisplayList {
+public:
+    OverlayDisplayList();
+    ~OverlayDisplayList();
+
+    /// Drops every recorded command.
+    void Reset();
+
+    /// Records clearing the whole overlay to transparent.
+    void AddClear();
+
+    void AddPixel(s32 x, s32 y, PluginDefinitions::GuiColor color);
+
+    /// Records copying an RGBA8 image to the given position. The pixels are copied immediately.
+    void AddBlit(s32 x, s32 y, u32 width, u32 height, const u8* pixels, u32 stride);
+
+    void AddLines(const PluginDefinitions::GuiLine* lines, std::size_t count);
+
+    void AddRects(const PluginDefinitions::GuiRect* rects, std::size_t count);
+
+    void AddTexts(const PluginDefinitions::GuiText* texts, std::size_t count);
+
+    [[nodiscard]] bool IsEmpty() const {
+        return commands.empty();
+    }
+
+    /// Draws every recorded command in order onto the target, which must be RGBA8888.
+    void Composite(QImage& target) const;
+
+private:
+    enum class CommandType : u8 {
+        Clear,
+        Pixels,
+        Blit,
+        Lines,
+        Rects,
+        Texts,
+    };
+
+    struct Command {
+        CommandType type;
+        std::size_t first;
+        std::size_t count;
+    };
+
+    struct Pixel {
+        s32 x;
+        s32 y;
+        PluginDefinitions::GuiColor color;
+    };
+
+    struct Blit {
+        s32 x;
+        s32 y;
+        u32 width;
+        u32 height;
+        std::size_t offset;
+    };
+
+    struct Text {
+        s32 x;
+        s32 y;
+        PluginDefinitions::GuiColor color;
+        std::string text;
+    };
+
+    /// Appends count entries to the last command if it has the same type, otherwise a new one.
+    void PushCommand(CommandType type, std::size_t first, std::size_t count);
+
+    void CompositePixels(QImage& target, const Command& command) const;
+
+    std::vector<Command> commands;
+    std::vector<Pixel> pixels;
+    std::vector<Blit> blits;
+    std::vector<u8> blit_data;
+    std::vector<PluginDefinitions::GuiLine> lines;
+    std::vector<PluginDefinitions::GuiRect> rects;
+    std::vector<Text> texts;
+};
+
+} // namespace Tools
@@ -1,6 +1,6 @@
 #pragma once
 
-#define PLUGIN_INTERFACE_VERSION 1
+#define PLUGIN_INTERFACE_VERSION 2
 
 #define BIT(n) (1U << (n))
 
@@ -342,6 +342,102 @@ enum class SixAxisMotionTypes : uint8_t {
     DirectionZZ,
 };
 
+// One range of a scattered memory read or write
+struct MemoryRange {
+    uint64_t address;
+    uint64_t length;
+    // Destination of a read or source of a write, may be null to only look up host_pointer
+    uint8_t* buffer;
+    // Filled in with a pointer directly into guest memory if the whole range is regular contiguous
+    // memory, null otherwise. Stays valid until the game remaps the range
+    uint8_t* host_pointer;
+};
+
+enum class MemoryScanType : uint8_t {
+    U8,
+    U16,
+    U32,
+    U64,
+    Float,
+    Double,
+};
+
+enum class MemoryScanComparison : uint8_t {
+    // Matches everything, first scan only
+    Any,
+    Exact,
+    // Between value and upper, inclusive
+    Range,
+    // Within tolerance of value, floating point types only
+    Fuzzy,
+    // Compared with the value at the previous scan
+    Changed,
+    Unchanged,
+    Increased,
+    Decreased,
+};
+
+struct MemoryScanQuery {
+    MemoryScanComparison comparison;
+    // Bit patterns of values of the scanned type
+    uint64_t value;
+    uint64_t upper;
+    double tolerance;
+};
+
+struct MemoryScanResult {
+    uint64_t address;
+    // Bit pattern of the value at the last scan
+    uint64_t value;
+};
+
+// Called on the emulated CPU thread right after the game writes to a watched address, with the value
+// the address now holds. Must not add or remove watchpoints
+typedef void(MemoryWatchCallback)(void* userdata, uint64_t address, uint64_t value);
+
+// A frame presented by the renderer, owned by the emulator and never copied
+struct FrameInfo {
+    // RGBA8 pixels, rows are stored bottom to top
+    const uint8_t* data;
+    uint64_t frame_number;
+    uint32_t width;
+    uint32_t height;
+    // Bytes per row
+    uint32_t stride;
+};
+
+struct GuiColor {
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+    uint8_t alpha;
+};
+
+struct GuiLine {
+    int32_t x0;
+    int32_t y0;
+    int32_t x1;
+    int32_t y1;
+    GuiColor color;
+};
+
+struct GuiRect {
+    int32_t x;
+    int32_t y;
+    int32_t width;
+    int32_t height;
+    GuiColor color;
+    // Non zero fills the rectangle, otherwise only the outline is drawn
+    uint8_t filled;
+};
+
+struct GuiText {
+    int32_t x;
+    int32_t y;
+    GuiColor color;
+    const char* text;
+};
+
 enum PopupType : uint8_t {
     NoIcon,
     Information,
@@ -353,20 +449,39 @@ typedef void(meta_setup_plugin)();
 typedef void(meta_handle_main_loop)();
 typedef uint64_t(meta_getplugininterfaceversion)();
 typedef void(meta_handle_close)();
+// Optional, returning true runs on_main_loop on the vsync thread once per frame
+typedef uint8_t(meta_run_inline)();
 
 typedef void(meta_free)(void*);
 typedef void(emu_frameadvance)(void* ctx);
+// Runs the main loop as soon as possible, even if its period has not elapsed
+typedef void(emu_requestmainloop)(void* ctx);
+// Sets how often the main loop runs on its own, zero disables it so only requests run it
+typedef void(emu_setmainloopperiod)(void* ctx, uint64_t ns);
 typedef void(emu_pause)(void* ctx);
 typedef void(emu_unpause)(void* ctx);
 typedef int32_t(emu_framecount)(void* ctx);
 typedef float(emu_fps)(void* ctx);
 typedef uint8_t(emu_emulating)(void* ctx);
+// Emulation has to be paused with emu_pause. Loading only succeeds in the same session of the game
+// while its threads are in the kernel state they were saved in, otherwise nothing is changed
+typedef uint8_t(emu_savestate)(void* ctx, const char* path);
+typedef uint8_t(emu_loadstate)(void* ctx, const char* path);
+// Goes back the given number of frames when the next one is presented, 0 undoes everything since
+// the last one. Returns false unless rewinding is enabled in the settings
+typedef uint8_t(emu_rewind)(void* ctx, uint64_t frames);
 /*
 typedef char*(emu_getgamedir)(void* ctx);
 typedef void(emu_loadrom)(void* ctx, const char* filename);
 typedef uint8_t*(emu_getscreenframebuffer)(void* ctx, uint64_t* size);
 typedef uint8_t*(emu_getscreenjpeg)(void* ctx, uint64_t* size);
 */
+// Starts or stops the renderer from publishing presented frames for emu_getlatestframe
+typedef void(emu_enableframering)(void* ctx, uint8_t enable);
+// Returns false if no frame was published yet. The data is only guaranteed to be intact while
+// emu_isframevalid returns true for its frame number, so check after reading it
+typedef uint8_t(emu_getlatestframe)(void* ctx, FrameInfo* info);
+typedef uint8_t(emu_isframevalid)(void* ctx, uint64_t frame_number);
 typedef char*(emu_romname)(void* ctx);
 typedef uint64_t(emu_getprogramid)(void* ctx);
 typedef uint64_t(emu_getprocessid)(void* ctx);
@@ -380,6 +495,20 @@ typedef void(emu_log)(void* ctx, const char* logmessage, LogLevel level);
 typedef uint8_t(memory_readbyterange)(void* ctx, uint64_t address, uint8_t* bytes, uint64_t length);
 typedef uint8_t(memory_writebyterange)(void* ctx, uint64_t address, uint8_t* bytes,
                                        uint64_t length);
+typedef uint8_t(memory_readscatter)(void* ctx, MemoryRange* ranges, uint64_t count);
+typedef uint8_t(memory_writegather)(void* ctx, MemoryRange* ranges, uint64_t count);
+// Width is 1, 2, 4 or 8 bytes. Returns a handle for memory_removewatchpoint, zero on failure
+typedef uint64_t(memory_addwatchpoint)(void* ctx, uint64_t address, uint8_t width,
+                                       MemoryWatchCallback* callback, void* userdata);
+typedef void(memory_removewatchpoint)(void* ctx, uint64_t handle);
+// Searches the heap and main module data, alignment is 1, 2, 4 or 8. Returns the result count
+typedef uint64_t(memory_scanfirst)(void* ctx, MemoryScanType type, uint8_t alignment,
+                                   const MemoryScanQuery* query);
+// Narrows down the results of the last scan, returns the remaining count
+typedef uint64_t(memory_scannext)(void* ctx, const MemoryScanQuery* query);
+// Copies up to max results starting at index first, returns how many were copied
+typedef uint64_t(memory_getscanresults)(void* ctx, uint64_t first, MemoryScanResult* results,
+                                        uint64_t max);
 typedef uint64_t(debugger_getclockticks)(void* ctx);
 typedef uint64_t(debugger_getcputicks)(void* ctx);
 typedef uint64_t(joypad_read)(void* ctx, ControllerNumber player);
@@ -419,12 +548,26 @@ typedef void(input_settouch)(void* ctx, uint8_t idx, TouchTypes type, uint32_t v
 typedef void(input_movemouse)(void* ctx, MouseTypes type, int32_t val);
 typedef int32_t(input_readmouse)(void* ctx, MouseTypes type);
 typedef void(input_enableoutsideinput)(void* ctx, EnableInputType typetoenable, uint8_t enable);
+// Input movies replace the joypad, keyboard and touch input on every frame while playing
+typedef uint8_t(movie_startrecording)(void* ctx, const char* path);
+typedef uint8_t(movie_startplayback)(void* ctx, const char* path);
+// Writes the movie if one was being recorded
+typedef uint8_t(movie_stop)(void* ctx);
+typedef uint8_t(movie_seek)(void* ctx, uint64_t frame);
+typedef uint64_t(movie_getframe)(void* ctx);
+typedef uint64_t(movie_getframecount)(void* ctx);
 typedef uint32_t(gui_getwidth)(void* ctx);
 typedef uint32_t(gui_getheight)(void* ctx);
 typedef void(gui_clearscreen)(void* ctx);
 typedef void(gui_render)(void* ctx);
 typedef void(gui_drawpixel)(void* ctx, uint32_t x, uint32_t y, uint8_t red, uint8_t green,
                             uint8_t blue, uint8_t alpha);
+// Drawing is recorded and only composited onto the overlay by gui_render
+typedef void(gui_blit)(void* ctx, int32_t x, int32_t y, uint32_t width, uint32_t height,
+                       const uint8_t* pixels, uint32_t stride);
+typedef void(gui_drawlines)(void* ctx, const GuiLine* lines, uint64_t count);
+typedef void(gui_drawrects)(void* ctx, const GuiRect* rects, uint64_t count);
+typedef void(gui_drawtexts)(void* ctx, const GuiText* texts, uint64_t count);
 typedef bool(gui_savescreenshotas)(void* ctx, const char* path);
 typedef void(gui_drawimage)(void* ctx, int32_t dx, int32_t dy, const char* path, int32_t sx,
                             int32_t sy, int32_t sw, int32_t sh);
@@ -25,13 +25,10 @@
 
 #include <QBuffer>
 #include <QByteArray>
-#include <QColor>
 #include <QFile>
 #include <QImageWriter>
 #include <QMessageBox>
-#include <QPainter>
 #include <QPixmap>
-#include <QRectF>
 #include <QString>
 
 #include "common/assert.h"
@@ -53,36 +50,94 @@
 #include "core/loader/loader.h"
 #include "core/memory.h"
 #include "core/settings.h"
+#include "core/tools/input_movie.h"
+#include "core/tools/memory_watcher.h"
 #include "core/tools/plugin_definitions.h"
 #include "core/tools/plugin_manager.h"
+#include "core/tools/rewind_buffer.h"
+#include "core/tools/save_state.h"
 #include "video_core/renderer_base.h"
 
 namespace Tools {
-// Approximately every 4 frames
+// Approximately every 4 frames, used until a plugin chooses its own period
 constexpr auto plugin_manager_ns = std::chrono::nanoseconds{(1000000000 / 60) * 4};
 
+static MemoryScanner::Query ToScannerQuery(const PluginDefinitions::MemoryScanQuery& query) {
+    return {
+        .comparison = static_cast<MemoryScanner::Comparison>(query.comparison),
+        .value = query.value,
+        .upper = query.upper,
+        .tolerance = query.tolerance,
+    };
+}
+
 PluginManager::PluginManager(Core::System& system_)
     : system{system_}, core_timing{system.CoreTiming()}, memory{system.Memory()} {}
 
 PluginManager::~PluginManager() {
     if (plugin_main_loop_thread) {
         run_main_loop_thread = false;
+        main_loop_event.Set();
         plugin_main_loop_thread->join();
     }
 }
 
 void PluginManager::SetActive(bool active_) {
-    if (active.exchange(active_)) {
+    active.store(active_);
+
+    if (active_) {
         // Check if thread hasn't been created before and create it
         if (!plugin_main_loop_thread) {
-            plugin_main_loop_thread = std::make_unique<std::thread>([&]() {
-                while (run_main_loop_thread.load(std::memory_order_relaxed)) {
-                    std::this_thread::sleep_for(plugin_manager_ns);
-                    ProcessScriptFromMainLoop();
-                }
-            });
+            plugin_main_loop_thread =
+                std::make_unique<std::thread>(&PluginManager::MainLoopThreadExecuter, this);
+        }
+        WakeMainLoop();
+    }
+}
+
+void PluginManager::WakeMainLoop() {
+    main_loop_event.Set();
+}
+
+void PluginManager::MainLoopThreadExecuter() {
+    while (run_main_loop_thread.load(std::memory_order_relaxed)) {
+        // Sleep until the closest plugin is due or a plugin asks to be run, an idle plugin
+        // manager never wakes up on its own
+        const auto deadline = NextMainLoopDeadline();
+        if (deadline) {
+            main_loop_event.WaitUntil(*deadline);
+        } else {
+            main_loop_event.Wait();
+        }
+
+        if (!run_main_loop_thread.load(std::memory_order_relaxed)) {
+            break;
+        }
+
+        ProcessScriptFromMainLoop();
+    }
+}
+
+std::optional<std::chrono::steady_clock::time_point> PluginManager::NextMainLoopDeadline() const {
+    std::lock_guard lock{plugins_mutex};
+
+    if (!IsActive()) {
+        return std::nullopt;
+    }
+
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+    for (const auto& plugin : plugins) {
+        // Plugins still inside their main loop are resumed by vsync, they wake this thread
+        // again once they finish it
+        if (plugin->runInline || plugin->mainLoopPeriod.load().count() == 0 ||
+            !plugin->processedMainLoop.load(std::memory_order_relaxed)) {
+            continue;
+        }
+        if (!deadline || plugin->nextMainLoop < *deadline) {
+            deadline = plugin->nextMainLoop;
         }
     }
+    return deadline;
 }
 
 bool PluginManager::IsActive() const {
@@ -96,26 +151,28 @@ void PluginManager::ProcessScript(std::shared_ptr<Plugin> plugin) {
             std::make_unique<std::thread>(&PluginManager::PluginThreadExecuter, this, plugin);
     }
 
-    {
-        std::lock_guard<std::mutex> lk(plugin->pluginMutex);
-        plugin->ready = true;
+    // Let the plugin run until it either finishes its main loop or reaches a vsync boundary
+    plugin->rendezvous.HandToAndWait(Common::Rendezvous::Side::Worker,
+                                     Common::Rendezvous::Side::Host);
+
+    // Check if the PluginManager has been told to unload the plugin
+    // Can only unload on main loop boundaries
+    if (plugin->processedMainLoop.load(std::memory_order_relaxed) &&
+        loaded_plugins.find(plugin->path) == loaded_plugins.end()) {
+        plugin->hasStopped = true;
+        temp_plugins_to_remove.push_back(plugin);
     }
-    // Signal thread it may start
-    plugin->pluginCv.notify_one();
-
-    {
-        // Wait for thread to finish momentarily
-        std::unique_lock<std::mutex> lk(plugin->pluginMutex);
-        plugin->pluginCv.wait(
-            lk, [plugin] { return plugin->processedMainLoop || plugin->encounteredVsync; });
-
-        // Check if the PluginManager has been told to unload the plugin
-        // Can only unload on main loop boundaries
-        if (plugin->processedMainLoop.load(std::memory_order_relaxed) &&
-            loaded_plugins.find(plugin->path) == loaded_plugins.end()) {
-            plugin->hasStopped = true;
-            temp_plugins_to_remove.push_back(plugin);
-        }
+}
+
+void PluginManager::ProcessScriptInline(std::shared_ptr<Plugin> plugin) {
+    EnsureHidAppletLoaded(plugin);
+
+    // Inline plugins get exactly one call of their main loop per frame
+    plugin->mainLoopFunction();
+
+    if (loaded_plugins.find(plugin->path) == loaded_plugins.end()) {
+        plugin->hasStopped = true;
+        temp_plugins_to_remove.push_back(plugin);
     }
 }
 
@@ -124,7 +181,9 @@ void PluginManager::ProcessScriptFromVsync() {
         std::lock_guard lock{plugins_mutex};
 
         for (auto& plugin : plugins) {
-            if (plugin->encounteredVsync.load(std::memory_order_relaxed)) {
+            if (plugin->runInline) {
+                ProcessScriptInline(plugin);
+            } else if (plugin->encounteredVsync.load(std::memory_order_relaxed)) {
                 // Continue thread from the vsync event
                 plugin->encounteredVsync = false;
 
@@ -148,8 +207,18 @@ void PluginManager::ProcessScriptFromMainLoop() {
     if (IsActive()) {
         std::lock_guard lock{plugins_mutex};
 
+        const auto now = std::chrono::steady_clock::now();
         for (auto& plugin : plugins) {
-            if (plugin->processedMainLoop.load(std::memory_order_relaxed)) {
+            if (plugin->runInline || !plugin->processedMainLoop.load(std::memory_order_relaxed)) {
+                continue;
+            }
+
+            const auto period = plugin->mainLoopPeriod.load();
+            const bool requested = plugin->mainLoopRequested.exchange(false);
+            const bool due = period.count() != 0 && now >= plugin->nextMainLoop;
+            if (requested || due) {
+                plugin->nextMainLoop = now + period;
+
                 // Continue thread from the beginning of the main loop
                 plugin->processedMainLoop = false;
 
@@ -165,12 +234,11 @@ void PluginManager::ProcessScriptFromMainLoop() {
 
 void PluginManager::PluginThreadExecuter(std::shared_ptr<Plugin> plugin) {
     while (true) {
-        std::unique_lock<std::mutex> lk(plugin->pluginMutex);
-        plugin->pluginCv.wait(lk, [this, plugin] { return plugin->ready; });
-        plugin->ready = false;
+        plugin->rendezvous.WaitFor(Common::Rendezvous::Side::Worker);
 
         if (plugin->hasStopped) {
             plugin->processedMainLoop = true;
+            plugin->rendezvous.HandTo(Common::Rendezvous::Side::Host);
             return;
         }
 
@@ -181,10 +249,10 @@ void PluginManager::PluginThreadExecuter(std::shared_ptr<Plugin> plugin) {
         plugin->mainLoopFunction();
 
         // Once the end of this function is reached, the main loop must have completed
-        lk.unlock();
         plugin->processedMainLoop = true;
         plugin->encounteredVsync = false;
-        plugin->pluginCv.notify_one();
+        main_loop_event.Set();
+        plugin->rendezvous.HandTo(Common::Rendezvous::Side::Host);
     }
 }
 
@@ -255,15 +323,25 @@ bool PluginManager::LoadPlugin(std::string path, std::string name) {
 
         plugin->mainLoopFunction = mainLoop;
 
+        PluginDefinitions::meta_run_inline* runInline =
+            GetDllFunction<PluginDefinitions::meta_run_inline>(*plugin, "run_inline");
+        plugin->runInline = runInline && runInline();
+
         ConnectAllDllFunctions(plugin);
 
         loaded_plugins.insert(path);
 
         plugin->system = &system;
+        plugin->pluginManager = this;
+        plugin->mainLoopPeriod = plugin_manager_ns;
+        plugin->nextMainLoop = std::chrono::steady_clock::now();
 
         setup();
 
         plugins.push_back(plugin);
+
+        // Let the main loop thread take the new plugin's deadline into account
+        WakeMainLoop();
     }
 
     return true;
@@ -275,7 +353,6 @@ void PluginManager::RegenerateGuiRendererIfNeeded() {
     if (lastDockedState == LastDockedState::Neither || lastDockedState != thisDockedState) {
         lastDockedState = thisDockedState;
         delete guiPixmap;
-        delete guiPainter;
         if (Settings::values.use_docked_mode) {
             guiPixmap = new QImage((int)Service::VI::DisplayResolution::DockedWidth,
                                    (int)Service::VI::DisplayResolution::DockedHeight,
@@ -286,8 +363,18 @@ void PluginManager::RegenerateGuiRendererIfNeeded() {
                                    QImage::Format_RGBA8888);
         }
         guiPixmap->fill(0);
-        guiPainter = new QPainter(guiPixmap);
-        guiPainter->setWindow(guiPixmap->rect());
+    }
+}
+
+void PluginManager::RenderGui() {
+    std::lock_guard lock{overlay_mutex};
+
+    RegenerateGuiRendererIfNeeded();
+    overlay.Composite(*guiPixmap);
+    overlay.Reset();
+
+    if (render_callback) {
+        render_callback(*guiPixmap);
     }
 }
 
@@ -310,7 +397,22 @@ void PluginManager::HandlePluginClosings() {
         if (closeFunction) {
             closeFunction();
         }
-        plugin->pluginThread->join();
+        if (plugin->pluginThread) {
+            // Wake the thread so it can observe hasStopped and exit
+            plugin->rendezvous.HandToAndWait(Common::Rendezvous::Side::Worker,
+                                             Common::Rendezvous::Side::Host);
+            plugin->pluginThread->join();
+        }
+
+        {
+            // The callbacks live in the library that is about to be unloaded
+            std::lock_guard lock{plugin->memoryWatchesMutex};
+            for (const u64 handle : plugin->memoryWatches) {
+                system.MemoryWatcher().RemoveWatch(handle);
+            }
+            plugin->memoryWatches.clear();
+            system.MemoryWatcher().WaitForCallbacks();
+        }
 
 #ifdef _WIN32
         FreeLibrary(plugin->sharedLibHandle);
@@ -343,18 +445,31 @@ void PluginManager::ConnectAllDllFunctions(std::shared_ptr<Plugin> plugin) {
     ADD_FUNCTION_TO_PLUGIN(emu_frameadvance, [](void* ctx) -> void {
         Plugin* self = (Plugin*)ctx;
 
-        // Notify main thread a vsync event is now being waited for
+        if (self->runInline) {
+            // The main loop is already called once per frame, there is nothing to wait for
+            return;
+        }
+
+        // Notify main thread a vsync event is now being waited for and block until it has
+        // reached vsync. Once this is done, execution will resume as normal
         self->encounteredVsync = true;
-        self->encounteredVsync = false;
-        self->pluginCv.notify_one();
-
-        // Block until main thread has reached vsync
-        std::unique_lock<std::mutex> lk(self->pluginMutex);
-        self->pluginCv.wait(lk, [self] { return self->ready; });
-        self->ready = false;
-        // Once this is done, execution will resume as normal
+        self->rendezvous.HandToAndWait(Common::Rendezvous::Side::Host,
+                                       Common::Rendezvous::Side::Worker);
     });
 
+    ADD_FUNCTION_TO_PLUGIN(emu_requestmainloop, [](void* ctx) -> void {
+        Plugin* self = (Plugin*)ctx;
+        self->mainLoopRequested = true;
+        self->pluginManager->WakeMainLoop();
+    })
+
+    ADD_FUNCTION_TO_PLUGIN(emu_setmainloopperiod, [](void* ctx, uint64_t ns) -> void {
+        Plugin* self = (Plugin*)ctx;
+        self->mainLoopPeriod = std::chrono::nanoseconds{ns};
+        // The main loop thread may be sleeping on the old period or indefinitely
+        self->pluginManager->WakeMainLoop();
+    })
+
     ADD_FUNCTION_TO_PLUGIN(emu_pause, [](void* ctx) -> void {
         Plugin* self = (Plugin*)ctx;
         self->system->Pause();
@@ -387,6 +502,52 @@ void PluginManager::ConnectAllDllFunctions(std::shared_ptr<Plugin> plugin) {
         return false;
     })
 
+    ADD_FUNCTION_TO_PLUGIN(emu_savestate, [](void* ctx, const char* path) -> uint8_t {
+        Plugin* self = (Plugin*)ctx;
+        return Tools::SaveState(*self->system).Save(path);
+    })
+
+    ADD_FUNCTION_TO_PLUGIN(emu_loadstate, [](void* ctx, const char* path) -> uint8_t {
+        Plugin* self = (Plugin*)ctx;
+        return Tools::SaveState(*self->system).Load(path);
+    })
+
+    ADD_FUNCTION_TO_PLUGIN(emu_rewind, [](void* ctx, uint64_t frames) -> uint8_t {
+        Plugin* self = (Plugin*)ctx;
+        return self->system->RewindBuffer().RequestRewind(frames);
+    })
+
+    ADD_FUNCTION_TO_PLUGIN(emu_enableframering, [](void* ctx, uint8_t enable) -> void {
+        Plugin* self = (Plugin*)ctx;
+        if (self->system->IsPoweredOn())
+            self->system->Renderer().GetFrameRing().SetEnabled(enable);
+    })
+
+    ADD_FUNCTION_TO_PLUGIN(
+        emu_getlatestframe, [](void* ctx, PluginDefinitions::FrameInfo* info) -> uint8_t {
+            Plugin* self = (Plugin*)ctx;
+            if (!self->system->IsPoweredOn())
+                return false;
+
+            const auto frame = self->system->Renderer().GetFrameRing().GetLatestFrame();
+            if (!frame)
+                return false;
+
+            info->data = frame->data;
+            info->frame_number = frame->number;
+            info->width = frame->width;
+            info->height = frame->height;
+            info->stride = frame->stride;
+            return true;
+        })
+
+    ADD_FUNCTION_TO_PLUGIN(emu_isframevalid, [](void* ctx, uint64_t frame_number) -> uint8_t {
+        Plugin* self = (Plugin*)ctx;
+        if (self->system->IsPoweredOn())
+            return self->system->Renderer().GetFrameRing().IsFrameValid(frame_number);
+        return false;
+    })
+
     ADD_FUNCTION_TO_PLUGIN(emu_romname, [](void* ctx) -> char* {
         Plugin* self = (Plugin*)ctx;
         std::string name;
@@ -510,6 +671,134 @@ void PluginManager::ConnectAllDllFunctions(std::shared_ptr<Plugin> plugin) {
             return false;
         })
 
+    ADD_FUNCTION_TO_PLUGIN(
+        memory_readscatter,
+        [](void* ctx, PluginDefinitions::MemoryRange* ranges, uint64_t count) -> uint8_t {
+            Plugin* self = (Plugin*)ctx;
+            Kernel::Process* process = self->system->CurrentProcess();
+            if (!self->system->IsPoweredOn() || !process) {
+                return false;
+            }
+
+            Core::Memory::Memory& memoryInstance = self->system->Memory();
+            for (uint64_t i = 0; i < count; i++) {
+                auto& range = ranges[i];
+                range.host_pointer =
+                    memoryInstance.GetContiguousPointer(*process, range.address, range.length);
+                if (!range.buffer) {
+                    continue;
+                }
+                if (range.host_pointer) {
+                    std::memcpy(range.buffer, range.host_pointer, range.length);
+                } else {
+                    // Unmapped or rasterizer cached pages, take the slow path
+                    memoryInstance.ReadBlock(*process, range.address, range.buffer, range.length);
+                }
+            }
+            return true;
+        })
+
+    ADD_FUNCTION_TO_PLUGIN(
+        memory_writegather,
+        [](void* ctx, PluginDefinitions::MemoryRange* ranges, uint64_t count) -> uint8_t {
+            Plugin* self = (Plugin*)ctx;
+            Kernel::Process* process = self->system->CurrentProcess();
+            if (!self->system->IsPoweredOn() || !process) {
+                return false;
+            }
+
+            Core::Memory::Memory& memoryInstance = self->system->Memory();
+            for (uint64_t i = 0; i < count; i++) {
+                auto& range = ranges[i];
+                range.host_pointer =
+                    memoryInstance.GetContiguousPointer(*process, range.address, range.length);
+                if (!range.buffer) {
+                    continue;
+                }
+                if (range.host_pointer) {
+                    std::memcpy(range.host_pointer, range.buffer, range.length);
+                } else {
+                    memoryInstance.WriteBlock(*process, range.address, range.buffer, range.length);
+                }
+            }
+            return true;
+        })
+
+    ADD_FUNCTION_TO_PLUGIN(
+        memory_addwatchpoint,
+        [](void* ctx, uint64_t address, uint8_t width,
+           PluginDefinitions::MemoryWatchCallback* callback, void* userdata) -> uint64_t {
+            Plugin* self = (Plugin*)ctx;
+            if (!self->system->IsPoweredOn() || !callback) {
+                return 0;
+            }
+
+            const u64 handle = self->system->MemoryWatcher().AddWatch(
+                address, width, [callback, userdata](VAddr watch_address, u64 value) {
+                    callback(userdata, watch_address, value);
+                    return std::optional<u64>{};
+                });
+            if (handle != 0) {
+                std::lock_guard lock{self->memoryWatchesMutex};
+                self->memoryWatches.push_back(handle);
+            }
+            return handle;
+        })
+
+    ADD_FUNCTION_TO_PLUGIN(memory_removewatchpoint, [](void* ctx, uint64_t handle) -> void {
+        Plugin* self = (Plugin*)ctx;
+        std::lock_guard lock{self->memoryWatchesMutex};
+        const auto iter =
+            std::find(self->memoryWatches.begin(), self->memoryWatches.end(), handle);
+        if (iter == self->memoryWatches.end()) {
+            return;
+        }
+        self->memoryWatches.erase(iter);
+        self->system->MemoryWatcher().RemoveWatch(handle);
+    })
+
+    ADD_FUNCTION_TO_PLUGIN(
+        memory_scanfirst,
+        [](void* ctx, PluginDefinitions::MemoryScanType type, uint8_t alignment,
+           const PluginDefinitions::MemoryScanQuery* query) -> uint64_t {
+            Plugin* self = (Plugin*)ctx;
+            if (!self->system->IsPoweredOn() || !query) {
+                return 0;
+            }
+            if (!self->memoryScanner) {
+                self->memoryScanner = std::make_unique<Tools::MemoryScanner>(*self->system);
+            }
+            return self->memoryScanner->FirstScan(
+                static_cast<Tools::MemoryScanner::ValueType>(type), alignment,
+                ToScannerQuery(*query));
+        })
+
+    ADD_FUNCTION_TO_PLUGIN(
+        memory_scannext,
+        [](void* ctx, const PluginDefinitions::MemoryScanQuery* query) -> uint64_t {
+            Plugin* self = (Plugin*)ctx;
+            if (!self->system->IsPoweredOn() || !self->memoryScanner || !query) {
+                return 0;
+            }
+            return self->memoryScanner->NextScan(ToScannerQuery(*query));
+        })
+
+    ADD_FUNCTION_TO_PLUGIN(
+        memory_getscanresults,
+        [](void* ctx, uint64_t first, PluginDefinitions::MemoryScanResult* results,
+           uint64_t max) -> uint64_t {
+            Plugin* self = (Plugin*)ctx;
+            if (!self->memoryScanner || !results) {
+                return 0;
+            }
+            const auto found = self->memoryScanner->GetResults(first, max);
+            for (std::size_t i = 0; i < found.size(); i++) {
+                results[i].address = found[i].address;
+                results[i].value = found[i].value;
+            }
+            return found.size();
+        })
+
     ADD_FUNCTION_TO_PLUGIN(debugger_getclockticks, [](void* ctx) -> uint64_t {
         Plugin* self = (Plugin*)ctx;
         if (self->system->IsPoweredOn())
@@ -1216,6 +1505,36 @@ void PluginManager::ConnectAllDllFunctions(std::shared_ptr<Plugin> plugin) {
             }
         })
 
+    ADD_FUNCTION_TO_PLUGIN(movie_startrecording, [](void* ctx, const char* path) -> uint8_t {
+        Plugin* self = (Plugin*)ctx;
+        return self->system->InputMovie().StartRecording(std::string(path));
+    })
+
+    ADD_FUNCTION_TO_PLUGIN(movie_startplayback, [](void* ctx, const char* path) -> uint8_t {
+        Plugin* self = (Plugin*)ctx;
+        return self->system->InputMovie().StartPlayback(std::string(path));
+    })
+
+    ADD_FUNCTION_TO_PLUGIN(movie_stop, [](void* ctx) -> uint8_t {
+        Plugin* self = (Plugin*)ctx;
+        return self->system->InputMovie().Stop();
+    })
+
+    ADD_FUNCTION_TO_PLUGIN(movie_seek, [](void* ctx, uint64_t frame) -> uint8_t {
+        Plugin* self = (Plugin*)ctx;
+        return self->system->InputMovie().Seek(frame);
+    })
+
+    ADD_FUNCTION_TO_PLUGIN(movie_getframe, [](void* ctx) -> uint64_t {
+        Plugin* self = (Plugin*)ctx;
+        return self->system->InputMovie().GetCurrentFrame();
+    })
+
+    ADD_FUNCTION_TO_PLUGIN(movie_getframecount, [](void* ctx) -> uint64_t {
+        Plugin* self = (Plugin*)ctx;
+        return self->system->InputMovie().GetFrameCount();
+    })
+
     ADD_FUNCTION_TO_PLUGIN(gui_getwidth, [](void* ctx) -> uint32_t {
         Plugin* self = (Plugin*)ctx;
         return self->system->Renderer().Settings().screenshot_framebuffer_layout.width;
@@ -1229,17 +1548,14 @@ void PluginManager::ConnectAllDllFunctions(std::shared_ptr<Plugin> plugin) {
     ADD_FUNCTION_TO_PLUGIN(gui_clearscreen, [](void* ctx) -> void {
         Plugin* self = (Plugin*)ctx;
         if (self->system->IsPoweredOn()) {
-            self->pluginManager->RegenerateGuiRendererIfNeeded();
-            auto& painter = self->pluginManager->guiPainter;
-            painter->fillRect(QRectF(0, 0, painter->window().width(), painter->window().height()),
-                              Qt::GlobalColor::transparent);
+            self->pluginManager->RecordOverlay(
+                [](OverlayDisplayList& overlay) { overlay.AddClear(); });
         }
     })
 
     ADD_FUNCTION_TO_PLUGIN(gui_render, [](void* ctx) -> void {
         Plugin* self = (Plugin*)ctx;
         if (self->system->IsPoweredOn()) {
-            self->pluginManager->RegenerateGuiRendererIfNeeded();
             self->pluginManager->RenderGui();
         }
     })
@@ -1249,13 +1565,55 @@ void PluginManager::ConnectAllDllFunctions(std::shared_ptr<Plugin> plugin) {
                               uint8_t blue, uint8_t alpha) -> void {
                                Plugin* self = (Plugin*)ctx;
                                if (self->system->IsPoweredOn()) {
-                                   self->pluginManager->RegenerateGuiRendererIfNeeded();
-                                   auto& painter = self->pluginManager->guiPainter;
-                                   painter->setPen(QColor(red, green, blue, alpha));
-                                   painter->drawPoint(x, y);
+                                   self->pluginManager->RecordOverlay(
+                                       [&](OverlayDisplayList& overlay) {
+                                           overlay.AddPixel(x, y, {red, green, blue, alpha});
+                                       });
                                }
                            })
 
+    ADD_FUNCTION_TO_PLUGIN(
+        gui_blit,
+        [](void* ctx, int32_t x, int32_t y, uint32_t width, uint32_t height, const uint8_t* pixels,
+           uint32_t stride) -> void {
+            Plugin* self = (Plugin*)ctx;
+            if (self->system->IsPoweredOn()) {
+                self->pluginManager->RecordOverlay([&](OverlayDisplayList& overlay) {
+                    overlay.AddBlit(x, y, width, height, pixels, stride);
+                });
+            }
+        })
+
+    ADD_FUNCTION_TO_PLUGIN(
+        gui_drawlines,
+        [](void* ctx, const PluginDefinitions::GuiLine* lines, uint64_t count) -> void {
+            Plugin* self = (Plugin*)ctx;
+            if (self->system->IsPoweredOn()) {
+                self->pluginManager->RecordOverlay(
+                    [&](OverlayDisplayList& overlay) { overlay.AddLines(lines, count); });
+            }
+        })
+
+    ADD_FUNCTION_TO_PLUGIN(
+        gui_drawrects,
+        [](void* ctx, const PluginDefinitions::GuiRect* rects, uint64_t count) -> void {
+            Plugin* self = (Plugin*)ctx;
+            if (self->system->IsPoweredOn()) {
+                self->pluginManager->RecordOverlay(
+                    [&](OverlayDisplayList& overlay) { overlay.AddRects(rects, count); });
+            }
+        })
+
+    ADD_FUNCTION_TO_PLUGIN(
+        gui_drawtexts,
+        [](void* ctx, const PluginDefinitions::GuiText* texts, uint64_t count) -> void {
+            Plugin* self = (Plugin*)ctx;
+            if (self->system->IsPoweredOn()) {
+                self->pluginManager->RecordOverlay(
+                    [&](OverlayDisplayList& overlay) { overlay.AddTexts(texts, count); });
+            }
+        })
+
     ADD_FUNCTION_TO_PLUGIN(gui_savescreenshotas, [](void* ctx, const char* path) -> bool {
         Plugin* self = (Plugin*)ctx;
         if (self->pluginManager->screenshot_callback) {
@@ -1268,17 +1626,27 @@ void PluginManager::ConnectAllDllFunctions(std::shared_ptr<Plugin> plugin) {
         }
     })
 
-    ADD_FUNCTION_TO_PLUGIN(gui_drawimage,
-                           [](void* ctx, int32_t dx, int32_t dy, const char* path, int32_t sx,
-                              int32_t sy, int32_t sw, int32_t sh) -> void {
-                               Plugin* self = (Plugin*)ctx;
-                               if (self->system->IsPoweredOn()) {
-                                   self->pluginManager->RegenerateGuiRendererIfNeeded();
-                                   QImage image(path);
-                                   auto& painter = self->pluginManager->guiPainter;
-                                   painter->drawImage(dx, dy, image, sx, sy, sw, sh);
-                               }
-                           })
+    ADD_FUNCTION_TO_PLUGIN(
+        gui_drawimage,
+        [](void* ctx, int32_t dx, int32_t dy, const char* path, int32_t sx, int32_t sy, int32_t sw,
+           int32_t sh) -> void {
+            Plugin* self = (Plugin*)ctx;
+            if (self->system->IsPoweredOn()) {
+                QImage image(path);
+                if (image.isNull()) {
+                    return;
+                }
+                // Negative sizes mean the rest of the image, like QPainter::drawImage
+                const int width = sw < 0 ? image.width() - sx : sw;
+                const int height = sh < 0 ? image.height() - sy : sh;
+                const QImage region =
+                    image.copy(sx, sy, width, height).convertToFormat(QImage::Format_RGBA8888);
+                self->pluginManager->RecordOverlay([&](OverlayDisplayList& overlay) {
+                    overlay.AddBlit(dx, dy, region.width(), region.height(), region.constBits(),
+                                    region.bytesPerLine());
+                });
+            }
+        })
 
     ADD_FUNCTION_TO_PLUGIN(gui_popup,
                            [](void* ctx, const char* title, const char* message,
@@ -6,16 +6,20 @@
 
 #include <atomic>
 #include <chrono>
-#include <condition_variable>
 #include <cstring>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <set>
 #include <string>
 #include <thread>
 #include <vector>
 #include "common/common_types.h"
+#include "common/rendezvous.h"
+#include "common/thread.h"
+#include "core/tools/memory_scanner.h"
+#include "core/tools/overlay.h"
 #include "core/tools/plugin_definitions.h"
 
 #ifdef _WIN32
@@ -27,7 +31,6 @@
 #endif
 
 class QImage;
-class QPainter;
 
 namespace Core::Timing {
 class CoreTiming;
@@ -68,14 +71,25 @@ class PluginManager {
 
 public:
     struct Plugin {
-        bool ready{false};
         std::string path;
         std::string plugin_name;
         std::atomic_bool processedMainLoop{true};
         std::atomic_bool encounteredVsync{false};
         bool hasStopped{false};
-        std::mutex pluginMutex;
-        std::condition_variable pluginCv;
+        // When set, the main loop is called directly on the vsync thread once per frame instead
+        // of on its own thread, emu_frameadvance then becomes a no-op
+        bool runInline{false};
+        // Host is the emulator, Worker is the plugin thread. Exactly one of them runs at a time
+        Common::Rendezvous rendezvous;
+        // How often the main loop is started without being woken, zero means only on request
+        std::atomic<std::chrono::nanoseconds> mainLoopPeriod{};
+        std::chrono::steady_clock::time_point nextMainLoop{};
+        std::atomic_bool mainLoopRequested{false};
+        // Handles of the memory watches added by the plugin, removed when it is closed
+        std::mutex memoryWatchesMutex;
+        std::vector<u64> memoryWatches;
+        // Created by the first memory scan, each plugin has its own results
+        std::unique_ptr<Tools::MemoryScanner> memoryScanner;
         std::unique_ptr<std::thread> pluginThread{nullptr};
         Tools::PluginManager* pluginManager;
         std::shared_ptr<Service::HID::IAppletResource> hidAppletResource{nullptr};
@@ -102,6 +116,9 @@ public:
     // Done during the course of the emulator (especially when a game is closed)
     void ProcessScriptFromMainLoop();
 
+    // Wakes the main loop thread so due or requested plugins are run immediately
+    void WakeMainLoop();
+
     bool LoadPlugin(std::string path, std::string name);
 
     void RemovePlugin(std::string path) {
@@ -143,15 +160,17 @@ public:
     }
 
     void RegenerateGuiRendererIfNeeded();
-    void RenderGui() {
-        std::lock_guard lock{plugins_mutex};
 
-        if (render_callback) {
-            render_callback(*guiPixmap);
-        }
+    // Composites everything recorded since the last call onto the overlay and displays it
+    void RenderGui();
+
+    // Runs func with exclusive access to the display list of the current frame
+    template <typename Func>
+    void RecordOverlay(Func&& func) {
+        std::lock_guard lock{overlay_mutex};
+        func(overlay);
     }
 
-    QPainter* guiPainter;
     std::function<QImage()> screenshot_callback;
 
 private:
@@ -192,6 +211,8 @@ private:
 
     void ProcessScript(std::shared_ptr<Plugin> plugin);
 
+    void ProcessScriptInline(std::shared_ptr<Plugin> plugin);
+
     void ConnectAllDllFunctions(std::shared_ptr<Plugin> plugin);
 
     void PluginThreadExecuter(std::shared_ptr<Plugin> plugin);
@@ -200,6 +221,11 @@ private:
 
     void HandlePluginClosings();
 
+    void MainLoopThreadExecuter();
+
+    // Returns the earliest time a plugin main loop is due, std::nullopt if every plugin is idle
+    std::optional<std::chrono::steady_clock::time_point> NextMainLoopDeadline() const;
+
     std::atomic_bool active{false};
 
     std::vector<std::shared_ptr<Plugin>> plugins;
@@ -211,13 +237,18 @@ private:
     std::string last_error;
 
     LastDockedState lastDockedState{LastDockedState::Neither};
-    QImage* guiPixmap;
+    QImage* guiPixmap{nullptr};
     std::function<void(const QImage& pixmap)> render_callback;
 
+    // Guards the overlay and guiPixmap, which are used from every plugin thread
+    std::mutex overlay_mutex;
+    OverlayDisplayList overlay;
+
     mutable std::mutex plugins_mutex;
 
     std::unique_ptr<std::thread> plugin_main_loop_thread{nullptr};
     std::atomic_bool run_main_loop_thread{true};
+    Common::Event main_loop_event;
 
     Core::System& system;
     Core::Timing::CoreTiming& core_timing;
@@ -0,0 +1,232 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <utility>
+
+#include "common/logging/log.h"
+#include "core/core.h"
+#include "core/device_memory.h"
+#include "core/hardware_properties.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/scheduler.h"
+#include "core/hle/kernel/thread.h"
+#include "core/tools/memory_journal.h"
+#include "core/tools/rewind_buffer.h"
+#include "video_core/gpu.h"
+
+namespace Tools {
+namespace {
+
+/// The guest thread whose call is handled on this host thread. Its live context is in the JIT, the
+/// thread only holds the context it was last switched in with.
+Kernel::Thread* GetCallingThread(Core::System& system) {
+    auto& kernel = system.Kernel();
+    const u32 core = kernel.GetCurrentHostThreadID();
+    if (core >= Core::Hardware::NUM_CPU_CORES) {
+        return nullptr;
+    }
+    Kernel::Thread* const thread = kernel.Scheduler(core).GetCurrentThread();
+    if (thread == nullptr || thread->IsHLEThread()) {
+        return nullptr;
+    }
+    return thread;
+}
+
+/// The application process, its memory is journaled as the physical memory backing it
+class SystemTarget final : public RewindBuffer::Target {
+public:
+    explicit SystemTarget(Core::System& system_) : system{system_} {}
+
+    u8* GetMemory() override {
+        if (system.CurrentProcess() == nullptr) {
+            return nullptr;
+        }
+        return system.DeviceMemory().GetPointer(Core::DramMemoryMap::Base);
+    }
+
+    std::size_t GetMemorySize() const override {
+        return Core::DramMemoryMap::Size;
+    }
+
+    RewindBuffer::State Capture() override {
+        RewindBuffer::State state{
+            .regions = SaveState::CollectRegions(system),
+            .threads = SaveState::CaptureThreads(system),
+            .events = system.CoreTiming().GetPendingEvents(),
+        };
+        if (Kernel::Thread* const thread = GetCallingThread(system)) {
+            const auto it = std::find_if(state.threads.begin(), state.threads.end(),
+                                         [&](const SaveState::ThreadRecord& record) {
+                                             return record.thread_id == thread->GetThreadID();
+                                         });
+            if (it != state.threads.end()) {
+                Core::ARM_Interface& cpu_core = thread->ArmInterface();
+                cpu_core.SaveContext(it->context_32);
+                cpu_core.SaveContext(it->context_64);
+                it->tpidr_el0 = cpu_core.GetTPIDR_EL0();
+            }
+        }
+        return state;
+    }
+
+    bool CanApply(const RewindBuffer::State& state) override {
+        // The journal only knows about physical memory, the rest of the state has to fit
+        if (state.regions != SaveState::CollectRegions(system)) {
+            LOG_ERROR(Core, "The memory layout changed since the state was captured");
+            return false;
+        }
+        return SaveState::CheckThreads(system, state.threads);
+    }
+
+    void Apply(const RewindBuffer::State& state) override {
+        SaveState::RestoreThreads(system, state.threads);
+        if (Kernel::Thread* const thread = GetCallingThread(system)) {
+            // Returning from the call resumes the restored context
+            Core::ARM_Interface& cpu_core = thread->ArmInterface();
+            cpu_core.LoadContext(thread->GetContext32());
+            cpu_core.LoadContext(thread->GetContext64());
+            cpu_core.SetTPIDR_EL0(thread->GetTPIDR_EL0());
+            cpu_core.ClearExclusiveState();
+        }
+        const std::size_t skipped_events = system.CoreTiming().RestorePendingEvents(state.events);
+        if (skipped_events != 0) {
+            LOG_WARNING(Core, "{} events are no longer scheduled", skipped_events);
+        }
+        for (const SaveState::RegionRecord& region : state.regions) {
+            system.GPU().InvalidateRegion(region.base, region.size);
+        }
+        system.InvalidateCpuInstructionCaches();
+    }
+
+private:
+    Core::System& system;
+};
+
+} // Anonymous namespace
+
+RewindBuffer::Target::~Target() = default;
+
+RewindBuffer::RewindBuffer(Core::System& system_)
+    : RewindBuffer(std::make_unique<SystemTarget>(system_)) {}
+
+RewindBuffer::RewindBuffer(std::unique_ptr<Target> target_) : target{std::move(target_)} {}
+
+RewindBuffer::~RewindBuffer() {
+    Stop();
+}
+
+bool RewindBuffer::Start(std::size_t max_states_, std::size_t max_stored_bytes_) {
+    u8* const memory = target->GetMemory();
+    if (IsActive() || max_states_ == 0 || memory == nullptr) {
+        return false;
+    }
+    max_states = max_states_;
+    max_stored_bytes = max_stored_bytes_;
+
+    // Pages written in a frame beyond the whole budget could not be kept anyway
+    const std::size_t max_written_pages = max_stored_bytes / MemoryJournal::PAGE_SIZE;
+    journal =
+        std::make_unique<MemoryJournal>(memory, target->GetMemorySize(), max_written_pages);
+    if (!journal->Start()) {
+        LOG_ERROR(Core, "Guest memory cannot be journaled on this host");
+        journal.reset();
+        return false;
+    }
+
+    states.clear();
+    states.push_back(target->Capture());
+    return true;
+}
+
+void RewindBuffer::Stop() {
+    journal.reset();
+    states.clear();
+    pending_rewind.store(NO_REWIND, std::memory_order_relaxed);
+}
+
+bool RewindBuffer::IsActive() const {
+    return journal != nullptr;
+}
+
+void RewindBuffer::Capture() {
+    if (!IsActive()) {
+        return;
+    }
+
+    journal->TakeSnapshot();
+    states.push_back(target->Capture());
+
+    // The journal drops every snapshot when too many pages were written since the last one
+    while (states.size() > journal->GetStats().num_snapshots) {
+        states.pop_front();
+    }
+    while (states.size() > 1 && (states.size() > max_states ||
+                                 journal->GetStats().stored_pages * MemoryJournal::PAGE_SIZE >
+                                     max_stored_bytes)) {
+        journal->DropOldest();
+        states.pop_front();
+    }
+}
+
+bool RewindBuffer::Rewind(std::size_t steps) {
+    if (!IsActive() || steps >= states.size()) {
+        return false;
+    }
+    const std::size_t index = states.size() - 1 - steps;
+    const u64 snapshot = journal->GetOldestSnapshot() + index;
+    if (snapshot > journal->GetNewestSnapshot()) {
+        LOG_ERROR(Core, "State {} has no memory snapshot", index);
+        return false;
+    }
+
+    // Nothing is changed unless the whole state can be brought back, memory goes first so the
+    // threads never run on memory of another state
+    const State& state = states[index];
+    if (!target->CanApply(state)) {
+        return false;
+    }
+    if (!journal->Restore(snapshot)) {
+        LOG_ERROR(Core, "Memory could not be rewound");
+        return false;
+    }
+    target->Apply(state);
+
+    states.resize(index + 1);
+    return true;
+}
+
+void RewindBuffer::AdvanceFrame() {
+    if (!IsActive()) {
+        return;
+    }
+    const std::size_t steps = pending_rewind.exchange(NO_REWIND, std::memory_order_acq_rel);
+    if (steps == NO_REWIND) {
+        Capture();
+    } else if (!Rewind(steps)) {
+        LOG_WARNING(Core, "Could not rewind {} states", steps);
+    }
+}
+
+bool RewindBuffer::RequestRewind(std::size_t steps) {
+    if (!IsActive()) {
+        return false;
+    }
+    pending_rewind.store(steps, std::memory_order_release);
+    return true;
+}
+
+RewindBuffer::Stats RewindBuffer::GetStats() const {
+    if (!IsActive()) {
+        return {};
+    }
+    const auto stats = journal->GetStats();
+    return {
+        .num_states = states.size(),
+        .stored_bytes = stats.stored_pages * MemoryJournal::PAGE_SIZE,
+        .last_written_pages = stats.last_written_pages,
+    };
+}
+
+} // namespace Tools
@@ -0,0 +1,114 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <vector>
+#include "common/common_types.h"
+#include "core/core_timing.h"
+#include "core/tools/save_state.h"
+
+namespace Core {
+class System;
+} // namespace Core
+
+namespace Tools {
+
+class MemoryJournal;
+
+/**
+ * Keeps a ring of recent states of the running application in memory so that it can be rewound,
+ * typically by capturing once per frame.
+ *
+ * Guest memory is journaled through MemoryJournal, so a capture only costs the pages written since
+ * the previous one and identical pages are kept once. The oldest states are dropped to stay
+ * within the given number of states and bytes of stored pages. Like SaveState, thread contexts and
+ * pending events are part of a state while kernel objects and HLE services are not, and a state is
+ * only rewound to while the threads are in the same kernel state.
+ *
+ * The System owns one that captures at every presented frame when enabled in the settings. Outside
+ * of AdvanceFrame, emulation must be paused to capture and to rewind.
+ */
+class RewindBuffer {
+public:
+    struct Stats {
+        std::size_t num_states;
+        std::size_t stored_bytes;
+        /// Pages written between the last two captures
+        std::size_t last_written_pages;
+    };
+
+    /// Everything in a state except memory
+    struct State {
+        std::vector<SaveState::RegionRecord> regions;
+        std::vector<SaveState::ThreadRecord> threads;
+        std::vector<Core::Timing::CoreTiming::PendingEvent> events;
+    };
+
+    /// What is rewound, the running application unless a test provides its own.
+    class Target {
+    public:
+        virtual ~Target();
+
+        /// Page aligned memory journaled between captures, nullptr if there is nothing to rewind.
+        [[nodiscard]] virtual u8* GetMemory() = 0;
+        [[nodiscard]] virtual std::size_t GetMemorySize() const = 0;
+
+        [[nodiscard]] virtual State Capture() = 0;
+
+        /// Returns whether Apply can bring back the given state, without changing anything.
+        [[nodiscard]] virtual bool CanApply(const State& state) = 0;
+
+        /// Brings back the rest of a state once its memory has been rewound.
+        virtual void Apply(const State& state) = 0;
+    };
+
+    explicit RewindBuffer(Core::System& system_);
+    explicit RewindBuffer(std::unique_ptr<Target> target_);
+    ~RewindBuffer();
+
+    /// Starts journaling guest memory and captures the first state. Fails on hosts without
+    /// memory journaling.
+    bool Start(std::size_t max_states_, std::size_t max_stored_bytes_);
+
+    /// Drops every state and stops journaling.
+    void Stop();
+
+    [[nodiscard]] bool IsActive() const;
+
+    /// Captures the current state, dropping the oldest ones if a budget is exceeded.
+    void Capture();
+
+    /// Goes back the given number of states from the newest one, 0 undoes everything since the
+    /// last capture. The states after it are dropped.
+    bool Rewind(std::size_t steps);
+
+    /// Called by the guest thread presenting a frame, in single core mode. Rewinds if it was
+    /// requested since the previous frame and captures otherwise.
+    void AdvanceFrame();
+
+    /// Rewinds the given number of states, see Rewind, at the next frame. Can be called from any
+    /// thread, returns false if rewinding is not active.
+    bool RequestRewind(std::size_t steps);
+
+    [[nodiscard]] Stats GetStats() const;
+
+private:
+    static constexpr std::size_t NO_REWIND = std::numeric_limits<std::size_t>::max();
+
+    std::unique_ptr<Target> target;
+    std::unique_ptr<MemoryJournal> journal;
+    /// Oldest first, matches the snapshots of the journal
+    std::deque<State> states;
+    std::size_t max_states = 0;
+    std::size_t max_stored_bytes = 0;
+    std::atomic<std::size_t> pending_rewind{NO_REWIND};
+};
+
+} // namespace Tools
@@ -0,0 +1,407 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+
+#include <boost/functional/hash.hpp>
+
+#include "common/file_util.h"
+#include "common/logging/log.h"
+#include "common/zstd_compression.h"
+#include "core/core.h"
+#include "core/core_timing.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/memory/page_table.h"
+#include "core/hle/kernel/process.h"
+#include "core/hle/kernel/scheduler.h"
+#include "core/hle/kernel/thread.h"
+#include "core/memory.h"
+#include "core/tools/save_state.h"
+
+namespace Tools {
+namespace {
+
+/// States are taken often while searching for inputs, so speed matters more than size
+constexpr s32 COMPRESSION_LEVEL = 1;
+
+std::vector<std::shared_ptr<Kernel::Thread>> GetGuestThreads(Core::System& system,
+                                                             const Kernel::Process& process) {
+    std::vector<std::shared_ptr<Kernel::Thread>> threads;
+    for (const auto& thread : system.Kernel().GlobalScheduler().GetThreadList()) {
+        if (thread->GetOwnerProcess() == &process && !thread->IsHLEThread() &&
+            !thread->HasExited()) {
+            threads.push_back(thread);
+        }
+    }
+    return threads;
+}
+
+/// Fills in the kernel state of a thread record
+void CaptureKernelState(const Kernel::Thread& thread, SaveState::ThreadRecord& record) {
+    const Kernel::ThreadStatus status = thread.GetStatus();
+    record.status = static_cast<u32>(status);
+    record.priority = thread.GetPriority();
+    record.processor_id = thread.GetProcessorID();
+    switch (status) {
+    case Kernel::ThreadStatus::WaitMutex:
+        record.wait_handle = thread.GetWaitHandle();
+        record.wait_address = thread.GetMutexWaitAddress();
+        break;
+    case Kernel::ThreadStatus::WaitCondVar:
+        record.wait_handle = thread.GetWaitHandle();
+        record.wait_address = thread.GetCondVarWaitAddress();
+        break;
+    case Kernel::ThreadStatus::WaitArb:
+        record.wait_address = thread.GetArbiterWaitAddress();
+        break;
+    case Kernel::ThreadStatus::WaitSynch: {
+        // Only valid while waiting, the list belongs to the svc call
+        std::size_t hash = 0;
+        for (const auto& object : thread.GetSynchronizationObjects()) {
+            boost::hash_combine(hash, object->GetObjectId());
+        }
+        record.wait_objects = hash;
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+/// Whether a thread can take the context it had in a state. Threads have to be blocked on the
+/// same thing, the kernel won't be in the middle of a different call on their behalf.
+bool IsSameKernelState(const SaveState::ThreadRecord& saved,
+                       const SaveState::ThreadRecord& current) {
+    const auto is_runnable = [](u32 status) {
+        return status == static_cast<u32>(Kernel::ThreadStatus::Running) ||
+               status == static_cast<u32>(Kernel::ThreadStatus::Ready);
+    };
+    const bool same_status = saved.status == current.status ||
+                             (is_runnable(saved.status) && is_runnable(current.status));
+    return same_status && saved.priority == current.priority &&
+           saved.processor_id == current.processor_id &&
+           saved.wait_handle == current.wait_handle &&
+           saved.wait_address == current.wait_address &&
+           saved.wait_objects == current.wait_objects;
+}
+
+} // Anonymous namespace
+
+SaveState::SaveState(Core::System& system_) : system{system_} {}
+
+SaveState::~SaveState() = default;
+
+bool SaveState::Save(const std::string& path) {
+    Kernel::Process* const process = system.CurrentProcess();
+    if (process == nullptr) {
+        LOG_ERROR(Core, "Cannot save a state without a running process");
+        return false;
+    }
+
+    const Contents contents{
+        .title_id = process->GetTitleID(),
+        .regions = CollectRegions(system),
+        .threads = CaptureThreads(system),
+        .events = system.CoreTiming().GetPendingEvents(),
+    };
+    auto& memory = system.Memory();
+    const bool success = WriteFile(path, contents, [&](VAddr vaddr, u8* dest, std::size_t size) {
+        memory.ReadBlock(*process, vaddr, dest, size);
+    });
+    if (!success) {
+        return false;
+    }
+    LOG_INFO(Core, "Saved state {} with {} regions and {} threads", path, contents.regions.size(),
+             contents.threads.size());
+    return true;
+}
+
+bool SaveState::Load(const std::string& path) {
+    Kernel::Process* const process = system.CurrentProcess();
+    if (process == nullptr) {
+        LOG_ERROR(Core, "Cannot load a state without a running process");
+        return false;
+    }
+
+    // Everything is checked before anything is restored, so a state that doesn't fit is harmless
+    std::vector<ThreadRecord> threads;
+    std::vector<Core::Timing::CoreTiming::PendingEvent> events;
+    const auto check = [&](const Contents& contents) {
+        if (contents.title_id != process->GetTitleID()) {
+            LOG_ERROR(Core, "State {} belongs to title {:016X}", path, contents.title_id);
+            return false;
+        }
+        if (contents.regions != CollectRegions(system)) {
+            LOG_ERROR(Core, "State {} does not match the current memory layout", path);
+            return false;
+        }
+        if (!CheckThreads(system, contents.threads)) {
+            LOG_ERROR(Core, "State {} does not match the current threads", path);
+            return false;
+        }
+        threads = contents.threads;
+        events = contents.events;
+        return true;
+    };
+    auto& memory = system.Memory();
+    const auto write_memory = [&](VAddr vaddr, const u8* src, std::size_t size) {
+        memory.WriteBlock(*process, vaddr, src, size);
+    };
+    if (!ReadFile(path, check, write_memory)) {
+        return false;
+    }
+
+    RestoreThreads(system, threads);
+    const std::size_t skipped_events = system.CoreTiming().RestorePendingEvents(events);
+    if (skipped_events != 0) {
+        LOG_WARNING(Core, "{} events of state {} are no longer scheduled", skipped_events, path);
+    }
+
+    system.InvalidateCpuInstructionCaches();
+
+    LOG_INFO(Core, "Loaded state {}", path);
+    return true;
+}
+
+bool SaveState::WriteFile(const std::string& path, const Contents& contents,
+                          const ReadMemoryFunc& read_memory) {
+    const auto& regions = contents.regions;
+    const auto& threads = contents.threads;
+    const auto& events = contents.events;
+
+    // Memory is compressed up front, the size of every chunk is written ahead of the data
+    std::vector<u8> buffer(CHUNK_SIZE);
+    std::vector<std::vector<u8>> chunks;
+    std::vector<u32> chunk_sizes;
+    for (const RegionRecord& region : regions) {
+        for (u64 offset = 0; offset < region.size; offset += CHUNK_SIZE) {
+            const std::size_t size = std::min(CHUNK_SIZE, region.size - offset);
+            read_memory(region.base + offset, buffer.data(), size);
+            chunks.push_back(
+                Common::Compression::CompressDataZSTD(buffer.data(), size, COMPRESSION_LEVEL));
+            chunk_sizes.push_back(static_cast<u32>(chunks.back().size()));
+        }
+    }
+
+    const Header header{
+        .magic = MAGIC,
+        .version = VERSION,
+        .title_id = contents.title_id,
+        .num_regions = static_cast<u32>(regions.size()),
+        .num_threads = static_cast<u32>(threads.size()),
+        .num_events = static_cast<u32>(events.size()),
+        .num_chunks = static_cast<u32>(chunks.size()),
+    };
+
+    Common::FS::IOFile file(path, "wb");
+    bool success = file.IsOpen();
+    success = success && file.WriteObject(header) == 1;
+    success = success && file.WriteArray(regions.data(), regions.size()) == regions.size();
+    success = success && file.WriteArray(threads.data(), threads.size()) == threads.size();
+    for (const auto& event : events) {
+        const EventRecord record{
+            .user_data = event.user_data,
+            .time_left = event.time_left.count(),
+            .name_size = static_cast<u32>(event.name.size()),
+        };
+        success = success && file.WriteObject(record) == 1;
+        success = success && file.WriteString(event.name) == event.name.size();
+    }
+    success = success && file.WriteArray(chunk_sizes.data(), chunk_sizes.size()) == chunks.size();
+    for (const auto& chunk : chunks) {
+        success = success && file.WriteBytes(chunk.data(), chunk.size()) == chunk.size();
+    }
+
+    if (!success) {
+        LOG_ERROR(Core, "Could not write state {}", path);
+    }
+    return success;
+}
+
+bool SaveState::ReadFile(const std::string& path, const CheckFunc& check,
+                         const WriteMemoryFunc& write_memory) {
+    Common::FS::IOFile file(path, "rb");
+    if (!file.IsOpen()) {
+        LOG_ERROR(Core, "Could not open state {}", path);
+        return false;
+    }
+
+    Header header{};
+    if (file.ReadBytes(&header, sizeof(header)) != sizeof(header) || header.magic != MAGIC ||
+        header.version != VERSION) {
+        LOG_ERROR(Core, "State {} is invalid", path);
+        return false;
+    }
+    const u64 records_size = u64{header.num_regions} * sizeof(RegionRecord) +
+                             u64{header.num_threads} * sizeof(ThreadRecord) +
+                             u64{header.num_events} * sizeof(EventRecord) +
+                             u64{header.num_chunks} * sizeof(u32);
+    if (records_size > file.GetSize()) {
+        LOG_ERROR(Core, "State {} is invalid", path);
+        return false;
+    }
+
+    Contents contents{.title_id = header.title_id};
+    auto& regions = contents.regions;
+    auto& threads = contents.threads;
+    auto& events = contents.events;
+    regions.resize(header.num_regions);
+    threads.resize(header.num_threads);
+    events.resize(header.num_events);
+    std::vector<u32> chunk_sizes(header.num_chunks);
+    bool success = file.ReadArray(regions.data(), regions.size()) == regions.size();
+    success = success && file.ReadArray(threads.data(), threads.size()) == threads.size();
+    for (auto& event : events) {
+        EventRecord record{};
+        success = success && file.ReadBytes(&record, sizeof(record)) == sizeof(record) &&
+                  record.name_size <= file.GetSize();
+        if (!success) {
+            break;
+        }
+        event.name.resize(record.name_size);
+        event.user_data = static_cast<std::uintptr_t>(record.user_data);
+        event.time_left = std::chrono::nanoseconds{record.time_left};
+        success = file.ReadBytes(event.name.data(), event.name.size()) == event.name.size();
+    }
+    success =
+        success && file.ReadArray(chunk_sizes.data(), chunk_sizes.size()) == chunk_sizes.size();
+
+    const u64 expected_chunks = std::accumulate(
+        regions.begin(), regions.end(), u64{0}, [](u64 sum, const RegionRecord& region) {
+            return sum + (region.size + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        });
+    const u64 data_size = std::accumulate(chunk_sizes.begin(), chunk_sizes.end(), u64{0});
+    if (!success || expected_chunks != chunk_sizes.size() ||
+        file.Tell() + data_size != file.GetSize()) {
+        LOG_ERROR(Core, "State {} is invalid", path);
+        return false;
+    }
+
+    if (!check(contents)) {
+        return false;
+    }
+
+    std::vector<u8> compressed;
+    auto chunk_size = chunk_sizes.begin();
+    for (const RegionRecord& region : regions) {
+        for (u64 offset = 0; offset < region.size; offset += CHUNK_SIZE, ++chunk_size) {
+            compressed.resize(*chunk_size);
+            const std::size_t size = std::min(CHUNK_SIZE, region.size - offset);
+            std::vector<u8> chunk;
+            if (file.ReadBytes(compressed.data(), compressed.size()) == compressed.size()) {
+                chunk = Common::Compression::DecompressDataZSTD(compressed);
+            }
+            if (chunk.size() != size) {
+                LOG_CRITICAL(Core, "State {} is corrupted, memory is partially restored", path);
+                return false;
+            }
+            write_memory(region.base + offset, chunk.data(), size);
+        }
+    }
+    return true;
+}
+
+std::vector<SaveState::ThreadRecord> SaveState::CaptureThreads(Core::System& system) {
+    std::vector<ThreadRecord> threads;
+    const Kernel::Process* const process = system.CurrentProcess();
+    if (process == nullptr) {
+        return threads;
+    }
+    for (const auto& thread : GetGuestThreads(system, *process)) {
+        ThreadRecord record{
+            .thread_id = thread->GetThreadID(),
+            .tpidr_el0 = thread->GetTPIDR_EL0(),
+            .context_64 = thread->GetContext64(),
+            .context_32 = thread->GetContext32(),
+        };
+        CaptureKernelState(*thread, record);
+        threads.push_back(record);
+    }
+    return threads;
+}
+
+bool SaveState::CheckThreads(Core::System& system, const std::vector<ThreadRecord>& threads) {
+    const Kernel::Process* const process = system.CurrentProcess();
+    if (process == nullptr) {
+        return false;
+    }
+
+    const auto guest_threads = GetGuestThreads(system, *process);
+    if (guest_threads.size() != threads.size()) {
+        LOG_ERROR(Core, "The state has {} threads, the process has {}", threads.size(),
+                  guest_threads.size());
+        return false;
+    }
+    for (const ThreadRecord& record : threads) {
+        const auto it = std::find_if(guest_threads.begin(), guest_threads.end(),
+                                     [&](const auto& thread) {
+                                         return thread->GetThreadID() == record.thread_id;
+                                     });
+        if (it == guest_threads.end()) {
+            LOG_ERROR(Core, "Thread {} no longer exists", record.thread_id);
+            return false;
+        }
+        ThreadRecord current{};
+        CaptureKernelState(**it, current);
+        if (!IsSameKernelState(record, current)) {
+            LOG_ERROR(Core, "Thread {} is in status {} instead of {}", record.thread_id,
+                      current.status, record.status);
+            return false;
+        }
+    }
+    return true;
+}
+
+void SaveState::RestoreThreads(Core::System& system, const std::vector<ThreadRecord>& threads) {
+    const Kernel::Process* const process = system.CurrentProcess();
+    if (process == nullptr) {
+        return;
+    }
+    for (const auto& thread : GetGuestThreads(system, *process)) {
+        const auto it =
+            std::find_if(threads.begin(), threads.end(), [&](const ThreadRecord& record) {
+                return record.thread_id == thread->GetThreadID();
+            });
+        if (it == threads.end()) {
+            continue;
+        }
+        thread->GetContext64() = it->context_64;
+        thread->GetContext32() = it->context_32;
+        thread->SetTPIDR_EL0(it->tpidr_el0);
+    }
+}
+
+std::vector<SaveState::RegionRecord> SaveState::CollectRegions(Core::System& system) {
+    std::vector<RegionRecord> regions;
+    Kernel::Process* const process = system.CurrentProcess();
+    if (process == nullptr) {
+        return regions;
+    }
+
+    // Everything backed by memory, including code and thread local storage
+    auto& page_table = process->PageTable();
+    VAddr address = page_table.GetAddressSpaceStart();
+    while (address < page_table.GetAddressSpaceEnd()) {
+        const auto info = page_table.QueryInfo(address);
+        if (info.GetSize() == 0) {
+            break;
+        }
+        const bool is_mapped = (info.state & Kernel::Memory::MemoryState::FlagMapped) ==
+                               Kernel::Memory::MemoryState::FlagMapped;
+        if (is_mapped && info.state != Kernel::Memory::MemoryState::Io) {
+            regions.push_back({
+                .base = info.GetAddress(),
+                .size = info.GetSize(),
+                .state = static_cast<u32>(info.state),
+                .perm = static_cast<u32>(info.perm),
+            });
+        }
+        address = info.GetAddress() + info.GetSize();
+    }
+    return regions;
+}
+
+} // namespace Tools
@@ -0,0 +1,139 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "core/arm/arm_interface.h"
+#include "core/core_timing.h"
+
+namespace Core {
+class System;
+} // namespace Core
+
+namespace Tools {
+
+/**
+ * Saves the state of the running application to a file and restores it in place, without
+ * rebooting the title. Emulation must be paused for both.
+ *
+ * A state holds the memory mapped by the application process, the context of each of its guest
+ * threads and the events pending in core timing. Memory is compressed with zstd in chunks.
+ *
+ * Kernel objects and HLE services are not part of the state and keep running as they are. The
+ * kernel state of every thread is recorded instead: its status, priority, core and what it waits
+ * for. A state can only be loaded into the session of the same title while its memory layout, its
+ * set of threads and their kernel state are unchanged, e.g. to retry from a point where the game
+ * waits for the next frame. Loading checks this before touching anything.
+ *
+ * Plugins reach this through emu_savestate and emu_loadstate.
+ */
+class SaveState {
+public:
+    /// Context of a guest thread
+    struct ThreadRecord {
+        u64 thread_id;
+        u64 tpidr_el0;
+        Core::ARM_Interface::ThreadContext64 context_64;
+        Core::ARM_Interface::ThreadContext32 context_32;
+
+        /// Kernel state, which is not restored and has to match when loading
+        u32 status;
+        u32 priority;
+        s32 processor_id;
+        u32 wait_handle;
+        /// Mutex, condition variable or arbiter address waited on
+        VAddr wait_address;
+        /// Hash of the objects waited on by WaitSynchronization
+        u64 wait_objects;
+    };
+    static_assert(sizeof(ThreadRecord) == 0x4A0, "ThreadRecord is an invalid size");
+
+    /// Range of memory mapped by the application
+    struct RegionRecord {
+        VAddr base;
+        u64 size;
+        u32 state;
+        u32 perm;
+
+        bool operator==(const RegionRecord&) const = default;
+    };
+    static_assert(sizeof(RegionRecord) == 0x18, "RegionRecord is an invalid size");
+
+    /// Everything in a state except memory, which is streamed to and from the file
+    struct Contents {
+        u64 title_id;
+        std::vector<RegionRecord> regions;
+        std::vector<ThreadRecord> threads;
+        std::vector<Core::Timing::CoreTiming::PendingEvent> events;
+    };
+
+    using ReadMemoryFunc = std::function<void(VAddr vaddr, u8* dest, std::size_t size)>;
+    using WriteMemoryFunc = std::function<void(VAddr vaddr, const u8* src, std::size_t size)>;
+    using CheckFunc = std::function<bool(const Contents& contents)>;
+
+    explicit SaveState(Core::System& system_);
+    ~SaveState();
+
+    /// Writes the state of the current process to path.
+    bool Save(const std::string& path);
+
+    /// Restores the state in path into the current process.
+    bool Load(const std::string& path);
+
+    /// Writes a state file, the memory of the regions is copied with read_memory.
+    static bool WriteFile(const std::string& path, const Contents& contents,
+                          const ReadMemoryFunc& read_memory);
+
+    /// Reads a state file. Once the file is validated, check decides whether the state can be
+    /// applied, and only then is its memory handed to write_memory.
+    static bool ReadFile(const std::string& path, const CheckFunc& check,
+                         const WriteMemoryFunc& write_memory);
+
+    /// Returns the contexts and kernel state of the guest threads of the current process.
+    static std::vector<ThreadRecord> CaptureThreads(Core::System& system);
+
+    /// Returns whether the given threads are exactly the guest threads of the current process, in
+    /// the kernel state they were captured in.
+    static bool CheckThreads(Core::System& system, const std::vector<ThreadRecord>& threads);
+
+    /// Restores the contexts of threads which passed CheckThreads.
+    static void RestoreThreads(Core::System& system, const std::vector<ThreadRecord>& threads);
+
+    /// Returns the memory of the current process that is part of a state.
+    static std::vector<RegionRecord> CollectRegions(Core::System& system);
+
+private:
+    static constexpr u32 MAGIC = 0x53535A59; // "YZSS"
+    static constexpr u32 VERSION = 2;
+    /// Memory is compressed in independent chunks of this size
+    static constexpr u64 CHUNK_SIZE = 0x400000;
+
+    struct Header {
+        u32 magic;
+        u32 version;
+        u64 title_id;
+        u32 num_regions;
+        u32 num_threads;
+        u32 num_events;
+        u32 num_chunks;
+    };
+    static_assert(sizeof(Header) == 0x20, "Header is an invalid size");
+
+    struct EventRecord {
+        u64 user_data;
+        s64 time_left;
+        u32 name_size;
+        INSERT_PADDING_WORDS(1);
+    };
+    static_assert(sizeof(EventRecord) == 0x18, "EventRecord is an invalid size");
+
+    Core::System& system;
+};
+
+} // namespace Tools
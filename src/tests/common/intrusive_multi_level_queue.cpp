@@ -0,0 +1,225 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "common/intrusive_multi_level_queue.h"
+#include "common/multi_level_queue.h"
+
+namespace {
+
+constexpr std::size_t NUM_CORES = 4;
+
+struct FakeThread {
+    u32 priority = 0;
+    u32 core = 0;
+    bool is_ready = false;
+    std::array<Common::IntrusiveMultiLevelQueueNode<FakeThread>, NUM_CORES> nodes{};
+};
+
+using Queue = Common::IntrusiveMultiLevelQueue<FakeThread, 64, &FakeThread::nodes>;
+
+std::vector<FakeThread*> Collect(const Queue& queue) {
+    std::vector<FakeThread*> elements;
+    for (FakeThread* const thread : queue) {
+        elements.push_back(thread);
+    }
+    return elements;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("IntrusiveMultiLevelQueue[Order]", "[common]") {
+    std::array<FakeThread, 5> threads{};
+    Queue queue;
+    REQUIRE(queue.empty());
+    REQUIRE(queue.front() == nullptr);
+
+    queue.add(&threads[0], 10);
+    queue.add(&threads[1], 3);
+    queue.add(&threads[2], 10);
+    queue.add(&threads[3], 63);
+    queue.add(&threads[4], 10, false);
+    REQUIRE(queue.size() == 5);
+    REQUIRE(queue.size(10) == 3);
+    REQUIRE(queue.front() == &threads[1]);
+    REQUIRE(queue.front(4) == &threads[4]);
+    REQUIRE(queue.front(11) == &threads[3]);
+    REQUIRE(Collect(queue) ==
+            std::vector<FakeThread*>{&threads[1], &threads[4], &threads[0], &threads[2],
+                                     &threads[3]});
+
+    queue.yield(10);
+    REQUIRE(queue.front(10) == &threads[0]);
+    queue.yield(10, 2);
+    REQUIRE(queue.front(10) == &threads[4]);
+
+    // Removing at the wrong priority or twice does nothing
+    queue.remove(&threads[1], 4);
+    REQUIRE(queue.size(3) == 1);
+    queue.remove(&threads[1], 3);
+    queue.remove(&threads[1], 3);
+    REQUIRE(queue.empty(3));
+    REQUIRE(queue.front() == &threads[4]);
+
+    queue.clear();
+    REQUIRE(queue.empty());
+    REQUIRE(queue.begin() == queue.end());
+}
+
+TEST_CASE("IntrusiveMultiLevelQueue[SharedNodes]", "[common]") {
+    FakeThread thread;
+    std::array<Queue, 3> queues{};
+    queues[1].set_node_index(1);
+    queues[2].set_node_index(1);
+
+    // Queues with their own nodes are independent, queues sharing one exclude each other
+    queues[0].add(&thread, 5);
+    queues[1].add(&thread, 5);
+    queues[2].add(&thread, 5);
+    REQUIRE(queues[0].front() == &thread);
+    REQUIRE(queues[1].front() == &thread);
+    REQUIRE(queues[2].empty());
+
+    queues[2].remove(&thread, 5);
+    REQUIRE(queues[1].front() == &thread);
+    queues[1].remove(&thread, 5);
+    queues[2].add(&thread, 5);
+    REQUIRE(queues[1].empty());
+    REQUIRE(queues[2].front() == &thread);
+    REQUIRE(queues[0].front() == &thread);
+}
+
+TEST_CASE("IntrusiveMultiLevelQueue[Churn]", "[common]") {
+    // Random adds, removes and priority changes pick the same threads as MultiLevelQueue
+    constexpr std::size_t num_threads = 64;
+    constexpr u32 base_priority = 40;
+    constexpr u32 num_priorities = 4;
+
+    std::mt19937 rng{4321};
+    std::vector<FakeThread> threads(num_threads);
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        threads[i].priority = base_priority + static_cast<u32>(rng() % num_priorities);
+        threads[i].core = static_cast<u32>(i % NUM_CORES);
+    }
+    std::array<Queue, NUM_CORES> queues{};
+    std::array<Common::MultiLevelQueue<FakeThread*, 64>, NUM_CORES> lists{};
+    for (std::size_t core = 0; core < NUM_CORES; ++core) {
+        queues[core].set_node_index(core);
+    }
+    const auto add = [&](FakeThread& thread) {
+        queues[thread.core].add(&thread, thread.priority);
+        lists[thread.core].add(&thread, thread.priority);
+    };
+    const auto remove = [&](FakeThread& thread) {
+        queues[thread.core].remove(&thread, thread.priority);
+        lists[thread.core].remove(&thread, thread.priority);
+    };
+
+    for (std::size_t op = 0; op < 2000; ++op) {
+        FakeThread& thread = threads[rng() % num_threads];
+        if (!thread.is_ready) {
+            add(thread);
+            thread.is_ready = true;
+        } else if (op % 4 == 0) {
+            remove(thread);
+            thread.priority = base_priority + static_cast<u32>(rng() % num_priorities);
+            add(thread);
+        } else {
+            remove(thread);
+            thread.is_ready = false;
+        }
+        for (std::size_t core = 0; core < NUM_CORES; ++core) {
+            FakeThread* const expected = lists[core].empty() ? nullptr : lists[core].front();
+            REQUIRE(queues[core].front() == expected);
+            REQUIRE(queues[core].size() == lists[core].size());
+        }
+    }
+}
+
+TEST_CASE("IntrusiveMultiLevelQueue[ThreadChurn]", "[.benchmark]") {
+    // Models a title with hundreds of worker threads on a few priorities that keep blocking,
+    // waking up and changing priority, with every core picking its top thread after each change
+    // as SelectThreads does
+    constexpr std::size_t num_threads = 512;
+    constexpr std::size_t num_operations = 200000;
+    constexpr u32 base_priority = 40;
+    constexpr u32 num_priorities = 4;
+
+    std::mt19937 rng{1234};
+    std::vector<u32> initial_priorities(num_threads);
+    for (u32& priority : initial_priorities) {
+        priority = base_priority + static_cast<u32>(rng() % num_priorities);
+    }
+    std::vector<std::pair<u32, u32>> operations(num_operations);
+    for (auto& [thread, priority] : operations) {
+        thread = static_cast<u32>(rng() % num_threads);
+        priority = base_priority + static_cast<u32>(rng() % num_priorities);
+    }
+
+    using Clock = std::chrono::steady_clock;
+    const auto run = [&](auto&& add, auto&& remove, auto&& front) {
+        std::vector<FakeThread> threads(num_threads);
+        for (std::size_t i = 0; i < num_threads; ++i) {
+            threads[i].priority = initial_priorities[i];
+            threads[i].core = static_cast<u32>(i % NUM_CORES);
+        }
+
+        u64 checksum = 0;
+        const auto start = Clock::now();
+        for (std::size_t op = 0; op < num_operations; ++op) {
+            FakeThread& thread = threads[operations[op].first];
+            if (!thread.is_ready) {
+                add(thread);
+                thread.is_ready = true;
+            } else if (op % 4 == 0) {
+                // Priority change while ready
+                remove(thread);
+                thread.priority = operations[op].second;
+                add(thread);
+            } else {
+                remove(thread);
+                thread.is_ready = false;
+            }
+            for (u32 core = 0; core < NUM_CORES; ++core) {
+                checksum += front(core);
+            }
+        }
+        const auto elapsed = std::chrono::duration<double, std::micro>(Clock::now() - start);
+        return std::make_pair(elapsed.count() / num_operations, checksum);
+    };
+
+    std::array<Queue, NUM_CORES> queues{};
+    for (std::size_t core = 0; core < NUM_CORES; ++core) {
+        queues[core].set_node_index(core);
+    }
+    const auto [intrusive_time, intrusive_checksum] = run(
+        [&](FakeThread& thread) { queues[thread.core].add(&thread, thread.priority); },
+        [&](FakeThread& thread) { queues[thread.core].remove(&thread, thread.priority); },
+        [&](u32 core) -> u64 {
+            const FakeThread* const top = queues[core].front();
+            return top == nullptr ? 0 : top->priority;
+        });
+
+    std::array<Common::MultiLevelQueue<FakeThread*, 64>, NUM_CORES> lists{};
+    const auto [list_time, list_checksum] = run(
+        [&](FakeThread& thread) { lists[thread.core].add(&thread, thread.priority); },
+        [&](FakeThread& thread) { lists[thread.core].remove(&thread, thread.priority); },
+        [&](u32 core) -> u64 {
+            return lists[core].empty() ? 0 : lists[core].front()->priority;
+        });
+
+    std::printf("Thread churn with %zu threads: %.3f us per operation intrusive, %.3f us with "
+                "lists\n",
+                num_threads, intrusive_time, list_time);
+    REQUIRE(intrusive_checksum == list_checksum);
+}
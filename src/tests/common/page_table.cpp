@@ -0,0 +1,61 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <tuple>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "common/page_table.h"
+#include "common/virtual_buffer.h"
+
+namespace {
+
+constexpr std::size_t PAGE_BITS = 12;
+constexpr u64 PAGE_SIZE = 1ULL << PAGE_BITS;
+
+/// Maps pages the way Memory does, pointers have the virtual address subtracted
+void MapMemory(Common::PageTable& page_table, VAddr base, u64 size, u8* host) {
+    u8* const pointer = host - base;
+    for (u64 page = base >> PAGE_BITS; page < (base + size) >> PAGE_BITS; ++page) {
+        page_table.pointers[page] = pointer;
+        page_table.attributes[page] = Common::PageType::Memory;
+    }
+    page_table.AddMemoryRun(base, size, pointer);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("PageTable[MemoryRuns]", "[common]") {
+    Common::PageTable page_table;
+    page_table.Resize(32, PAGE_BITS, true);
+    Common::VirtualBuffer<u8> host(16 * PAGE_SIZE);
+
+    // Two mappings that are contiguous in host memory make a single run
+    MapMemory(page_table, 0x10000, 4 * PAGE_SIZE, host.data());
+    MapMemory(page_table, 0x14000, 4 * PAGE_SIZE, host.data() + 4 * PAGE_SIZE);
+    auto [pointer, size] = page_table.FindMemoryRun(0x10010, 0x100000);
+    REQUIRE(pointer == host.data() + 0x10);
+    REQUIRE(size == 8 * PAGE_SIZE - 0x10);
+    REQUIRE(page_table.FindMemoryRun(0x10010, 0x20).second == 0x20);
+
+    // One that is not is its own run
+    MapMemory(page_table, 0x18000, 2 * PAGE_SIZE, host.data() + 12 * PAGE_SIZE);
+    std::tie(pointer, size) = page_table.FindMemoryRun(0x17000, 0x100000);
+    REQUIRE(size == PAGE_SIZE);
+    std::tie(pointer, size) = page_table.FindMemoryRun(0x18000, 0x100000);
+    REQUIRE(pointer == host.data() + 12 * PAGE_SIZE);
+    REQUIRE(size == 2 * PAGE_SIZE);
+
+    // Pages leaving plain memory split runs
+    page_table.RemoveMemoryRun(0x12000, PAGE_SIZE);
+    REQUIRE(page_table.FindMemoryRun(0x10000, 0x100000).second == 2 * PAGE_SIZE);
+    REQUIRE(page_table.FindMemoryRun(0x12800, 0x100000).first == nullptr);
+    REQUIRE(page_table.FindMemoryRun(0x13000, 0x100000).second == 5 * PAGE_SIZE);
+    page_table.AddMemoryRun(0x12000, PAGE_SIZE, host.data() - 0x10000);
+    REQUIRE(page_table.FindMemoryRun(0x10000, 0x100000).second == 8 * PAGE_SIZE);
+
+    REQUIRE(page_table.FindMemoryRun(0x1A000, 1).first == nullptr);
+    REQUIRE(page_table.FindMemoryRun(0, 1).first == nullptr);
+}
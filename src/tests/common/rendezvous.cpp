@@ -0,0 +1,110 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+#include <catch2/catch.hpp>
+#include "common/common_types.h"
+#include "common/rendezvous.h"
+
+namespace Common {
+
+namespace {
+
+constexpr u32 NUM_STEPS = 200000;
+
+using Side = Rendezvous::Side;
+
+// Mirrors the handoff the plugin manager used before the rendezvous, kept as a baseline
+struct ConditionVariableHandoff {
+    void HandTo(Side side) {
+        {
+            std::lock_guard lk{mutex};
+            owner = side;
+        }
+        cv.notify_one();
+    }
+
+    void WaitFor(Side side) {
+        std::unique_lock lk{mutex};
+        cv.wait(lk, [this, side] { return owner == side; });
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    Side owner{Side::Host};
+};
+
+template <typename Handoff>
+double MeasureStepsPerSecond(Handoff& handoff, u32& worker_steps) {
+    std::thread worker([&handoff, &worker_steps] {
+        for (u32 i = 0; i < NUM_STEPS; i++) {
+            handoff.WaitFor(Side::Worker);
+            worker_steps++;
+            handoff.HandTo(Side::Host);
+        }
+    });
+
+    const auto start = std::chrono::steady_clock::now();
+    for (u32 i = 0; i < NUM_STEPS; i++) {
+        handoff.HandTo(Side::Worker);
+        handoff.WaitFor(Side::Host);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    worker.join();
+
+    const std::chrono::duration<double> elapsed = end - start;
+    return NUM_STEPS / elapsed.count();
+}
+
+} // Anonymous namespace
+
+TEST_CASE("Rendezvous[StrictAlternation]", "[common]") {
+    Rendezvous rendezvous;
+    u32 host_value = 0;
+    u32 worker_value = 0;
+    bool mismatch = false;
+
+    std::thread worker([&] {
+        for (u32 i = 0; i < 1000; i++) {
+            rendezvous.WaitFor(Side::Worker);
+            // The host must have finished its step before the worker observes it
+            mismatch |= host_value != i + 1;
+            worker_value = host_value;
+            rendezvous.HandTo(Side::Host);
+        }
+    });
+
+    for (u32 i = 0; i < 1000; i++) {
+        host_value = i + 1;
+        rendezvous.HandToAndWait(Side::Worker, Side::Host);
+        mismatch |= worker_value != host_value;
+    }
+    worker.join();
+
+    REQUIRE(!mismatch);
+    REQUIRE(rendezvous.Owner() == Side::Host);
+}
+
+TEST_CASE("Rendezvous[StepsPerSecond]", "[common]") {
+    u32 rendezvous_steps = 0;
+    Rendezvous rendezvous;
+    const double rendezvous_rate = MeasureStepsPerSecond(rendezvous, rendezvous_steps);
+
+    u32 cv_steps = 0;
+    ConditionVariableHandoff cv_handoff;
+    const double cv_rate = MeasureStepsPerSecond(cv_handoff, cv_steps);
+
+    REQUIRE(rendezvous_steps == NUM_STEPS);
+    REQUIRE(cv_steps == NUM_STEPS);
+
+    printf("Rendezvous frame steps per second: %.0f\n", rendezvous_rate);
+    printf("Condition variable frame steps per second: %.0f\n", cv_rate);
+}
+
+} // namespace Common
@@ -10,6 +10,8 @@
 #include <cstdlib>
 #include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "common/file_util.h"
 #include "core/core.h"
@@ -145,3 +147,124 @@ TEST_CASE("CoreTiming[BasicOrderNoPausing]", "[core]") {
     printf("HostTimer No Pausing Timer Time: %.3f %.6f\n", timer_time / 1000.f,
            timer_time / 1000000.f);
 }
+
+TEST_CASE("CoreTiming[Unschedule]", "[core]") {
+    Core::Timing::CoreTiming core_timing;
+    core_timing.Initialize([]() {});
+
+    std::vector<std::uintptr_t> fired;
+    const auto callback = [&fired](std::uintptr_t user_data, std::chrono::nanoseconds) {
+        fired.push_back(user_data);
+    };
+    const auto event_a = Core::Timing::CreateEvent("eventA", callback);
+    const auto event_b = Core::Timing::CreateEvent("eventB", callback);
+
+    // Times are a permutation of the user data, so the firing order is known
+    for (std::uintptr_t i = 0; i < 100; i++) {
+        const auto time = std::chrono::nanoseconds{static_cast<s64>((i * 37 % 100 + 1) * 1000)};
+        core_timing.ScheduleEvent(time, event_a, i);
+        core_timing.ScheduleEvent(time, event_b, i);
+    }
+    for (std::uintptr_t i = 0; i < 100; i += 2) {
+        core_timing.UnscheduleEvent(event_a, i);
+    }
+    core_timing.RemoveEvent(event_b);
+
+    core_timing.AddTicks(100000000);
+    REQUIRE(!core_timing.Advance());
+
+    std::vector<std::uintptr_t> expected;
+    for (std::uintptr_t time = 1; time <= 100; time++) {
+        for (std::uintptr_t i = 1; i < 100; i += 2) {
+            if (i * 37 % 100 + 1 == time) {
+                expected.push_back(i);
+            }
+        }
+    }
+    REQUIRE(fired == expected);
+
+    core_timing.Shutdown();
+}
+
+TEST_CASE("CoreTiming[ScheduleCancelThroughput]", "[core]") {
+    ScopeInit guard;
+    auto& core_timing = guard.core_timing;
+    core_timing.SyncPause(true);
+
+    constexpr std::size_t num_threads = 4;
+    constexpr std::uintptr_t events_per_thread = 20000;
+
+    const auto empty_callback = [](std::uintptr_t, std::chrono::nanoseconds) {};
+    std::vector<std::shared_ptr<Core::Timing::EventType>> events;
+    for (std::size_t i = 0; i < num_threads; i++) {
+        events.push_back(Core::Timing::CreateEvent("producer" + std::to_string(i), empty_callback));
+    }
+
+    // Every producer reschedules its events like a periodic service would, far enough in the
+    // future that none of them fire
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < num_threads; i++) {
+        threads.emplace_back([&core_timing, &event = events[i]] {
+            for (std::uintptr_t j = 0; j < events_per_thread; j++) {
+                core_timing.ScheduleEvent(std::chrono::seconds{10}, event, j);
+                if (j % 2 == 1) {
+                    core_timing.UnscheduleEvent(event, j - 1);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    // Half of the events are left, the next one is still far away
+    const auto next_time = core_timing.Advance();
+    REQUIRE(next_time);
+    REQUIRE(*next_time > 0);
+    for (const auto& event : events) {
+        core_timing.RemoveEvent(event);
+    }
+    REQUIRE(!core_timing.Advance());
+
+    const double elapsed = std::chrono::duration<double, std::milli>(end - start).count();
+    const double operations = static_cast<double>(num_threads * events_per_thread * 3 / 2);
+    printf("CoreTiming Schedule/Cancel: %.3f ms, %.1f ns per operation\n", elapsed,
+           elapsed * 1000000.0 / operations);
+}
+
+TEST_CASE("CoreTiming[RestorePendingEvents]", "[core]") {
+    Core::Timing::CoreTiming core_timing;
+    core_timing.Initialize([]() {});
+
+    std::vector<std::uintptr_t> fired;
+    const auto callback = [&fired](std::uintptr_t user_data, std::chrono::nanoseconds) {
+        fired.push_back(user_data);
+    };
+    const auto event_a = Core::Timing::CreateEvent("eventA", callback);
+    const auto event_b = Core::Timing::CreateEvent("eventB", callback);
+
+    core_timing.ScheduleEvent(std::chrono::microseconds{30}, event_a, 1);
+    core_timing.ScheduleEvent(std::chrono::microseconds{10}, event_a, 2);
+    core_timing.ScheduleEvent(std::chrono::microseconds{20}, event_b, 3);
+    const auto pending = core_timing.GetPendingEvents();
+    REQUIRE(pending.size() == 3);
+    REQUIRE(pending[0].name == "eventA");
+    REQUIRE(pending[0].user_data == 2);
+    REQUIRE(pending[2].user_data == 1);
+
+    // The events change after the list is taken
+    core_timing.UnscheduleEvent(event_a, 1);
+    core_timing.ScheduleEvent(std::chrono::microseconds{1}, event_a, 1);
+    core_timing.ScheduleEvent(std::chrono::microseconds{5}, event_a, 4);
+    core_timing.UnscheduleEvent(event_b, 3);
+
+    // Event 4 is dropped and event 3 can't be recreated
+    REQUIRE(core_timing.RestorePendingEvents(pending) == 1);
+    core_timing.AddTicks(100000000);
+    REQUIRE(!core_timing.Advance());
+    REQUIRE(fired == std::vector<std::uintptr_t>{2, 1});
+
+    core_timing.Shutdown();
+}
@@ -0,0 +1,456 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <random>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#ifdef ARCHITECTURE_x86_64
+#include <dynarmic/A64/a64.h>
+#include <dynarmic/A64/config.h>
+#endif
+
+#include "common/cityhash.h"
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "common/page_table.h"
+#include "common/virtual_buffer.h"
+#include "core/core.h"
+#include "core/hle/guest_functions.h"
+#include "core/memory.h"
+
+namespace {
+
+namespace GuestFunctions = HLE::GuestFunctions;
+using Core::Memory::PAGE_BITS;
+using Core::Memory::PAGE_SIZE;
+
+constexpr VAddr HEAP_BASE = 0x10000000;
+constexpr std::size_t HEAP_SIZE = 16 * 1024 * 1024;
+
+/// A page table with a heap of plain memory mapped at HEAP_BASE
+struct GuestHeap {
+    GuestHeap() : memory(HEAP_SIZE) {
+        page_table.Resize(32, PAGE_BITS, true);
+        for (std::size_t page = 0; page < HEAP_SIZE / PAGE_SIZE; ++page) {
+            const std::size_t index = (HEAP_BASE >> PAGE_BITS) + page;
+            page_table.pointers[index] = memory.data() - HEAP_BASE;
+            page_table.attributes[index] = Common::PageType::Memory;
+        }
+    }
+
+    u8* Pointer(VAddr addr) {
+        return memory.data() + (addr - HEAP_BASE);
+    }
+
+    Common::VirtualBuffer<u8> memory;
+    Common::PageTable page_table;
+};
+
+/// A program image with a MOD0 header and a dynamic symbol table behind .text
+class ModuleImage {
+public:
+    static constexpr std::size_t TEXT_SIZE = 0x1000;
+
+    ModuleImage() : image(0x2000) {
+        Write32(4, MOD_HEADER_OFFSET);
+        Write32(MOD_HEADER_OFFSET, Common::MakeMagic('M', 'O', 'D', '0'));
+        Write32(MOD_HEADER_OFFSET + 4, DYNAMIC_OFFSET - MOD_HEADER_OFFSET);
+        Write64(DYNAMIC_OFFSET + 0x00, 5);
+        Write64(DYNAMIC_OFFSET + 0x08, STRINGS_OFFSET);
+        Write64(DYNAMIC_OFFSET + 0x10, 6);
+        Write64(DYNAMIC_OFFSET + 0x18, SYMBOLS_OFFSET);
+        Write64(DYNAMIC_OFFSET + 0x20, 11);
+        Write64(DYNAMIC_OFFSET + 0x28, 0x18);
+    }
+
+    void AddCode(std::size_t offset, std::span<const u32> code) {
+        std::memcpy(image.data() + offset, code.data(), code.size_bytes());
+    }
+
+    /// Adds a global function, defined in .text unless section is 0
+    void AddSymbol(std::string_view name, u64 value, u64 size, u16 section = 1) {
+        const std::size_t offset = SYMBOLS_OFFSET + ++num_symbols * 0x18;
+        Write32(offset, static_cast<u32>(strings_size));
+        image[offset + 4] = 0x12;
+        std::memcpy(image.data() + offset + 6, &section, sizeof(section));
+        Write64(offset + 8, value);
+        Write64(offset + 16, size);
+        std::memcpy(image.data() + STRINGS_OFFSET + strings_size, name.data(), name.size());
+        strings_size += name.size() + 1;
+    }
+
+    GuestFunctions::KnownFunction Known(u64 value, u64 size,
+                                        GuestFunctions::Routine routine) const {
+        return {GuestFunctions::ComputeCodeHash(std::span(image).subspan(value, size)), routine};
+    }
+
+    u32 Read32(std::size_t offset) const {
+        u32 value;
+        std::memcpy(&value, image.data() + offset, sizeof(value));
+        return value;
+    }
+
+    std::vector<u8> image;
+
+private:
+    static constexpr u32 MOD_HEADER_OFFSET = 0x80;
+    static constexpr u32 DYNAMIC_OFFSET = 0x1000;
+    static constexpr u32 SYMBOLS_OFFSET = 0x1100;
+    static constexpr u32 STRINGS_OFFSET = 0x1800;
+
+    void Write32(std::size_t offset, u32 value) {
+        std::memcpy(image.data() + offset, &value, sizeof(value));
+    }
+
+    void Write64(std::size_t offset, u64 value) {
+        std::memcpy(image.data() + offset, &value, sizeof(value));
+    }
+
+    std::size_t num_symbols = 0;
+    std::size_t strings_size = 1;
+};
+
+u32 SvcImmediate(u32 instruction) {
+    return (instruction >> 5) & 0xFFFF;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("GuestFunctions[PatchModule]", "[core]") {
+    using GuestFunctions::Routine;
+    ModuleImage module;
+    for (u32 offset = 0x100; offset < 0x500; offset += 4) {
+        const u32 instruction = offset * 0x01010101;
+        module.AddCode(offset, std::span(&instruction, 1));
+    }
+    module.AddSymbol("memcpy", 0x100, 0x40);
+    module.AddSymbol("strlen", 0x200, 0x40);
+    module.AddSymbol("strcpy", 0x300, 0x40);
+    module.AddSymbol("memset", 0, 0, 0);
+    module.AddSymbol("memmove", 0x400, 0x40);
+    module.AddSymbol("strlen", 0xFFC, 0x40);
+    const std::array functions{
+        module.Known(0x100, 0x40, Routine::MoveBlock),
+        module.Known(0x200, 0x40, Routine::StringLength),
+        module.Known(0x300, 0x3C, Routine::FillBlock),
+    };
+
+    // Only the code counts. Names don't, the memmove here is not a known one.
+    REQUIRE(GuestFunctions::PatchModule(module.image, ModuleImage::TEXT_SIZE, {}, functions) == 2);
+    REQUIRE(SvcImmediate(module.Read32(0x100)) ==
+            GuestFunctions::SVC_BASE + static_cast<u32>(Routine::MoveBlock));
+    REQUIRE(SvcImmediate(module.Read32(0x200)) ==
+            GuestFunctions::SVC_BASE + static_cast<u32>(Routine::StringLength));
+    REQUIRE(GuestFunctions::IsGuestFunctionCall(SvcImmediate(module.Read32(0x100))));
+    REQUIRE(module.Read32(0x104) == 0xD65F03C0);
+    REQUIRE(module.Read32(0x300) == 0x300U * 0x01010101U);
+    REQUIRE(module.Read32(0x400) == 0x400U * 0x01010101U);
+
+    // Patched code no longer matches
+    REQUIRE(GuestFunctions::PatchModule(module.image, ModuleImage::TEXT_SIZE, {}, functions) == 0);
+
+    // Images without a MOD0 header are left alone
+    std::vector<u8> stripped(0x1000);
+    REQUIRE(GuestFunctions::PatchModule(stripped, stripped.size(), {}, functions) == 0);
+}
+
+TEST_CASE("GuestFunctions[Routines]", "[core]") {
+    auto& memory = Core::System::GetInstance().Memory();
+    GuestHeap heap;
+    const auto& page_table = heap.page_table;
+
+    // Across pages, overlapping in both directions
+    for (std::size_t i = 0; i < 3 * PAGE_SIZE; ++i) {
+        heap.Pointer(HEAP_BASE)[i] = static_cast<u8>(i);
+    }
+    GuestFunctions::MoveBlock(memory, page_table, HEAP_BASE + 0x10000, HEAP_BASE + 0x10,
+                              2 * PAGE_SIZE);
+    REQUIRE(std::memcmp(heap.Pointer(HEAP_BASE + 0x10000), heap.Pointer(HEAP_BASE + 0x10),
+                        2 * PAGE_SIZE) == 0);
+    GuestFunctions::MoveBlock(memory, page_table, HEAP_BASE + 1, HEAP_BASE, PAGE_SIZE + 3);
+    REQUIRE(heap.Pointer(HEAP_BASE)[1] == 0);
+    REQUIRE(heap.Pointer(HEAP_BASE)[PAGE_SIZE + 3] == static_cast<u8>(PAGE_SIZE + 2));
+    GuestFunctions::MoveBlock(memory, page_table, HEAP_BASE, HEAP_BASE + 1, PAGE_SIZE + 3);
+    REQUIRE(heap.Pointer(HEAP_BASE)[0] == 0);
+    REQUIRE(heap.Pointer(HEAP_BASE)[PAGE_SIZE + 2] == static_cast<u8>(PAGE_SIZE + 2));
+
+    GuestFunctions::FillBlock(memory, page_table, HEAP_BASE + PAGE_SIZE - 5, 0xAB, 10);
+    REQUIRE(heap.Pointer(HEAP_BASE)[PAGE_SIZE - 6] != 0xAB);
+    REQUIRE(heap.Pointer(HEAP_BASE)[PAGE_SIZE - 5] == 0xAB);
+    REQUIRE(heap.Pointer(HEAP_BASE)[PAGE_SIZE + 4] == 0xAB);
+    REQUIRE(heap.Pointer(HEAP_BASE)[PAGE_SIZE + 5] != 0xAB);
+
+    std::memset(heap.Pointer(HEAP_BASE + 2 * PAGE_SIZE - 20), 'a', 40);
+    heap.Pointer(HEAP_BASE + 2 * PAGE_SIZE + 20)[0] = 0;
+    REQUIRE(GuestFunctions::StringLength(memory, page_table, HEAP_BASE + 2 * PAGE_SIZE - 20) ==
+            40);
+    REQUIRE(GuestFunctions::StringLength(memory, page_table, HEAP_BASE + 2 * PAGE_SIZE + 20) == 0);
+}
+
+#ifdef ARCHITECTURE_x86_64
+
+namespace {
+
+/**
+ * A guest libc and a loop calling it for every entry of a list of {routine, x0, x1, x2}, ending
+ * with "svc #0". Symbol offsets are in 32-bit words.
+ */
+constexpr std::size_t FRAME_WORD = 0;
+constexpr std::size_t MEMCPY_WORD = 15;
+constexpr std::size_t MEMSET_WORD = 29;
+constexpr std::size_t STRLEN_WORD = 44;
+constexpr std::array<u32, 50> GUEST_CODE{
+    // frame: cbz x20, end; ldp x21, x0, [x19]; ldp x1, x2, [x19, #16]; add x19, x19, #32;
+    // sub x20, x20, #1; cmp x21, #1; b.eq 1f; b.hi 2f; bl memcpy; b frame; 1: bl memset;
+    // b frame; 2: bl strlen; b frame; end: svc #0
+    0xB40001D4, 0xA9400275, 0xA9410A61, 0x91008273, 0xD1000694, 0xF10006BF, 0x54000080,
+    0x540000A8, 0x94000007, 0x17FFFFF7, 0x94000013, 0x17FFFFF5, 0x94000020, 0x17FFFFF3,
+    0xD4000001,
+    // memcpy: 16 bytes at a time with ldp/stp, then bytewise
+    0xAA0003E3, 0xF100405F, 0x540000C3, 0xA8C11424, 0xA8811464, 0xD1004042, 0xF100405F,
+    0x54FFFF82, 0xB40000A2, 0x38401424, 0x38001464, 0xF1000442, 0x54FFFFA1, 0xD65F03C0,
+    // memset: the byte repeated in a register, 16 bytes at a time with stp, then bytewise
+    0xAA0003E3, 0x92401C21, 0xB200C3E4, 0x9B047C21, 0xF100405F, 0x540000A3, 0xA8810461,
+    0xD1004042, 0xF100405F, 0x54FFFFA2, 0xB4000082, 0x38001461, 0xF1000442, 0x54FFFFC1,
+    0xD65F03C0,
+    // strlen: bytewise
+    0xAA0003E1, 0x38401422, 0x35FFFFE2, 0xCB000020, 0xD1000400, 0xD65F03C0,
+};
+
+/// Runs guest code of the heap on the JIT, counting the ticks it takes like the emulated cores do
+class GuestCore final : public Dynarmic::A64::UserCallbacks {
+public:
+    explicit GuestCore(GuestHeap& heap_) : heap{heap_} {
+        Dynarmic::A64::UserConfig config;
+        config.callbacks = this;
+        config.page_table = reinterpret_cast<void**>(heap.page_table.pointers.data());
+        config.page_table_address_space_bits = 32;
+        config.silently_mirror_page_table = false;
+        config.absolute_offset_page_table = true;
+        jit = std::make_unique<Dynarmic::A64::Jit>(config);
+    }
+
+    /// Runs from pc until "svc #0" with x19 and x20 set, returns the ticks taken
+    std::optional<u64> Run(VAddr pc, const std::array<u64, 2>& args) {
+        ticks = 0;
+        failed = false;
+        jit->SetRegister(19, args[0]);
+        jit->SetRegister(20, args[1]);
+        jit->SetPC(pc);
+        jit->Run();
+        if (failed) {
+            return std::nullopt;
+        }
+        return ticks;
+    }
+
+    u8 MemoryRead8(u64 vaddr) override {
+        return Read<u8>(vaddr);
+    }
+    u16 MemoryRead16(u64 vaddr) override {
+        return Read<u16>(vaddr);
+    }
+    u32 MemoryRead32(u64 vaddr) override {
+        return Read<u32>(vaddr);
+    }
+    u64 MemoryRead64(u64 vaddr) override {
+        return Read<u64>(vaddr);
+    }
+    Dynarmic::A64::Vector MemoryRead128(u64 vaddr) override {
+        return {Read<u64>(vaddr), Read<u64>(vaddr + 8)};
+    }
+
+    void MemoryWrite8(u64 vaddr, u8 value) override {
+        Write(vaddr, value);
+    }
+    void MemoryWrite16(u64 vaddr, u16 value) override {
+        Write(vaddr, value);
+    }
+    void MemoryWrite32(u64 vaddr, u32 value) override {
+        Write(vaddr, value);
+    }
+    void MemoryWrite64(u64 vaddr, u64 value) override {
+        Write(vaddr, value);
+    }
+    void MemoryWrite128(u64 vaddr, Dynarmic::A64::Vector value) override {
+        Write(vaddr, value[0]);
+        Write(vaddr + 8, value[1]);
+    }
+
+    bool MemoryWriteExclusive8(u64 vaddr, u8 value, u8) override {
+        Write(vaddr, value);
+        return true;
+    }
+    bool MemoryWriteExclusive16(u64 vaddr, u16 value, u16) override {
+        Write(vaddr, value);
+        return true;
+    }
+    bool MemoryWriteExclusive32(u64 vaddr, u32 value, u32) override {
+        Write(vaddr, value);
+        return true;
+    }
+    bool MemoryWriteExclusive64(u64 vaddr, u64 value, u64) override {
+        Write(vaddr, value);
+        return true;
+    }
+    bool MemoryWriteExclusive128(u64 vaddr, Dynarmic::A64::Vector value,
+                                 Dynarmic::A64::Vector) override {
+        MemoryWrite128(vaddr, value);
+        return true;
+    }
+
+    // Nothing may be thrown through JIT code, failures stop the guest instead
+    void InterpreterFallback(u64, std::size_t) override {
+        failed = true;
+        jit->HaltExecution();
+    }
+
+    void ExceptionRaised(u64, Dynarmic::A64::Exception) override {
+        failed = true;
+        jit->HaltExecution();
+    }
+
+    void CallSVC(u32 swi) override {
+        if (!GuestFunctions::IsGuestFunctionCall(swi)) {
+            jit->HaltExecution();
+            return;
+        }
+        const std::array<u64, 3> args{jit->GetRegister(0), jit->GetRegister(1),
+                                      jit->GetRegister(2)};
+        auto& memory = Core::System::GetInstance().Memory();
+        jit->SetRegister(0, GuestFunctions::Invoke(memory, heap.page_table, swi, args));
+    }
+
+    void AddTicks(u64 ticks_) override {
+        ticks += ticks_;
+    }
+
+    u64 GetTicksRemaining() override {
+        return u64{1} << 40;
+    }
+
+    u64 GetCNTPCT() override {
+        return 0;
+    }
+
+private:
+    template <typename T>
+    T Read(VAddr vaddr) {
+        T value;
+        std::memcpy(&value, heap.Pointer(vaddr), sizeof(value));
+        return value;
+    }
+
+    template <typename T>
+    void Write(VAddr vaddr, T value) {
+        std::memcpy(heap.Pointer(vaddr), &value, sizeof(value));
+    }
+
+    GuestHeap& heap;
+    std::unique_ptr<Dynarmic::A64::Jit> jit;
+    u64 ticks = 0;
+    bool failed = false;
+};
+
+} // Anonymous namespace
+
+TEST_CASE("GuestFunctions[GuestCyclesPerFrame]", "[.benchmark]") {
+    using GuestFunctions::Routine;
+
+    // The guest libc as a module, replaced by the host routines once its functions are known
+    ModuleImage module;
+    module.AddCode(0x100, GUEST_CODE);
+    const auto add_function = [&](std::string_view name, std::size_t word, std::size_t end_word) {
+        module.AddSymbol(name, 0x100 + word * 4, (end_word - word) * 4);
+    };
+    add_function("memcpy", MEMCPY_WORD, MEMSET_WORD);
+    add_function("memset", MEMSET_WORD, STRLEN_WORD);
+    add_function("strlen", STRLEN_WORD, GUEST_CODE.size());
+    const std::array functions{
+        module.Known(0x100 + MEMCPY_WORD * 4, (MEMSET_WORD - MEMCPY_WORD) * 4, Routine::MoveBlock),
+        module.Known(0x100 + MEMSET_WORD * 4, (STRLEN_WORD - MEMSET_WORD) * 4, Routine::FillBlock),
+        module.Known(0x100 + STRLEN_WORD * 4, (GUEST_CODE.size() - STRLEN_WORD) * 4,
+                     Routine::StringLength),
+    };
+    ModuleImage patched = module;
+    REQUIRE(GuestFunctions::PatchModule(patched.image, ModuleImage::TEXT_SIZE, {}, functions) == 3);
+
+    // The calls of a frame: lots of small copies and strings, a few buffer sized copies and
+    // clears. Data lives in the upper half of the heap.
+    constexpr VAddr code_base = HEAP_BASE;
+    constexpr VAddr calls_base = HEAP_BASE + 0x10000;
+    constexpr VAddr data_base = HEAP_BASE + HEAP_SIZE / 2;
+    constexpr std::size_t data_size = HEAP_SIZE / 2;
+    std::mt19937 rng{1234};
+    const auto random_size = [&] {
+        const u32 roll = rng() % 100;
+        return roll < 90 ? 16 + rng() % 240 : roll < 99 ? 4096 : 65536;
+    };
+    const auto random_address = [&](std::size_t size) {
+        return data_base + rng() % (data_size / 2 - size);
+    };
+    std::vector<std::array<u64, 4>> calls;
+    for (int i = 0; i < 4000; ++i) {
+        const std::size_t size = random_size();
+        calls.push_back({0, random_address(size), data_size / 2 + random_address(size), size});
+    }
+    for (int i = 0; i < 1000; ++i) {
+        const std::size_t size = random_size();
+        calls.push_back({1, random_address(size), rng() % 256, size});
+    }
+    for (int i = 0; i < 2000; ++i) {
+        calls.push_back({2, data_base + data_size - PAGE_SIZE + (i % 64) * 64, 0, 0});
+    }
+    std::shuffle(calls.begin(), calls.end(), rng);
+
+    using Clock = std::chrono::steady_clock;
+    constexpr int num_frames = 20;
+    const auto run = [&](const ModuleImage& image) {
+        GuestHeap heap;
+        std::memcpy(heap.Pointer(code_base), image.image.data(), image.image.size());
+        std::memcpy(heap.Pointer(calls_base), calls.data(), calls.size() * sizeof(calls[0]));
+        // Strings of up to 48 characters
+        for (int i = 0; i < 64; ++i) {
+            u8* const string = heap.Pointer(data_base + data_size - PAGE_SIZE + i * 64);
+            std::memset(string, 'a', 63);
+            string[i % 48] = 0;
+        }
+
+        GuestCore core{heap};
+        u64 ticks = 0;
+        const auto start = Clock::now();
+        for (int frame = 0; frame < num_frames; ++frame) {
+            const auto frame_ticks =
+                core.Run(code_base + 0x100 + FRAME_WORD * 4, {calls_base, calls.size()});
+            REQUIRE(frame_ticks);
+            ticks += *frame_ticks;
+        }
+        const std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+        const u64 data_hash = Common::CityHash64(
+            reinterpret_cast<const char*>(heap.Pointer(data_base)), data_size);
+        return std::tuple{ticks / num_frames, elapsed.count() / num_frames, data_hash};
+    };
+    const auto [guest_ticks, guest_ms, guest_data_hash] = run(module);
+    const auto [host_ticks, host_ms, host_data_hash] = run(patched);
+    REQUIRE(guest_data_hash == host_data_hash);
+    std::printf("Guest libc: %10llu ticks, %7.3f ms per frame\n",
+                static_cast<unsigned long long>(guest_ticks), guest_ms);
+    std::printf("Host routines: %10llu ticks, %7.3f ms per frame\n",
+                static_cast<unsigned long long>(host_ticks), host_ms);
+    REQUIRE(host_ticks < guest_ticks);
+}
+
+#endif
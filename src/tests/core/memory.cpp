@@ -0,0 +1,156 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "common/page_table.h"
+#include "common/virtual_buffer.h"
+#include "core/core.h"
+#include "core/hle/kernel/memory/page_table.h"
+#include "core/hle/kernel/process.h"
+#include "core/memory.h"
+
+namespace {
+
+using Core::Memory::PAGE_BITS;
+using Core::Memory::PAGE_SIZE;
+
+constexpr VAddr HEAP_BASE = 0x10000000;
+
+/**
+ * A process with a heap of plain memory, mapped in chunks the way the kernel allocates it. Every
+ * other chunk is backed by host memory that doesn't follow the previous one, so reads across them
+ * can't be merged into one run.
+ */
+struct TestProcess {
+    TestProcess(std::size_t heap_size_, std::size_t chunk_size)
+        : process{Kernel::Process::Create(Core::System::GetInstance(), "",
+                                          Kernel::Process::ProcessType::Userland)},
+          heap_size{heap_size_}, host(heap_size + heap_size / chunk_size * PAGE_SIZE) {
+        auto& page_table = process->PageTable().PageTableImpl();
+        page_table.Resize(32, PAGE_BITS, true);
+        u8* chunk_host = host.data();
+        for (std::size_t offset = 0; offset < heap_size; offset += chunk_size) {
+            if ((offset / chunk_size) % 2 == 1) {
+                chunk_host += PAGE_SIZE;
+            }
+            const VAddr base = HEAP_BASE + offset;
+            u8* const pointer = chunk_host - base;
+            for (std::size_t page = 0; page < chunk_size / PAGE_SIZE; ++page) {
+                page_table.pointers[(base >> PAGE_BITS) + page] = pointer;
+                page_table.attributes[(base >> PAGE_BITS) + page] = Common::PageType::Memory;
+            }
+            page_table.AddMemoryRun(base, chunk_size, pointer);
+            chunk_host += chunk_size;
+        }
+    }
+
+    u8* Pointer(VAddr vaddr) {
+        return process->PageTable().PageTableImpl().pointers[vaddr >> PAGE_BITS] + vaddr;
+    }
+
+    std::shared_ptr<Kernel::Process> process;
+    std::size_t heap_size;
+    Common::VirtualBuffer<u8> host;
+};
+
+} // Anonymous namespace
+
+TEST_CASE("Memory[Blocks]", "[core]") {
+    constexpr std::size_t chunk_size = 4 * PAGE_SIZE;
+    TestProcess test(16 * PAGE_SIZE, chunk_size);
+    auto& memory = Core::System::GetInstance().Memory();
+    for (VAddr vaddr = HEAP_BASE; vaddr < HEAP_BASE + test.heap_size; ++vaddr) {
+        *test.Pointer(vaddr) = static_cast<u8>(vaddr * 7 + (vaddr >> PAGE_BITS));
+    }
+    const auto expected = [&](VAddr vaddr, std::size_t size) {
+        std::vector<u8> bytes(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            bytes[i] = *test.Pointer(vaddr + i);
+        }
+        return bytes;
+    };
+
+    // Within a page, across pages of a run, across runs and at the end of the heap
+    const std::array<std::pair<VAddr, std::size_t>, 6> ranges{{
+        {HEAP_BASE + 0x10, 0x20},
+        {HEAP_BASE + PAGE_SIZE - 8, 16},
+        {HEAP_BASE + 0x123, 3 * PAGE_SIZE},
+        {HEAP_BASE + chunk_size - 0x80, 0x100},
+        {HEAP_BASE + 0x40, 14 * PAGE_SIZE},
+        {HEAP_BASE + test.heap_size - PAGE_SIZE, PAGE_SIZE},
+    }};
+    for (const auto& [vaddr, size] : ranges) {
+        std::vector<u8> read(size);
+        memory.ReadBlock(*test.process, vaddr, read.data(), size);
+        REQUIRE(read == expected(vaddr, size));
+
+        std::vector<u8> written(size);
+        std::iota(written.begin(), written.end(), static_cast<u8>(size));
+        memory.WriteBlock(*test.process, vaddr, written.data(), size);
+        REQUIRE(expected(vaddr, size) == written);
+
+        memory.ZeroBlock(*test.process, vaddr, size);
+        REQUIRE(expected(vaddr, size) == std::vector<u8>(size));
+    }
+
+    // Reads past the heap come back as zeroes
+    std::vector<u8> read(2 * PAGE_SIZE, 0xFF);
+    const VAddr end = HEAP_BASE + test.heap_size;
+    *test.Pointer(end - PAGE_SIZE) = 1;
+    memory.ReadBlock(*test.process, end - PAGE_SIZE, read.data(), read.size());
+    REQUIRE(read[0] == 1);
+    REQUIRE(std::all_of(read.begin() + PAGE_SIZE, read.end(), [](u8 value) { return value == 0; }));
+}
+
+TEST_CASE("Memory[BlockReads]", "[.benchmark]") {
+    // A 64 MiB heap mapped in 2 MiB chunks, read in IPC sized blocks, many of them within a page,
+    // and in a few large payloads
+    TestProcess test(64 * 1024 * 1024, 2 * 1024 * 1024);
+    auto& memory = Core::System::GetInstance().Memory();
+
+    struct Reads {
+        const char* name;
+        std::size_t min_size;
+        std::size_t max_size;
+        int count;
+    };
+    constexpr std::array<Reads, 3> classes{{
+        {"under a page", 0x8, 0x800, 200000},
+        {"a few pages", 0x1000, 0x10000, 20000},
+        {"payloads", 0x400000, 0x400000, 20},
+    }};
+
+    std::mt19937 rng{1234};
+    std::vector<u8> buffer(0x400000);
+    for (const Reads& reads : classes) {
+        std::vector<std::pair<VAddr, std::size_t>> blocks;
+        for (int i = 0; i < reads.count; ++i) {
+            const std::size_t size = reads.min_size + rng() % (reads.max_size - reads.min_size + 1);
+            blocks.emplace_back(HEAP_BASE + rng() % (test.heap_size - size), size);
+        }
+
+        // Warm up the host pages so that the first touch is not measured
+        for (const auto& [vaddr, size] : blocks) {
+            memory.ReadBlock(*test.process, vaddr, buffer.data(), size);
+        }
+        using Clock = std::chrono::steady_clock;
+        const auto start = Clock::now();
+        for (const auto& [vaddr, size] : blocks) {
+            memory.ReadBlock(*test.process, vaddr, buffer.data(), size);
+        }
+        const auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start);
+        std::printf("ReadBlock %s: %.1f ns per read\n", reads.name, elapsed.count() / reads.count);
+    }
+}
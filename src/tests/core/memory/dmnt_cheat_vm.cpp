@@ -0,0 +1,162 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "core/memory/dmnt_cheat_types.h"
+#include "core/memory/dmnt_cheat_vm.h"
+
+namespace {
+
+using Core::Memory::CheatEntry;
+using Core::Memory::CheatProcessMetadata;
+using Core::Memory::DmntCheatVm;
+
+constexpr std::size_t MEMORY_SIZE = 0x10000;
+constexpr int ITERATIONS = 1000;
+
+class TestCallbacks final : public DmntCheatVm::Callbacks {
+public:
+    explicit TestCallbacks(std::vector<u8>& memory_) : memory{memory_} {}
+
+    void MemoryRead(VAddr address, void* data, u64 size) override {
+        if (address + size <= memory.size()) {
+            std::memcpy(data, memory.data() + address, size);
+        }
+    }
+
+    void MemoryWrite(VAddr address, const void* data, u64 size) override {
+        if (address + size <= memory.size()) {
+            std::memcpy(memory.data() + address, data, size);
+        }
+    }
+
+    u64 HidKeysDown() override {
+        return 0;
+    }
+
+    void DebugLog(u8, u64) override {}
+    void CommandLog(std::string_view) override {}
+
+private:
+    std::vector<u8>& memory;
+};
+
+// Fills every cheat with a loop over conditional blocks, half of which are skipped, storing at
+// addresses that depend on a register so both modes have to agree on every step.
+std::vector<CheatEntry> MakeCheats() {
+    std::vector<CheatEntry> cheats(4);
+    for (std::size_t c = 0; c < cheats.size(); ++c) {
+        auto& definition = cheats[c].definition;
+        cheats[c].enabled = true;
+        cheats[c].cheat_id = static_cast<u32>(c);
+
+        u32 count = 0;
+        const auto emit = [&](std::initializer_list<u32> dwords) {
+            for (const u32 dword : dwords) {
+                definition.opcodes[count++] = dword;
+            }
+        };
+
+        // Loop four times on register 1
+        emit({0x30100000, 4});
+        for (u32 i = 0; i < 21; ++i) {
+            const u32 rel_address = 0x100 + static_cast<u32>(c) * 0x100 + i * 4;
+            // If the u32 at rel_address equals 0 (met) or 1 (not met)
+            emit({0x14050000, rel_address, i % 2});
+            // Store i + 1 to 0x1000 + register 0
+            emit({0x04000000, 0x1000, i + 1});
+            // Register 0 += 4
+            emit({0x74000000, 4});
+            // Store the cheat index to 0x8000 + register 0
+            emit({0x04000000, 0x8000, static_cast<u32>(c)});
+            emit({0x20000000});
+        }
+        emit({0x31100000});
+        definition.num_opcodes = count;
+    }
+    return cheats;
+}
+
+double MeasureMicroseconds(DmntCheatVm& vm, const CheatProcessMetadata& metadata) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        vm.Execute(metadata);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const std::chrono::duration<double, std::micro> elapsed = end - start;
+    return elapsed.count() / ITERATIONS;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("DmntCheatVm[PredecodedMatchesInterpreter]", "[core]") {
+    const std::vector<CheatEntry> cheats = MakeCheats();
+    const CheatProcessMetadata metadata{};
+
+    std::vector<u8> interpreted_memory(MEMORY_SIZE);
+    DmntCheatVm interpreted_vm(std::make_unique<TestCallbacks>(interpreted_memory));
+    interpreted_vm.SetUsePredecodedProgram(false);
+    REQUIRE(interpreted_vm.LoadProgram(cheats));
+    interpreted_vm.Execute(metadata);
+
+    std::vector<u8> predecoded_memory(MEMORY_SIZE);
+    DmntCheatVm predecoded_vm(std::make_unique<TestCallbacks>(predecoded_memory));
+    REQUIRE(predecoded_vm.LoadProgram(cheats));
+    predecoded_vm.Execute(metadata);
+
+    REQUIRE(interpreted_memory == predecoded_memory);
+
+    // Eleven met conditions per pass, four passes per cheat, each advancing register 0 by 4
+    u32 last_store{};
+    std::memcpy(&last_store, predecoded_memory.data() + 0x1000 + (4 * 4 * 11 - 1) * 4,
+                sizeof(last_store));
+    REQUIRE(last_store == 21);
+}
+
+TEST_CASE("DmntCheatVm[UnclosedConditional]", "[core]") {
+    std::vector<CheatEntry> cheats(1);
+    cheats[0].enabled = true;
+    auto& definition = cheats[0].definition;
+    // If the u32 at 0x100 equals 1, store 1 to 0x200, with no end of the block
+    const u32 opcodes[] = {0x14050000, 0x100, 1, 0x04000000, 0x200, 1};
+    std::copy(std::begin(opcodes), std::end(opcodes), definition.opcodes.begin());
+    definition.num_opcodes = static_cast<u32>(std::size(opcodes));
+
+    for (const bool predecoded : {false, true}) {
+        std::vector<u8> memory(MEMORY_SIZE);
+        DmntCheatVm vm(std::make_unique<TestCallbacks>(memory));
+        vm.SetUsePredecodedProgram(predecoded);
+        REQUIRE(vm.LoadProgram(cheats));
+        vm.Execute({});
+        REQUIRE(memory[0x200] == 0);
+    }
+}
+
+TEST_CASE("DmntCheatVm[LargeCheatSet]", "[core]") {
+    const std::vector<CheatEntry> cheats = MakeCheats();
+    const CheatProcessMetadata metadata{};
+    std::vector<u8> memory(MEMORY_SIZE);
+
+    DmntCheatVm vm(std::make_unique<TestCallbacks>(memory));
+    REQUIRE(vm.LoadProgram(cheats));
+
+    vm.SetUsePredecodedProgram(false);
+    const double interpreted_us = MeasureMicroseconds(vm, metadata);
+    vm.SetUsePredecodedProgram(true);
+    const double predecoded_us = MeasureMicroseconds(vm, metadata);
+
+    printf("DmntCheatVm %zu dwords, decoding every instruction: %.3f us\n", vm.GetProgramSize(),
+           interpreted_us);
+    printf("DmntCheatVm %zu dwords, predecoded: %.3f us\n", vm.GetProgramSize(), predecoded_us);
+}
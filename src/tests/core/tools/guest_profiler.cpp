@@ -0,0 +1,303 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "core/tools/guest_profiler.h"
+
+namespace {
+
+using Tools::GuestProfiler;
+using BacktraceEntry = Core::ARM_Interface::BacktraceEntry;
+
+constexpr VAddr MAIN_BASE = 0x1000;
+constexpr VAddr SDK_BASE = 0x8000;
+constexpr u64 PERIOD = 1000000;
+
+/**
+ * Foo and Bar in main, leaf first:
+ * - 4 samples in Foo at two addresses
+ * - 2 samples in Foo called by Bar
+ * - 5 samples in sdk code without a symbol, called by Bar
+ */
+const GuestProfiler::Samples samples{
+    {{0x1010}, 3},
+    {{0x1020}, 1},
+    {{0x1010, 0x1090}, 2},
+    {{0x8010, 0x1094}, 5},
+};
+
+bool Symbolize(std::vector<BacktraceEntry>& entries) {
+    for (BacktraceEntry& entry : entries) {
+        const VAddr address = entry.original_address;
+        if (address >= SDK_BASE) {
+            entry.module = "sdk";
+            entry.offset = address - SDK_BASE;
+        } else {
+            entry.module = "main";
+            entry.offset = address - MAIN_BASE;
+            entry.name = address < 0x1080 ? "Foo" : "Bar";
+        }
+    }
+    return true;
+}
+
+/// A field of a protobuf message, varints are in value and length delimited fields in bytes
+struct Field {
+    u32 number;
+    u64 value;
+    std::string_view bytes;
+};
+
+u64 ReadVarint(std::string_view& data) {
+    u64 value = 0;
+    for (u32 shift = 0;; shift += 7) {
+        REQUIRE(!data.empty());
+        const u8 byte = static_cast<u8>(data.front());
+        data.remove_prefix(1);
+        value |= u64{byte & 0x7Fu} << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+}
+
+/// Decodes a message, only the varint and length delimited wire types are expected
+std::vector<Field> Decode(std::string_view data) {
+    std::vector<Field> fields;
+    while (!data.empty()) {
+        const u64 key = ReadVarint(data);
+        Field field{static_cast<u32>(key >> 3), 0, {}};
+        if ((key & 7) == 0) {
+            field.value = ReadVarint(data);
+        } else {
+            REQUIRE((key & 7) == 2);
+            const u64 size = ReadVarint(data);
+            REQUIRE(size <= data.size());
+            field.bytes = data.substr(0, size);
+            data.remove_prefix(size);
+        }
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+std::vector<u64> DecodePacked(std::string_view data) {
+    std::vector<u64> values;
+    while (!data.empty()) {
+        values.push_back(ReadVarint(data));
+    }
+    return values;
+}
+
+struct Sample {
+    std::vector<u64> locations;
+    std::vector<u64> values;
+    bool operator==(const Sample&) const = default;
+};
+
+struct Mapping {
+    u64 id;
+    u64 start;
+    u64 limit;
+    std::string filename;
+    bool operator==(const Mapping&) const = default;
+};
+
+struct Location {
+    u64 id;
+    u64 mapping_id;
+    u64 address;
+    std::vector<u64> function_ids;
+    bool operator==(const Location&) const = default;
+};
+
+struct Function {
+    u64 id;
+    std::string name;
+    std::string system_name;
+    std::string filename;
+    bool operator==(const Function&) const = default;
+};
+
+/// The parts of a pprof profile that are written, with strings looked up in the string table
+struct Profile {
+    std::vector<std::string> sample_types;
+    std::vector<Sample> samples;
+    std::vector<Mapping> mappings;
+    std::vector<Location> locations;
+    std::vector<Function> functions;
+    u64 duration = 0;
+    std::string period_type;
+    u64 period = 0;
+};
+
+Profile DecodeProfile(std::string_view data) {
+    const std::vector<Field> fields = Decode(data);
+    std::vector<std::string> strings;
+    for (const Field& field : fields) {
+        if (field.number == 6) {
+            strings.emplace_back(field.bytes);
+        }
+    }
+    const auto string = [&](u64 index) {
+        REQUIRE(index < strings.size());
+        return strings[index];
+    };
+    const auto value_type = [&](std::string_view message) {
+        std::string result;
+        for (const Field& field : Decode(message)) {
+            result += (result.empty() ? "" : "/") + string(field.value);
+        }
+        return result;
+    };
+
+    Profile profile;
+    for (const Field& field : fields) {
+        switch (field.number) {
+        case 1:
+            profile.sample_types.push_back(value_type(field.bytes));
+            break;
+        case 2: {
+            Sample& sample = profile.samples.emplace_back();
+            for (const Field& sample_field : Decode(field.bytes)) {
+                auto& values = sample_field.number == 1 ? sample.locations : sample.values;
+                values = DecodePacked(sample_field.bytes);
+            }
+            break;
+        }
+        case 3: {
+            Mapping& mapping = profile.mappings.emplace_back();
+            for (const Field& mapping_field : Decode(field.bytes)) {
+                switch (mapping_field.number) {
+                case 1:
+                    mapping.id = mapping_field.value;
+                    break;
+                case 2:
+                    mapping.start = mapping_field.value;
+                    break;
+                case 3:
+                    mapping.limit = mapping_field.value;
+                    break;
+                case 5:
+                    mapping.filename = string(mapping_field.value);
+                    break;
+                }
+            }
+            break;
+        }
+        case 4: {
+            Location& location = profile.locations.emplace_back();
+            for (const Field& location_field : Decode(field.bytes)) {
+                switch (location_field.number) {
+                case 1:
+                    location.id = location_field.value;
+                    break;
+                case 2:
+                    location.mapping_id = location_field.value;
+                    break;
+                case 3:
+                    location.address = location_field.value;
+                    break;
+                case 4:
+                    for (const Field& line_field : Decode(location_field.bytes)) {
+                        if (line_field.number == 1) {
+                            location.function_ids.push_back(line_field.value);
+                        }
+                    }
+                    break;
+                }
+            }
+            break;
+        }
+        case 5: {
+            Function& function = profile.functions.emplace_back();
+            for (const Field& function_field : Decode(field.bytes)) {
+                switch (function_field.number) {
+                case 1:
+                    function.id = function_field.value;
+                    break;
+                case 2:
+                    function.name = string(function_field.value);
+                    break;
+                case 3:
+                    function.system_name = string(function_field.value);
+                    break;
+                case 4:
+                    function.filename = string(function_field.value);
+                    break;
+                }
+            }
+            break;
+        }
+        case 10:
+            profile.duration = field.value;
+            break;
+        case 11:
+            profile.period_type = value_type(field.bytes);
+            break;
+        case 12:
+            profile.period = field.value;
+            break;
+        }
+    }
+    return profile;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("GuestProfiler[CollapseStacks]", "[core]") {
+    // Root first, the two addresses in Foo make one line
+    REQUIRE(GuestProfiler::CollapseStacks(samples, Symbolize) == "main!Bar;main!Foo 2\n"
+                                                                 "main!Bar;sdk+0x10 5\n"
+                                                                 "main!Foo 4\n");
+
+    // Without modules every address is its own function
+    const auto fail = [](std::vector<BacktraceEntry>&) { return false; };
+    REQUIRE(GuestProfiler::CollapseStacks(samples, fail) == "unknown+0x1010 3\n"
+                                                            "unknown+0x1020 1\n"
+                                                            "unknown+0x1090;unknown+0x1010 2\n"
+                                                            "unknown+0x1094;unknown+0x8010 5\n");
+}
+
+TEST_CASE("GuestProfiler[Pprof]", "[core]") {
+    const std::string data =
+        GuestProfiler::EncodePprof(samples, std::chrono::nanoseconds{PERIOD}, Symbolize);
+    const Profile profile = DecodeProfile(data);
+
+    REQUIRE(profile.sample_types == std::vector<std::string>{"samples/count", "cpu/nanoseconds"});
+    REQUIRE(profile.period_type == "cpu/nanoseconds");
+    REQUIRE(profile.period == PERIOD);
+    REQUIRE(profile.duration == 11 * PERIOD);
+
+    // Locations are numbered in the order their addresses first appear in the sorted stacks
+    REQUIRE(profile.samples == std::vector<Sample>{
+                                   {{1}, {3, 3 * PERIOD}},
+                                   {{1, 2}, {2, 2 * PERIOD}},
+                                   {{3}, {1, PERIOD}},
+                                   {{4, 5}, {5, 5 * PERIOD}},
+                               });
+    REQUIRE(profile.mappings == std::vector<Mapping>{
+                                    {1, MAIN_BASE, 0x1098, "main"},
+                                    {2, SDK_BASE, 0x8014, "sdk"},
+                                });
+    REQUIRE(profile.locations == std::vector<Location>{
+                                     {1, 1, 0x1010, {1}},
+                                     {2, 1, 0x1090, {2}},
+                                     {3, 1, 0x1020, {1}},
+                                     {4, 2, 0x8010, {3}},
+                                     {5, 1, 0x1094, {2}},
+                                 });
+    REQUIRE(profile.functions == std::vector<Function>{
+                                     {1, "Foo", "Foo", "main"},
+                                     {2, "Bar", "Bar", "main"},
+                                     {3, "sdk+0x10", "sdk+0x10", "sdk"},
+                                 });
+}
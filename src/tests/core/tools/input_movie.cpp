@@ -0,0 +1,119 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "core/tools/input_movie.h"
+
+namespace {
+
+using Frame = Tools::InputMovie::Frame;
+
+constexpr u64 NUM_FRAMES = 2000;
+
+// Holds A for a while, sweeps the left stick and taps the screen, with idle stretches between
+std::vector<Frame> MakeFrames() {
+    std::vector<Frame> frames(NUM_FRAMES);
+    for (u64 i = 0; i < NUM_FRAMES; ++i) {
+        Frame& frame = frames[i];
+        if (i % 100 < 30) {
+            frame.pads[0].buttons = 1;
+            frame.pads[0].l_stick_x = static_cast<s32>(i % 100) * 1000 - 15000;
+        }
+        if (i % 250 == 0) {
+            frame.pads[8].buttons = 1ULL << 10;
+            frame.keyboard.keys[4] = 0x10;
+            frame.touch.count = 2;
+            frame.touch.points[0] = {static_cast<u32>(i), 100};
+            frame.touch.points[1] = {200, static_cast<u32>(i)};
+        }
+    }
+    return frames;
+}
+
+/// Path in the temporary directory, removed again even when a check fails
+class TempFile {
+public:
+    explicit TempFile(const char* name)
+        : path{(std::filesystem::temp_directory_path() / name).string()} {}
+
+    ~TempFile() {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+
+    TempFile(const TempFile&) = delete;
+    TempFile& operator=(const TempFile&) = delete;
+
+    const std::string path;
+};
+
+} // Anonymous namespace
+
+TEST_CASE("InputMovie[EncodeDecode]", "[core]") {
+    const std::vector<Frame> frames = MakeFrames();
+    const std::vector<u8> data = Tools::InputMovie::Encode(frames);
+
+    std::vector<Frame> decoded;
+    REQUIRE(Tools::InputMovie::Decode(data, decoded));
+    REQUIRE(decoded == frames);
+
+    // Idle frames take a single byte, so the movie is far smaller than the raw state
+    REQUIRE(data.size() < NUM_FRAMES * 8);
+
+    std::vector<u8> truncated(data.begin(), data.begin() + data.size() / 2);
+    REQUIRE(!Tools::InputMovie::Decode(truncated, decoded));
+}
+
+TEST_CASE("InputMovie[RecordAndPlay]", "[core]") {
+    const std::vector<Frame> frames = MakeFrames();
+    const TempFile file("yuzu_input_movie_test.yzmv");
+    const std::string& path = file.path;
+
+    Tools::InputMovie movie;
+    REQUIRE(movie.StartRecording(path));
+    for (const Frame& frame : frames) {
+        for (std::size_t i = 0; i < Tools::InputMovie::NUM_PADS; ++i) {
+            movie.RecordPad(i, frame.pads[i]);
+        }
+        movie.RecordKeyboard(frame.keyboard);
+        movie.RecordTouch(frame.touch);
+        movie.AdvanceFrame();
+    }
+    REQUIRE(movie.GetFrameCount() == NUM_FRAMES);
+    REQUIRE(movie.Stop());
+
+    REQUIRE(movie.StartPlayback(path));
+    REQUIRE(movie.GetFrameCount() == NUM_FRAMES);
+
+    Tools::InputMovie::PadState pad;
+    for (u64 i = 0; i < 700; ++i) {
+        REQUIRE(movie.PlaybackPad(0, pad));
+        REQUIRE(pad == frames[i].pads[0]);
+        movie.AdvanceFrame();
+    }
+
+    // Seeking lands past and before a keyframe
+    for (const u64 target : {u64{1250}, u64{1199}, u64{3}, NUM_FRAMES - 1}) {
+        REQUIRE(movie.Seek(target));
+        REQUIRE(movie.GetCurrentFrame() == target);
+        Tools::InputMovie::TouchState touch;
+        REQUIRE(movie.PlaybackPad(8, pad));
+        REQUIRE(movie.PlaybackTouch(touch));
+        REQUIRE(pad == frames[target].pads[8]);
+        REQUIRE(touch == frames[target].touch);
+    }
+    REQUIRE(!movie.Seek(NUM_FRAMES));
+
+    // Playback ends after the last frame and input is no longer replaced
+    movie.AdvanceFrame();
+    REQUIRE(movie.GetState() == Tools::InputMovie::State::Idle);
+    REQUIRE(!movie.PlaybackPad(0, pad));
+}
@@ -0,0 +1,161 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "common/virtual_buffer.h"
+#include "core/tools/memory_journal.h"
+
+namespace {
+
+using Tools::MemoryJournal;
+constexpr std::size_t PAGE_SIZE = MemoryJournal::PAGE_SIZE;
+
+void FillPage(u8* base, std::size_t page, u8 value) {
+    std::memset(base + page * PAGE_SIZE, value, PAGE_SIZE);
+}
+
+bool PageIs(const u8* base, std::size_t page, u8 value) {
+    for (std::size_t i = 0; i < PAGE_SIZE; ++i) {
+        if (base[page * PAGE_SIZE + i] != value) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("MemoryJournal[Restore]", "[core]") {
+    constexpr std::size_t num_pages = 16;
+    Common::VirtualBuffer<u8> memory(num_pages * PAGE_SIZE);
+    u8* const base = memory.data();
+    for (std::size_t page = 0; page < num_pages; ++page) {
+        FillPage(base, page, 1);
+    }
+
+    MemoryJournal journal(base, num_pages * PAGE_SIZE, num_pages);
+    if (!journal.Start()) {
+        return;
+    }
+    REQUIRE(journal.GetNewestSnapshot() == 0);
+
+    // Snapshot 1 has pages 0 and 1 changed, snapshot 2 has page 1 and 2 changed
+    FillPage(base, 0, 2);
+    base[PAGE_SIZE + 7] = 2;
+    REQUIRE(journal.TakeSnapshot() == 1);
+    FillPage(base, 1, 3);
+    FillPage(base, 2, 3);
+    REQUIRE(journal.TakeSnapshot() == 2);
+    REQUIRE(journal.GetStats().last_written_pages == 2);
+
+    // Written since the newest snapshot
+    FillPage(base, 3, 4);
+    FillPage(base, 0, 4);
+
+    REQUIRE(journal.Restore(1));
+    REQUIRE(journal.GetNewestSnapshot() == 1);
+    REQUIRE(PageIs(base, 0, 2));
+    REQUIRE(base[PAGE_SIZE] == 1);
+    REQUIRE(base[PAGE_SIZE + 7] == 2);
+    REQUIRE(PageIs(base, 2, 1));
+    REQUIRE(PageIs(base, 3, 1));
+
+    // The restored pages are journaled again
+    FillPage(base, 2, 5);
+    REQUIRE(journal.Restore(0));
+    for (std::size_t page = 0; page < num_pages; ++page) {
+        REQUIRE(PageIs(base, page, 1));
+    }
+    REQUIRE(!journal.Restore(1));
+
+    // Identical pages are only stored once
+    for (std::size_t page = 0; page < 8; ++page) {
+        FillPage(base, page, 6);
+    }
+    journal.TakeSnapshot();
+    const auto stats = journal.GetStats();
+    REQUIRE(stats.journaled_pages == 8);
+    REQUIRE(stats.stored_pages == 1);
+
+    journal.DropOldest();
+    REQUIRE(journal.GetOldestSnapshot() == 1);
+    REQUIRE(journal.GetStats().stored_pages == 0);
+
+    journal.Stop();
+    FillPage(base, 0, 7);
+    REQUIRE(PageIs(base, 0, 7));
+}
+
+TEST_CASE("MemoryJournal[Overflow]", "[core]") {
+    constexpr std::size_t num_pages = 16;
+    Common::VirtualBuffer<u8> memory(num_pages * PAGE_SIZE);
+    u8* const base = memory.data();
+
+    MemoryJournal journal(base, num_pages * PAGE_SIZE, 4);
+    if (!journal.Start()) {
+        return;
+    }
+    journal.TakeSnapshot();
+    for (std::size_t page = 0; page < 8; ++page) {
+        FillPage(base, page, 1);
+    }
+    REQUIRE(!journal.Restore(0));
+
+    // Earlier snapshots can't be restored, the new one can
+    REQUIRE(journal.TakeSnapshot() == 2);
+    REQUIRE(journal.GetOldestSnapshot() == 2);
+    FillPage(base, 0, 2);
+    REQUIRE(journal.Restore(2));
+    REQUIRE(PageIs(base, 0, 1));
+}
+
+TEST_CASE("MemoryJournal[PerFrameOverhead]", "[.benchmark]") {
+    // 256 MiB of memory with 2000 pages written per frame in runs of 100, half of them with
+    // repeated contents
+    constexpr std::size_t num_pages = 0x10000;
+    constexpr std::size_t pages_per_frame = 2000;
+    constexpr std::size_t num_frames = 60;
+    Common::VirtualBuffer<u8> memory(num_pages * PAGE_SIZE);
+    u8* const base = memory.data();
+
+    MemoryJournal journal(base, num_pages * PAGE_SIZE, pages_per_frame);
+    if (!journal.Start()) {
+        return;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    Clock::duration write_time{};
+    Clock::duration snapshot_time{};
+    for (std::size_t frame = 0; frame < num_frames; ++frame) {
+        const auto start = Clock::now();
+        for (std::size_t i = 0; i < pages_per_frame; ++i) {
+            const std::size_t page = (frame * 7919 + (i / 100) * 3001 + i % 100) % num_pages;
+            base[page * PAGE_SIZE + (i % PAGE_SIZE)] = static_cast<u8>(i % 2 == 0 ? frame : 0);
+        }
+        const auto written = Clock::now();
+        journal.TakeSnapshot();
+        snapshot_time += Clock::now() - written;
+        write_time += written - start;
+    }
+
+    const auto stats = journal.GetStats();
+    REQUIRE(stats.num_snapshots == num_frames + 1);
+    REQUIRE(stats.journaled_pages == num_frames * pages_per_frame);
+
+    const auto to_us = [](Clock::duration duration) {
+        return std::chrono::duration<double, std::micro>(duration).count() / num_frames;
+    };
+    std::printf("MemoryJournal per frame: %.1f us faulting, %.1f us snapshot, %zu of %zu pages "
+                "stored\n",
+                to_us(write_time), to_us(snapshot_time), stats.stored_pages, stats.journaled_pages);
+
+    REQUIRE(journal.Restore(0));
+}
@@ -0,0 +1,200 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "core/tools/memory_scanner.h"
+
+namespace {
+
+using Tools::MemoryScanner;
+using Comparison = MemoryScanner::Comparison;
+using ValueType = MemoryScanner::ValueType;
+
+constexpr std::size_t PAGE_SIZE = 0x1000;
+constexpr VAddr BASE = 0x10000000;
+
+/// Guest memory backed by a vector, single pages can be unmapped
+class TestSource final : public MemoryScanner::Source {
+public:
+    explicit TestSource(std::size_t num_pages)
+        : data(num_pages * PAGE_SIZE), mapped(num_pages, true) {}
+
+    std::vector<Range> GetRanges() override {
+        return {{BASE, data.size()}};
+    }
+
+    bool Read(VAddr vaddr, u8* dest, std::size_t size) override {
+        const std::size_t offset = vaddr - BASE;
+        if (vaddr < BASE || offset + size > data.size() || !mapped[offset / PAGE_SIZE] ||
+            !mapped[(offset + size - 1) / PAGE_SIZE]) {
+            return false;
+        }
+        std::memcpy(dest, data.data() + offset, size);
+        return true;
+    }
+
+    template <typename T>
+    void Set(VAddr vaddr, T value) {
+        std::memcpy(data.data() + (vaddr - BASE), &value, sizeof(T));
+    }
+
+    std::vector<u8> data;
+    std::vector<bool> mapped;
+};
+
+template <typename T>
+u64 Bits(T value) {
+    u64 bits = 0;
+    std::memcpy(&bits, &value, sizeof(T));
+    return bits;
+}
+
+template <typename T>
+MemoryScanner::Query Exact(T value) {
+    return {.comparison = Comparison::Exact, .value = Bits(value)};
+}
+
+MemoryScanner::Query Compare(Comparison comparison) {
+    return {.comparison = comparison};
+}
+
+std::vector<VAddr> Addresses(const MemoryScanner& scanner) {
+    std::vector<VAddr> addresses;
+    for (const auto& result : scanner.GetResults(0, scanner.GetResultCount())) {
+        addresses.push_back(result.address);
+    }
+    return addresses;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("MemoryScanner[FirstScan]", "[core]") {
+    auto source = std::make_unique<TestSource>(4);
+    TestSource& memory = *source;
+    memory.Set<u32>(BASE + 0x10, 1234);
+    memory.Set<u32>(BASE + 0x1FFC, 1234);
+    memory.Set<u32>(BASE + 0x3FFC, 1234);
+    memory.Set<u32>(BASE + 0x2002, 1234);
+    MemoryScanner scanner(std::move(source));
+
+    // Unaligned values are skipped
+    REQUIRE(scanner.FirstScan(ValueType::U32, 4, Exact<u32>(1234)) == 3);
+    REQUIRE(Addresses(scanner) == std::vector<VAddr>{BASE + 0x10, BASE + 0x1FFC, BASE + 0x3FFC});
+    REQUIRE(scanner.GetResults(1, 1).size() == 1);
+    REQUIRE(scanner.GetResults(1, 1)[0].address == BASE + 0x1FFC);
+    REQUIRE(scanner.GetResults(1, 1)[0].value == 1234);
+
+    REQUIRE(scanner.FirstScan(ValueType::U32, 2, Exact<u32>(1234)) == 4);
+
+    // Everything matches an unknown value, values crossing the end of memory don't exist
+    REQUIRE(scanner.FirstScan(ValueType::U32, 4, Compare(Comparison::Any)) == 4 * PAGE_SIZE / 4);
+    REQUIRE(scanner.FirstScan(ValueType::U32, 1, Compare(Comparison::Any)) == 4 * PAGE_SIZE - 3);
+
+    REQUIRE(scanner.FirstScan(ValueType::U32, 3, Exact<u32>(1234)) == 0);
+}
+
+TEST_CASE("MemoryScanner[ValueTypes]", "[core]") {
+    auto source = std::make_unique<TestSource>(2);
+    TestSource& memory = *source;
+    memory.Set<u8>(BASE + 0x101, 0x5A);
+    memory.Set<u16>(BASE + 0x202, 0xABCD);
+    memory.Set<u64>(BASE + 0x308, 0x123456789ABCDEF0);
+    memory.Set<float>(BASE + 0x404, 99.5f);
+    memory.Set<double>(BASE + 0x508, -3.25);
+    // A value crossing the page boundary
+    memory.Set<u64>(BASE + 0xFFC, 0xFEDCBA9876543210);
+    MemoryScanner scanner(std::move(source));
+
+    REQUIRE(scanner.FirstScan(ValueType::U8, 1, Exact<u8>(0x5A)) == 1);
+    REQUIRE(scanner.GetResults(0, 1)[0].address == BASE + 0x101);
+    REQUIRE(scanner.FirstScan(ValueType::U16, 2, Exact<u16>(0xABCD)) == 1);
+    REQUIRE(scanner.FirstScan(ValueType::U64, 8, Exact<u64>(0x123456789ABCDEF0)) == 1);
+    REQUIRE(scanner.FirstScan(ValueType::U64, 4, Exact<u64>(0xFEDCBA9876543210)) == 1);
+    REQUIRE(scanner.GetResults(0, 1)[0].address == BASE + 0xFFC);
+
+    REQUIRE(scanner.FirstScan(ValueType::Float, 4,
+                              {.comparison = Comparison::Fuzzy,
+                               .value = Bits(100.0f),
+                               .tolerance = 0.5}) == 1);
+    REQUIRE(scanner.GetResults(0, 1)[0].value == Bits(99.5f));
+    REQUIRE(scanner.FirstScan(ValueType::Float, 4,
+                              {.comparison = Comparison::Fuzzy,
+                               .value = Bits(100.0f),
+                               .tolerance = 0.25}) == 0);
+
+    REQUIRE(scanner.FirstScan(ValueType::Double, 8,
+                              {.comparison = Comparison::Range,
+                               .value = Bits(-4.0),
+                               .upper = Bits(-3.0)}) == 1);
+    REQUIRE(scanner.GetResults(0, 1)[0].address == BASE + 0x508);
+}
+
+TEST_CASE("MemoryScanner[NextScan]", "[core]") {
+    auto source = std::make_unique<TestSource>(16);
+    TestSource& memory = *source;
+    for (VAddr offset = 0; offset < memory.data.size(); offset += 4) {
+        memory.Set<u32>(BASE + offset, 100);
+    }
+    MemoryScanner scanner(std::move(source));
+
+    // Too many results for a list, the scan stays dense
+    REQUIRE(scanner.FirstScan(ValueType::U32, 4, Compare(Comparison::Any)) == 16 * PAGE_SIZE / 4);
+    memory.Set<u32>(BASE + 0x40, 150);
+    memory.Set<u32>(BASE + 0x5000, 50);
+    memory.Set<u32>(BASE + 0xF000, 200);
+    REQUIRE(scanner.NextScan(Compare(Comparison::Unchanged)) == 16 * PAGE_SIZE / 4 - 3);
+    REQUIRE(scanner.NextScan(Compare(Comparison::Changed)) == 0);
+
+    // Narrowed down to a list
+    REQUIRE(scanner.FirstScan(ValueType::U32, 4, Compare(Comparison::Any)) == 16 * PAGE_SIZE / 4);
+    memory.Set<u32>(BASE + 0x40, 160);
+    memory.Set<u32>(BASE + 0x5000, 60);
+    memory.Set<u32>(BASE + 0xF000, 210);
+    REQUIRE(scanner.NextScan(Compare(Comparison::Changed)) == 3);
+    REQUIRE(Addresses(scanner) == std::vector<VAddr>{BASE + 0x40, BASE + 0x5000, BASE + 0xF000});
+
+    REQUIRE(scanner.NextScan(Compare(Comparison::Unchanged)) == 3);
+    memory.Set<u32>(BASE + 0x5000, 40);
+    memory.Set<u32>(BASE + 0xF000, 300);
+    REQUIRE(scanner.NextScan(Compare(Comparison::Increased)) == 1);
+    REQUIRE(scanner.GetResults(0, 1)[0].address == BASE + 0xF000);
+    REQUIRE(scanner.GetResults(0, 1)[0].value == 300);
+
+    memory.Set<u32>(BASE + 0xF000, 250);
+    REQUIRE(scanner.NextScan(Compare(Comparison::Decreased)) == 1);
+    REQUIRE(scanner.NextScan(Exact<u32>(250)) == 1);
+    REQUIRE(scanner.NextScan(Exact<u32>(251)) == 0);
+
+    // Nothing to narrow down after a reset
+    scanner.Reset();
+    REQUIRE(scanner.NextScan(Compare(Comparison::Any)) == 0);
+}
+
+TEST_CASE("MemoryScanner[Unmapped]", "[core]") {
+    auto source = std::make_unique<TestSource>(4);
+    TestSource& memory = *source;
+    memory.Set<u32>(BASE + 0x1000, 7);
+    memory.Set<u32>(BASE + 0x2000, 7);
+    memory.mapped[3] = false;
+    MemoryScanner scanner(std::move(source));
+
+    // Values running into an unmapped page are not results
+    REQUIRE(scanner.FirstScan(ValueType::U32, 4, Compare(Comparison::Any)) == 3 * PAGE_SIZE / 4);
+    REQUIRE(scanner.FirstScan(ValueType::U32, 1, Compare(Comparison::Any)) == 3 * PAGE_SIZE - 3);
+
+    // Pages that go away drop their results, dense and sparse
+    REQUIRE(scanner.FirstScan(ValueType::U32, 4, Compare(Comparison::Any)) == 3 * PAGE_SIZE / 4);
+    memory.mapped[0] = false;
+    REQUIRE(scanner.NextScan(Compare(Comparison::Any)) == 2 * PAGE_SIZE / 4);
+    REQUIRE(scanner.NextScan(Exact<u32>(7)) == 2);
+    memory.mapped[2] = false;
+    REQUIRE(scanner.NextScan(Exact<u32>(7)) == 1);
+    REQUIRE(scanner.GetResults(0, 1)[0].address == BASE + 0x1000);
+}
@@ -0,0 +1,207 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "common/page_table.h"
+#include "core/core.h"
+#include "core/device_memory.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/memory/page_table.h"
+#include "core/hle/kernel/process.h"
+#include "core/memory.h"
+#include "core/tools/freezer.h"
+#include "core/tools/memory_watcher.h"
+
+namespace {
+
+using Core::Memory::PAGE_BITS;
+using Core::Memory::PAGE_SIZE;
+
+constexpr VAddr BASE = 0x10000000;
+constexpr u64 SIZE = 4 * PAGE_SIZE;
+constexpr PAddr TARGET = Core::DramMemoryMap::Base + 0x1000000;
+constexpr PAddr OTHER_TARGET = TARGET + SIZE;
+
+/// The current process, with a few pages of memory mapped at BASE
+class TestProcess {
+public:
+    TestProcess()
+        : system{Core::System::GetInstance()},
+          process{Kernel::Process::Create(system, "", Kernel::Process::ProcessType::Userland)} {
+        PageTable().Resize(32, PAGE_BITS, true);
+        system.Memory().MapMemoryRegion(PageTable(), BASE, SIZE, TARGET);
+        system.Kernel().MakeCurrentProcess(process.get());
+        system.Memory().SetCurrentPageTable(*process, 0);
+    }
+
+    ~TestProcess() {
+        system.MemoryWatcher().Clear();
+        system.Kernel().MakeCurrentProcess(nullptr);
+    }
+
+    TestProcess(const TestProcess&) = delete;
+    TestProcess& operator=(const TestProcess&) = delete;
+
+    Common::PageTable& PageTable() {
+        return process->PageTable().PageTableImpl();
+    }
+
+    Common::PageType PageType(VAddr vaddr) {
+        return PageTable().attributes[vaddr >> PAGE_BITS];
+    }
+
+    /// What is stored at vaddr when the pages are mapped to target, bypassing hooks
+    u32 Backing32(PAddr target, VAddr vaddr) {
+        u32 value;
+        std::memcpy(&value, system.DeviceMemory().GetPointer(target + (vaddr - BASE)),
+                    sizeof(value));
+        return value;
+    }
+
+    Core::System& system;
+    std::shared_ptr<Kernel::Process> process;
+};
+
+/// Counts the callbacks of a watch and the values they saw
+struct Recorder {
+    Tools::MemoryWatcher::Callback Callback() {
+        return [this](VAddr address, u64 value) -> std::optional<u64> {
+            addresses.push_back(address);
+            values.push_back(value);
+            return std::nullopt;
+        };
+    }
+
+    std::vector<VAddr> addresses;
+    std::vector<u64> values;
+};
+
+} // Anonymous namespace
+
+TEST_CASE("MemoryWatcher[Writes]", "[core]") {
+    TestProcess test;
+    auto& memory = test.system.Memory();
+    auto& watcher = test.system.MemoryWatcher();
+    constexpr VAddr address = BASE + 0x10;
+
+    Recorder recorder;
+    const u64 handle = watcher.AddWatch(address, 4, recorder.Callback());
+    REQUIRE(handle != 0);
+    REQUIRE(test.PageType(address) == Common::PageType::Special);
+    REQUIRE(test.PageType(BASE + PAGE_SIZE) == Common::PageType::Memory);
+
+    // Every write overlapping the watch calls back with the value the watch now holds
+    memory.Write8(address + 3, 0x11);
+    memory.Write16(address, 0x2222);
+    memory.Write32(address, 0x33333333);
+    memory.Write64(address - 4, 0x4444444455555555);
+    std::array<u8, 16> block;
+    block.fill(0x66);
+    memory.WriteBlock(address - 8, block.data(), block.size());
+    REQUIRE(recorder.addresses == std::vector<VAddr>(5, address));
+    REQUIRE(recorder.values ==
+            std::vector<u64>{0x11000000, 0x11002222, 0x33333333, 0x44444444, 0x66666666});
+    REQUIRE(memory.Read32(address) == 0x66666666);
+
+    // Writes next to the watch, or elsewhere, don't
+    memory.Write32(address - 4, 1);
+    memory.Write32(address + 4, 2);
+    memory.Write8(address + 0x100, 3);
+    memory.Write32(BASE + PAGE_SIZE + 0x10, 4);
+    REQUIRE(recorder.addresses.size() == 5);
+    REQUIRE(memory.Read32(address - 4) == 1);
+    REQUIRE(memory.Read32(address + 4) == 2);
+
+    // Without watches the page is back on the fast path and nothing is looked up
+    watcher.RemoveWatch(handle);
+    REQUIRE(test.PageType(address) == Common::PageType::Memory);
+    REQUIRE(test.PageTable().num_special_regions == 0);
+    memory.Write32(address, 5);
+    REQUIRE(recorder.addresses.size() == 5);
+    REQUIRE(memory.Read32(address) == 5);
+}
+
+TEST_CASE("MemoryWatcher[Freeze]", "[core]") {
+    TestProcess test;
+    auto& memory = test.system.Memory();
+    constexpr VAddr address = BASE + 0x40;
+    memory.Write32(address, 5);
+
+    Tools::Freezer freezer(memory, test.system.MemoryWatcher());
+    REQUIRE(freezer.Freeze(address, 4) == 5);
+    freezer.SetActive(true);
+
+    // Guest writes are undone as they happen
+    memory.Write32(address, 9);
+    REQUIRE(memory.Read32(address) == 5);
+    memory.Write8(address + 1, 0xFF);
+    REQUIRE(memory.Read32(address) == 5);
+    std::array<u8, 8> block{};
+    memory.WriteBlock(address - 2, block.data(), block.size());
+    REQUIRE(memory.Read32(address) == 5);
+
+    freezer.SetFrozenValue(address, 7);
+    REQUIRE(memory.Read32(address) == 7);
+    memory.Write32(address, 9);
+    REQUIRE(memory.Read32(address) == 7);
+
+    freezer.Unfreeze(address);
+    memory.Write32(address, 9);
+    REQUIRE(memory.Read32(address) == 9);
+}
+
+TEST_CASE("MemoryWatcher[Remap]", "[core]") {
+    TestProcess test;
+    auto& memory = test.system.Memory();
+    constexpr VAddr address = BASE + PAGE_SIZE + 0x20;
+
+    Recorder recorder;
+    test.system.MemoryWatcher().AddWatch(address, 8, recorder.Callback());
+
+    // The watch follows its address to the new mapping
+    memory.MapMemoryRegion(test.PageTable(), BASE, SIZE, OTHER_TARGET);
+    REQUIRE(test.PageType(address) == Common::PageType::Special);
+    REQUIRE(test.PageType(BASE) == Common::PageType::Memory);
+    memory.Write32(address, 0x1234);
+    REQUIRE(recorder.addresses == std::vector<VAddr>{address});
+    REQUIRE(test.Backing32(OTHER_TARGET, address) == 0x1234);
+    REQUIRE(test.Backing32(TARGET, address) == 0);
+}
+
+TEST_CASE("MemoryWatcher[RasterizerCaching]", "[core]") {
+    TestProcess test;
+    auto& memory = test.system.Memory();
+    constexpr VAddr address = BASE + 0x80;
+
+    Recorder recorder;
+    const u64 handle = test.system.MemoryWatcher().AddWatch(address, 4, recorder.Callback());
+
+    // Writes while the page is cached need a GPU, only the transitions are checked here
+    memory.RasterizerMarkRegionCached(BASE, 2 * PAGE_SIZE, true);
+    REQUIRE(test.PageType(address) == Common::PageType::RasterizerCachedMemory);
+    REQUIRE(test.PageType(BASE + PAGE_SIZE) == Common::PageType::RasterizerCachedMemory);
+    memory.RasterizerMarkRegionCached(BASE, 2 * PAGE_SIZE, false);
+    REQUIRE(test.PageType(address) == Common::PageType::Special);
+    REQUIRE(test.PageType(BASE + PAGE_SIZE) == Common::PageType::Memory);
+
+    memory.Write32(address, 0x5678);
+    REQUIRE(recorder.addresses == std::vector<VAddr>{address});
+    REQUIRE(memory.Read32(address) == 0x5678);
+
+    // A watch removed while the page is cached leaves it to become plain memory
+    memory.RasterizerMarkRegionCached(BASE, PAGE_SIZE, true);
+    test.system.MemoryWatcher().RemoveWatch(handle);
+    memory.RasterizerMarkRegionCached(BASE, PAGE_SIZE, false);
+    REQUIRE(test.PageType(address) == Common::PageType::Memory);
+    REQUIRE(test.PageTable().pointers[address >> PAGE_BITS] != nullptr);
+    memory.Write32(address, 0);
+    REQUIRE(recorder.addresses.size() == 1);
+}
@@ -0,0 +1,115 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include <QColor>
+#include <QImage>
+#include <QPainter>
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "core/tools/overlay.h"
+
+namespace {
+
+constexpr int WIDTH = 1280;
+constexpr int HEIGHT = 720;
+constexpr int ITERATIONS = 10;
+
+template <typename Func>
+double MeasureMilliseconds(Func&& func) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        func();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const std::chrono::duration<double, std::milli> elapsed = end - start;
+    return elapsed.count() / ITERATIONS;
+}
+
+std::vector<u8> MakeHeatmap() {
+    std::vector<u8> pixels(WIDTH * HEIGHT * 4);
+    for (int y = 0; y < HEIGHT; ++y) {
+        for (int x = 0; x < WIDTH; ++x) {
+            u8* pixel = &pixels[(y * WIDTH + x) * 4];
+            pixel[0] = static_cast<u8>(x);
+            pixel[1] = static_cast<u8>(y);
+            pixel[2] = static_cast<u8>(x ^ y);
+            pixel[3] = 0x80;
+        }
+    }
+    return pixels;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("Overlay[PixelsAndClear]", "[core]") {
+    QImage target(WIDTH, HEIGHT, QImage::Format_RGBA8888);
+    target.fill(0);
+
+    Tools::OverlayDisplayList overlay;
+    overlay.AddClear();
+    overlay.AddPixel(0, 0, {0xFF, 0x00, 0x00, 0xFF});
+    overlay.AddPixel(1, 0, {0x00, 0xFF, 0x00, 0xFF});
+    overlay.AddPixel(-1, 5000, {0xFF, 0xFF, 0xFF, 0xFF});
+    overlay.Composite(target);
+
+    const u8* bits = target.constBits();
+    REQUIRE(bits[0] == 0xFF);
+    REQUIRE(bits[1] == 0x00);
+    REQUIRE(bits[3] == 0xFF);
+    REQUIRE(bits[4] == 0x00);
+    REQUIRE(bits[5] == 0xFF);
+
+    overlay.Reset();
+    REQUIRE(overlay.IsEmpty());
+    overlay.AddClear();
+    overlay.Composite(target);
+    REQUIRE(bits[3] == 0x00);
+}
+
+TEST_CASE("Overlay[FullScreenUpdate]", "[.benchmark]") {
+    const std::vector<u8> heatmap = MakeHeatmap();
+    QImage target(WIDTH, HEIGHT, QImage::Format_RGBA8888);
+
+    Tools::OverlayDisplayList overlay;
+    const double blit_ms = MeasureMilliseconds([&] {
+        overlay.Reset();
+        overlay.AddClear();
+        overlay.AddBlit(0, 0, WIDTH, HEIGHT, heatmap.data(), WIDTH * 4);
+        overlay.Composite(target);
+    });
+
+    const double pixels_ms = MeasureMilliseconds([&] {
+        overlay.Reset();
+        overlay.AddClear();
+        for (int y = 0; y < HEIGHT; ++y) {
+            for (int x = 0; x < WIDTH; ++x) {
+                const u8* pixel = &heatmap[(y * WIDTH + x) * 4];
+                overlay.AddPixel(x, y, {pixel[0], pixel[1], pixel[2], pixel[3]});
+            }
+        }
+        overlay.Composite(target);
+    });
+
+    // What gui_drawpixel used to do for every pixel
+    const double painter_ms = MeasureMilliseconds([&] {
+        target.fill(0);
+        QPainter painter(&target);
+        for (int y = 0; y < HEIGHT; ++y) {
+            for (int x = 0; x < WIDTH; ++x) {
+                const u8* pixel = &heatmap[(y * WIDTH + x) * 4];
+                painter.setPen(QColor(pixel[0], pixel[1], pixel[2], pixel[3]));
+                painter.drawPoint(x, y);
+            }
+        }
+    });
+
+    printf("Overlay full screen update, display list blit: %.3f ms\n", blit_ms);
+    printf("Overlay full screen update, display list pixels: %.3f ms\n", pixels_ms);
+    printf("Overlay full screen update, QPainter per pixel: %.3f ms\n", painter_ms);
+}
@@ -0,0 +1,178 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "common/virtual_buffer.h"
+#include "core/tools/memory_journal.h"
+#include "core/tools/rewind_buffer.h"
+
+namespace {
+
+using Tools::RewindBuffer;
+constexpr std::size_t PAGE_SIZE = Tools::MemoryJournal::PAGE_SIZE;
+constexpr std::size_t NUM_PAGES = 16;
+
+/// Memory with a frame counter standing in for the rest of the state
+class TestTarget final : public RewindBuffer::Target {
+public:
+    TestTarget() : memory(NUM_PAGES * PAGE_SIZE) {}
+
+    u8* GetMemory() override {
+        return memory.data();
+    }
+
+    std::size_t GetMemorySize() const override {
+        return memory.size();
+    }
+
+    RewindBuffer::State Capture() override {
+        RewindBuffer::State state;
+        state.threads.push_back({.thread_id = frame});
+        return state;
+    }
+
+    bool CanApply(const RewindBuffer::State&) override {
+        return can_apply;
+    }
+
+    void Apply(const RewindBuffer::State& state) override {
+        frame = state.threads[0].thread_id;
+        // Memory has to be back in place before anything else
+        memory_when_applied = memory[0];
+    }
+
+    void Write(u8 value) {
+        std::memset(memory.data(), value, PAGE_SIZE);
+    }
+
+    Common::VirtualBuffer<u8> memory;
+    u64 frame = 0;
+    bool can_apply = true;
+    u8 memory_when_applied = 0;
+};
+
+} // Anonymous namespace
+
+TEST_CASE("RewindBuffer[Rewind]", "[core]") {
+    auto target_owner = std::make_unique<TestTarget>();
+    TestTarget& target = *target_owner;
+    RewindBuffer buffer(std::move(target_owner));
+    if (!buffer.Start(8, NUM_PAGES * PAGE_SIZE)) {
+        // No memory journaling on this host
+        return;
+    }
+
+    // State n has frame n and memory filled with n
+    for (u8 frame = 1; frame <= 5; ++frame) {
+        target.frame = frame;
+        target.Write(frame);
+        buffer.Capture();
+    }
+    REQUIRE(buffer.GetStats().num_states == 6);
+
+    // Undoes what happened since the last capture
+    target.frame = 6;
+    target.Write(6);
+    REQUIRE(buffer.Rewind(0));
+    REQUIRE(target.frame == 5);
+    REQUIRE(target.memory_when_applied == 5);
+
+    REQUIRE(buffer.Rewind(2));
+    REQUIRE(target.frame == 3);
+    REQUIRE(target.memory[0] == 3);
+    REQUIRE(target.memory_when_applied == 3);
+    REQUIRE(buffer.GetStats().num_states == 4);
+
+    REQUIRE(!buffer.Rewind(4));
+    REQUIRE(target.frame == 3);
+}
+
+TEST_CASE("RewindBuffer[Rejected]", "[core]") {
+    auto target_owner = std::make_unique<TestTarget>();
+    TestTarget& target = *target_owner;
+    RewindBuffer buffer(std::move(target_owner));
+    if (!buffer.Start(8, NUM_PAGES * PAGE_SIZE)) {
+        return;
+    }
+    target.frame = 1;
+    target.Write(1);
+    buffer.Capture();
+    target.frame = 2;
+    target.Write(2);
+
+    // A state that doesn't fit leaves memory alone and is kept
+    target.can_apply = false;
+    REQUIRE(!buffer.Rewind(1));
+    REQUIRE(target.frame == 2);
+    REQUIRE(target.memory[0] == 2);
+    REQUIRE(buffer.GetStats().num_states == 2);
+
+    target.can_apply = true;
+    REQUIRE(buffer.Rewind(1));
+    REQUIRE(target.frame == 0);
+    REQUIRE(target.memory[0] == 0);
+}
+
+TEST_CASE("RewindBuffer[Budget]", "[core]") {
+    auto target_owner = std::make_unique<TestTarget>();
+    TestTarget& target = *target_owner;
+    RewindBuffer buffer(std::move(target_owner));
+    if (!buffer.Start(3, NUM_PAGES * PAGE_SIZE)) {
+        return;
+    }
+    for (u8 frame = 1; frame <= 5; ++frame) {
+        target.frame = frame;
+        target.Write(frame);
+        buffer.Capture();
+    }
+
+    // Only the newest states are kept
+    REQUIRE(buffer.GetStats().num_states == 3);
+    REQUIRE(buffer.Rewind(2));
+    REQUIRE(target.frame == 3);
+    REQUIRE(target.memory[0] == 3);
+
+    buffer.Stop();
+    REQUIRE(!buffer.IsActive());
+    REQUIRE(!buffer.Rewind(0));
+}
+
+TEST_CASE("RewindBuffer[Frames]", "[core]") {
+    auto target_owner = std::make_unique<TestTarget>();
+    TestTarget& target = *target_owner;
+    RewindBuffer buffer(std::move(target_owner));
+    REQUIRE(!buffer.RequestRewind(0));
+    if (!buffer.Start(8, NUM_PAGES * PAGE_SIZE)) {
+        return;
+    }
+
+    // Every frame captures until a rewind is requested, which happens instead at the next frame
+    for (u8 frame = 1; frame <= 3; ++frame) {
+        target.frame = frame;
+        target.Write(frame);
+        buffer.AdvanceFrame();
+    }
+    REQUIRE(buffer.GetStats().num_states == 4);
+    REQUIRE(buffer.RequestRewind(2));
+    REQUIRE(target.frame == 3);
+    target.frame = 4;
+    target.Write(4);
+    buffer.AdvanceFrame();
+    REQUIRE(target.frame == 1);
+    REQUIRE(target.memory[0] == 1);
+    REQUIRE(buffer.GetStats().num_states == 2);
+
+    // The request is used up
+    target.frame = 2;
+    target.Write(2);
+    buffer.AdvanceFrame();
+    REQUIRE(target.frame == 2);
+    REQUIRE(buffer.GetStats().num_states == 3);
+}
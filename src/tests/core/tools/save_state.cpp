@@ -0,0 +1,154 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "common/file_util.h"
+#include "core/tools/save_state.h"
+
+namespace {
+
+using Tools::SaveState;
+
+/// Path in the temporary directory, removed again even when a check fails
+class TempFile {
+public:
+    explicit TempFile(const char* name)
+        : path{(std::filesystem::temp_directory_path() / name).string()} {}
+
+    ~TempFile() {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+
+    TempFile(const TempFile&) = delete;
+    TempFile& operator=(const TempFile&) = delete;
+
+    const std::string path;
+};
+
+/// Memory that differs at every address, so misplaced chunks are noticed
+u8 Pattern(VAddr vaddr) {
+    return static_cast<u8>((vaddr >> 12) * 7 + vaddr);
+}
+
+SaveState::Contents MakeContents() {
+    SaveState::Contents contents{.title_id = 0x0100000000010000};
+
+    // The second region spans several compression chunks and ends in a partial one
+    contents.regions.push_back({.base = 0x8000000, .size = 0x4000, .state = 3, .perm = 5});
+    contents.regions.push_back({.base = 0x10000000, .size = 0x901000, .state = 4, .perm = 3});
+
+    for (u64 i = 0; i < 3; ++i) {
+        SaveState::ThreadRecord thread{};
+        thread.thread_id = 70 + i;
+        thread.tpidr_el0 = 0x1234000 + i;
+        thread.context_64.pc = 0x8000100 + i * 4;
+        thread.context_64.cpu_registers[0] = i;
+        thread.context_64.vector_registers[31] = {i, ~i};
+        thread.context_32.cpu_registers[15] = static_cast<u32>(i);
+        thread.status = static_cast<u32>(i);
+        thread.priority = 44;
+        thread.processor_id = static_cast<s32>(i);
+        thread.wait_address = 0x10000040 * i;
+        contents.threads.push_back(thread);
+    }
+
+    contents.events.push_back({"ScreenComposition", 0, std::chrono::nanoseconds{16666666}});
+    contents.events.push_back({"ThreadWakeupCallback", 0x21, std::chrono::nanoseconds{-5}});
+    return contents;
+}
+
+bool WriteContents(const std::string& path, const SaveState::Contents& contents) {
+    return SaveState::WriteFile(path, contents, [](VAddr vaddr, u8* dest, std::size_t size) {
+        for (std::size_t i = 0; i < size; ++i) {
+            dest[i] = Pattern(vaddr + i);
+        }
+    });
+}
+
+} // Anonymous namespace
+
+TEST_CASE("SaveState[RoundTrip]", "[core]") {
+    const TempFile file("yuzu_save_state_test.yzss");
+    const SaveState::Contents contents = MakeContents();
+    REQUIRE(WriteContents(file.path, contents));
+
+    SaveState::Contents loaded{};
+    std::map<VAddr, std::size_t> written;
+    bool memory_matches = true;
+    const bool success = SaveState::ReadFile(
+        file.path,
+        [&](const SaveState::Contents& read) {
+            loaded = read;
+            return true;
+        },
+        [&](VAddr vaddr, const u8* src, std::size_t size) {
+            written[vaddr] = size;
+            for (std::size_t i = 0; i < size; ++i) {
+                memory_matches &= src[i] == Pattern(vaddr + i);
+            }
+        });
+    REQUIRE(success);
+
+    REQUIRE(loaded.title_id == contents.title_id);
+    REQUIRE(loaded.regions == contents.regions);
+    REQUIRE(loaded.threads.size() == contents.threads.size());
+    REQUIRE(std::memcmp(loaded.threads.data(), contents.threads.data(),
+                        contents.threads.size() * sizeof(SaveState::ThreadRecord)) == 0);
+    REQUIRE(loaded.events.size() == contents.events.size());
+    for (std::size_t i = 0; i < contents.events.size(); ++i) {
+        REQUIRE(loaded.events[i].name == contents.events[i].name);
+        REQUIRE(loaded.events[i].user_data == contents.events[i].user_data);
+        REQUIRE(loaded.events[i].time_left == contents.events[i].time_left);
+    }
+
+    // Every byte of every region is restored exactly once
+    REQUIRE(memory_matches);
+    std::size_t total = 0;
+    VAddr end = 0;
+    for (const auto& [vaddr, size] : written) {
+        REQUIRE((end == 0 || vaddr == end || vaddr == 0x10000000));
+        end = vaddr + size;
+        total += size;
+    }
+    REQUIRE(total == 0x4000 + 0x901000);
+}
+
+TEST_CASE("SaveState[Rejected]", "[core]") {
+    const TempFile file("yuzu_save_state_rejected_test.yzss");
+    REQUIRE(WriteContents(file.path, MakeContents()));
+
+    // Nothing is written when the state doesn't fit the session
+    bool memory_written = false;
+    const auto write_memory = [&](VAddr, const u8*, std::size_t) { memory_written = true; };
+    REQUIRE(!SaveState::ReadFile(
+        file.path, [](const SaveState::Contents&) { return false; }, write_memory));
+    REQUIRE(!memory_written);
+
+    // Nor when the file is cut short
+    {
+        Common::FS::IOFile io(file.path, "r+b");
+        REQUIRE(io.Resize(io.GetSize() - 1));
+    }
+    bool checked = false;
+    const auto check = [&](const SaveState::Contents&) {
+        checked = true;
+        return true;
+    };
+    REQUIRE(!SaveState::ReadFile(file.path, check, write_memory));
+    REQUIRE(!checked);
+    REQUIRE(!memory_written);
+
+    REQUIRE(!SaveState::ReadFile(file.path + ".missing", check, write_memory));
+}
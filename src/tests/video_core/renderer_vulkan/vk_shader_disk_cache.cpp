@@ -0,0 +1,130 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "common/file_util.h"
+#include "core/settings.h"
+#include "video_core/renderer_vulkan/vk_shader_disk_cache.h"
+
+namespace {
+
+using Vulkan::GraphicsPipelineCacheKey;
+using Vulkan::VKShaderDiskCache;
+
+constexpr u64 TITLE_ID = 0x0100000000010000;
+
+/// Points the shader directory to an empty temporary one for as long as it lives
+class TempShaderDir {
+public:
+    TempShaderDir()
+        : previous{Common::FS::GetUserPath(Common::FS::UserPath::ShaderDir)},
+          path{std::filesystem::temp_directory_path() / "yuzu_vk_shader_disk_cache_test"} {
+        std::error_code ec;
+        std::filesystem::remove_all(path, ec);
+        std::filesystem::create_directories(path, ec);
+        Common::FS::GetUserPath(Common::FS::UserPath::ShaderDir, path.string());
+        Settings::values.use_disk_shader_cache.SetValue(true);
+    }
+
+    ~TempShaderDir() {
+        Common::FS::GetUserPath(Common::FS::UserPath::ShaderDir, previous);
+        std::error_code ec;
+        std::filesystem::remove_all(path, ec);
+    }
+
+    TempShaderDir(const TempShaderDir&) = delete;
+    TempShaderDir& operator=(const TempShaderDir&) = delete;
+
+private:
+    const std::string previous;
+    const std::filesystem::path path;
+};
+
+VideoCommon::Shader::ShaderDiskCacheEntry MakeShader(u64 unique_identifier) {
+    VideoCommon::Shader::ShaderDiskCacheEntry entry;
+    entry.type = Tegra::Engines::ShaderType::Vertex;
+    entry.code = {unique_identifier, ~unique_identifier};
+    entry.unique_identifier = unique_identifier;
+    return entry;
+}
+
+GraphicsPipelineCacheKey MakeKey(u64 vertex_shader, bool has_extended_dynamic_state) {
+    GraphicsPipelineCacheKey key{};
+    key.renderpass_params.num_color_attachments = 1;
+    key.renderpass_params.color_formats[0] = 5;
+    key.shaders[0] = vertex_shader;
+    key.fixed_state.no_extended_dynamic_state.Assign(has_extended_dynamic_state ? 0 : 1);
+    key.fixed_state.point_size = 0x3F800000;
+    if (!has_extended_dynamic_state) {
+        // Only stored when the pipeline bakes its dynamic state in
+        key.fixed_state.dynamic_state.raw1 = 0x1234;
+        key.fixed_state.dynamic_state.raw2 = 0x5678;
+    }
+    return key;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("VKShaderDiskCache[RoundTrip]", "[video_core]") {
+    const TempShaderDir shader_dir;
+    const std::vector<GraphicsPipelineCacheKey> keys{MakeKey(1, false), MakeKey(1, true),
+                                                     MakeKey(2, true)};
+    {
+        VKShaderDiskCache disk_cache;
+        disk_cache.BindTitleID(TITLE_ID);
+        REQUIRE(!disk_cache.LoadTransferable());
+        REQUIRE(disk_cache.ShouldSaveShader(1));
+        disk_cache.SaveShader(MakeShader(1));
+        REQUIRE(!disk_cache.ShouldSaveShader(1));
+        disk_cache.SaveShader(MakeShader(1));
+        disk_cache.SaveShader(MakeShader(2));
+        for (const GraphicsPipelineCacheKey& key : keys) {
+            disk_cache.SaveGraphicsPipeline(key);
+        }
+        // Pipelines already in the file are not added again
+        disk_cache.SaveGraphicsPipeline(keys[0]);
+    }
+
+    VKShaderDiskCache disk_cache;
+    disk_cache.BindTitleID(TITLE_ID);
+    const auto transferable = disk_cache.LoadTransferable();
+    REQUIRE(transferable);
+    REQUIRE(transferable->shaders.size() == 2);
+    REQUIRE(transferable->shaders[0].unique_identifier == 1);
+    REQUIRE(transferable->shaders[0].code == MakeShader(1).code);
+    REQUIRE(transferable->shaders[1].unique_identifier == 2);
+    REQUIRE(transferable->graphics_pipelines.size() == keys.size());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        // Keys using extended dynamic state are stored without it and come back with it cleared
+        REQUIRE(std::memcmp(&transferable->graphics_pipelines[i], &keys[i],
+                            sizeof(GraphicsPipelineCacheKey)) == 0);
+    }
+    REQUIRE(!disk_cache.ShouldSaveShader(2));
+    REQUIRE(disk_cache.ShouldSaveShader(3));
+}
+
+TEST_CASE("VKShaderDiskCache[Disabled]", "[video_core]") {
+    const TempShaderDir shader_dir;
+    VKShaderDiskCache disk_cache;
+    disk_cache.BindTitleID(TITLE_ID);
+    Settings::values.use_disk_shader_cache.SetValue(false);
+    REQUIRE(!disk_cache.LoadTransferable());
+
+    // Nothing is saved before the cache has been loaded
+    REQUIRE(!disk_cache.ShouldSaveShader(1));
+    disk_cache.SaveShader(MakeShader(1));
+    Settings::values.use_disk_shader_cache.SetValue(true);
+    VKShaderDiskCache reloaded;
+    reloaded.BindTitleID(TITLE_ID);
+    REQUIRE(!reloaded.LoadTransferable());
+    REQUIRE(reloaded.ShouldSaveShader(1));
+}
@@ -0,0 +1,139 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "common/file_util.h"
+#include "video_core/shader/disk_cache_entry.h"
+
+namespace {
+
+using Tegra::Engines::SamplerDescriptor;
+using Tegra::Engines::ShaderType;
+using VideoCommon::Shader::ShaderDiskCacheEntry;
+
+/// Path in the temporary directory, removed again even when a check fails
+class TempFile {
+public:
+    explicit TempFile(const char* name)
+        : path{(std::filesystem::temp_directory_path() / name).string()} {}
+
+    ~TempFile() {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+
+    TempFile(const TempFile&) = delete;
+    TempFile& operator=(const TempFile&) = delete;
+
+    const std::string path;
+};
+
+SamplerDescriptor MakeSampler(u32 raw) {
+    SamplerDescriptor sampler;
+    sampler.raw = raw;
+    return sampler;
+}
+
+/// An entry with every field set, program A included
+ShaderDiskCacheEntry MakeEntry() {
+    ShaderDiskCacheEntry entry;
+    entry.type = ShaderType::Vertex;
+    entry.code = {0x1111, 0x2222, 0x3333};
+    entry.code_b = {0x4444, 0x5555};
+    entry.unique_identifier = 0x0123456789ABCDEF;
+    entry.texture_handler_size = 8;
+    entry.bound_buffer = 3;
+    entry.graphics_info.tfb_enabled = true;
+    entry.graphics_info.tfb_layouts[1].stride = 16;
+    entry.graphics_info.tfb_varying_locs[2][5] = 7;
+    entry.graphics_info.tessellation_clockwise = true;
+    entry.compute_info.workgroup_size = {8, 4, 2};
+    entry.compute_info.shared_memory_size_in_words = 64;
+    entry.keys.insert({{1, 0x10}, 0xCAFE});
+    entry.keys.insert({{2, 0x20}, 0xBEEF});
+    entry.bound_samplers.emplace(0x30, MakeSampler(0x1234));
+    entry.separate_samplers.emplace(VideoCommon::Shader::SeparateSamplerKey{{4, 5}, {0x40, 0x50}},
+                                    MakeSampler(0x5678));
+    entry.bindless_samplers.insert({{6, 0x60}, MakeSampler(0x9ABC)});
+    return entry;
+}
+
+bool SaveEntry(const std::string& path, const ShaderDiskCacheEntry& entry) {
+    Common::FS::IOFile file(path, "wb");
+    return file.IsOpen() && entry.Save(file);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("ShaderDiskCacheEntry[RoundTrip]", "[video_core]") {
+    const TempFile file("yuzu_shader_disk_cache_entry_test.bin");
+    const ShaderDiskCacheEntry entry = MakeEntry();
+    REQUIRE(SaveEntry(file.path, entry));
+
+    ShaderDiskCacheEntry loaded;
+    {
+        Common::FS::IOFile io(file.path, "rb");
+        REQUIRE(loaded.Load(io));
+        REQUIRE(io.Tell() == io.GetSize());
+    }
+    REQUIRE(loaded.type == entry.type);
+    REQUIRE(loaded.code == entry.code);
+    REQUIRE(loaded.code_b == entry.code_b);
+    REQUIRE(loaded.unique_identifier == entry.unique_identifier);
+    REQUIRE(loaded.texture_handler_size == entry.texture_handler_size);
+    REQUIRE(loaded.bound_buffer == entry.bound_buffer);
+    REQUIRE(std::memcmp(&loaded.graphics_info, &entry.graphics_info,
+                        sizeof(entry.graphics_info)) == 0);
+    REQUIRE(loaded.compute_info.workgroup_size == entry.compute_info.workgroup_size);
+    REQUIRE(loaded.compute_info.shared_memory_size_in_words ==
+            entry.compute_info.shared_memory_size_in_words);
+    REQUIRE(loaded.keys == entry.keys);
+    REQUIRE(loaded.bound_samplers == entry.bound_samplers);
+    REQUIRE(loaded.bindless_samplers == entry.bindless_samplers);
+    REQUIRE(loaded.separate_samplers.size() == 1);
+    const auto separate = loaded.separate_samplers.begin();
+    REQUIRE(separate->first.buffers == std::pair<u32, u32>{4, 5});
+    REQUIRE(separate->first.offsets == std::pair<u32, u32>{0x40, 0x50});
+    REQUIRE(separate->second == MakeSampler(0x5678));
+}
+
+TEST_CASE("ShaderDiskCacheEntry[Compute]", "[video_core]") {
+    // No program A and no texture handler size, the second code size is still stored
+    const TempFile file("yuzu_shader_disk_cache_entry_compute_test.bin");
+    ShaderDiskCacheEntry entry;
+    entry.type = ShaderType::Compute;
+    entry.code = {0xAAAA};
+    entry.unique_identifier = 42;
+    entry.compute_info.local_memory_size_in_words = 128;
+    REQUIRE(SaveEntry(file.path, entry));
+
+    ShaderDiskCacheEntry loaded;
+    {
+        Common::FS::IOFile io(file.path, "rb");
+        REQUIRE(loaded.Load(io));
+    }
+    REQUIRE(loaded.type == ShaderType::Compute);
+    REQUIRE(loaded.code == entry.code);
+    REQUIRE(loaded.code_b.empty());
+    REQUIRE(!loaded.HasProgramA());
+    REQUIRE(!loaded.texture_handler_size);
+    REQUIRE(loaded.compute_info.local_memory_size_in_words == 128);
+    REQUIRE(loaded.keys.empty());
+
+    // Entries cut short fail to load
+    {
+        Common::FS::IOFile io(file.path, "r+b");
+        REQUIRE(io.Resize(io.GetSize() - 1));
+    }
+    Common::FS::IOFile io(file.path, "rb");
+    ShaderDiskCacheEntry truncated;
+    REQUIRE(!truncated.Load(io));
+}
@@ -0,0 +1,282 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "video_core/textures/astc.h"
+
+namespace {
+
+using Block = std::array<u8, 16>;
+
+void WriteBits(Block& block, u32 offset, u32 count, u32 value) {
+    for (u32 i = 0; i < count; ++i) {
+        const u32 bit = offset + i;
+        block[bit / 8] = static_cast<u8>((block[bit / 8] & ~(1U << (bit % 8))) |
+                                         (((value >> i) & 1) << (bit % 8)));
+    }
+}
+
+/**
+ * Random blocks of the kind encoders produce: a 4 texels wide weight grid, one or two partitions
+ * and LDR endpoint modes. Completely random bits would mostly decode to the error color.
+ */
+std::vector<u8> RandomBlocks(std::size_t count, u32 seed) {
+    constexpr std::array<u32, 10> ldr_modes{0, 1, 4, 5, 6, 8, 9, 10, 12, 13};
+    std::mt19937 rng{seed};
+    std::vector<u8> data;
+    data.reserve(count * sizeof(Block));
+    for (std::size_t i = 0; i < count; ++i) {
+        Block block;
+        for (u8& byte : block) {
+            byte = static_cast<u8>(rng());
+        }
+        // Block mode: weight grid of 4x2 to 4x4, single plane, low precision weight range
+        WriteBits(block, 0, 2, 1 + rng() % 3);
+        WriteBits(block, 2, 2, 0);
+        WriteBits(block, 5, 2, rng() % 3);
+        WriteBits(block, 7, 4, 0);
+
+        const u32 mode = ldr_modes[rng() % ldr_modes.size()];
+        if (rng() % 2 == 0) {
+            WriteBits(block, 11, 2, 0);
+            WriteBits(block, 13, 4, mode);
+        } else {
+            // Two partitions sharing the same endpoint mode
+            WriteBits(block, 11, 2, 1);
+            WriteBits(block, 23, 6, mode << 2);
+        }
+        data.insert(data.end(), block.begin(), block.end());
+    }
+    return data;
+}
+
+/// A 4x4 block and the texels it decodes to, as 0xAABBGGRR
+struct GoldenBlock {
+    const char* name;
+    Block block;
+    std::array<u32, 16> texels;
+};
+
+/**
+ * Blocks with interpolated weights in most endpoint modes, checked against the floating point
+ * decoder this one replaced. The weight grids are smaller than the block, so the weights are
+ * infilled as well.
+ */
+constexpr std::array<GoldenBlock, 8> golden_blocks{{
+    {"Luminance and alpha",
+     {0x33, 0x80, 0xB6, 0xC5, 0x81, 0x68, 0x57, 0xC8,
+      0x32, 0x89, 0x3A, 0xFC, 0x67, 0x6D, 0x5E, 0x37},
+     {0x83DFDFDF, 0x93E0E0E0, 0x71DEDEDE, 0x93E0E0E0,
+      0xA5E1E1E1, 0x88DFDFDF, 0x88DFDFDF, 0x93E0E0E0,
+      0xAFE2E2E2, 0x83DFDFDF, 0x9EE1E1E1, 0x9EE1E1E1,
+      0xA4E1E1E1, 0x83DFDFDF, 0xB4E2E2E2, 0xB4E2E2E2}},
+    {"RGB scale",
+     {0x33, 0xC0, 0xB6, 0xC5, 0x81, 0x68, 0x57, 0xC8,
+      0x32, 0x89, 0x3A, 0xFC, 0x67, 0x6D, 0x5E, 0x37},
+     {0xFF38C5BF, 0xFF3BCFC8, 0xFF35BBB5, 0xFF3BCFC8,
+      0xFF3ED9D3, 0xFF39C8C2, 0xFF39C8C2, 0xFF3BCFC8,
+      0xFF3FDFD8, 0xFF38C5BF, 0xFF3CD5CF, 0xFF3CD5CF,
+      0xFF3DD8D2, 0xFF38C5BF, 0xFF40E2DB, 0xFF40E2DB}},
+    {"RGB base and offset",
+     {0x33, 0x20, 0xB7, 0xC5, 0x81, 0x68, 0x57, 0xC8,
+      0x32, 0x89, 0x3A, 0xFC, 0x67, 0x6D, 0x5E, 0x37},
+     {0xFF0F5D7B, 0xFF115C7D, 0xFF0D5D78, 0xFF115C7D,
+      0xFF135B7F, 0xFF105C7B, 0xFF105C7B, 0xFF115C7D,
+      0xFF145A80, 0xFF0F5D7B, 0xFF125B7E, 0xFF125B7E,
+      0xFF135B7F, 0xFF0F5D7B, 0xFF155A81, 0xFF155A81}},
+    {"RGBA",
+     {0x33, 0x80, 0xB7, 0xC5, 0x81, 0x68, 0x57, 0xC8,
+      0x32, 0x89, 0x3A, 0xFC, 0x67, 0x6D, 0x5E, 0x37},
+     {0x684C83DF, 0x5C5493E0, 0x754371DE, 0x5C5493E0,
+      0x4F5DA5E1, 0x644F88DF, 0x644F88DF, 0x5C5493E0,
+      0x4861AFE2, 0x684C83DF, 0x54599EE1, 0x54599EE1,
+      0x505CA4E1, 0x684C83DF, 0x4464B4E2, 0x4464B4E2}},
+    {"RGBA base and offset",
+     {0x33, 0xA0, 0xB7, 0xC5, 0x81, 0x68, 0x57, 0xC8,
+      0x32, 0x89, 0x3A, 0xFC, 0x67, 0x6D, 0x5E, 0x37},
+     {0x3F0F5D7B, 0x44115C7D, 0x3B0D5D78, 0x44115C7D,
+      0x48135B7F, 0x41105C7B, 0x41105C7B, 0x44115C7D,
+      0x4B145A80, 0x3F0F5D7B, 0x46125B7E, 0x46125B7E,
+      0x48135B7F, 0x3F0F5D7B, 0x4C155A81, 0x4C155A81}},
+    {"Two partitions",
+     {0x01, 0xE8, 0x0C, 0x50, 0xFF, 0x89, 0xCB, 0x85,
+      0x4F, 0xC0, 0x90, 0x81, 0xCC, 0x47, 0xED, 0xFC},
+     {0xFFB79BC1, 0xFFB79BC1, 0xFFC7E365, 0xFFB79BC1,
+      0xFFB79BC1, 0xFFB79BC1, 0xFFBFCF66, 0xFF948AA6,
+      0xFFB79BC1, 0xFFB79BC1, 0xFFB6B767, 0xFF697786,
+      0xFFB79BC1, 0xFFB79BC1, 0xFFAEA368, 0xFF46666B}},
+    {"Dual plane RGBA",
+     {0x01, 0x84, 0x8D, 0x48, 0xFF, 0x89, 0xCB, 0x85,
+      0x4F, 0xC0, 0x90, 0x81, 0xCC, 0x47, 0xED, 0xFC},
+     {0x60C2C4A4, 0x60C2C4A4, 0x60C2C4A4, 0x27E5FF46,
+      0x60C2C4A4, 0x60C2D6A4, 0x60C2C4A4, 0x27E5ED46,
+      0x60C2C4A4, 0x60C2EDA4, 0x60C2C4A4, 0x27E5D646,
+      0x60C2C4A4, 0x60C2FFA4, 0x60C2C4A4, 0x27E5C446}},
+    {"Dual plane luminance and alpha",
+     {0x01, 0x84, 0x8C, 0x48, 0xFF, 0x89, 0xCB, 0x85,
+      0x4F, 0xC0, 0x90, 0x81, 0xCC, 0x47, 0xED, 0xFC},
+     {0xC4A4A4A4, 0xC4A4A4A4, 0xC4A4A4A4, 0xFF464646,
+      0xC4A4A4A4, 0xC4A487A4, 0xC4A4A4A4, 0xFF466346,
+      0xC4A4A4A4, 0xC4A463A4, 0xC4A4A4A4, 0xFF468746,
+      0xC4A4A4A4, 0xC4A446A4, 0xC4A4A4A4, 0xFF46A446}},
+}};
+
+} // Anonymous namespace
+
+TEST_CASE("ASTC[VoidExtent]", "[video_core]") {
+    Block block{};
+    WriteBits(block, 0, 12, 0xDFC);
+    WriteBits(block, 12, 52, 0xFFFFFFFF);
+    WriteBits(block, 64, 16, 0x1234);
+    WriteBits(block, 80, 16, 0x5678);
+    WriteBits(block, 96, 16, 0x9ABC);
+    WriteBits(block, 112, 16, 0xDEF0);
+    std::vector<u8> data;
+    for (int i = 0; i < 4; ++i) {
+        data.insert(data.end(), block.begin(), block.end());
+    }
+
+    // Texels outside of the texture are dropped
+    const std::vector<u8> decoded = Tegra::Texture::ASTC::Decompress(data.data(), 7, 6, 1, 4, 4);
+    REQUIRE(decoded.size() == 7 * 6 * 4);
+    for (std::size_t i = 0; i < decoded.size(); i += 4) {
+        REQUIRE(decoded[i] == 0x12);
+        REQUIRE(decoded[i + 1] == 0x56);
+        REQUIRE(decoded[i + 2] == 0x9A);
+        REQUIRE(decoded[i + 3] == 0xDE);
+    }
+}
+
+TEST_CASE("ASTC[Golden]", "[video_core]") {
+    for (const GoldenBlock& golden : golden_blocks) {
+        INFO(golden.name);
+        const std::vector<u8> decoded =
+            Tegra::Texture::ASTC::Decompress(golden.block.data(), 4, 4, 1, 4, 4);
+        std::array<u32, 16> texels;
+        std::memcpy(texels.data(), decoded.data(), sizeof(texels));
+        REQUIRE(texels == golden.texels);
+    }
+}
+
+TEST_CASE("ASTC[Rows]", "[video_core]") {
+    // Large enough to be split between threads, with partial blocks on the right and bottom
+    constexpr u32 width = 250;
+    constexpr u32 height = 245;
+    constexpr u32 blocks_x = (width + 5) / 6;
+    constexpr u32 blocks_y = (height + 4) / 5;
+    const std::vector<u8> data = RandomBlocks(blocks_x * blocks_y * 2, 3);
+    const std::vector<u8> decoded =
+        Tegra::Texture::ASTC::Decompress(data.data(), width, height, 2, 6, 5);
+
+    // Every block lands where decoding it alone puts it
+    for (u32 z = 0; z < 2; ++z) {
+        for (u32 y = 0; y < blocks_y; ++y) {
+            for (u32 x = 0; x < blocks_x; ++x) {
+                const std::size_t block = (std::size_t{z} * blocks_y + y) * blocks_x + x;
+                const std::vector<u8> alone =
+                    Tegra::Texture::ASTC::Decompress(data.data() + block * 16, 6, 5, 1, 6, 5);
+                for (u32 j = 0; j < 5 && y * 5 + j < height; ++j) {
+                    const std::size_t row = (std::size_t{z} * height + y * 5 + j) * width;
+                    const u32 columns = std::min(6U, width - x * 6);
+                    REQUIRE(std::equal(alone.begin() + j * 6 * 4,
+                                       alone.begin() + (j * 6 + columns) * 4,
+                                       decoded.begin() + (row + x * 6) * 4));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("ASTC[DecodeCache]", "[video_core]") {
+    using Tegra::Texture::ASTC::DecodeCache;
+    // 8x8 texels in 4x4 blocks take 64 input and 256 decoded bytes
+    constexpr std::size_t entry_size = 64 + 8 * 8 * 4;
+    DecodeCache cache(entry_size * 4);
+    std::vector<u8> data = RandomBlocks(4, 5);
+    const auto decode = [&](u32 width, u32 height, u32 block_width, u32 block_height) {
+        std::vector<u8> output(width * height * 4, 0xCD);
+        cache.Decompress(data.data(), width, height, 1, block_width, block_height,
+                         output.data());
+        REQUIRE(output == Tegra::Texture::ASTC::Decompress(data.data(), width, height, 1,
+                                                           block_width, block_height));
+    };
+
+    decode(8, 8, 4, 4);
+    decode(8, 8, 4, 4);
+    REQUIRE(cache.GetNumEntries() == 1);
+    REQUIRE(cache.GetSize() == entry_size);
+
+    // The same blocks in another layout or format are another texture
+    decode(16, 4, 4, 4);
+    decode(16, 4, 8, 4);
+    REQUIRE(cache.GetNumEntries() == 3);
+
+    // Changed blocks are decoded again
+    data[20] ^= 0xFF;
+    decode(8, 8, 4, 4);
+    REQUIRE(cache.GetNumEntries() == 4);
+
+    // Beyond the budget the least recently used go first
+    for (u32 seed = 6; seed < 10; ++seed) {
+        data = RandomBlocks(4, seed);
+        decode(8, 8, 4, 4);
+    }
+    REQUIRE(cache.GetNumEntries() == 4);
+    REQUIRE(cache.GetSize() == entry_size * 4);
+
+    // Textures larger than a quarter of the budget aren't kept
+    data = RandomBlocks(16, 10);
+    decode(16, 16, 4, 4);
+    REQUIRE(cache.GetNumEntries() == 4);
+
+    cache.Clear();
+    REQUIRE(cache.GetNumEntries() == 0);
+    REQUIRE(cache.GetSize() == 0);
+}
+
+TEST_CASE("ASTC[Throughput]", "[.benchmark]") {
+    constexpr std::array<std::pair<u32, u32>, 14> footprints{{
+        {4, 4},
+        {5, 4},
+        {5, 5},
+        {6, 5},
+        {6, 6},
+        {8, 5},
+        {8, 6},
+        {8, 8},
+        {10, 5},
+        {10, 6},
+        {10, 8},
+        {10, 10},
+        {12, 10},
+        {12, 12},
+    }};
+    constexpr u32 width = 1024;
+    constexpr u32 height = 1024;
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<u8> output(width * height * 4);
+    for (const auto& [block_width, block_height] : footprints) {
+        const u32 blocks_x = (width + block_width - 1) / block_width;
+        const u32 blocks_y = (height + block_height - 1) / block_height;
+        const std::vector<u8> data = RandomBlocks(blocks_x * blocks_y, block_width * block_height);
+
+        const auto start = Clock::now();
+        Tegra::Texture::ASTC::Decompress(data.data(), width, height, 1, block_width, block_height,
+                                         output.data());
+        const std::chrono::duration<double> elapsed = Clock::now() - start;
+        std::printf("ASTC %2ux%-2u: %8.2f Mtexels/s\n", block_width, block_height,
+                    width * height / elapsed.count() / 1e6);
+    }
+}
@@ -0,0 +1,174 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "video_core/textures/decoders.h"
+
+namespace {
+
+using namespace Tegra::Texture;
+
+/// Offset of a byte of a block linear texture, straight from the layout description
+std::size_t SwizzledOffset(u32 x_byte, u32 y, u32 z, u32 width_bytes, u32 height,
+                           u32 block_height, u32 block_depth) {
+    const u32 gobs_y = GOB_SIZE_Y << block_height;
+    const u32 gobs_z = 1U << block_depth;
+    const std::size_t blocks_x = (width_bytes + GOB_SIZE_X - 1) / GOB_SIZE_X;
+    const std::size_t blocks_y = (height + gobs_y - 1) / gobs_y;
+    const std::size_t xy_block_size = GOB_SIZE << block_height;
+    const std::size_t block_size = xy_block_size << block_depth;
+    const std::size_t block =
+        ((z / gobs_z) * blocks_y + y / gobs_y) * blocks_x + x_byte / GOB_SIZE_X;
+    const u32 gob_x = x_byte % GOB_SIZE_X;
+    const u32 gob_y = y % GOB_SIZE_Y;
+    const u32 in_gob = (gob_x / 32) * 256 + (gob_y / 2) * 64 + ((gob_x % 32) / 16) * 32 +
+                       (gob_y % 2) * 16 + gob_x % 16;
+    return block * block_size + (z % gobs_z) * xy_block_size +
+           ((y % gobs_y) / GOB_SIZE_Y) * GOB_SIZE + in_gob;
+}
+
+std::vector<u8> RandomBytes(std::size_t size, u32 seed) {
+    std::mt19937 rng{seed};
+    std::vector<u8> bytes(size);
+    for (u8& byte : bytes) {
+        byte = static_cast<u8>(rng());
+    }
+    return bytes;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("Decoders[CopySwizzledData]", "[video_core]") {
+    struct Case {
+        u32 width;
+        u32 height;
+        u32 depth;
+        u32 bytes_per_pixel;
+        u32 block_height;
+        u32 block_depth;
+    };
+    // Whole GOB kernels, partial GOBs at the edges, and the per pixel path
+    const std::vector<Case> cases{
+        {256, 256, 1, 4, 4, 0}, {100, 77, 1, 4, 2, 0}, {64, 64, 4, 8, 1, 1},
+        {36, 20, 1, 16, 0, 0},  {33, 17, 1, 2, 3, 0},  {45, 30, 3, 2, 1, 1},
+        {2048, 1024, 1, 4, 4, 0},
+    };
+    for (const Case& c : cases) {
+        const u32 width_bytes = c.width * c.bytes_per_pixel;
+        const std::size_t swizzled_size = CalculateSize(true, c.bytes_per_pixel, c.width, c.height,
+                                                        c.depth, c.block_height, c.block_depth);
+        const std::vector<u8> linear =
+            RandomBytes(std::size_t{width_bytes} * c.height * c.depth, c.width);
+
+        std::vector<u8> swizzled(swizzled_size);
+        CopySwizzledData(c.width, c.height, c.depth, c.bytes_per_pixel, c.bytes_per_pixel,
+                         swizzled.data(), const_cast<u8*>(linear.data()), false, c.block_height,
+                         c.block_depth, 1);
+        std::vector<u8> unswizzled(linear.size());
+        CopySwizzledData(c.width, c.height, c.depth, c.bytes_per_pixel, c.bytes_per_pixel,
+                         swizzled.data(), unswizzled.data(), true, c.block_height, c.block_depth,
+                         1);
+
+        bool matches = true;
+        for (u32 z = 0; z < c.depth; ++z) {
+            for (u32 y = 0; y < c.height; ++y) {
+                for (u32 x = 0; x < width_bytes; ++x) {
+                    const std::size_t offset = SwizzledOffset(x, y, z, width_bytes, c.height,
+                                                              c.block_height, c.block_depth);
+                    const std::size_t index = (std::size_t{z} * c.height + y) * width_bytes + x;
+                    matches &= swizzled[offset] == linear[index];
+                }
+            }
+        }
+        INFO("width " << c.width << " height " << c.height << " bytes per pixel "
+                      << c.bytes_per_pixel);
+        REQUIRE(matches);
+        REQUIRE(unswizzled == linear);
+    }
+}
+
+TEST_CASE("Decoders[Subrects]", "[video_core]") {
+    constexpr u32 width = 300;
+    constexpr u32 height = 100;
+    constexpr u32 bytes_per_pixel = 4;
+    constexpr u32 block_height = 3;
+    constexpr u32 width_bytes = width * bytes_per_pixel;
+    const std::vector<u8> swizzled = RandomBytes(
+        CalculateSize(true, bytes_per_pixel, width, height, 1, block_height, 0), 1);
+
+    // A rectangle that starts and ends in the middle of GOB sectors
+    constexpr u32 origin_x = 13;
+    constexpr u32 origin_y = 5;
+    constexpr u32 rect_width = 250;
+    constexpr u32 rect_height = 90;
+    constexpr u32 pitch = rect_width * bytes_per_pixel + 12;
+    std::vector<u8> rect(pitch * rect_height);
+    UnswizzleSubrect(rect_width, rect_height, pitch, width, bytes_per_pixel, block_height, origin_x,
+                     origin_y, rect.data(), swizzled.data());
+
+    bool matches = true;
+    for (u32 y = 0; y < rect_height; ++y) {
+        for (u32 x = 0; x < rect_width * bytes_per_pixel; ++x) {
+            const std::size_t offset = SwizzledOffset(origin_x * bytes_per_pixel + x, origin_y + y,
+                                                      0, width_bytes, height, block_height, 0);
+            matches &= rect[y * pitch + x] == swizzled[offset];
+        }
+    }
+    REQUIRE(matches);
+
+    std::vector<u8> copy(swizzled.size());
+    SwizzleSubrect(rect_width, rect_height, pitch, width, bytes_per_pixel, copy.data(),
+                   rect.data(), block_height, origin_x, origin_y);
+    for (u32 y = 0; y < rect_height; ++y) {
+        for (u32 x = 0; x < rect_width * bytes_per_pixel; ++x) {
+            const std::size_t offset = SwizzledOffset(origin_x * bytes_per_pixel + x, origin_y + y,
+                                                      0, width_bytes, height, block_height, 0);
+            matches &= copy[offset] == swizzled[offset];
+        }
+    }
+    REQUIRE(matches);
+}
+
+TEST_CASE("Decoders[Throughput]", "[.benchmark]") {
+    // A 1080p-sized render target at the common pixel sizes and block heights
+    constexpr u32 width_bytes = 1920 * 4;
+    constexpr u32 height = 1088;
+    using Clock = std::chrono::steady_clock;
+
+    for (const u32 bytes_per_pixel : {4U, 8U, 16U}) {
+        for (const u32 block_height : {0U, 2U, 4U}) {
+            const u32 width = width_bytes / bytes_per_pixel;
+            std::vector<u8> linear = RandomBytes(std::size_t{width_bytes} * height, block_height);
+            std::vector<u8> swizzled(
+                CalculateSize(true, bytes_per_pixel, width, height, 1, block_height, 0));
+
+            const auto measure = [&](bool unswizzle) {
+                constexpr int iterations = 10;
+                CopySwizzledData(width, height, 1, bytes_per_pixel, bytes_per_pixel,
+                                 swizzled.data(), linear.data(), unswizzle, block_height, 0, 1);
+                const auto start = Clock::now();
+                for (int i = 0; i < iterations; ++i) {
+                    CopySwizzledData(width, height, 1, bytes_per_pixel, bytes_per_pixel,
+                                     swizzled.data(), linear.data(), unswizzle, block_height, 0,
+                                     1);
+                }
+                const std::chrono::duration<double> elapsed = Clock::now() - start;
+                return static_cast<double>(linear.size()) * iterations / elapsed.count() / 1e9;
+            };
+            const double swizzle = measure(false);
+            const double unswizzle = measure(true);
+            std::printf("Swizzle %2u bytes per pixel, block height %2u: %6.2f GB/s swizzle, "
+                        "%6.2f GB/s unswizzle\n",
+                        bytes_per_pixel, 1U << block_height, swizzle, unswizzle);
+            REQUIRE(swizzle > 0.0);
+        }
+    }
+}
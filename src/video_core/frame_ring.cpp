@@ -0,0 +1,68 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+
+#include "core/frontend/framebuffer_layout.h"
+#include "video_core/frame_ring.h"
+
+namespace VideoCore {
+
+namespace {
+
+constexpr std::size_t BYTES_PER_PIXEL = 4;
+
+// Slots are sized for the largest native output up front, so switching between docked and
+// undocked mode never reallocates a buffer a reader may still be looking at
+constexpr std::size_t MIN_SLOT_SIZE =
+    Layout::ScreenDocked::Width * Layout::ScreenDocked::Height * BYTES_PER_PIXEL;
+
+} // Anonymous namespace
+
+FrameRing::FrameRing() = default;
+
+FrameRing::~FrameRing() = default;
+
+u8* FrameRing::BeginWrite(u32 width, u32 height) {
+    const u64 number = published.load(std::memory_order_relaxed) + 1;
+    writing.store(number, std::memory_order_relaxed);
+    // Make sure readers see the frame as invalid before any of its bytes change
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Slot& slot = slots[number % NUM_SLOTS];
+    const std::size_t size = std::size_t{width} * height * BYTES_PER_PIXEL;
+    if (slot.data.size() < size) {
+        slot.data.resize(std::max(size, MIN_SLOT_SIZE));
+    }
+    slot.width = width;
+    slot.height = height;
+    return slot.data.data();
+}
+
+void FrameRing::EndWrite() {
+    published.store(writing.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+std::optional<FrameRing::Frame> FrameRing::GetLatestFrame() const {
+    const u64 number = published.load(std::memory_order_acquire);
+    if (number == 0) {
+        return std::nullopt;
+    }
+
+    const Slot& slot = slots[number % NUM_SLOTS];
+    return Frame{
+        .data = slot.data.data(),
+        .number = number,
+        .width = slot.width,
+        .height = slot.height,
+        .stride = static_cast<u32>(slot.width * BYTES_PER_PIXEL),
+    };
+}
+
+bool FrameRing::IsFrameValid(u64 number) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return number != 0 && writing.load(std::memory_order_relaxed) < number + NUM_SLOTS;
+}
+
+} // namespace VideoCore
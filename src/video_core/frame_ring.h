@@ -0,0 +1,78 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <optional>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace VideoCore {
+
+/**
+ * Ring of the most recently presented frames, written once per present by the renderer and read
+ * in place by any number of consumers (such as plugins) without copying or allocating.
+ *
+ * Frame N is stored in slot N % NUM_SLOTS, so a frame stays intact until the renderer starts
+ * writing frame N + NUM_SLOTS. Readers check this with IsFrameValid after they are done reading,
+ * in the same way as a sequence lock.
+ */
+class FrameRing {
+public:
+    static constexpr std::size_t NUM_SLOTS = 3;
+
+    struct Frame {
+        const u8* data;
+        u64 number;
+        u32 width;
+        u32 height;
+        /// Bytes per row, rows are stored bottom to top in RGBA8 order
+        u32 stride;
+    };
+
+    FrameRing();
+    ~FrameRing();
+
+    /// Enables or disables publishing frames, the renderer skips all work while disabled.
+    void SetEnabled(bool enabled_) {
+        enabled.store(enabled_, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] bool IsEnabled() const {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    /// Returns the buffer the next frame has to be written to. Only called by the renderer.
+    [[nodiscard]] u8* BeginWrite(u32 width, u32 height);
+
+    /// Publishes the frame written after the last call to BeginWrite.
+    void EndWrite();
+
+    /// Returns the most recently published frame, or std::nullopt if there is none yet.
+    [[nodiscard]] std::optional<Frame> GetLatestFrame() const;
+
+    /// Returns whether the given frame has not been overwritten. Call after reading the frame.
+    [[nodiscard]] bool IsFrameValid(u64 number) const;
+
+private:
+    struct Slot {
+        std::vector<u8> data;
+        u32 width = 0;
+        u32 height = 0;
+    };
+
+    std::array<Slot, NUM_SLOTS> slots;
+
+    /// Number of the last published frame, zero when nothing was published yet
+    std::atomic<u64> published{0};
+    /// Number of the frame currently being written, or the last written one
+    std::atomic<u64> writing{0};
+
+    std::atomic_bool enabled{false};
+};
+
+} // namespace VideoCore
@@ -10,6 +10,7 @@
 
 #include "common/common_types.h"
 #include "core/frontend/emu_window.h"
+#include "video_core/frame_ring.h"
 #include "video_core/gpu.h"
 #include "video_core/rasterizer_interface.h"
 
@@ -89,6 +90,14 @@ public:
         return renderer_settings;
     }
 
+    FrameRing& GetFrameRing() {
+        return frame_ring;
+    }
+
+    const FrameRing& GetFrameRing() const {
+        return frame_ring;
+    }
+
     /// Refreshes the settings common to all renderers
     void RefreshBaseSettings();
 
@@ -104,6 +113,7 @@ protected:
     int m_current_frame = 0;  ///< Current frame, should be set by the renderer
 
     RendererSettings renderer_settings;
+    FrameRing frame_ring; ///< Presented frames shared with plugins, filled by the renderer
 
 private:
     /// Updates the framebuffer layout of the contained render window handle.
@@ -0,0 +1,71 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "video_core/gpu.h"
+#include "video_core/memory_manager.h"
+#include "video_core/renderer_null/null_rasterizer.h"
+
+namespace Null {
+
+namespace {
+
+/// Offset of the timestamp in a query written with one
+constexpr GPUVAddr QUERY_TIMESTAMP_OFFSET = 8;
+
+} // Anonymous namespace
+
+RasterizerNull::RasterizerNull(Tegra::GPU& gpu_) : gpu{gpu_}, gpu_memory{gpu_.MemoryManager()} {}
+
+RasterizerNull::~RasterizerNull() = default;
+
+void RasterizerNull::Draw(bool is_indexed, bool is_instanced) {}
+
+void RasterizerNull::Clear() {}
+
+void RasterizerNull::DispatchCompute(GPUVAddr code_addr) {}
+
+void RasterizerNull::ResetCounter(VideoCore::QueryType type) {}
+
+void RasterizerNull::Query(GPUVAddr gpu_addr, VideoCore::QueryType type,
+                           std::optional<u64> timestamp) {
+    // Nothing is drawn, so no sample ever passes
+    gpu_memory.Write<u64>(gpu_addr, 0);
+    if (timestamp) {
+        gpu_memory.Write<u64>(gpu_addr + QUERY_TIMESTAMP_OFFSET, *timestamp);
+    }
+}
+
+void RasterizerNull::SignalSemaphore(GPUVAddr addr, u32 value) {
+    gpu_memory.Write<u32>(addr, value);
+}
+
+void RasterizerNull::SignalSyncPoint(u32 value) {
+    gpu.IncrementSyncPoint(value);
+}
+
+void RasterizerNull::ReleaseFences() {}
+
+void RasterizerNull::FlushAll() {}
+
+void RasterizerNull::FlushRegion(VAddr addr, u64 size) {}
+
+bool RasterizerNull::MustFlushRegion(VAddr addr, u64 size) {
+    return false;
+}
+
+void RasterizerNull::InvalidateRegion(VAddr addr, u64 size) {}
+
+void RasterizerNull::OnCPUWrite(VAddr addr, u64 size) {}
+
+void RasterizerNull::SyncGuestHost() {}
+
+void RasterizerNull::FlushAndInvalidateRegion(VAddr addr, u64 size) {}
+
+void RasterizerNull::WaitForIdle() {}
+
+void RasterizerNull::FlushCommands() {}
+
+void RasterizerNull::TickFrame() {}
+
+} // namespace Null
@@ -0,0 +1,53 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <optional>
+
+#include "common/common_types.h"
+#include "video_core/rasterizer_interface.h"
+
+namespace Tegra {
+class GPU;
+class MemoryManager;
+} // namespace Tegra
+
+namespace Null {
+
+/**
+ * Rasterizer that never talks to a host GPU. Guest memory is the only copy of every resource, so
+ * there is nothing to flush or invalidate, and the commands that report back to the guest
+ * (queries, semaphores and syncpoints) complete as soon as they are issued.
+ */
+class RasterizerNull final : public VideoCore::RasterizerInterface {
+public:
+    explicit RasterizerNull(Tegra::GPU& gpu);
+    ~RasterizerNull() override;
+
+    void Draw(bool is_indexed, bool is_instanced) override;
+    void Clear() override;
+    void DispatchCompute(GPUVAddr code_addr) override;
+    void ResetCounter(VideoCore::QueryType type) override;
+    void Query(GPUVAddr gpu_addr, VideoCore::QueryType type, std::optional<u64> timestamp) override;
+    void SignalSemaphore(GPUVAddr addr, u32 value) override;
+    void SignalSyncPoint(u32 value) override;
+    void ReleaseFences() override;
+    void FlushAll() override;
+    void FlushRegion(VAddr addr, u64 size) override;
+    bool MustFlushRegion(VAddr addr, u64 size) override;
+    void InvalidateRegion(VAddr addr, u64 size) override;
+    void OnCPUWrite(VAddr addr, u64 size) override;
+    void SyncGuestHost() override;
+    void FlushAndInvalidateRegion(VAddr addr, u64 size) override;
+    void WaitForIdle() override;
+    void FlushCommands() override;
+    void TickFrame() override;
+
+private:
+    Tegra::GPU& gpu;
+    Tegra::MemoryManager& gpu_memory;
+};
+
+} // namespace Null
@@ -0,0 +1,46 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "common/logging/log.h"
+#include "core/frontend/emu_window.h"
+#include "video_core/gpu.h"
+#include "video_core/renderer_null/null_rasterizer.h"
+#include "video_core/renderer_null/renderer_null.h"
+
+namespace Null {
+
+RendererNull::RendererNull(Core::Frontend::EmuWindow& emu_window, Tegra::GPU& gpu_,
+                           std::unique_ptr<Core::Frontend::GraphicsContext> context)
+    : RendererBase{emu_window, std::move(context)}, gpu{gpu_} {}
+
+RendererNull::~RendererNull() = default;
+
+bool RendererNull::Init() {
+    rasterizer = std::make_unique<RasterizerNull>(gpu);
+    LOG_INFO(Render, "Using the null renderer, nothing will be drawn");
+    return true;
+}
+
+void RendererNull::ShutDown() {}
+
+void RendererNull::SwapBuffers(const Tegra::FramebufferConfig* framebuffer) {
+    if (!framebuffer) {
+        return;
+    }
+
+    if (renderer_settings.screenshot_requested) {
+        // There is no image to capture, the callback would save garbage
+        LOG_WARNING(Render, "Screenshots are not supported by the null renderer");
+        renderer_settings.screenshot_requested = false;
+    }
+
+    ++m_current_frame;
+
+    rasterizer->TickFrame();
+
+    render_window.PollEvents();
+    context->SwapBuffers();
+}
+
+} // namespace Null
@@ -0,0 +1,37 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+
+#include "video_core/renderer_base.h"
+
+namespace Core::Frontend {
+class EmuWindow;
+class GraphicsContext;
+} // namespace Core::Frontend
+
+namespace Tegra {
+class GPU;
+}
+
+namespace Null {
+
+/// Renderer for headless runs, the GPU engines execute but nothing is drawn or presented
+class RendererNull final : public VideoCore::RendererBase {
+public:
+    explicit RendererNull(Core::Frontend::EmuWindow& emu_window, Tegra::GPU& gpu,
+                          std::unique_ptr<Core::Frontend::GraphicsContext> context);
+    ~RendererNull() override;
+
+    bool Init() override;
+    void ShutDown() override;
+    void SwapBuffers(const Tegra::FramebufferConfig* framebuffer) override;
+
+private:
+    Tegra::GPU& gpu;
+};
+
+} // namespace Null
@@ -8,6 +8,7 @@
 #include <optional>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "common/alignment.h"
@@ -357,23 +358,26 @@ void ShaderCacheOpenGL::LoadDiskCache(u64 title_id, const std::atomic_bool& stop
     std::size_t built_shaders = 0; // It doesn't have be atomic since it's used behind a mutex
     std::atomic_bool gl_cache_failed = false;
 
-    const auto find_precompiled = [&gl_cache](u64 id) {
-        return std::find_if(gl_cache.begin(), gl_cache.end(),
-                            [id](const auto& entry) { return entry.unique_identifier == id; });
-    };
+    // Big caches have tens of thousands of entries, don't search them linearly
+    std::unordered_map<u64, const ShaderDiskCachePrecompiled*> precompiled_entries;
+    precompiled_entries.reserve(gl_cache.size());
+    for (const ShaderDiskCachePrecompiled& precompiled : gl_cache) {
+        precompiled_entries.emplace(precompiled.unique_identifier, &precompiled);
+    }
 
-    const auto worker = [&](Core::Frontend::GraphicsContext* context, std::size_t begin,
-                            std::size_t end) {
+    // Workers take entries one at a time, build times vary too much to split them evenly
+    std::atomic_size_t next_entry = 0;
+    const auto worker = [&](Core::Frontend::GraphicsContext* context) {
         const auto scope = context->Acquire();
 
-        for (std::size_t i = begin; i < end; ++i) {
+        for (std::size_t i = next_entry++; i < transferable->size(); i = next_entry++) {
             if (stop_loading) {
                 return;
             }
             const auto& entry = (*transferable)[i];
             const u64 uid = entry.unique_identifier;
-            const auto it = find_precompiled(uid);
-            const auto precompiled_entry = it != gl_cache.end() ? &*it : nullptr;
+            const auto it = precompiled_entries.find(uid);
+            const auto precompiled_entry = it != precompiled_entries.end() ? it->second : nullptr;
 
             const bool is_compute = entry.type == ShaderType::Compute;
             const u32 main_offset = is_compute ? KERNEL_MAIN_OFFSET : STAGE_MAIN_OFFSET;
@@ -407,18 +411,14 @@ void ShaderCacheOpenGL::LoadDiskCache(u64 title_id, const std::atomic_bool& stop
         }
     };
 
-    const std::size_t num_workers{std::max(1U, std::thread::hardware_concurrency())};
-    const std::size_t bucket_size{transferable->size() / num_workers};
+    const std::size_t num_workers{std::min<std::size_t>(
+        std::max(1U, std::thread::hardware_concurrency()), transferable->size())};
     std::vector<std::unique_ptr<Core::Frontend::GraphicsContext>> contexts(num_workers);
     std::vector<std::thread> threads(num_workers);
     for (std::size_t i = 0; i < num_workers; ++i) {
-        const bool is_last_worker = i + 1 == num_workers;
-        const std::size_t start{bucket_size * i};
-        const std::size_t end{is_last_worker ? transferable->size() : start + bucket_size};
-
         // On some platforms the shared context has to be created from the GUI thread
         contexts[i] = emu_window.CreateSharedContext();
-        threads[i] = std::thread(worker, contexts[i].get(), start, end);
+        threads[i] = std::thread(worker, contexts[i].get());
     }
     for (auto& thread : threads) {
         thread.join();
@@ -444,8 +444,7 @@ void ShaderCacheOpenGL::LoadDiskCache(u64 title_id, const std::atomic_bool& stop
 
     for (std::size_t i = 0; i < transferable->size(); ++i) {
         const u64 id = (*transferable)[i].unique_identifier;
-        const auto it = find_precompiled(id);
-        if (it == gl_cache.end()) {
+        if (!precompiled_entries.contains(id)) {
             const GLuint program = runtime_cache.at(id).program->source_program.handle;
             disk_cache.SavePrecompiled(id, program);
             precompiled_cache_altered = true;
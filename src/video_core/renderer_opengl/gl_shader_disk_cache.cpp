@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <cstring>
+#include <span>
 
 #include <fmt/format.h>
 
@@ -16,48 +17,15 @@
 #include "core/core.h"
 #include "core/hle/kernel/process.h"
 #include "core/settings.h"
-#include "video_core/engines/shader_type.h"
 #include "video_core/renderer_opengl/gl_shader_cache.h"
 #include "video_core/renderer_opengl/gl_shader_disk_cache.h"
 
 namespace OpenGL {
 
-using Tegra::Engines::ShaderType;
-using VideoCommon::Shader::BindlessSamplerMap;
-using VideoCommon::Shader::BoundSamplerMap;
-using VideoCommon::Shader::KeyMap;
-
 namespace {
 
-using VideoCommon::Shader::SeparateSamplerKey;
-
 using ShaderCacheVersionHash = std::array<u8, 64>;
 
-struct ConstBufferKey {
-    u32 cbuf = 0;
-    u32 offset = 0;
-    u32 value = 0;
-};
-
-struct BoundSamplerEntry {
-    u32 offset = 0;
-    Tegra::Engines::SamplerDescriptor sampler;
-};
-
-struct SeparateSamplerEntry {
-    u32 cbuf1 = 0;
-    u32 cbuf2 = 0;
-    u32 offset1 = 0;
-    u32 offset2 = 0;
-    Tegra::Engines::SamplerDescriptor sampler;
-};
-
-struct BindlessSamplerEntry {
-    u32 cbuf = 0;
-    u32 offset = 0;
-    Tegra::Engines::SamplerDescriptor sampler;
-};
-
 constexpr u32 NativeVersion = 21;
 
 ShaderCacheVersionHash GetShaderCacheVersionHash() {
@@ -67,144 +35,46 @@ ShaderCacheVersionHash GetShaderCacheVersionHash() {
     return hash;
 }
 
-} // Anonymous namespace
-
-ShaderDiskCacheEntry::ShaderDiskCacheEntry() = default;
-
-ShaderDiskCacheEntry::~ShaderDiskCacheEntry() = default;
-
-bool ShaderDiskCacheEntry::Load(Common::FS::IOFile& file) {
-    if (file.ReadBytes(&type, sizeof(u32)) != sizeof(u32)) {
-        return false;
-    }
-    u32 code_size;
-    u32 code_size_b;
-    if (file.ReadBytes(&code_size, sizeof(u32)) != sizeof(u32) ||
-        file.ReadBytes(&code_size_b, sizeof(u32)) != sizeof(u32)) {
-        return false;
-    }
-    code.resize(code_size);
-    code_b.resize(code_size_b);
+/// Parses the decompressed precompiled file in place. Returns empty on failure.
+std::optional<std::vector<ShaderDiskCachePrecompiled>> LoadPrecompiledFile(
+    std::span<const u8> data) {
+    std::size_t offset = 0;
+    const auto read = [&](void* dest, std::size_t size) {
+        if (data.size() - offset < size) {
+            return false;
+        }
+        std::memcpy(dest, data.data() + offset, size);
+        offset += size;
+        return true;
+    };
 
-    if (file.ReadArray(code.data(), code_size) != code_size) {
-        return false;
+    ShaderCacheVersionHash file_hash{};
+    if (!read(file_hash.data(), file_hash.size())) {
+        return std::nullopt;
     }
-    if (HasProgramA() && file.ReadArray(code_b.data(), code_size_b) != code_size_b) {
-        return false;
+    if (GetShaderCacheVersionHash() != file_hash) {
+        LOG_INFO(Render_OpenGL, "Precompiled cache is from another version of the emulator");
+        return std::nullopt;
     }
 
-    u8 is_texture_handler_size_known;
-    u32 texture_handler_size_value;
-    u32 num_keys;
-    u32 num_bound_samplers;
-    u32 num_separate_samplers;
-    u32 num_bindless_samplers;
-    if (file.ReadArray(&unique_identifier, 1) != 1 || file.ReadArray(&bound_buffer, 1) != 1 ||
-        file.ReadArray(&is_texture_handler_size_known, 1) != 1 ||
-        file.ReadArray(&texture_handler_size_value, 1) != 1 ||
-        file.ReadArray(&graphics_info, 1) != 1 || file.ReadArray(&compute_info, 1) != 1 ||
-        file.ReadArray(&num_keys, 1) != 1 || file.ReadArray(&num_bound_samplers, 1) != 1 ||
-        file.ReadArray(&num_separate_samplers, 1) != 1 ||
-        file.ReadArray(&num_bindless_samplers, 1) != 1) {
-        return false;
-    }
-    if (is_texture_handler_size_known) {
-        texture_handler_size = texture_handler_size_value;
-    }
+    std::vector<ShaderDiskCachePrecompiled> entries;
+    while (offset < data.size()) {
+        u32 binary_size;
+        auto& entry = entries.emplace_back();
+        if (!read(&entry.unique_identifier, sizeof(entry.unique_identifier)) ||
+            !read(&entry.binary_format, sizeof(entry.binary_format)) ||
+            !read(&binary_size, sizeof(binary_size)) || binary_size > data.size() - offset) {
+            return std::nullopt;
+        }
 
-    std::vector<ConstBufferKey> flat_keys(num_keys);
-    std::vector<BoundSamplerEntry> flat_bound_samplers(num_bound_samplers);
-    std::vector<SeparateSamplerEntry> flat_separate_samplers(num_separate_samplers);
-    std::vector<BindlessSamplerEntry> flat_bindless_samplers(num_bindless_samplers);
-    if (file.ReadArray(flat_keys.data(), flat_keys.size()) != flat_keys.size() ||
-        file.ReadArray(flat_bound_samplers.data(), flat_bound_samplers.size()) !=
-            flat_bound_samplers.size() ||
-        file.ReadArray(flat_separate_samplers.data(), flat_separate_samplers.size()) !=
-            flat_separate_samplers.size() ||
-        file.ReadArray(flat_bindless_samplers.data(), flat_bindless_samplers.size()) !=
-            flat_bindless_samplers.size()) {
-        return false;
-    }
-    for (const auto& entry : flat_keys) {
-        keys.insert({{entry.cbuf, entry.offset}, entry.value});
-    }
-    for (const auto& entry : flat_bound_samplers) {
-        bound_samplers.emplace(entry.offset, entry.sampler);
-    }
-    for (const auto& entry : flat_separate_samplers) {
-        SeparateSamplerKey key;
-        key.buffers = {entry.cbuf1, entry.cbuf2};
-        key.offsets = {entry.offset1, entry.offset2};
-        separate_samplers.emplace(key, entry.sampler);
-    }
-    for (const auto& entry : flat_bindless_samplers) {
-        bindless_samplers.insert({{entry.cbuf, entry.offset}, entry.sampler});
+        entry.binary.resize(binary_size);
+        read(entry.binary.data(), entry.binary.size());
     }
 
-    return true;
+    return entries;
 }
 
-bool ShaderDiskCacheEntry::Save(Common::FS::IOFile& file) const {
-    if (file.WriteObject(static_cast<u32>(type)) != 1 ||
-        file.WriteObject(static_cast<u32>(code.size())) != 1 ||
-        file.WriteObject(static_cast<u32>(code_b.size())) != 1) {
-        return false;
-    }
-    if (file.WriteArray(code.data(), code.size()) != code.size()) {
-        return false;
-    }
-    if (HasProgramA() && file.WriteArray(code_b.data(), code_b.size()) != code_b.size()) {
-        return false;
-    }
-
-    if (file.WriteObject(unique_identifier) != 1 || file.WriteObject(bound_buffer) != 1 ||
-        file.WriteObject(static_cast<u8>(texture_handler_size.has_value())) != 1 ||
-        file.WriteObject(texture_handler_size.value_or(0)) != 1 ||
-        file.WriteObject(graphics_info) != 1 || file.WriteObject(compute_info) != 1 ||
-        file.WriteObject(static_cast<u32>(keys.size())) != 1 ||
-        file.WriteObject(static_cast<u32>(bound_samplers.size())) != 1 ||
-        file.WriteObject(static_cast<u32>(separate_samplers.size())) != 1 ||
-        file.WriteObject(static_cast<u32>(bindless_samplers.size())) != 1) {
-        return false;
-    }
-
-    std::vector<ConstBufferKey> flat_keys;
-    flat_keys.reserve(keys.size());
-    for (const auto& [address, value] : keys) {
-        flat_keys.push_back(ConstBufferKey{address.first, address.second, value});
-    }
-
-    std::vector<BoundSamplerEntry> flat_bound_samplers;
-    flat_bound_samplers.reserve(bound_samplers.size());
-    for (const auto& [address, sampler] : bound_samplers) {
-        flat_bound_samplers.push_back(BoundSamplerEntry{address, sampler});
-    }
-
-    std::vector<SeparateSamplerEntry> flat_separate_samplers;
-    flat_separate_samplers.reserve(separate_samplers.size());
-    for (const auto& [key, sampler] : separate_samplers) {
-        SeparateSamplerEntry entry;
-        std::tie(entry.cbuf1, entry.cbuf2) = key.buffers;
-        std::tie(entry.offset1, entry.offset2) = key.offsets;
-        entry.sampler = sampler;
-        flat_separate_samplers.push_back(entry);
-    }
-
-    std::vector<BindlessSamplerEntry> flat_bindless_samplers;
-    flat_bindless_samplers.reserve(bindless_samplers.size());
-    for (const auto& [address, sampler] : bindless_samplers) {
-        flat_bindless_samplers.push_back(
-            BindlessSamplerEntry{address.first, address.second, sampler});
-    }
-
-    return file.WriteArray(flat_keys.data(), flat_keys.size()) == flat_keys.size() &&
-           file.WriteArray(flat_bound_samplers.data(), flat_bound_samplers.size()) ==
-               flat_bound_samplers.size() &&
-           file.WriteArray(flat_separate_samplers.data(), flat_separate_samplers.size()) ==
-               flat_separate_samplers.size() &&
-           file.WriteArray(flat_bindless_samplers.data(), flat_bindless_samplers.size()) ==
-               flat_bindless_samplers.size();
-}
+} // Anonymous namespace
 
 ShaderDiskCacheOpenGL::ShaderDiskCacheOpenGL() = default;
 
@@ -266,61 +136,29 @@ std::vector<ShaderDiskCachePrecompiled> ShaderDiskCacheOpenGL::LoadPrecompiled()
         return {};
     }
 
-    Common::FS::IOFile file(GetPrecompiledPath(), "rb");
-    if (!file.IsOpen()) {
-        LOG_INFO(Render_OpenGL, "No precompiled shader cache found");
-        return {};
+    std::vector<u8> decompressed;
+    {
+        // Map the compressed file instead of reading it, it's only needed to decompress it
+        const Common::FS::MappedFile file(GetPrecompiledPath());
+        if (!file.IsOpen()) {
+            LOG_INFO(Render_OpenGL, "No precompiled shader cache found");
+            return {};
+        }
+        decompressed = Common::Compression::DecompressDataZSTD(file.Data());
     }
 
-    if (const auto result = LoadPrecompiledFile(file)) {
-        return *result;
+    if (auto result = LoadPrecompiledFile(decompressed)) {
+        // New binaries are appended after the loaded ones
+        precompiled_cache_virtual_file_offset = decompressed.size();
+        precompiled_cache_virtual_file.Assign(std::move(decompressed));
+        return std::move(*result);
     }
 
     LOG_INFO(Render_OpenGL, "Failed to load precompiled cache");
-    file.Close();
     InvalidatePrecompiled();
     return {};
 }
 
-std::optional<std::vector<ShaderDiskCachePrecompiled>> ShaderDiskCacheOpenGL::LoadPrecompiledFile(
-    Common::FS::IOFile& file) {
-    // Read compressed file from disk and decompress to virtual precompiled cache file
-    std::vector<u8> compressed(file.GetSize());
-    file.ReadBytes(compressed.data(), compressed.size());
-    const std::vector<u8> decompressed = Common::Compression::DecompressDataZSTD(compressed);
-    SaveArrayToPrecompiled(decompressed.data(), decompressed.size());
-    precompiled_cache_virtual_file_offset = 0;
-
-    ShaderCacheVersionHash file_hash{};
-    if (!LoadArrayFromPrecompiled(file_hash.data(), file_hash.size())) {
-        precompiled_cache_virtual_file_offset = 0;
-        return std::nullopt;
-    }
-    if (GetShaderCacheVersionHash() != file_hash) {
-        LOG_INFO(Render_OpenGL, "Precompiled cache is from another version of the emulator");
-        precompiled_cache_virtual_file_offset = 0;
-        return std::nullopt;
-    }
-
-    std::vector<ShaderDiskCachePrecompiled> entries;
-    while (precompiled_cache_virtual_file_offset < precompiled_cache_virtual_file.GetSize()) {
-        u32 binary_size;
-        auto& entry = entries.emplace_back();
-        if (!LoadObjectFromPrecompiled(entry.unique_identifier) ||
-            !LoadObjectFromPrecompiled(entry.binary_format) ||
-            !LoadObjectFromPrecompiled(binary_size)) {
-            return std::nullopt;
-        }
-
-        entry.binary.resize(binary_size);
-        if (!LoadArrayFromPrecompiled(entry.binary.data(), entry.binary.size())) {
-            return std::nullopt;
-        }
-    }
-
-    return std::move(entries);
-}
-
 void ShaderDiskCacheOpenGL::InvalidateTransferable() {
     if (!Common::FS::Delete(GetTransferablePath())) {
         LOG_ERROR(Render_OpenGL, "Failed to invalidate transferable file={}",
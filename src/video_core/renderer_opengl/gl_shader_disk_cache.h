@@ -18,8 +18,7 @@
 #include "common/assert.h"
 #include "common/common_types.h"
 #include "core/file_sys/vfs_vector.h"
-#include "video_core/engines/shader_type.h"
-#include "video_core/shader/registry.h"
+#include "video_core/shader/disk_cache_entry.h"
 
 namespace Common::FS {
 class IOFile;
@@ -28,34 +27,7 @@ class IOFile;
 namespace OpenGL {
 
 using ProgramCode = std::vector<u64>;
-
-/// Describes a shader and how it's used by the guest GPU
-struct ShaderDiskCacheEntry {
-    ShaderDiskCacheEntry();
-    ~ShaderDiskCacheEntry();
-
-    bool Load(Common::FS::IOFile& file);
-
-    bool Save(Common::FS::IOFile& file) const;
-
-    bool HasProgramA() const {
-        return !code.empty() && !code_b.empty();
-    }
-
-    Tegra::Engines::ShaderType type{};
-    ProgramCode code;
-    ProgramCode code_b;
-
-    u64 unique_identifier = 0;
-    std::optional<u32> texture_handler_size;
-    u32 bound_buffer = 0;
-    VideoCommon::Shader::GraphicsInfo graphics_info;
-    VideoCommon::Shader::ComputeInfo compute_info;
-    VideoCommon::Shader::KeyMap keys;
-    VideoCommon::Shader::BoundSamplerMap bound_samplers;
-    VideoCommon::Shader::SeparateSamplerMap separate_samplers;
-    VideoCommon::Shader::BindlessSamplerMap bindless_samplers;
-};
+using VideoCommon::Shader::ShaderDiskCacheEntry;
 
 /// Contains an OpenGL dumped binary program
 struct ShaderDiskCachePrecompiled {
@@ -94,10 +66,6 @@ public:
     void SaveVirtualPrecompiledFile();
 
 private:
-    /// Loads the transferable cache. Returns empty on failure.
-    std::optional<std::vector<ShaderDiskCachePrecompiled>> LoadPrecompiledFile(
-        Common::FS::IOFile& file);
-
     /// Opens current game's transferable file and write it's header if it doesn't exist
     Common::FS::IOFile AppendTransferableFile() const;
 
@@ -133,14 +101,6 @@ private:
         return write_length == sizeof(T) * length;
     }
 
-    template <typename T>
-    bool LoadArrayFromPrecompiled(T* data, std::size_t length) {
-        const std::size_t read_length = precompiled_cache_virtual_file.ReadArray(
-            data, length, precompiled_cache_virtual_file_offset);
-        precompiled_cache_virtual_file_offset += read_length;
-        return read_length == sizeof(T) * length;
-    }
-
     template <typename T>
     bool SaveObjectToPrecompiled(const T& object) {
         return SaveArrayToPrecompiled(&object, 1);
@@ -151,11 +111,6 @@ private:
         return SaveArrayToPrecompiled(&value, 1);
     }
 
-    template <typename T>
-    bool LoadObjectFromPrecompiled(T& object) {
-        return LoadArrayFromPrecompiled(&object, 1);
-    }
-
     // Stores whole precompiled cache which will be read from or saved to the precompiled chache
     // file
     FileSys::VectorVfsFile precompiled_cache_virtual_file;
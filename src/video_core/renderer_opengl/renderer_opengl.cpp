@@ -143,6 +143,7 @@ void RendererOpenGL::SwapBuffers(const Tegra::FramebufferConfig* framebuffer) {
 
     PrepareRendertarget(framebuffer);
     RenderScreenshot();
+    RenderFrameRing();
 
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
     DrawScreen(emu_window.GetFramebufferLayout());
@@ -486,6 +487,42 @@ void RendererOpenGL::RenderScreenshot() {
     renderer_settings.screenshot_requested = false;
 }
 
+void RendererOpenGL::RenderFrameRing() {
+    if (!frame_ring.IsEnabled()) {
+        return;
+    }
+
+    GLint old_read_fb;
+    GLint old_draw_fb;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &old_read_fb);
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &old_draw_fb);
+
+    // Unlike screenshots the target is kept alive, it is only rebuilt when the output size changes
+    const Layout::FramebufferLayout layout = Layout::FrameLayoutFromResolutionScale(1);
+    if (frame_ring_framebuffer.handle == 0 || layout.width != frame_ring_layout.width ||
+        layout.height != frame_ring_layout.height) {
+        frame_ring_layout = layout;
+        frame_ring_renderbuffer.Release();
+        frame_ring_renderbuffer.Create();
+        glNamedRenderbufferStorage(frame_ring_renderbuffer.handle, GL_RGBA8, layout.width,
+                                   layout.height);
+        frame_ring_framebuffer.Release();
+        frame_ring_framebuffer.Create();
+        glNamedFramebufferRenderbuffer(frame_ring_framebuffer.handle, GL_COLOR_ATTACHMENT0,
+                                       GL_RENDERBUFFER, frame_ring_renderbuffer.handle);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, frame_ring_framebuffer.handle);
+    DrawScreen(layout);
+
+    u8* const pixels = frame_ring.BeginWrite(layout.width, layout.height);
+    glReadPixels(0, 0, layout.width, layout.height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    frame_ring.EndWrite();
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, old_read_fb);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, old_draw_fb);
+}
+
 bool RendererOpenGL::Init() {
     if (Settings::values.renderer_debug && GLAD_GL_KHR_debug) {
         glEnable(GL_DEBUG_OUTPUT);
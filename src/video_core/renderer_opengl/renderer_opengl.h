@@ -83,6 +83,9 @@ private:
 
     void RenderScreenshot();
 
+    /// Publishes the current frame to the frame ring if anyone is consuming it.
+    void RenderFrameRing();
+
     /// Loads framebuffer from emulated memory into the active OpenGL texture.
     void LoadFBToScreenInfo(const Tegra::FramebufferConfig& framebuffer);
 
@@ -107,6 +110,9 @@ private:
     OGLProgram fragment_program;
     OGLPipeline pipeline;
     OGLFramebuffer screenshot_framebuffer;
+    OGLFramebuffer frame_ring_framebuffer;
+    OGLRenderbuffer frame_ring_renderbuffer;
+    Layout::FramebufferLayout frame_ring_layout;
 
     // GPU address of the vertex buffer
     GLuint64EXT vertex_buffer_address = 0;
@@ -75,6 +75,7 @@ VKGraphicsPipeline::VKGraphicsPipeline(const VKDevice& device, VKScheduler& sche
                                        VKDescriptorPool& descriptor_pool,
                                        VKUpdateDescriptorQueue& update_descriptor_queue,
                                        VKRenderPassCache& renderpass_cache,
+                                       VkPipelineCache driver_cache,
                                        const GraphicsPipelineCacheKey& key,
                                        vk::Span<VkDescriptorSetLayoutBinding> bindings,
                                        const SPIRVProgram& program)
@@ -85,7 +86,7 @@ VKGraphicsPipeline::VKGraphicsPipeline(const VKDevice& device, VKScheduler& sche
       descriptor_template{CreateDescriptorUpdateTemplate(program)}, modules{CreateShaderModules(
                                                                         program)},
       renderpass{renderpass_cache.GetRenderPass(cache_key.renderpass_params)},
-      pipeline{CreatePipeline(cache_key.renderpass_params, program)} {}
+      pipeline{CreatePipeline(cache_key.renderpass_params, program, driver_cache)} {}
 
 VKGraphicsPipeline::~VKGraphicsPipeline() = default;
 
@@ -179,7 +180,8 @@ std::vector<vk::ShaderModule> VKGraphicsPipeline::CreateShaderModules(
 }
 
 vk::Pipeline VKGraphicsPipeline::CreatePipeline(const RenderPassParams& renderpass_params,
-                                                const SPIRVProgram& program) const {
+                                                const SPIRVProgram& program,
+                                                VkPipelineCache driver_cache) const {
     const auto& state = cache_key.fixed_state;
     const auto& viewport_swizzles = state.viewport_swizzles;
 
@@ -468,7 +470,7 @@ vk::Pipeline VKGraphicsPipeline::CreatePipeline(const RenderPassParams& renderpa
         .basePipelineHandle = nullptr,
         .basePipelineIndex = 0,
     };
-    return device.GetLogical().CreateGraphicsPipeline(ci);
+    return device.GetLogical().CreateGraphicsPipeline(ci, driver_cache);
 }
 
 } // namespace Vulkan
@@ -22,7 +22,9 @@ using Maxwell = Tegra::Engines::Maxwell3D::Regs;
 struct GraphicsPipelineCacheKey {
     RenderPassParams renderpass_params;
     u32 padding;
-    std::array<GPUVAddr, Maxwell::MaxShaderProgram> shaders;
+    /// Unique identifiers of the shaders, zero for disabled stages. Unlike guest addresses they
+    /// stay the same between boots, so keys can be stored in the disk cache.
+    std::array<u64, Maxwell::MaxShaderProgram> shaders;
     FixedPipelineState fixed_state;
 
     std::size_t Hash() const noexcept;
@@ -54,7 +56,7 @@ public:
     explicit VKGraphicsPipeline(const VKDevice& device, VKScheduler& scheduler,
                                 VKDescriptorPool& descriptor_pool,
                                 VKUpdateDescriptorQueue& update_descriptor_queue,
-                                VKRenderPassCache& renderpass_cache,
+                                VKRenderPassCache& renderpass_cache, VkPipelineCache driver_cache,
                                 const GraphicsPipelineCacheKey& key,
                                 vk::Span<VkDescriptorSetLayoutBinding> bindings,
                                 const SPIRVProgram& program);
@@ -90,7 +92,7 @@ private:
     std::vector<vk::ShaderModule> CreateShaderModules(const SPIRVProgram& program) const;
 
     vk::Pipeline CreatePipeline(const RenderPassParams& renderpass_params,
-                                const SPIRVProgram& program) const;
+                                const SPIRVProgram& program, VkPipelineCache driver_cache) const;
 
     const VKDevice& device;
     VKScheduler& scheduler;
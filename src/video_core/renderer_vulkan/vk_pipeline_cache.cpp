@@ -3,8 +3,12 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "common/microprofile.h"
@@ -37,8 +41,10 @@ MICROPROFILE_DECLARE(Vulkan_PipelineCache);
 using Tegra::Engines::ShaderType;
 using VideoCommon::Shader::GetShaderAddress;
 using VideoCommon::Shader::GetShaderCode;
+using VideoCommon::Shader::GetUniqueIdentifier;
 using VideoCommon::Shader::KERNEL_MAIN_OFFSET;
 using VideoCommon::Shader::ProgramCode;
+using VideoCommon::Shader::Registry;
 using VideoCommon::Shader::STAGE_MAIN_OFFSET;
 
 namespace {
@@ -115,6 +121,58 @@ u32 FillDescriptorLayout(const ShaderEntries& entries,
     return binding;
 }
 
+Registry MakeRegistry(const ShaderDiskCacheEntry& entry) {
+    const VideoCore::GuestDriverProfile guest_profile{entry.texture_handler_size};
+    const VideoCommon::Shader::SerializedRegistryInfo info{guest_profile, entry.bound_buffer,
+                                                           entry.graphics_info, entry.compute_info};
+    Registry registry(entry.type, info);
+    for (const auto& [address, value] : entry.keys) {
+        const auto [buffer, offset] = address;
+        registry.InsertKey(buffer, offset, value);
+    }
+    for (const auto& [offset, sampler] : entry.bound_samplers) {
+        registry.InsertBoundSampler(offset, sampler);
+    }
+    for (const auto& [key, sampler] : entry.separate_samplers) {
+        registry.InsertSeparateSampler(key.buffers, key.offsets, sampler);
+    }
+    for (const auto& [key, sampler] : entry.bindless_samplers) {
+        const auto [buffer, offset] = key;
+        registry.InsertBindlessSampler(buffer, offset, sampler);
+    }
+    return registry;
+}
+
+vk::PipelineCache CreateDriverCache(const VKDevice& device, const std::vector<u8>& data) {
+    return device.GetLogical().CreatePipelineCache({
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .initialDataSize = data.size(),
+        .pInitialData = data.data(),
+    });
+}
+
+/// Calls func for every index in [0, count), spread across one thread per core
+template <typename Func>
+void ParallelFor(std::size_t count, Func&& func) {
+    std::atomic_size_t next_index = 0;
+    const auto worker = [&] {
+        for (std::size_t index = next_index++; index < count; index = next_index++) {
+            func(index);
+        }
+    };
+    const std::size_t num_threads = std::max(1U, std::thread::hardware_concurrency());
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < std::min(num_threads, count); ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
 } // Anonymous namespace
 
 std::size_t GraphicsPipelineCacheKey::Hash() const noexcept {
@@ -135,15 +193,48 @@ bool ComputePipelineCacheKey::operator==(const ComputePipelineCacheKey& rhs) con
     return std::memcmp(&rhs, this, sizeof *this) == 0;
 }
 
-Shader::Shader(Tegra::Engines::ConstBufferEngineInterface& engine, Tegra::Engines::ShaderType stage,
+Shader::Shader(Tegra::Engines::ConstBufferEngineInterface& engine, ShaderType stage_,
                GPUVAddr gpu_addr_, VAddr cpu_addr, VideoCommon::Shader::ProgramCode program_code_,
                u32 main_offset)
-    : gpu_addr(gpu_addr_), program_code(std::move(program_code_)), registry(stage, engine),
+    : stage(stage_), gpu_addr(gpu_addr_),
+      unique_identifier(GetUniqueIdentifier(stage_, false, program_code_)),
+      program_code(std::move(program_code_)), registry(stage, engine),
       shader_ir(program_code, main_offset, compiler_settings, registry),
       entries(GenerateShaderEntries(shader_ir)) {}
 
+Shader::Shader(const ShaderDiskCacheEntry& entry)
+    : stage(entry.type), unique_identifier(entry.unique_identifier), program_code(entry.code),
+      registry(MakeRegistry(entry)),
+      shader_ir(program_code,
+                stage == ShaderType::Compute ? KERNEL_MAIN_OFFSET : STAGE_MAIN_OFFSET,
+                compiler_settings, registry),
+      entries(GenerateShaderEntries(shader_ir)) {}
+
 Shader::~Shader() = default;
 
+ShaderDiskCacheEntry Shader::MakeDiskCacheEntry() {
+    const VideoCore::GuestDriverProfile& guest_profile = registry.AccessGuestDriverProfile();
+
+    ShaderDiskCacheEntry entry;
+    entry.type = stage;
+    entry.code = program_code;
+    entry.unique_identifier = unique_identifier;
+    if (guest_profile.IsTextureHandlerSizeKnown()) {
+        entry.texture_handler_size = guest_profile.GetTextureHandlerSize();
+    }
+    entry.bound_buffer = registry.GetBoundBuffer();
+    if (stage == ShaderType::Compute) {
+        entry.compute_info = registry.GetComputeInfo();
+    } else {
+        entry.graphics_info = registry.GetGraphicsInfo();
+    }
+    entry.keys = registry.GetKeys();
+    entry.bound_samplers = registry.GetBoundSamplers();
+    entry.separate_samplers = registry.GetSeparateSamplers();
+    entry.bindless_samplers = registry.GetBindlessSamplers();
+    return entry;
+}
+
 VKPipelineCache::VKPipelineCache(RasterizerVulkan& rasterizer, Tegra::GPU& gpu_,
                                  Tegra::Engines::Maxwell3D& maxwell3d_,
                                  Tegra::Engines::KeplerCompute& kepler_compute_,
@@ -154,9 +245,13 @@ VKPipelineCache::VKPipelineCache(RasterizerVulkan& rasterizer, Tegra::GPU& gpu_,
     : VideoCommon::ShaderCache<Shader>{rasterizer}, gpu{gpu_}, maxwell3d{maxwell3d_},
       kepler_compute{kepler_compute_}, gpu_memory{gpu_memory_}, device{device_},
       scheduler{scheduler_}, descriptor_pool{descriptor_pool_},
-      update_descriptor_queue{update_descriptor_queue_}, renderpass_cache{renderpass_cache_} {}
+      update_descriptor_queue{update_descriptor_queue_}, renderpass_cache{renderpass_cache_},
+      driver_cache{CreateDriverCache(device, {})} {}
 
-VKPipelineCache::~VKPipelineCache() = default;
+VKPipelineCache::~VKPipelineCache() {
+    // Keep the pipelines built while playing for the next boot
+    SaveDriverCache();
+}
 
 std::array<Shader*, Maxwell::MaxShaderProgram> VKPipelineCache::GetShaders() {
     std::array<Shader*, Maxwell::MaxShaderProgram> shaders{};
@@ -213,7 +308,8 @@ VKGraphicsPipeline* VKPipelineCache::GetGraphicsPipeline(
         if (is_cache_miss) {
             gpu.ShaderNotify().MarkSharderBuilding();
             LOG_INFO(Render_Vulkan, "Compile 0x{:016X}", key.Hash());
-            const auto [program, bindings] = DecompileShaders(key.fixed_state);
+            const auto [program, bindings] = DecompileShaders(key.fixed_state, last_shaders);
+            SaveGraphicsPipeline(key, last_shaders);
             async_shaders.QueueVulkanShader(this, device, scheduler, descriptor_pool,
                                             update_descriptor_queue, renderpass_cache, bindings,
                                             program, key);
@@ -227,10 +323,11 @@ VKGraphicsPipeline* VKPipelineCache::GetGraphicsPipeline(
     if (is_cache_miss) {
         gpu.ShaderNotify().MarkSharderBuilding();
         LOG_INFO(Render_Vulkan, "Compile 0x{:016X}", key.Hash());
-        const auto [program, bindings] = DecompileShaders(key.fixed_state);
+        const auto [program, bindings] = DecompileShaders(key.fixed_state, last_shaders);
+        SaveGraphicsPipeline(key, last_shaders);
         entry = std::make_unique<VKGraphicsPipeline>(device, scheduler, descriptor_pool,
-                                                     update_descriptor_queue, renderpass_cache, key,
-                                                     bindings, program);
+                                                     update_descriptor_queue, renderpass_cache,
+                                                     *driver_cache, key, bindings, program);
         gpu.ShaderNotify().MarkShaderComplete();
     }
     last_graphics_pipeline = entry.get();
@@ -294,6 +391,82 @@ void VKPipelineCache::EmplacePipeline(std::unique_ptr<VKGraphicsPipeline> pipeli
     graphics_cache.at(pipeline->GetCacheKey()) = std::move(pipeline);
 }
 
+void VKPipelineCache::LoadDiskResources(u64 title_id, const std::atomic_bool& stop_loading,
+                                        const VideoCore::DiskResourceLoadCallback& callback) {
+    disk_cache.BindTitleID(title_id);
+    const std::optional transferable = disk_cache.LoadTransferable();
+    if (!transferable) {
+        return;
+    }
+    if (const std::vector<u8> data = disk_cache.LoadPrecompiled(); !data.empty()) {
+        // Nothing has been built with the empty cache yet, it can be replaced
+        driver_cache = CreateDriverCache(device, data);
+        saved_driver_cache_size = data.size();
+    }
+
+    // Keys filled for a device with a different extended dynamic state support never match
+    const bool has_extended_dynamic_state = device.IsExtExtendedDynamicStateSupported();
+    std::vector<const GraphicsPipelineCacheKey*> keys;
+    for (const GraphicsPipelineCacheKey& key : transferable->graphics_pipelines) {
+        if ((key.fixed_state.no_extended_dynamic_state == 0) == has_extended_dynamic_state) {
+            keys.push_back(&key);
+        }
+    }
+
+    // Inform the frontend about shader build initialization
+    if (callback) {
+        callback(VideoCore::LoadCallbackStage::Build, 0, keys.size());
+    }
+
+    // Shaders are shared between pipelines, rebuild their IR once
+    std::vector<std::unique_ptr<Shader>> shaders(transferable->shaders.size());
+    ParallelFor(shaders.size(), [&](std::size_t index) {
+        if (!stop_loading) {
+            shaders[index] = std::make_unique<Shader>(transferable->shaders[index]);
+        }
+    });
+    if (stop_loading) {
+        return;
+    }
+    std::unordered_map<u64, Shader*> shaders_by_id;
+    for (const auto& shader : shaders) {
+        shaders_by_id.emplace(shader->GetUniqueIdentifier(), shader.get());
+    }
+
+    std::size_t built_pipelines = 0; // Only used behind the pipeline cache mutex
+    ParallelFor(keys.size(), [&](std::size_t index) {
+        if (stop_loading) {
+            return;
+        }
+        const GraphicsPipelineCacheKey& key = *keys[index];
+        std::array<Shader*, Maxwell::MaxShaderProgram> key_shaders{};
+        for (std::size_t program = 0; program < Maxwell::MaxShaderProgram; ++program) {
+            if (key.shaders[program] == 0) {
+                continue;
+            }
+            const auto it = shaders_by_id.find(key.shaders[program]);
+            if (it == shaders_by_id.end()) {
+                LOG_ERROR(Render_Vulkan, "Pipeline 0x{:016X} uses a shader missing in the cache",
+                          key.Hash());
+                return;
+            }
+            key_shaders[program] = it->second;
+        }
+        const auto [program, bindings] = DecompileShaders(key.fixed_state, key_shaders);
+        auto pipeline = std::make_unique<VKGraphicsPipeline>(
+            device, scheduler, descriptor_pool, update_descriptor_queue, renderpass_cache,
+            *driver_cache, key, bindings, program);
+
+        std::scoped_lock lock{pipeline_cache};
+        graphics_cache.emplace(key, std::move(pipeline));
+        if (callback) {
+            callback(VideoCore::LoadCallbackStage::Build, ++built_pipelines, keys.size());
+        }
+    });
+
+    SaveDriverCache();
+}
+
 void VKPipelineCache::OnShaderRemoval(Shader* shader) {
     bool finished = false;
     const auto Finish = [&] {
@@ -306,10 +479,10 @@ void VKPipelineCache::OnShaderRemoval(Shader* shader) {
         scheduler.Finish();
     };
 
-    const GPUVAddr invalidated_addr = shader->GetGpuAddr();
+    const u64 invalidated_id = shader->GetUniqueIdentifier();
     for (auto it = graphics_cache.begin(); it != graphics_cache.end();) {
         auto& entry = it->first;
-        if (std::find(entry.shaders.begin(), entry.shaders.end(), invalidated_addr) ==
+        if (std::find(entry.shaders.begin(), entry.shaders.end(), invalidated_id) ==
             entry.shaders.end()) {
             ++it;
             continue;
@@ -317,6 +490,7 @@ void VKPipelineCache::OnShaderRemoval(Shader* shader) {
         Finish();
         it = graphics_cache.erase(it);
     }
+    const GPUVAddr invalidated_addr = shader->GetGpuAddr();
     for (auto it = compute_cache.begin(); it != compute_cache.end();) {
         auto& entry = it->first;
         if (entry.shader != invalidated_addr) {
@@ -329,7 +503,8 @@ void VKPipelineCache::OnShaderRemoval(Shader* shader) {
 }
 
 std::pair<SPIRVProgram, std::vector<VkDescriptorSetLayoutBinding>>
-VKPipelineCache::DecompileShaders(const FixedPipelineState& fixed_state) {
+VKPipelineCache::DecompileShaders(const FixedPipelineState& fixed_state,
+                                  const std::array<Shader*, Maxwell::MaxShaderProgram>& shaders) {
     Specialization specialization;
     if (fixed_state.dynamic_state.Topology() == Maxwell::PrimitiveTopology::Points ||
         device.IsExtExtendedDynamicStateSupported()) {
@@ -352,14 +527,11 @@ VKPipelineCache::DecompileShaders(const FixedPipelineState& fixed_state) {
         const auto program_enum = static_cast<Maxwell::ShaderProgram>(index);
 
         // Skip stages that are not enabled
-        if (!maxwell3d.regs.IsShaderConfigEnabled(index)) {
+        const Shader* const shader = shaders[index];
+        if (!shader) {
             continue;
         }
 
-        const GPUVAddr gpu_addr = GetShaderAddress(maxwell3d, program_enum);
-        const std::optional<VAddr> cpu_addr = gpu_memory.GpuToCpuAddress(gpu_addr);
-        Shader* const shader = cpu_addr ? TryGet(*cpu_addr) : null_shader.get();
-
         const std::size_t stage = index == 0 ? 0 : index - 1; // Stage indices are 0 - 5
         const ShaderType program_type = GetShaderType(program_enum);
         const auto& entries = shader->GetEntries();
@@ -380,6 +552,28 @@ VKPipelineCache::DecompileShaders(const FixedPipelineState& fixed_state) {
     return {std::move(program), std::move(bindings)};
 }
 
+void VKPipelineCache::SaveGraphicsPipeline(
+    const GraphicsPipelineCacheKey& key,
+    const std::array<Shader*, Maxwell::MaxShaderProgram>& shaders) {
+    // Building an entry copies the shader's code and registry, only do it for new shaders
+    for (Shader* const shader : shaders) {
+        if (shader && disk_cache.ShouldSaveShader(shader->GetUniqueIdentifier())) {
+            disk_cache.SaveShader(shader->MakeDiskCacheEntry());
+        }
+    }
+    disk_cache.SaveGraphicsPipeline(key);
+}
+
+void VKPipelineCache::SaveDriverCache() {
+    // Drivers only append to the cache, a different size means there are new pipelines
+    const std::vector<u8> data = driver_cache.GetData();
+    if (data.size() == saved_driver_cache_size) {
+        return;
+    }
+    disk_cache.SavePrecompiled(data);
+    saved_driver_cache_size = data.size();
+}
+
 template <VkDescriptorType descriptor_type, class Container>
 void AddEntry(std::vector<VkDescriptorUpdateTemplateEntry>& template_entries, u32& binding,
               u32& offset, const Container& container) {
@@ -5,8 +5,10 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <memory>
+#include <mutex>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
@@ -17,10 +19,12 @@
 #include "common/common_types.h"
 #include "video_core/engines/const_buffer_engine_interface.h"
 #include "video_core/engines/maxwell_3d.h"
+#include "video_core/rasterizer_interface.h"
 #include "video_core/renderer_vulkan/fixed_pipeline_state.h"
 #include "video_core/renderer_vulkan/vk_graphics_pipeline.h"
 #include "video_core/renderer_vulkan/vk_renderpass_cache.h"
 #include "video_core/renderer_vulkan/vk_shader_decompiler.h"
+#include "video_core/renderer_vulkan/vk_shader_disk_cache.h"
 #include "video_core/renderer_vulkan/wrapper.h"
 #include "video_core/shader/async_shaders.h"
 #include "video_core/shader/memory_util.h"
@@ -87,12 +91,23 @@ public:
     explicit Shader(Tegra::Engines::ConstBufferEngineInterface& engine,
                     Tegra::Engines::ShaderType stage, GPUVAddr gpu_addr, VAddr cpu_addr,
                     VideoCommon::Shader::ProgramCode program_code, u32 main_offset);
+
+    /// Builds a shader from the disk cache, it's not bound to any guest address
+    explicit Shader(const ShaderDiskCacheEntry& entry);
+
     ~Shader();
 
+    /// Describes the shader for the disk cache, with everything it has read from the engine
+    ShaderDiskCacheEntry MakeDiskCacheEntry();
+
     GPUVAddr GetGpuAddr() const {
         return gpu_addr;
     }
 
+    u64 GetUniqueIdentifier() const {
+        return unique_identifier;
+    }
+
     VideoCommon::Shader::ShaderIR& GetIR() {
         return shader_ir;
     }
@@ -110,7 +125,9 @@ public:
     }
 
 private:
+    Tegra::Engines::ShaderType stage{};
     GPUVAddr gpu_addr{};
+    u64 unique_identifier{};
     VideoCommon::Shader::ProgramCode program_code;
     VideoCommon::Shader::Registry registry;
     VideoCommon::Shader::ShaderIR shader_ir;
@@ -137,12 +154,29 @@ public:
 
     void EmplacePipeline(std::unique_ptr<VKGraphicsPipeline> pipeline);
 
+    /// Builds the graphics pipelines of the disk cache before the game starts
+    void LoadDiskResources(u64 title_id, const std::atomic_bool& stop_loading,
+                           const VideoCore::DiskResourceLoadCallback& callback);
+
+    /// Driver pipeline cache every pipeline is created with
+    VkPipelineCache GetDriverCache() const {
+        return *driver_cache;
+    }
+
 protected:
     void OnShaderRemoval(Shader* shader) final;
 
 private:
     std::pair<SPIRVProgram, std::vector<VkDescriptorSetLayoutBinding>> DecompileShaders(
-        const FixedPipelineState& fixed_state);
+        const FixedPipelineState& fixed_state,
+        const std::array<Shader*, Maxwell::MaxShaderProgram>& shaders);
+
+    /// Saves a new graphics pipeline and the shaders it uses to the disk cache
+    void SaveGraphicsPipeline(const GraphicsPipelineCacheKey& key,
+                              const std::array<Shader*, Maxwell::MaxShaderProgram>& shaders);
+
+    /// Writes the driver pipeline cache to disk when it has grown since the last time
+    void SaveDriverCache();
 
     Tegra::GPU& gpu;
     Tegra::Engines::Maxwell3D& maxwell3d;
@@ -155,6 +189,10 @@ private:
     VKUpdateDescriptorQueue& update_descriptor_queue;
     VKRenderPassCache& renderpass_cache;
 
+    VKShaderDiskCache disk_cache;
+    vk::PipelineCache driver_cache;
+    std::size_t saved_driver_cache_size = 0;
+
     std::unique_ptr<Shader> null_shader;
     std::unique_ptr<Shader> null_kernel;
 
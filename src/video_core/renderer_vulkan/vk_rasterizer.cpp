@@ -100,13 +100,13 @@ VkRect2D GetScissorState(const Maxwell& regs, std::size_t index) {
     return scissor;
 }
 
-std::array<GPUVAddr, Maxwell::MaxShaderProgram> GetShaderAddresses(
+std::array<u64, Maxwell::MaxShaderProgram> GetShaderIdentifiers(
     const std::array<Shader*, Maxwell::MaxShaderProgram>& shaders) {
-    std::array<GPUVAddr, Maxwell::MaxShaderProgram> addresses;
-    for (std::size_t i = 0; i < std::size(addresses); ++i) {
-        addresses[i] = shaders[i] ? shaders[i]->GetGpuAddr() : 0;
+    std::array<u64, Maxwell::MaxShaderProgram> identifiers;
+    for (std::size_t i = 0; i < std::size(identifiers); ++i) {
+        identifiers[i] = shaders[i] ? shaders[i]->GetUniqueIdentifier() : 0;
     }
-    return addresses;
+    return identifiers;
 }
 
 void TransitionImages(const std::vector<ImageView>& views, VkPipelineStageFlags pipeline_stage,
@@ -432,7 +432,7 @@ void RasterizerVulkan::Draw(bool is_indexed, bool is_instanced) {
     image_views.clear();
 
     const auto shaders = pipeline_cache.GetShaders();
-    key.shaders = GetShaderAddresses(shaders);
+    key.shaders = GetShaderIdentifiers(shaders);
     SetupShaderDescriptors(shaders);
 
     buffer_cache.Unmap();
@@ -744,6 +744,11 @@ bool RasterizerVulkan::AccelerateDisplay(const Tegra::FramebufferConfig& config,
     return true;
 }
 
+void RasterizerVulkan::LoadDiskResources(u64 title_id, const std::atomic_bool& stop_loading,
+                                         const VideoCore::DiskResourceLoadCallback& callback) {
+    pipeline_cache.LoadDiskResources(title_id, stop_loading, callback);
+}
+
 void RasterizerVulkan::FlushWork() {
     static constexpr u32 DRAWS_TO_DISPATCH = 4096;
 
@@ -29,6 +29,7 @@ VKRenderPassCache::VKRenderPassCache(const VKDevice& device) : device{device} {}
 VKRenderPassCache::~VKRenderPassCache() = default;
 
 VkRenderPass VKRenderPassCache::GetRenderPass(const RenderPassParams& params) {
+    std::scoped_lock lock{mutex};
     const auto [pair, is_cache_miss] = cache.try_emplace(params);
     auto& entry = pair->second;
     if (is_cache_miss) {
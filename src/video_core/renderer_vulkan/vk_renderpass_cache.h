@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <type_traits>
 #include <unordered_map>
 
@@ -64,6 +65,8 @@ private:
     vk::RenderPass CreateRenderPass(const RenderPassParams& params) const;
 
     const VKDevice& device;
+
+    std::mutex mutex; ///< Pipelines can be built from worker threads
     std::unordered_map<RenderPassParams, vk::RenderPass> cache;
 };
 
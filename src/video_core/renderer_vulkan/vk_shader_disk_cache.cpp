@@ -0,0 +1,297 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+
+#include <fmt/format.h>
+
+#include "common/common_paths.h"
+#include "common/common_types.h"
+#include "common/file_util.h"
+#include "common/logging/log.h"
+#include "common/zstd_compression.h"
+#include "core/settings.h"
+#include "video_core/renderer_vulkan/vk_shader_disk_cache.h"
+
+namespace Vulkan {
+
+namespace {
+
+enum class TransferableEntryType : u32 {
+    Shader,
+    GraphicsPipeline,
+};
+
+constexpr u32 NativeVersion = 1;
+
+bool LoadGraphicsPipelineKey(Common::FS::IOFile& file, GraphicsPipelineCacheKey& key) {
+    // Keys are stored without the dynamic state they don't use, see FixedPipelineState::Size
+    u32 size;
+    if (file.ReadBytes(&size, sizeof(size)) != sizeof(size) || size > sizeof(key)) {
+        return false;
+    }
+    std::memset(&key, 0, sizeof(key));
+    return file.ReadBytes(&key, size) == size && key.Size() == size;
+}
+
+bool SaveGraphicsPipelineKey(Common::FS::IOFile& file, const GraphicsPipelineCacheKey& key) {
+    const u32 size = static_cast<u32>(key.Size());
+    return file.WriteObject(TransferableEntryType::GraphicsPipeline) == 1 &&
+           file.WriteObject(size) == 1 && file.WriteBytes(&key, size) == size;
+}
+
+} // Anonymous namespace
+
+VKShaderDiskCache::VKShaderDiskCache() = default;
+
+VKShaderDiskCache::~VKShaderDiskCache() = default;
+
+void VKShaderDiskCache::BindTitleID(u64 title_id_) {
+    title_id = title_id_;
+}
+
+std::optional<ShaderDiskCacheTransferable> VKShaderDiskCache::LoadTransferable() {
+    // Skip games without title id
+    const bool has_title_id = title_id != 0;
+    if (!Settings::values.use_disk_shader_cache.GetValue() || !has_title_id) {
+        return std::nullopt;
+    }
+
+    Common::FS::IOFile file(GetTransferablePath(), "rb");
+    if (!file.IsOpen()) {
+        LOG_INFO(Render_Vulkan, "No transferable shader cache found");
+        is_usable = true;
+        return std::nullopt;
+    }
+
+    u32 version{};
+    if (file.ReadBytes(&version, sizeof(version)) != sizeof(version)) {
+        LOG_ERROR(Render_Vulkan, "Failed to get transferable cache version, skipping it");
+        return std::nullopt;
+    }
+
+    if (version < NativeVersion) {
+        LOG_INFO(Render_Vulkan, "Transferable shader cache is old, removing");
+        file.Close();
+        InvalidateTransferable();
+        is_usable = true;
+        return std::nullopt;
+    }
+    if (version > NativeVersion) {
+        LOG_WARNING(Render_Vulkan, "Transferable shader cache was generated with a newer version "
+                                   "of the emulator, skipping");
+        return std::nullopt;
+    }
+
+    // Version is valid, load the shaders and pipelines
+    ShaderDiskCacheTransferable transferable;
+    while (file.Tell() < file.GetSize()) {
+        TransferableEntryType type;
+        if (file.ReadBytes(&type, sizeof(type)) != sizeof(type)) {
+            LOG_ERROR(Render_Vulkan, "Failed to load transferable entry type, skipping");
+            return std::nullopt;
+        }
+        switch (type) {
+        case TransferableEntryType::Shader: {
+            ShaderDiskCacheEntry& entry = transferable.shaders.emplace_back();
+            if (!entry.Load(file)) {
+                LOG_ERROR(Render_Vulkan, "Failed to load transferable raw entry, skipping");
+                return std::nullopt;
+            }
+            stored_shaders.insert(entry.unique_identifier);
+            break;
+        }
+        case TransferableEntryType::GraphicsPipeline: {
+            GraphicsPipelineCacheKey& key = transferable.graphics_pipelines.emplace_back();
+            if (!LoadGraphicsPipelineKey(file, key)) {
+                LOG_ERROR(Render_Vulkan, "Failed to load transferable pipeline, skipping");
+                return std::nullopt;
+            }
+            stored_pipelines.insert(key.Hash());
+            break;
+        }
+        default:
+            LOG_ERROR(Render_Vulkan, "Unknown transferable entry type={}, skipping",
+                      static_cast<u32>(type));
+            return std::nullopt;
+        }
+    }
+
+    is_usable = true;
+    return {std::move(transferable)};
+}
+
+std::vector<u8> VKShaderDiskCache::LoadPrecompiled() {
+    if (!is_usable) {
+        return {};
+    }
+
+    Common::FS::IOFile file(GetPrecompiledPath(), "rb");
+    if (!file.IsOpen()) {
+        LOG_INFO(Render_Vulkan, "No precompiled pipeline cache found");
+        return {};
+    }
+
+    std::vector<u8> compressed(file.GetSize());
+    if (file.ReadBytes(compressed.data(), compressed.size()) == compressed.size()) {
+        std::vector<u8> data = Common::Compression::DecompressDataZSTD(compressed);
+        if (!data.empty()) {
+            return data;
+        }
+    }
+
+    LOG_INFO(Render_Vulkan, "Failed to load precompiled cache");
+    file.Close();
+    InvalidatePrecompiled();
+    return {};
+}
+
+void VKShaderDiskCache::InvalidateTransferable() {
+    if (!Common::FS::Delete(GetTransferablePath())) {
+        LOG_ERROR(Render_Vulkan, "Failed to invalidate transferable file={}",
+                  GetTransferablePath());
+    }
+    stored_shaders.clear();
+    stored_pipelines.clear();
+    InvalidatePrecompiled();
+}
+
+void VKShaderDiskCache::InvalidatePrecompiled() {
+    if (!Common::FS::Delete(GetPrecompiledPath())) {
+        LOG_ERROR(Render_Vulkan, "Failed to invalidate precompiled file={}", GetPrecompiledPath());
+    }
+}
+
+bool VKShaderDiskCache::ShouldSaveShader(u64 unique_identifier) const {
+    return is_usable && !stored_shaders.contains(unique_identifier);
+}
+
+void VKShaderDiskCache::SaveShader(const ShaderDiskCacheEntry& entry) {
+    const u64 id = entry.unique_identifier;
+    if (!ShouldSaveShader(id)) {
+        return;
+    }
+
+    Common::FS::IOFile file = AppendTransferableFile();
+    if (!file.IsOpen()) {
+        return;
+    }
+    if (file.WriteObject(TransferableEntryType::Shader) != 1 || !entry.Save(file)) {
+        LOG_ERROR(Render_Vulkan, "Failed to save raw transferable cache entry, removing");
+        file.Close();
+        InvalidateTransferable();
+        return;
+    }
+
+    stored_shaders.insert(id);
+}
+
+void VKShaderDiskCache::SaveGraphicsPipeline(const GraphicsPipelineCacheKey& key) {
+    if (!is_usable) {
+        return;
+    }
+
+    const u64 hash = key.Hash();
+    if (stored_pipelines.find(hash) != stored_pipelines.end()) {
+        // The pipeline already exists
+        return;
+    }
+
+    Common::FS::IOFile file = AppendTransferableFile();
+    if (!file.IsOpen()) {
+        return;
+    }
+    if (!SaveGraphicsPipelineKey(file, key)) {
+        LOG_ERROR(Render_Vulkan, "Failed to save transferable pipeline, removing");
+        file.Close();
+        InvalidateTransferable();
+        return;
+    }
+
+    stored_pipelines.insert(hash);
+}
+
+void VKShaderDiskCache::SavePrecompiled(const std::vector<u8>& data) {
+    if (!is_usable || !EnsureDirectories()) {
+        return;
+    }
+
+    const std::vector<u8> compressed =
+        Common::Compression::CompressDataZSTDDefault(data.data(), data.size());
+
+    const auto precompiled_path{GetPrecompiledPath()};
+    Common::FS::IOFile file(precompiled_path, "wb");
+
+    if (!file.IsOpen()) {
+        LOG_ERROR(Render_Vulkan, "Failed to open precompiled cache in path={}", precompiled_path);
+        return;
+    }
+    if (file.WriteBytes(compressed.data(), compressed.size()) != compressed.size()) {
+        LOG_ERROR(Render_Vulkan, "Failed to write precompiled cache in path={}", precompiled_path);
+    }
+}
+
+Common::FS::IOFile VKShaderDiskCache::AppendTransferableFile() const {
+    if (!EnsureDirectories()) {
+        return {};
+    }
+
+    const auto transferable_path{GetTransferablePath()};
+    const bool existed = Common::FS::Exists(transferable_path);
+
+    Common::FS::IOFile file(transferable_path, "ab");
+    if (!file.IsOpen()) {
+        LOG_ERROR(Render_Vulkan, "Failed to open transferable cache in path={}", transferable_path);
+        return {};
+    }
+    if (!existed || file.GetSize() == 0) {
+        // If the file didn't exist, write its version
+        if (file.WriteObject(NativeVersion) != 1) {
+            LOG_ERROR(Render_Vulkan, "Failed to write transferable cache version in path={}",
+                      transferable_path);
+            return {};
+        }
+    }
+    return file;
+}
+
+bool VKShaderDiskCache::EnsureDirectories() const {
+    const auto CreateDir = [](const std::string& dir) {
+        if (!Common::FS::CreateDir(dir)) {
+            LOG_ERROR(Render_Vulkan, "Failed to create directory={}", dir);
+            return false;
+        }
+        return true;
+    };
+
+    return CreateDir(Common::FS::GetUserPath(Common::FS::UserPath::ShaderDir)) &&
+           CreateDir(GetBaseDir()) && CreateDir(GetTransferableDir()) &&
+           CreateDir(GetPrecompiledDir());
+}
+
+std::string VKShaderDiskCache::GetTransferablePath() const {
+    return Common::FS::SanitizePath(GetTransferableDir() + DIR_SEP_CHR + GetTitleID() + ".bin");
+}
+
+std::string VKShaderDiskCache::GetPrecompiledPath() const {
+    return Common::FS::SanitizePath(GetPrecompiledDir() + DIR_SEP_CHR + GetTitleID() + ".bin");
+}
+
+std::string VKShaderDiskCache::GetTransferableDir() const {
+    return GetBaseDir() + DIR_SEP "transferable";
+}
+
+std::string VKShaderDiskCache::GetPrecompiledDir() const {
+    return GetBaseDir() + DIR_SEP "precompiled";
+}
+
+std::string VKShaderDiskCache::GetBaseDir() const {
+    return Common::FS::GetUserPath(Common::FS::UserPath::ShaderDir) + DIR_SEP "vulkan";
+}
+
+std::string VKShaderDiskCache::GetTitleID() const {
+    return fmt::format("{:016X}", title_id);
+}
+
+} // namespace Vulkan
@@ -0,0 +1,106 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "common/common_types.h"
+#include "video_core/renderer_vulkan/vk_graphics_pipeline.h"
+#include "video_core/shader/disk_cache_entry.h"
+
+namespace Common::FS {
+class IOFile;
+}
+
+namespace Vulkan {
+
+using VideoCommon::Shader::ShaderDiskCacheEntry;
+
+/// Guest shaders and the graphics pipelines built from them, in the order they were found
+struct ShaderDiskCacheTransferable {
+    std::vector<ShaderDiskCacheEntry> shaders;
+    std::vector<GraphicsPipelineCacheKey> graphics_pipelines;
+};
+
+/**
+ * Disk cache of the Vulkan backend. The transferable file holds guest shaders and the keys of the
+ * graphics pipelines that used them, so every pipeline can be rebuilt at boot. Shaders in the keys
+ * are referenced by their unique identifier. The precompiled file holds the driver's pipeline
+ * cache, which is only a hint: drivers ignore the data of other devices and versions.
+ */
+class VKShaderDiskCache {
+public:
+    explicit VKShaderDiskCache();
+    ~VKShaderDiskCache();
+
+    /// Binds a title ID for all future operations.
+    void BindTitleID(u64 title_id);
+
+    /// Loads transferable cache. If file has a old version or on failure, it deletes the file.
+    std::optional<ShaderDiskCacheTransferable> LoadTransferable();
+
+    /// Loads current game's driver pipeline cache. Returns empty when there is none.
+    std::vector<u8> LoadPrecompiled();
+
+    /// Removes the transferable (and precompiled) cache file.
+    void InvalidateTransferable();
+
+    /// Removes the precompiled cache file.
+    void InvalidatePrecompiled();
+
+    /// Returns true when a shader is not in the transferable file yet and can be saved to it.
+    [[nodiscard]] bool ShouldSaveShader(u64 unique_identifier) const;
+
+    /// Saves a shader to the transferable file, unless it's already there.
+    void SaveShader(const ShaderDiskCacheEntry& entry);
+
+    /// Saves a graphics pipeline to the transferable file. Its shaders have to be saved first.
+    void SaveGraphicsPipeline(const GraphicsPipelineCacheKey& key);
+
+    /// Replaces the precompiled file with the given driver pipeline cache.
+    void SavePrecompiled(const std::vector<u8>& data);
+
+private:
+    /// Opens current game's transferable file and write it's header if it doesn't exist
+    Common::FS::IOFile AppendTransferableFile() const;
+
+    /// Create shader disk cache directories. Returns true on success.
+    bool EnsureDirectories() const;
+
+    /// Gets current game's transferable file path
+    std::string GetTransferablePath() const;
+
+    /// Gets current game's precompiled file path
+    std::string GetPrecompiledPath() const;
+
+    /// Get user's transferable directory path
+    std::string GetTransferableDir() const;
+
+    /// Get user's precompiled directory path
+    std::string GetPrecompiledDir() const;
+
+    /// Get user's shader directory path
+    std::string GetBaseDir() const;
+
+    /// Get current game's title id
+    std::string GetTitleID() const;
+
+    // Stored transferable shaders
+    std::unordered_set<u64> stored_shaders;
+
+    // Hashes of the stored transferable pipelines
+    std::unordered_set<u64> stored_pipelines;
+
+    /// Title ID to operate on
+    u64 title_id = 0;
+
+    // The cache has been loaded at boot
+    bool is_usable = false;
+};
+
+} // namespace Vulkan
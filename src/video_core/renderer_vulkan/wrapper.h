@@ -230,6 +230,7 @@ struct DeviceDispatch : public InstanceDispatch {
     PFN_vkCreateGraphicsPipelines vkCreateGraphicsPipelines;
     PFN_vkCreateImage vkCreateImage;
     PFN_vkCreateImageView vkCreateImageView;
+    PFN_vkCreatePipelineCache vkCreatePipelineCache;
     PFN_vkCreatePipelineLayout vkCreatePipelineLayout;
     PFN_vkCreateQueryPool vkCreateQueryPool;
     PFN_vkCreateRenderPass vkCreateRenderPass;
@@ -249,6 +250,7 @@ struct DeviceDispatch : public InstanceDispatch {
     PFN_vkDestroyImage vkDestroyImage;
     PFN_vkDestroyImageView vkDestroyImageView;
     PFN_vkDestroyPipeline vkDestroyPipeline;
+    PFN_vkDestroyPipelineCache vkDestroyPipelineCache;
     PFN_vkDestroyPipelineLayout vkDestroyPipelineLayout;
     PFN_vkDestroyQueryPool vkDestroyQueryPool;
     PFN_vkDestroyRenderPass vkDestroyRenderPass;
@@ -266,6 +268,7 @@ struct DeviceDispatch : public InstanceDispatch {
     PFN_vkGetEventStatus vkGetEventStatus;
     PFN_vkGetFenceStatus vkGetFenceStatus;
     PFN_vkGetImageMemoryRequirements vkGetImageMemoryRequirements;
+    PFN_vkGetPipelineCacheData vkGetPipelineCacheData;
     PFN_vkGetQueryPoolResults vkGetQueryPoolResults;
     PFN_vkGetSemaphoreCounterValueKHR vkGetSemaphoreCounterValueKHR;
     PFN_vkMapMemory vkMapMemory;
@@ -303,6 +306,7 @@ void Destroy(VkDevice, VkFramebuffer, const DeviceDispatch&) noexcept;
 void Destroy(VkDevice, VkImage, const DeviceDispatch&) noexcept;
 void Destroy(VkDevice, VkImageView, const DeviceDispatch&) noexcept;
 void Destroy(VkDevice, VkPipeline, const DeviceDispatch&) noexcept;
+void Destroy(VkDevice, VkPipelineCache, const DeviceDispatch&) noexcept;
 void Destroy(VkDevice, VkPipelineLayout, const DeviceDispatch&) noexcept;
 void Destroy(VkDevice, VkQueryPool, const DeviceDispatch&) noexcept;
 void Destroy(VkDevice, VkRenderPass, const DeviceDispatch&) noexcept;
@@ -667,6 +671,13 @@ public:
     std::vector<VkImage> GetImages() const;
 };
 
+class PipelineCache : public Handle<VkPipelineCache, VkDevice, DeviceDispatch> {
+    using Handle<VkPipelineCache, VkDevice, DeviceDispatch>::Handle;
+
+public:
+    std::vector<u8> GetData() const;
+};
+
 class Event : public Handle<VkEvent, VkDevice, DeviceDispatch> {
     using Handle<VkEvent, VkDevice, DeviceDispatch>::Handle;
 
@@ -746,7 +757,10 @@ public:
 
     PipelineLayout CreatePipelineLayout(const VkPipelineLayoutCreateInfo& ci) const;
 
-    Pipeline CreateGraphicsPipeline(const VkGraphicsPipelineCreateInfo& ci) const;
+    PipelineCache CreatePipelineCache(const VkPipelineCacheCreateInfo& ci) const;
+
+    Pipeline CreateGraphicsPipeline(const VkGraphicsPipelineCreateInfo& ci,
+                                    VkPipelineCache cache = nullptr) const;
 
     Pipeline CreateComputePipeline(const VkComputePipelineCreateInfo& ci) const;
 
@@ -210,8 +210,8 @@ void AsyncShaders::ShaderCompilerThread(Core::Frontend::GraphicsContext* context
         } else if (work.backend == Backend::Vulkan) {
             auto pipeline = std::make_unique<Vulkan::VKGraphicsPipeline>(
                 *work.vk_device, *work.scheduler, *work.descriptor_pool,
-                *work.update_descriptor_queue, *work.renderpass_cache, work.key, work.bindings,
-                work.program);
+                *work.update_descriptor_queue, *work.renderpass_cache,
+                work.pp_cache->GetDriverCache(), work.key, work.bindings, work.program);
 
             work.pp_cache->EmplacePipeline(std::move(pipeline));
         }
@@ -136,6 +136,14 @@ void Registry::InsertBoundSampler(u32 offset, SamplerDescriptor sampler) {
     bound_samplers.insert_or_assign(offset, sampler);
 }
 
+void Registry::InsertSeparateSampler(std::pair<u32, u32> buffers, std::pair<u32, u32> offsets,
+                                     SamplerDescriptor sampler) {
+    SeparateSamplerKey key;
+    key.buffers = buffers;
+    key.offsets = offsets;
+    separate_samplers.insert_or_assign(key, sampler);
+}
+
 void Registry::InsertBindlessSampler(u32 buffer, u32 offset, SamplerDescriptor sampler) {
     bindless_samplers.insert_or_assign({buffer, offset}, sampler);
 }
@@ -115,6 +115,10 @@ public:
     /// Inserts a bound sampler key.
     void InsertBoundSampler(u32 offset, Tegra::Engines::SamplerDescriptor sampler);
 
+    /// Inserts a separate sampler key.
+    void InsertSeparateSampler(std::pair<u32, u32> buffers, std::pair<u32, u32> offsets,
+                               Tegra::Engines::SamplerDescriptor sampler);
+
     /// Inserts a bindless sampler key.
     void InsertBindlessSampler(u32 buffer, u32 offset, Tegra::Engines::SamplerDescriptor sampler);
 
@@ -141,6 +145,11 @@ public:
         return bound_samplers;
     }
 
+    /// Gets separate samplers database.
+    const SeparateSamplerMap& GetSeparateSamplers() const {
+        return separate_samplers;
+    }
+
     /// Gets bindless samplers database.
     const BindlessSamplerMap& GetBindlessSamplers() const {
         return bindless_samplers;
@@ -20,6 +20,10 @@ namespace Tegra {
 class MemoryManager;
 }
 
+namespace Tegra::Texture::ASTC {
+class DecodeCache;
+}
+
 namespace VideoCommon {
 
 using VideoCore::MortonSwizzleMode;
@@ -60,7 +64,8 @@ private:
 
 class SurfaceBaseImpl {
 public:
-    void LoadBuffer(Tegra::MemoryManager& memory_manager, StagingCache& staging_cache);
+    void LoadBuffer(Tegra::MemoryManager& memory_manager, StagingCache& staging_cache,
+                    Tegra::Texture::ASTC::DecodeCache& astc_cache);
 
     void FlushBuffer(Tegra::MemoryManager& memory_manager, StagingCache& staging_cache);
 
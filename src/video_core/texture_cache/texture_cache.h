@@ -37,6 +37,7 @@
 #include "video_core/texture_cache/surface_base.h"
 #include "video_core/texture_cache/surface_params.h"
 #include "video_core/texture_cache/surface_view.h"
+#include "video_core/textures/astc.h"
 
 namespace Tegra::Texture {
 struct FullTextureInfo;
@@ -1105,7 +1106,7 @@ private:
 
     void LoadSurface(const TSurface& surface) {
         staging_cache.GetBuffer(0).resize(surface->GetHostSizeInBytes());
-        surface->LoadBuffer(gpu_memory, staging_cache);
+        surface->LoadBuffer(gpu_memory, staging_cache, astc_cache);
         surface->UploadTexture(staging_cache.GetBuffer(0));
         surface->MarkAsModified(false, Tick());
     }
@@ -1298,6 +1299,7 @@ private:
     std::list<std::shared_ptr<std::list<TSurface>>> committed_flushes;
 
     StagingCache staging_cache;
+    Tegra::Texture::ASTC::DecodeCache astc_cache;
     std::recursive_mutex mutex;
 };
 
@@ -18,13 +18,20 @@
 #include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <iterator>
 #include <vector>
 
 #include <boost/container/static_vector.hpp>
 
+#ifdef ARCHITECTURE_x86_64
+#include <emmintrin.h>
+#endif
+
+#include "common/cityhash.h"
 #include "common/common_types.h"
 
 #include "video_core/textures/astc.h"
+#include "video_core/textures/workers.h"
 
 namespace {
 
@@ -60,20 +67,25 @@ public:
     }
 
     constexpr u32 ReadBits(std::size_t nBits) {
+        // Take as many bits as possible out of each byte instead of going bit by bit
         u32 ret = 0;
-        for (std::size_t i = 0; i < nBits; ++i) {
-            ret |= (ReadBit() & 1) << i;
+        for (std::size_t shift = 0; shift < nBits;) {
+            const std::size_t amount = std::min(nBits - shift, 8 - next_bit);
+            ret |= ((*cur_byte >> next_bit) & ((1U << amount) - 1)) << shift;
+            shift += amount;
+            next_bit += amount;
+            if (next_bit == 8) {
+                next_bit = 0;
+                cur_byte++;
+            }
         }
+        bits_read += nBits;
         return ret;
     }
 
     template <std::size_t nBits>
     constexpr u32 ReadBits() {
-        u32 ret = 0;
-        for (std::size_t i = 0; i < nBits; ++i) {
-            ret |= (ReadBit() & 1) << i;
-        }
-        return ret;
+        return ReadBits(nBits);
     }
 
 private:
@@ -671,11 +683,6 @@ static constexpr auto MakeReplicateTable() {
     return table;
 }
 
-static constexpr auto REPLICATE_BYTE_TO_16_TABLE = MakeReplicateTable<u32, 8, 16>();
-static constexpr u32 ReplicateByteTo16(std::size_t value) {
-    return REPLICATE_BYTE_TO_16_TABLE[value];
-}
-
 static constexpr auto REPLICATE_BIT_TO_7_TABLE = MakeReplicateTable<u32, 1, 7>();
 static constexpr u32 ReplicateBitTo7(std::size_t value) {
     return REPLICATE_BIT_TO_7_TABLE[value];
@@ -1438,6 +1445,36 @@ static void ComputeEndpos32s(Pixel& ep1, Pixel& ep2, const u32*& colorValues,
 #undef READ_INT_VALUES
 }
 
+// The spec interpolates the endpoints expanded to 16 bits, C = (C0 * (64 - w) + C1 * w + 32) / 64,
+// and the result is scaled back to 8 bits with rounding. Expanding to 16 bits multiplies by 257,
+// so the products fit in 16-bit lanes before the expansion.
+#ifdef ARCHITECTURE_x86_64
+// Interpolates every channel of a texel at once. Endpoints are interleaved 16-bit lanes in output
+// byte order (ep1.R, ep2.R, ep1.G, ...) and weights are the matching (64 - w, w) pairs.
+static u32 InterpolateTexelSSE2(__m128i endpoints, __m128i weights) {
+    const __m128i mixed = _mm_madd_epi16(endpoints, weights);
+    const __m128i expanded = _mm_add_epi32(_mm_slli_epi32(mixed, 8), mixed);
+    const __m128i C = _mm_srli_epi32(_mm_add_epi32(expanded, _mm_set1_epi32(32)), 6);
+    const __m128i scaled = _mm_sub_epi32(_mm_slli_epi32(C, 8), C);
+    const __m128i result = _mm_srli_epi32(_mm_add_epi32(scaled, _mm_set1_epi32(32768)), 16);
+    const __m128i words = _mm_packs_epi32(result, result);
+    return static_cast<u32>(_mm_cvtsi128_si32(_mm_packus_epi16(words, words)));
+}
+#else
+// Interpolates every channel of a texel. Endpoints are the 8-bit values of each channel in output
+// byte order (R, G, B, A), the weights go from 0 to 64.
+static u32 InterpolateTexel(const std::array<u8, 4>& ep1, const std::array<u8, 4>& ep2,
+                            const std::array<u32, 4>& weights) {
+    u32 texel = 0;
+    for (u32 c = 0; c < 4; c++) {
+        const u32 mixed = ep1[c] * (64 - weights[c]) + ep2[c] * weights[c];
+        const u32 C = (mixed * 257 + 32) / 64;
+        texel |= ((C * 255 + 32768) >> 16) << (c * 8);
+    }
+    return texel;
+}
+#endif
+
 static void DecompressBlock(const u8 inBuf[16], const u32 blockWidth, const u32 blockHeight,
                             u32* outBuf) {
     InputBitStream strm(inBuf);
@@ -1634,55 +1671,74 @@ static void DecompressBlock(const u8 inBuf[16], const u32 blockWidth, const u32
     u32 weights[2][144];
     UnquantizeTexelWeights(weights, texelWeightValues, weightParams, blockWidth, blockHeight);
 
-    // Now that we have endpos32s and weights, we can s32erpolate and generate
+    // Endpoints in output byte order, pixels store their channels as A, R, G, B. Not every
+    // endpoint mode clamps its results to a byte.
+    std::array<std::array<u8, 4>, 4> ep1{};
+    std::array<std::array<u8, 4>, 4> ep2{};
+    const auto to_byte = [](s16 value) { return static_cast<u8>(std::clamp<s16>(value, 0, 255)); };
+    for (u32 i = 0; i < nPartitions; i++) {
+        for (u32 c = 0; c < 4; c++) {
+            ep1[i][c] = to_byte(endpos32s[i][0].Component((c + 1) & 3));
+            ep2[i][c] = to_byte(endpos32s[i][1].Component((c + 1) & 3));
+        }
+    }
+    // Output channel that uses the second plane of weights
+    const u32 dualPlaneChannel = weightParams.m_bDualPlane ? static_cast<u32>(planeIdx) : 4;
+
+#ifdef ARCHITECTURE_x86_64
+    __m128i endpoints[4];
+    for (u32 i = 0; i < nPartitions; i++) {
+        endpoints[i] = _mm_setr_epi16(ep1[i][0], ep2[i][0], ep1[i][1], ep2[i][1], ep1[i][2],
+                                      ep2[i][2], ep1[i][3], ep2[i][3]);
+    }
+#endif
+
+    // Now that we have endpoints and weights, we can interpolate and generate
     // the proper decoding...
-    for (u32 j = 0; j < blockHeight; j++)
+    for (u32 j = 0; j < blockHeight; j++) {
         for (u32 i = 0; i < blockWidth; i++) {
-            u32 partition = Select2DPartition(partitionIndex, i, j, nPartitions,
-                                              (blockHeight * blockWidth) < 32);
+            const u32 partition = Select2DPartition(partitionIndex, i, j, nPartitions,
+                                                    (blockHeight * blockWidth) < 32);
             assert(partition < nPartitions);
 
-            Pixel p;
-            for (u32 c = 0; c < 4; c++) {
-                u32 C0 = endpos32s[partition][0].Component(c);
-                C0 = ReplicateByteTo16(C0);
-                u32 C1 = endpos32s[partition][1].Component(c);
-                C1 = ReplicateByteTo16(C1);
-
-                u32 plane = 0;
-                if (weightParams.m_bDualPlane && (((planeIdx + 1) & 3) == c)) {
-                    plane = 1;
-                }
-
-                u32 weight = weights[plane][j * blockWidth + i];
-                u32 C = (C0 * (64 - weight) + C1 * weight + 32) / 64;
-                if (C == 65535) {
-                    p.Component(c) = 255;
-                } else {
-                    double Cf = static_cast<double>(C);
-                    p.Component(c) = static_cast<u16>(255.0 * (Cf / 65536.0) + 0.5);
-                }
+            std::array<u32, 4> texelWeights;
+            texelWeights.fill(weights[0][j * blockWidth + i]);
+            if (dualPlaneChannel < 4) {
+                texelWeights[dualPlaneChannel] = weights[1][j * blockWidth + i];
             }
 
-            outBuf[j * blockWidth + i] = p.Pack();
+#ifdef ARCHITECTURE_x86_64
+            const auto pair = [&](u32 c) {
+                return static_cast<int>((texelWeights[c] << 16) | (64 - texelWeights[c]));
+            };
+            outBuf[j * blockWidth + i] = InterpolateTexelSSE2(
+                endpoints[partition], _mm_setr_epi32(pair(0), pair(1), pair(2), pair(3)));
+#else
+            outBuf[j * blockWidth + i] =
+                InterpolateTexel(ep1[partition], ep2[partition], texelWeights);
+#endif
         }
+    }
 }
 
 } // namespace ASTCC
 
 namespace Tegra::Texture::ASTC {
 
-std::vector<u8> Decompress(const u8* data, u32 width, u32 height, u32 depth, u32 block_width,
-                           u32 block_height) {
-    u32 blockIdx = 0;
-    std::size_t depth_offset = 0;
-    std::vector<u8> outData(height * width * depth * 4);
-    for (u32 k = 0; k < depth; k++) {
-        for (u32 j = 0; j < height; j += block_height) {
+void Decompress(const u8* data, u32 width, u32 height, u32 depth, u32 block_width,
+                u32 block_height, u8* output) {
+    const u32 blocks_x = (width + block_width - 1) / block_width;
+    const u32 blocks_y = (height + block_height - 1) / block_height;
+    const std::size_t row_size = std::size_t{width} * block_height * 4;
+
+    // Rows of blocks decode independently of each other
+    const auto decompress_rows = [&](u32 first_row, u32 last_row) {
+        for (u32 row = first_row; row < last_row; row++) {
+            const u32 k = row / blocks_y;
+            const u32 j = (row % blocks_y) * block_height;
+            const u8* blockPtr = data + std::size_t{row} * blocks_x * 16;
+            u8* const depthPtr = output + std::size_t{k} * height * width * 4;
             for (u32 i = 0; i < width; i += block_width) {
-
-                const u8* blockPtr = data + blockIdx * 16;
-
                 // Blocks can be at most 12x12
                 u32 uncompData[144];
                 ASTCC::DecompressBlock(blockPtr, block_width, block_height, uncompData);
@@ -1690,18 +1746,85 @@ std::vector<u8> Decompress(const u8* data, u32 width, u32 height, u32 depth, u32
                 u32 decompWidth = std::min(block_width, width - i);
                 u32 decompHeight = std::min(block_height, height - j);
 
-                u8* outRow = depth_offset + outData.data() + (j * width + i) * 4;
+                u8* outRow = depthPtr + (j * width + i) * 4;
                 for (u32 jj = 0; jj < decompHeight; jj++) {
                     memcpy(outRow + jj * width * 4, uncompData + jj * block_width, decompWidth * 4);
                 }
 
-                blockIdx++;
+                blockPtr += 16;
             }
         }
-        depth_offset += height * width * 4;
-    }
+    };
+    const u32 num_rows = blocks_y * depth;
+    ForEachRowRange(num_rows, row_size * num_rows, decompress_rows);
+}
 
+std::vector<u8> Decompress(const u8* data, u32 width, u32 height, u32 depth, u32 block_width,
+                           u32 block_height) {
+    std::vector<u8> outData(std::size_t{height} * width * depth * 4);
+    Decompress(data, width, height, depth, block_width, block_height, outData.data());
     return outData;
 }
 
+DecodeCache::DecodeCache(std::size_t max_size_) : max_size{max_size_} {}
+
+DecodeCache::~DecodeCache() = default;
+
+void DecodeCache::Decompress(const u8* data, u32 width, u32 height, u32 depth, u32 block_width,
+                             u32 block_height, u8* output) {
+    const std::size_t blocks_x = (width + block_width - 1) / block_width;
+    const std::size_t blocks_y = (height + block_height - 1) / block_height;
+    const std::size_t input_size = blocks_x * blocks_y * depth * 16;
+    const std::size_t output_size = std::size_t{width} * height * depth * 4;
+    const Key key{
+        .hash = Common::CityHash64(reinterpret_cast<const char*>(data), input_size),
+        .width = width,
+        .height = height,
+        .depth = depth,
+        .block_width = block_width,
+        .block_height = block_height,
+    };
+
+    if (const auto it = entries.find(key); it != entries.end()) {
+        const Entry& entry = *it->second;
+        if (std::memcmp(entry.input.data(), data, input_size) == 0) {
+            std::memcpy(output, entry.output.data(), output_size);
+            lru.splice(lru.begin(), lru, it->second);
+            return;
+        }
+        // Different blocks with the same hash, the newer ones replace them
+        Erase(it->second);
+    }
+
+    ASTC::Decompress(data, width, height, depth, block_width, block_height, output);
+
+    // A single texture shouldn't push out everything else
+    const std::size_t entry_size = input_size + output_size;
+    if (entry_size > max_size / 4) {
+        return;
+    }
+    lru.push_front(Entry{
+        .key = key,
+        .input = std::vector<u8>(data, data + input_size),
+        .output = std::vector<u8>(output, output + output_size),
+    });
+    entries.emplace(key, lru.begin());
+    total_size += entry_size;
+    while (total_size > max_size) {
+        Erase(std::prev(lru.end()));
+    }
+}
+
+void DecodeCache::Clear() {
+    entries.clear();
+    lru.clear();
+    total_size = 0;
+}
+
+void DecodeCache::Erase(std::list<Entry>::iterator it) {
+    total_size -= it->input.size() + it->output.size();
+    entries.erase(it->key);
+    lru.erase(it);
+}
+
 } // namespace Tegra::Texture::ASTC
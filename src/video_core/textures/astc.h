@@ -4,12 +4,89 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <list>
+#include <unordered_map>
 #include <vector>
 
 namespace Tegra::Texture::ASTC {
 
+/**
+ * Decodes ASTC blocks to RGBA8.
+ * @param output Buffer of at least width * height * depth * 4 bytes
+ */
+void Decompress(const uint8_t* data, uint32_t width, uint32_t height, uint32_t depth,
+                uint32_t block_width, uint32_t block_height, uint8_t* output);
+
+/// Decodes ASTC blocks to a new RGBA8 buffer.
 std::vector<uint8_t> Decompress(const uint8_t* data, uint32_t width, uint32_t height,
                                 uint32_t depth, uint32_t block_width, uint32_t block_height);
 
+/**
+ * Textures decoded recently, so that loading the same blocks again copies the previous result
+ * instead of decoding it. Entries keep their input to tell blocks with the same hash apart. The
+ * least recently used entries are dropped once the input and decoded bytes exceed the budget.
+ * Not thread safe, it belongs to the texture cache that loads the textures.
+ */
+class DecodeCache {
+public:
+    static constexpr std::size_t DEFAULT_MAX_SIZE = 128 * 1024 * 1024;
+
+    explicit DecodeCache(std::size_t max_size_ = DEFAULT_MAX_SIZE);
+    ~DecodeCache();
+
+    DecodeCache(const DecodeCache&) = delete;
+    DecodeCache& operator=(const DecodeCache&) = delete;
+
+    /// Same as ASTC::Decompress, copying a cached result when there is one
+    void Decompress(const uint8_t* data, uint32_t width, uint32_t height, uint32_t depth,
+                    uint32_t block_width, uint32_t block_height, uint8_t* output);
+
+    /// Drops every entry
+    void Clear();
+
+    /// Number of cached textures
+    std::size_t GetNumEntries() const {
+        return entries.size();
+    }
+
+    /// Input and decoded bytes held by the cached textures
+    std::size_t GetSize() const {
+        return total_size;
+    }
+
+private:
+    /// Block sizes stand in for the format, the sRGB variants decode to the same texels
+    struct Key {
+        uint64_t hash;
+        uint32_t width;
+        uint32_t height;
+        uint32_t depth;
+        uint32_t block_width;
+        uint32_t block_height;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const {
+            return static_cast<std::size_t>(key.hash);
+        }
+    };
+
+    struct Entry {
+        Key key;
+        std::vector<uint8_t> input;
+        std::vector<uint8_t> output;
+    };
+
+    void Erase(std::list<Entry>::iterator it);
+
+    std::size_t max_size;
+    std::size_t total_size = 0;
+    std::list<Entry> lru; ///< Most recently used first
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> entries;
+};
+
 } // namespace Tegra::Texture::ASTC
@@ -63,15 +63,20 @@ static void ConvertZ24S8ToS8Z24(u8* data, u32 width, u32 height) {
 }
 
 void ConvertFromGuestToHost(u8* in_data, u8* out_data, PixelFormat pixel_format, u32 width,
-                            u32 height, u32 depth, bool convert_astc, bool convert_s8z24) {
+                            u32 height, u32 depth, bool convert_astc, bool convert_s8z24,
+                            ASTC::DecodeCache* astc_cache) {
     if (convert_astc && IsPixelFormatASTC(pixel_format)) {
         // Convert ASTC pixel formats to RGBA8, as most desktop GPUs do not support ASTC.
         u32 block_width{};
         u32 block_height{};
         std::tie(block_width, block_height) = GetASTCBlockSize(pixel_format);
-        const std::vector<u8> rgba8_data = Tegra::Texture::ASTC::Decompress(
-            in_data, width, height, depth, block_width, block_height);
-        std::copy(rgba8_data.begin(), rgba8_data.end(), out_data);
+        if (astc_cache != nullptr) {
+            astc_cache->Decompress(in_data, width, height, depth, block_width, block_height,
+                                   out_data);
+        } else {
+            Tegra::Texture::ASTC::Decompress(in_data, width, height, depth, block_width,
+                                             block_height, out_data);
+        }
 
     } else if (convert_s8z24 && pixel_format == PixelFormat::S8_UINT_D24_UNORM) {
         Tegra::Texture::ConvertS8Z24ToZ24S8(in_data, width, height);
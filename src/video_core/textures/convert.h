@@ -12,9 +12,14 @@ enum class PixelFormat;
 
 namespace Tegra::Texture {
 
+namespace ASTC {
+class DecodeCache;
+}
+
+/// @param astc_cache Where ASTC textures are decoded through, they are always decoded when null
 void ConvertFromGuestToHost(u8* in_data, u8* out_data, VideoCore::Surface::PixelFormat pixel_format,
                             u32 width, u32 height, u32 depth, bool convert_astc,
-                            bool convert_s8z24);
+                            bool convert_s8z24, ASTC::DecodeCache* astc_cache = nullptr);
 
 void ConvertFromHostToGuest(u8* data, VideoCore::Surface::PixelFormat pixel_format, u32 width,
                             u32 height, u32 depth, bool convert_astc, bool convert_s8z24);
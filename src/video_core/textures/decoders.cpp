@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include "common/alignment.h"
@@ -10,6 +11,18 @@
 #include "video_core/gpu.h"
 #include "video_core/textures/decoders.h"
 #include "video_core/textures/texture.h"
+#include "video_core/textures/workers.h"
+
+#ifdef ARCHITECTURE_x86_64
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define TARGET_AVX2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
 
 namespace Tegra::Texture {
 namespace {
@@ -43,6 +56,65 @@ constexpr u32 FAST_SWIZZLE_ALIGN = 16;
 constexpr auto LEGACY_SWIZZLE_TABLE = SwizzleTable<GOB_SIZE_X, GOB_SIZE_X, GOB_SIZE_Z>();
 constexpr auto FAST_SWIZZLE_TABLE = SwizzleTable<GOB_SIZE_Y, 4, FAST_SWIZZLE_ALIGN>();
 
+/// Copies a whole GOB between swizzled memory and 64 bytes wide linear rows "stride" bytes apart
+using GobCopyFunc = void (*)(u8* swizzled, u8* linear, u32 stride);
+
+template <bool unswizzle>
+void CopyGob(u8* swizzled, u8* linear, u32 stride) {
+    // Fixed size copies of 16 bytes, compilers turn them into single SSE loads and stores
+    for (u32 y = 0; y < GOB_SIZE_Y; ++y) {
+        const auto& table = FAST_SWIZZLE_TABLE[y];
+        for (u32 x = 0; x < GOB_SIZE_X / FAST_SWIZZLE_ALIGN; ++x) {
+            u8* const sector = swizzled + table[x];
+            u8* const row = linear + y * stride + x * FAST_SWIZZLE_ALIGN;
+            if constexpr (unswizzle) {
+                std::memcpy(row, sector, FAST_SWIZZLE_ALIGN);
+            } else {
+                std::memcpy(sector, row, FAST_SWIZZLE_ALIGN);
+            }
+        }
+    }
+}
+
+#ifdef ARCHITECTURE_x86_64
+/**
+ * Every 64 bytes of a GOB hold 32 bytes of two consecutive rows, interleaved 16 bytes at a time:
+ * [row 0 bytes 0-15][row 1 bytes 0-15][row 0 bytes 16-31][row 1 bytes 16-31]
+ * Two 32 byte rows are loaded and their 128-bit halves swapped into place.
+ */
+template <bool unswizzle>
+TARGET_AVX2 void CopyGobAVX2(u8* swizzled, u8* linear, u32 stride) {
+    for (u32 y = 0; y < GOB_SIZE_Y; y += 2) {
+        for (u32 half = 0; half < 2; ++half) {
+            auto* const row0 = reinterpret_cast<__m256i*>(linear + y * stride + half * 32);
+            auto* const row1 = reinterpret_cast<__m256i*>(linear + (y + 1) * stride + half * 32);
+            auto* const sectors = reinterpret_cast<__m256i*>(swizzled + half * 256 + y * 32);
+            if constexpr (unswizzle) {
+                const __m256i low = _mm256_loadu_si256(sectors);
+                const __m256i high = _mm256_loadu_si256(sectors + 1);
+                _mm256_storeu_si256(row0, _mm256_permute2x128_si256(low, high, 0x20));
+                _mm256_storeu_si256(row1, _mm256_permute2x128_si256(low, high, 0x31));
+            } else {
+                const __m256i first = _mm256_loadu_si256(row0);
+                const __m256i second = _mm256_loadu_si256(row1);
+                _mm256_storeu_si256(sectors, _mm256_permute2x128_si256(first, second, 0x20));
+                _mm256_storeu_si256(sectors + 1, _mm256_permute2x128_si256(first, second, 0x31));
+            }
+        }
+    }
+}
+#endif
+
+GobCopyFunc GetGobCopyFunc(bool unswizzle) {
+#ifdef ARCHITECTURE_x86_64
+    static const bool has_avx2 = Common::GetCPUCaps().avx2;
+    if (has_avx2) {
+        return unswizzle ? &CopyGobAVX2<true> : &CopyGobAVX2<false>;
+    }
+#endif
+    return unswizzle ? &CopyGob<true> : &CopyGob<false>;
+}
+
 /**
  * This function manages ALL the GOBs(Group of Bytes) Inside a single block.
  * Instead of going gob by gob, we map the coordinates inside a block and manage from
@@ -112,11 +184,43 @@ void FastProcessBlock(u8* const swizzled_data, u8* const unswizzled_data, const
     }
 }
 
+/**
+ * Processes a block a whole GOB at a time with the GOB copy kernel. The block has to span the
+ * full GOB width and pixels must keep their size in the linear texture, rows of a partial GOB at
+ * the bottom of the texture go through FastProcessBlock.
+ */
+void GobProcessBlock(u8* const swizzled_data, u8* const unswizzled_data, const bool unswizzle,
+                     const u32 x_start, const u32 y_start, const u32 z_start, const u32 x_end,
+                     const u32 y_end, const u32 z_end, const u32 tile_offset,
+                     const u32 xy_block_size, const u32 layer_z, const u32 stride_x,
+                     const u32 bytes_per_pixel) {
+    const GobCopyFunc copy_gob = GetGobCopyFunc(unswizzle);
+    u32 z_address = tile_offset;
+
+    for (u32 z = z_start; z < z_end; z++) {
+        u32 y_address = z_address;
+        u32 pixel_base = layer_z * z + y_start * stride_x + x_start * bytes_per_pixel;
+        u32 y = y_start;
+        for (; y + GOB_SIZE_Y <= y_end; y += GOB_SIZE_Y) {
+            copy_gob(swizzled_data + y_address, unswizzled_data + pixel_base, stride_x);
+            pixel_base += GOB_SIZE_Y * stride_x;
+            y_address += GOB_SIZE;
+        }
+        if (y < y_end) {
+            FastProcessBlock(swizzled_data, unswizzled_data, unswizzle, x_start, y, z, x_end,
+                             y_end, z + 1, y_address, xy_block_size, layer_z, stride_x,
+                             bytes_per_pixel, bytes_per_pixel);
+        }
+        z_address += xy_block_size;
+    }
+}
+
 /**
  * This function unswizzles or swizzles a texture by mapping Linear to BlockLinear Textue.
  * The body of this function takes care of splitting the swizzled texture into blocks,
  * and managing the extents of it. Once all the parameters of a single block are obtained,
- * the function calls 'ProcessBlock' to process that particular Block.
+ * the function calls 'ProcessBlock' to process that particular Block. Rows of blocks are
+ * independent, large textures split them between worker threads.
  *
  * Documentation for the memory layout and decoding can be found at:
  *  https://envytools.readthedocs.io/en/latest/hw/memory/g80-surface.html#blocklinear-surfaces
@@ -141,17 +245,25 @@ void SwizzledData(u8* const swizzled_data, u8* const unswizzled_data, const bool
     const u32 blocks_on_z = div_ceil(depth, block_z_elements);
     const u32 xy_block_size = GOB_SIZE * block_height;
     const u32 block_size = xy_block_size * block_depth;
-    u32 tile_offset = 0;
-    for (u32 zb = 0; zb < blocks_on_z; zb++) {
-        const u32 z_start = zb * block_z_elements;
-        const u32 z_end = std::min(depth, z_start + block_z_elements);
-        for (u32 yb = 0; yb < blocks_on_y; yb++) {
-            const u32 y_start = yb * block_y_elements;
+    const u32 row_size = block_size * blocks_on_x;
+    const u32 num_rows = blocks_on_y * blocks_on_z;
+    const bool whole_gobs = fast && bytes_per_pixel == out_bytes_per_pixel;
+
+    const auto process_rows = [&](u32 first_row, u32 last_row) {
+        for (u32 row = first_row; row < last_row; row++) {
+            const u32 z_start = (row / blocks_on_y) * block_z_elements;
+            const u32 z_end = std::min(depth, z_start + block_z_elements);
+            const u32 y_start = (row % blocks_on_y) * block_y_elements;
             const u32 y_end = std::min(height, y_start + block_y_elements);
+            u32 tile_offset = row * row_size;
             for (u32 xb = 0; xb < blocks_on_x; xb++) {
                 const u32 x_start = xb * block_x_elements;
                 const u32 x_end = std::min(width, x_start + block_x_elements);
-                if constexpr (fast) {
+                if (whole_gobs && x_end - x_start == block_x_elements) {
+                    GobProcessBlock(swizzled_data, unswizzled_data, unswizzle, x_start, y_start,
+                                    z_start, x_end, y_end, z_end, tile_offset, xy_block_size,
+                                    layer_z, stride_x, bytes_per_pixel);
+                } else if constexpr (fast) {
                     FastProcessBlock(swizzled_data, unswizzled_data, unswizzle, x_start, y_start,
                                      z_start, x_end, y_end, z_end, tile_offset, xy_block_size,
                                      layer_z, stride_x, bytes_per_pixel, out_bytes_per_pixel);
@@ -163,7 +275,8 @@ void SwizzledData(u8* const swizzled_data, u8* const unswizzled_data, const bool
                 tile_offset += block_size;
             }
         }
-    }
+    };
+    ForEachRowRange(num_rows, std::size_t{row_size} * num_rows, process_rows);
 }
 
 } // Anonymous namespace
@@ -208,24 +321,33 @@ void SwizzleSubrect(u32 subrect_width, u32 subrect_height, u32 source_pitch, u32
     const u32 block_height = 1U << block_height_bit;
     const u32 image_width_in_gobs =
         (swizzled_width * bytes_per_pixel + (GOB_SIZE_X - 1)) / GOB_SIZE_X;
-    for (u32 line = 0; line < subrect_height; ++line) {
-        const u32 dst_y = line + offset_y;
-        const u32 gob_address_y =
-            (dst_y / (GOB_SIZE_Y * block_height)) * GOB_SIZE * block_height * image_width_in_gobs +
-            ((dst_y % (GOB_SIZE_Y * block_height)) / GOB_SIZE_Y) * GOB_SIZE;
-        const auto& table = LEGACY_SWIZZLE_TABLE[dst_y % GOB_SIZE_Y];
-        for (u32 x = 0; x < subrect_width; ++x) {
-            const u32 dst_x = x + offset_x;
-            const u32 gob_address =
-                gob_address_y + (dst_x * bytes_per_pixel / GOB_SIZE_X) * GOB_SIZE * block_height;
-            const u32 swizzled_offset = gob_address + table[(dst_x * bytes_per_pixel) % GOB_SIZE_X];
-            const u32 unswizzled_offset = line * source_pitch + x * bytes_per_pixel;
-
-            const u8* const source_line = unswizzled_data + unswizzled_offset;
-            u8* const dest_addr = swizzled_data + swizzled_offset;
-            std::memcpy(dest_addr, source_line, bytes_per_pixel);
+    const u32 line_size = subrect_width * bytes_per_pixel;
+    const u32 dst_start = offset_x * bytes_per_pixel;
+    const auto process_lines = [&](u32 first_line, u32 last_line) {
+        for (u32 line = first_line; line < last_line; ++line) {
+            const u32 dst_y = line + offset_y;
+            const u32 gob_address_y =
+                (dst_y / (GOB_SIZE_Y * block_height)) * GOB_SIZE * block_height *
+                    image_width_in_gobs +
+                ((dst_y % (GOB_SIZE_Y * block_height)) / GOB_SIZE_Y) * GOB_SIZE;
+            const auto& table = LEGACY_SWIZZLE_TABLE[dst_y % GOB_SIZE_Y];
+            // Bytes are contiguous within each 16 byte sector of a GOB row
+            for (u32 x = 0; x < line_size;) {
+                const u32 dst_x = dst_start + x;
+                const u32 copy_amount =
+                    std::min(FAST_SWIZZLE_ALIGN - dst_x % FAST_SWIZZLE_ALIGN, line_size - x);
+                const u32 gob_address =
+                    gob_address_y + (dst_x / GOB_SIZE_X) * GOB_SIZE * block_height;
+                const u32 swizzled_offset = gob_address + table[dst_x % GOB_SIZE_X];
+                const u32 unswizzled_offset = line * source_pitch + x;
+
+                std::memcpy(swizzled_data + swizzled_offset, unswizzled_data + unswizzled_offset,
+                            copy_amount);
+                x += copy_amount;
+            }
         }
-    }
+    };
+    ForEachRowRange(subrect_height, std::size_t{line_size} * subrect_height, process_lines);
 }
 
 void UnswizzleSubrect(u32 line_length_in, u32 line_count, u32 pitch, u32 width, u32 bytes_per_pixel,
@@ -236,24 +358,33 @@ void UnswizzleSubrect(u32 line_length_in, u32 line_count, u32 pitch, u32 width,
 
     const u32 block_height_mask = (1U << block_height) - 1;
     const u32 x_shift = static_cast<u32>(GOB_SIZE_SHIFT) + block_height;
+    const u32 line_size = line_length_in * bytes_per_pixel;
+    const u32 src_start = origin_x * bytes_per_pixel;
 
-    for (u32 line = 0; line < line_count; ++line) {
-        const u32 src_y = line + origin_y;
-        const auto& table = LEGACY_SWIZZLE_TABLE[src_y % GOB_SIZE_Y];
+    const auto process_lines = [&](u32 first_line, u32 last_line) {
+        for (u32 line = first_line; line < last_line; ++line) {
+            const u32 src_y = line + origin_y;
+            const auto& table = LEGACY_SWIZZLE_TABLE[src_y % GOB_SIZE_Y];
 
-        const u32 block_y = src_y >> GOB_SIZE_Y_SHIFT;
-        const u32 src_offset_y = (block_y >> block_height) * block_size +
-                                 ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
-        for (u32 column = 0; column < line_length_in; ++column) {
-            const u32 src_x = (column + origin_x) * bytes_per_pixel;
-            const u32 src_offset_x = (src_x >> GOB_SIZE_X_SHIFT) << x_shift;
+            const u32 block_y = src_y >> GOB_SIZE_Y_SHIFT;
+            const u32 src_offset_y = (block_y >> block_height) * block_size +
+                                     ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
+            // Bytes are contiguous within each 16 byte sector of a GOB row
+            for (u32 x = 0; x < line_size;) {
+                const u32 src_x = src_start + x;
+                const u32 copy_amount =
+                    std::min(FAST_SWIZZLE_ALIGN - src_x % FAST_SWIZZLE_ALIGN, line_size - x);
+                const u32 src_offset_x = (src_x >> GOB_SIZE_X_SHIFT) << x_shift;
 
-            const u32 swizzled_offset = src_offset_y + src_offset_x + table[src_x % GOB_SIZE_X];
-            const u32 unswizzled_offset = line * pitch + column * bytes_per_pixel;
+                const u32 swizzled_offset = src_offset_y + src_offset_x + table[src_x % GOB_SIZE_X];
+                const u32 unswizzled_offset = line * pitch + x;
 
-            std::memcpy(output + unswizzled_offset, input + swizzled_offset, bytes_per_pixel);
+                std::memcpy(output + unswizzled_offset, input + swizzled_offset, copy_amount);
+                x += copy_amount;
+            }
         }
-    }
+    };
+    ForEachRowRange(line_count, std::size_t{line_size} * line_count, process_lines);
 }
 
 void SwizzleSliceToVoxel(u32 line_length_in, u32 line_count, u32 pitch, u32 width, u32 height,
@@ -0,0 +1,48 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include "common/common_types.h"
+
+namespace Tegra::Texture {
+
+/// Each worker thread gets at least this many bytes to produce, smaller jobs stay on the caller
+constexpr std::size_t MIN_BYTES_PER_THREAD = 1024 * 1024;
+
+/**
+ * Calls func(first, last) over ranges splitting [0, num_rows) between worker threads, or once
+ * over the whole range on the calling thread when there are too few bytes to be worth it.
+ * Rows must write to disjoint memory.
+ */
+template <typename Func>
+void ForEachRowRange(u32 num_rows, std::size_t num_bytes, Func&& func) {
+    const std::size_t max_threads = std::max(1U, std::thread::hardware_concurrency());
+    const u32 num_threads = static_cast<u32>(
+        std::min({max_threads, std::size_t{num_rows}, num_bytes / MIN_BYTES_PER_THREAD}));
+    if (num_threads <= 1) {
+        func(0U, num_rows);
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(num_threads - 1);
+    const auto range_begin = [&](u32 thread) {
+        return static_cast<u32>(u64{num_rows} * thread / num_threads);
+    };
+    for (u32 thread = 1; thread < num_threads; ++thread) {
+        workers.emplace_back([&func, first = range_begin(thread), last = range_begin(thread + 1)] {
+            func(first, last);
+        });
+    }
+    func(0U, range_begin(1));
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+} // namespace Tegra::Texture
@@ -10,6 +10,7 @@
 #include "video_core/gpu_asynch.h"
 #include "video_core/gpu_synch.h"
 #include "video_core/renderer_base.h"
+#include "video_core/renderer_null/renderer_null.h"
 #include "video_core/renderer_opengl/renderer_opengl.h"
 #ifdef HAS_VULKAN
 #include "video_core/renderer_vulkan/renderer_vulkan.h"
@@ -33,6 +34,8 @@ std::unique_ptr<VideoCore::RendererBase> CreateRenderer(
         return std::make_unique<Vulkan::RendererVulkan>(telemetry_session, emu_window, cpu_memory,
                                                         gpu, std::move(context));
 #endif
+    case Settings::RendererBackend::Null:
+        return std::make_unique<Null::RendererNull>(emu_window, gpu, std::move(context));
     default:
         return nullptr;
     }
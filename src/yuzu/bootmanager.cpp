@@ -534,6 +534,9 @@ bool GRenderWindow::InitRenderTarget() {
             return false;
         }
         break;
+    case Settings::RendererBackend::Null:
+        InitializeNull();
+        break;
     }
 
     // Update the Window System information with the new render target
@@ -629,6 +632,13 @@ bool GRenderWindow::InitializeVulkan() {
 #endif
 }
 
+void GRenderWindow::InitializeNull() {
+    // The null renderer never presents, the widget only keeps the window layout intact
+    child_widget = new RenderWidget(this);
+    child_widget->windowHandle()->create();
+    main_context = std::make_unique<DummyContext>();
+}
+
 bool GRenderWindow::LoadOpenGL() {
     auto context = CreateSharedContext();
     auto scope = context->Acquire();
@@ -190,6 +190,7 @@ private:
 
     bool InitializeOpenGL();
     bool InitializeVulkan();
+    void InitializeNull();
     bool LoadOpenGL();
     QStringList GetUnsupportedGLExtensions() const;
 
@@ -582,6 +582,9 @@ void Config::ReadDebuggingValues() {
     Settings::values.quest_flag = ReadSetting(QStringLiteral("quest_flag"), false).toBool();
     Settings::values.disable_macro_jit =
         ReadSetting(QStringLiteral("disable_macro_jit"), false).toBool();
+    Settings::values.enable_hle_functions =
+        ReadSetting(QStringLiteral("enable_hle_functions"), false).toBool();
+    Settings::values.rewind_frames = ReadSetting(QStringLiteral("rewind_frames"), 0).toUInt();
 
     qt_config->endGroup();
 }
@@ -1155,6 +1158,9 @@ void Config::SaveDebuggingValues() {
     WriteSetting(QStringLiteral("dump_nso"), Settings::values.dump_nso, false);
     WriteSetting(QStringLiteral("quest_flag"), Settings::values.quest_flag, false);
     WriteSetting(QStringLiteral("disable_macro_jit"), Settings::values.disable_macro_jit, false);
+    WriteSetting(QStringLiteral("enable_hle_functions"), Settings::values.enable_hle_functions,
+                 false);
+    WriteSetting(QStringLiteral("rewind_frames"), Settings::values.rewind_frames, 0);
 
     qt_config->endGroup();
 }
@@ -609,10 +609,6 @@ void GMainWindow::InitializeWidgets() {
     renderer_status_button->setObjectName(QStringLiteral("RendererStatusBarButton"));
     renderer_status_button->setCheckable(true);
     renderer_status_button->setFocusPolicy(Qt::NoFocus);
-    connect(renderer_status_button, &QPushButton::toggled, [this](bool checked) {
-        renderer_status_button->setText(checked ? tr("VULKAN") : tr("OPENGL"));
-    });
-    renderer_status_button->toggle();
 
 #ifndef HAS_VULKAN
     renderer_status_button->setChecked(false);
@@ -630,10 +626,12 @@ void GMainWindow::InitializeWidgets() {
         } else {
             Settings::values.renderer_backend.SetValue(Settings::RendererBackend::OpenGL);
         }
+        UpdateRendererStatusButton();
 
         Settings::Apply();
     });
 #endif // HAS_VULKAN
+    UpdateRendererStatusButton();
     statusBar()->insertPermanentWidget(0, renderer_status_button);
 
     statusBar()->setVisible(true);
@@ -1376,8 +1374,12 @@ void GMainWindow::OnGameListOpenFolder(u64 program_id, GameListOpenTarget target
 void GMainWindow::OnTransferableShaderCacheOpenFile(u64 program_id) {
     const QString shader_dir =
         QString::fromStdString(Common::FS::GetUserPath(Common::FS::UserPath::ShaderDir));
+    const QString backend_dir =
+        Settings::values.renderer_backend.GetValue() == Settings::RendererBackend::Vulkan
+            ? QStringLiteral("vulkan")
+            : QStringLiteral("opengl");
     const QString transferable_shader_cache_folder_path =
-        shader_dir + QStringLiteral("opengl") + QDir::separator() + QStringLiteral("transferable");
+        shader_dir + backend_dir + QDir::separator() + QStringLiteral("transferable");
     const QString transferable_shader_cache_file_path =
         transferable_shader_cache_folder_path + QDir::separator() +
         QString::fromStdString(fmt::format("{:016X}.bin", program_id));
@@ -1570,8 +1572,12 @@ void GMainWindow::OnGameListRemoveFile(u64 program_id, GameListRemoveTarget targ
 void GMainWindow::RemoveTransferableShaderCache(u64 program_id) {
     const QString shader_dir =
         QString::fromStdString(Common::FS::GetUserPath(Common::FS::UserPath::ShaderDir));
+    const QString backend_dir =
+        Settings::values.renderer_backend.GetValue() == Settings::RendererBackend::Vulkan
+            ? QStringLiteral("vulkan")
+            : QStringLiteral("opengl");
     const QString transferable_shader_cache_folder_path =
-        shader_dir + QStringLiteral("opengl") + QDir::separator() + QStringLiteral("transferable");
+        shader_dir + backend_dir + QDir::separator() + QStringLiteral("transferable");
     const QString transferable_shader_cache_file_path =
         transferable_shader_cache_folder_path + QDir::separator() +
         QString::fromStdString(fmt::format("{:016X}.bin", program_id));
@@ -2484,6 +2490,22 @@ void GMainWindow::UpdateStatusButtons() {
     renderer_status_button->setChecked(Settings::values.renderer_backend.GetValue() ==
                                        Settings::RendererBackend::Vulkan);
 #endif
+    UpdateRendererStatusButton();
+}
+
+void GMainWindow::UpdateRendererStatusButton() {
+    // The button only toggles between the GPU backends, clicking it leaves the null renderer
+    switch (Settings::values.renderer_backend.GetValue()) {
+    case Settings::RendererBackend::OpenGL:
+        renderer_status_button->setText(tr("OPENGL"));
+        break;
+    case Settings::RendererBackend::Vulkan:
+        renderer_status_button->setText(tr("VULKAN"));
+        break;
+    case Settings::RendererBackend::Null:
+        renderer_status_button->setText(tr("NULL"));
+        break;
+    }
 }
 
 void GMainWindow::HideMouseCursor() {
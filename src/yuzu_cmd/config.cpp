@@ -440,6 +440,10 @@ void Config::ReadValues() {
     Settings::values.quest_flag = sdl2_config->GetBoolean("Debugging", "quest_flag", false);
     Settings::values.disable_macro_jit =
         sdl2_config->GetBoolean("Debugging", "disable_macro_jit", false);
+    Settings::values.enable_hle_functions =
+        sdl2_config->GetBoolean("Debugging", "enable_hle_functions", false);
+    Settings::values.rewind_frames =
+        static_cast<u32>(sdl2_config->GetInteger("Debugging", "rewind_frames", 0));
 
     const auto title_list = sdl2_config->Get("AddOns", "title_ids", "");
     std::stringstream ss(title_list);
@@ -132,7 +132,8 @@ cpuopt_reduce_misalign_checks =
 
 [Renderer]
 # Which backend API to use.
-# 0 (default): OpenGL, 1: Vulkan
+# 0 (default): OpenGL, 1: Vulkan, 2: Null
+# Null runs the GPU engines without drawing anything, for headless use
 backend =
 
 # Enable graphics API debugging mode.
@@ -322,6 +323,12 @@ dump_nso=false
 quest_flag =
 # Enables/Disables the macro JIT compiler
 disable_macro_jit=false
+# Replaces guest functions with known code (memcpy, memset, ...) with host implementations
+# false (default): Run the guest code, true: Replace them
+enable_hle_functions=
+# Number of recent frames kept in memory to rewind to with plugins, single core mode only
+# 0 (default): Disabled
+rewind_frames=
 
 [WebService]
 # Whether or not to enable telemetry
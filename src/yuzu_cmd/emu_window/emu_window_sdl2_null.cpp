@@ -0,0 +1,54 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#include <fmt/format.h>
+
+#include "common/logging/log.h"
+#include "common/scm_rev.h"
+#include "yuzu_cmd/emu_window/emu_window_sdl2_null.h"
+
+#include <SDL.h>
+
+namespace {
+
+class NullContext final : public Core::Frontend::GraphicsContext {};
+
+/// Headless machines may have no display at all, use SDL's dummy video driver unless the user
+/// asked for another one. This has to happen before EmuWindow_SDL2 initializes SDL.
+InputCommon::InputSubsystem* UseDummyVideoDriver(InputCommon::InputSubsystem* input_subsystem) {
+    SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+    return input_subsystem;
+}
+
+} // Anonymous namespace
+
+EmuWindow_SDL2_Null::EmuWindow_SDL2_Null(InputCommon::InputSubsystem* input_subsystem)
+    : EmuWindow_SDL2{UseDummyVideoDriver(input_subsystem)} {
+    const std::string window_title = fmt::format("yuzu {} | {}-{} (Null)", Common::g_build_name,
+                                                 Common::g_scm_branch, Common::g_scm_desc);
+    render_window =
+        SDL_CreateWindow(window_title.c_str(), SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+                         Layout::ScreenUndocked::Width, Layout::ScreenUndocked::Height,
+                         SDL_WINDOW_HIDDEN);
+    if (render_window == nullptr) {
+        LOG_CRITICAL(Frontend, "Failed to create SDL2 window! {}", SDL_GetError());
+        std::exit(EXIT_FAILURE);
+    }
+
+    OnResize();
+    OnMinimalClientAreaChangeRequest(GetActiveConfig().min_client_area_size);
+    SDL_PumpEvents();
+    LOG_INFO(Frontend, "yuzu Version: {} | {}-{} (Null)", Common::g_build_name,
+             Common::g_scm_branch, Common::g_scm_desc);
+}
+
+EmuWindow_SDL2_Null::~EmuWindow_SDL2_Null() = default;
+
+std::unique_ptr<Core::Frontend::GraphicsContext> EmuWindow_SDL2_Null::CreateSharedContext() const {
+    return std::make_unique<NullContext>();
+}
@@ -0,0 +1,23 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+
+#include "core/frontend/emu_window.h"
+#include "yuzu_cmd/emu_window/emu_window_sdl2.h"
+
+namespace InputCommon {
+class InputSubsystem;
+}
+
+/// Window of the null renderer, hidden and without a graphics context for headless runs
+class EmuWindow_SDL2_Null final : public EmuWindow_SDL2 {
+public:
+    explicit EmuWindow_SDL2_Null(InputCommon::InputSubsystem* input_subsystem);
+    ~EmuWindow_SDL2_Null() override;
+
+    std::unique_ptr<Core::Frontend::GraphicsContext> CreateSharedContext() const override;
+};
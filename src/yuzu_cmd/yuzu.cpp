@@ -31,11 +31,13 @@
 #include "core/loader/loader.h"
 #include "core/settings.h"
 #include "core/telemetry_session.h"
+#include "core/tools/guest_profiler.h"
 #include "input_common/main.h"
 #include "video_core/renderer_base.h"
 #include "yuzu_cmd/config.h"
 #include "yuzu_cmd/emu_window/emu_window_sdl2.h"
 #include "yuzu_cmd/emu_window/emu_window_sdl2_gl.h"
+#include "yuzu_cmd/emu_window/emu_window_sdl2_null.h"
 #ifdef HAS_VULKAN
 #include "yuzu_cmd/emu_window/emu_window_sdl2_vk.h"
 #endif
@@ -69,7 +71,9 @@ static void PrintHelp(const char* argv0) {
                  "-f, --fullscreen      Start in fullscreen mode\n"
                  "-h, --help            Display this help and exit\n"
                  "-v, --version         Output version information and exit\n"
-                 "-p, --program         Pass following string as arguments to executable\n";
+                 "-p, --program         Pass following string as arguments to executable\n"
+                 "--profile-folded=FILE Sample guest code and write collapsed stacks to FILE\n"
+                 "--profile-pprof=FILE  Sample guest code and write a pprof profile to FILE\n";
 }
 
 static void PrintVersion() {
@@ -115,11 +119,14 @@ int main(int argc, char** argv) {
     std::string filepath;
 
     bool fullscreen = false;
+    std::string profile_folded_path;
+    std::string profile_pprof_path;
 
     static struct option long_options[] = {
         {"gdbport", required_argument, 0, 'g'}, {"fullscreen", no_argument, 0, 'f'},
         {"help", no_argument, 0, 'h'},          {"version", no_argument, 0, 'v'},
-        {"program", optional_argument, 0, 'p'}, {0, 0, 0, 0},
+        {"program", optional_argument, 0, 'p'}, {"profile-folded", required_argument, 0, 'F'},
+        {"profile-pprof", required_argument, 0, 'P'}, {0, 0, 0, 0},
     };
 
     while (optind < argc) {
@@ -151,6 +158,12 @@ int main(int argc, char** argv) {
                 Settings::values.program_args = argv[optind];
                 ++optind;
                 break;
+            case 'F':
+                profile_folded_path = optarg;
+                break;
+            case 'P':
+                profile_pprof_path = optarg;
+                break;
             }
         } else {
 #ifdef _WIN32
@@ -195,6 +208,9 @@ int main(int argc, char** argv) {
         LOG_CRITICAL(Frontend, "Vulkan backend has not been compiled!");
         return 1;
 #endif
+    case Settings::RendererBackend::Null:
+        emu_window = std::make_unique<EmuWindow_SDL2_Null>(&input_subsystem);
+        break;
     }
 
     system.SetContentProvider(std::make_unique<FileSys::ContentProviderUnion>());
@@ -240,11 +256,28 @@ int main(int argc, char** argv) {
         system.CurrentProcess()->GetTitleID(), false,
         [](VideoCore::LoadCallbackStage, size_t value, size_t total) {});
 
+    const bool is_profiling = !profile_folded_path.empty() || !profile_pprof_path.empty();
+    if (is_profiling) {
+        system.GuestProfiler().Start(std::chrono::milliseconds(1));
+    }
+
     system.Run();
     while (emu_window->IsOpen()) {
         std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
     system.Pause();
+
+    // Symbols are read from guest memory, so the profile is written before shutting down
+    if (is_profiling) {
+        auto& profiler = system.GuestProfiler();
+        profiler.Stop();
+        if (!profile_folded_path.empty()) {
+            profiler.WriteCollapsedStacks(profile_folded_path);
+        }
+        if (!profile_pprof_path.empty()) {
+            profiler.WritePprof(profile_pprof_path);
+        }
+    }
     system.Shutdown();
 
     detached_tasks.WaitForAllTasks();
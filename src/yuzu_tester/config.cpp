@@ -121,6 +121,10 @@ void Config::ReadValues() {
         sdl2_config->GetBoolean("Core", "use_multi_core", false));
 
     // Renderer
+    const int renderer_backend = sdl2_config->GetInteger(
+        "Renderer", "backend", static_cast<int>(Settings::RendererBackend::OpenGL));
+    Settings::values.renderer_backend.SetValue(
+        static_cast<Settings::RendererBackend>(renderer_backend));
     Settings::values.aspect_ratio.SetValue(
         static_cast<int>(sdl2_config->GetInteger("Renderer", "aspect_ratio", 0)));
     Settings::values.max_anisotropy.SetValue(
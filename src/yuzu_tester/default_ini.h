@@ -46,6 +46,11 @@ cpuopt_misc_ir =
 cpuopt_reduce_misalign_checks =
 
 [Renderer]
+# Which backend API to use.
+# 0 (default): OpenGL, 2: Null
+# Null runs the GPU engines without drawing anything, for headless use
+backend =
+
 # Whether to use software or hardware rendering.
 # 0: Software, 1 (default): Hardware
 use_hw_renderer =
@@ -0,0 +1,34 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "common/logging/log.h"
+#include "common/scm_rev.h"
+#include "core/frontend/framebuffer_layout.h"
+#include "core/settings.h"
+#include "yuzu_tester/emu_window/emu_window_null.h"
+
+namespace {
+
+class NullContext final : public Core::Frontend::GraphicsContext {};
+
+} // Anonymous namespace
+
+EmuWindow_Null::EmuWindow_Null() {
+    UpdateCurrentFramebufferLayout(Layout::ScreenUndocked::Width, Layout::ScreenUndocked::Height);
+    LOG_INFO(Frontend, "yuzu-tester Version: {} | {}-{} (Null)", Common::g_build_fullname,
+             Common::g_scm_branch, Common::g_scm_desc);
+    Settings::LogSettings();
+}
+
+EmuWindow_Null::~EmuWindow_Null() = default;
+
+void EmuWindow_Null::PollEvents() {}
+
+bool EmuWindow_Null::IsShown() const {
+    return false;
+}
+
+std::unique_ptr<Core::Frontend::GraphicsContext> EmuWindow_Null::CreateSharedContext() const {
+    return std::make_unique<NullContext>();
+}
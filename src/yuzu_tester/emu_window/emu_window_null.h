@@ -0,0 +1,24 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+
+#include "core/frontend/emu_window.h"
+
+/// Window of the null renderer, which needs neither a window system nor a graphics context
+class EmuWindow_Null final : public Core::Frontend::EmuWindow {
+public:
+    explicit EmuWindow_Null();
+    ~EmuWindow_Null() override;
+
+    /// Polls window events
+    void PollEvents() override;
+
+    /// Whether the screen is being shown or not.
+    bool IsShown() const override;
+
+    std::unique_ptr<Core::Frontend::GraphicsContext> CreateSharedContext() const override;
+};
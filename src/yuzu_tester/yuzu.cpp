@@ -31,6 +31,7 @@
 #include "core/telemetry_session.h"
 #include "video_core/renderer_base.h"
 #include "yuzu_tester/config.h"
+#include "yuzu_tester/emu_window/emu_window_null.h"
 #include "yuzu_tester/emu_window/emu_window_sdl2_hide.h"
 #include "yuzu_tester/service/yuzutest.h"
 
@@ -163,7 +164,23 @@ int main(int argc, char** argv) {
     Settings::values.use_gdbstub = false;
     Settings::Apply();
 
-    std::unique_ptr<EmuWindow_SDL2_Hide> emu_window{std::make_unique<EmuWindow_SDL2_Hide>()};
+    // The null window has no graphics context, only the OpenGL one needs a display
+    std::unique_ptr<EmuWindow_SDL2_Hide> gl_window;
+    std::unique_ptr<EmuWindow_Null> null_window;
+    Core::Frontend::EmuWindow* emu_window{};
+    switch (Settings::values.renderer_backend.GetValue()) {
+    case Settings::RendererBackend::OpenGL:
+        gl_window = std::make_unique<EmuWindow_SDL2_Hide>();
+        emu_window = gl_window.get();
+        break;
+    case Settings::RendererBackend::Vulkan:
+        LOG_CRITICAL(Frontend, "yuzu-tester does not support the Vulkan backend");
+        return 1;
+    case Settings::RendererBackend::Null:
+        null_window = std::make_unique<EmuWindow_Null>();
+        emu_window = null_window.get();
+        break;
+    }
 
     bool finished = false;
     int return_value = 0;